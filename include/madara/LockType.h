@@ -5,6 +5,11 @@
 #include <condition_variable>
 #include "madara/MadaraExport.h"
 
+#ifdef _MADARA_SHARED_LOCK_
+#include <atomic>
+#include <thread>
+#endif  // _MADARA_SHARED_LOCK_
+
 #ifndef MADARA_LOCK_TYPE
 
 #if defined _MADARA_NULL_LOCK_
@@ -24,6 +29,151 @@ struct null_mutex
 #define MADARA_LOCK_TYPE madara::null_mutex
 #define MADARA_LOCK_LOCK lock
 #define MADARA_LOCK_UNLOCK unlock
+#elif defined _MADARA_SHARED_LOCK_
+namespace madara
+{
+/**
+ * A recursive reader/writer lock. Exclusive ownership (lock/unlock) is
+ * recursive and behaves like std::recursive_mutex, so ContextGuard,
+ * KnowledgeBase::lock and KaRL evaluation keep their atomicity. Shared
+ * ownership (lock_shared/unlock_shared) lets many readers proceed at once.
+ * A thread that already holds the exclusive lock may take the shared lock
+ * as a nested acquisition. Readers are preferred over waiting writers so
+ * that nested shared acquisitions by one thread can never deadlock.
+ **/
+class recursive_shared_mutex
+{
+public:
+  recursive_shared_mutex() : owner_(std::thread::id()), depth_(0),
+    writer_(false), readers_(0)
+  {
+  }
+
+  recursive_shared_mutex(const recursive_shared_mutex&) = delete;
+  recursive_shared_mutex& operator=(const recursive_shared_mutex&) = delete;
+
+  void lock()
+  {
+    const std::thread::id me = std::this_thread::get_id();
+    if (owner_.load(std::memory_order_relaxed) == me)
+    {
+      ++depth_;
+      return;
+    }
+
+    std::unique_lock<std::mutex> guard(mutex_);
+    while (writer_ || readers_ != 0)
+      released_.wait(guard);
+
+    writer_ = true;
+    owner_.store(me, std::memory_order_relaxed);
+    depth_ = 1;
+  }
+
+  bool try_lock()
+  {
+    const std::thread::id me = std::this_thread::get_id();
+    if (owner_.load(std::memory_order_relaxed) == me)
+    {
+      ++depth_;
+      return true;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (writer_ || readers_ != 0)
+      return false;
+
+    writer_ = true;
+    owner_.store(me, std::memory_order_relaxed);
+    depth_ = 1;
+    return true;
+  }
+
+  void unlock()
+  {
+    if (--depth_ != 0)
+      return;
+
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      owner_.store(std::thread::id(), std::memory_order_relaxed);
+      writer_ = false;
+    }
+    released_.notify_all();
+  }
+
+  void lock_shared()
+  {
+    if (owner_.load(std::memory_order_relaxed) ==
+        std::this_thread::get_id())
+    {
+      ++depth_;
+      return;
+    }
+
+    std::unique_lock<std::mutex> guard(mutex_);
+    while (writer_)
+      released_.wait(guard);
+
+    ++readers_;
+  }
+
+  void unlock_shared()
+  {
+    if (owner_.load(std::memory_order_relaxed) ==
+        std::this_thread::get_id())
+    {
+      --depth_;
+      return;
+    }
+
+    bool last;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      last = --readers_ == 0;
+    }
+    if (last)
+      released_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable released_;
+  std::atomic<std::thread::id> owner_;
+  unsigned int depth_;
+  bool writer_;
+  unsigned int readers_;
+};
+
+/**
+ * Scoped shared (reader) ownership of a lock with lock_shared/unlock_shared
+ **/
+template<typename Lock>
+class shared_guard
+{
+public:
+  explicit shared_guard(Lock& lock) : lock_(lock)
+  {
+    lock_.lock_shared();
+  }
+
+  ~shared_guard()
+  {
+    lock_.unlock_shared();
+  }
+
+  shared_guard(const shared_guard&) = delete;
+  shared_guard& operator=(const shared_guard&) = delete;
+
+private:
+  Lock& lock_;
+};
+}
+
+#define MADARA_LOCK_TYPE madara::recursive_shared_mutex
+#define MADARA_LOCK_LOCK lock
+#define MADARA_LOCK_UNLOCK unlock
+#define MADARA_SHARED_GUARD_TYPE madara::shared_guard<MADARA_LOCK_TYPE>
 #else
 #define MADARA_LOCK_TYPE std::recursive_mutex
 #define MADARA_LOCK_LOCK lock
@@ -31,6 +181,12 @@ struct null_mutex
 #endif  // !_MADARA_NULL_LOCK_
 
 #define MADARA_GUARD_TYPE std::lock_guard<MADARA_LOCK_TYPE>
+
+// guard for read-only sections; exclusive unless a shared lock is in use
+#ifndef MADARA_SHARED_GUARD_TYPE
+#define MADARA_SHARED_GUARD_TYPE MADARA_GUARD_TYPE
+#endif  // !MADARA_SHARED_GUARD_TYPE
+
 #define MADARA_CONDITION_TYPE std::condition_variable_any
 #define MADARA_CONDITION_NOTIFY_ONE notify_one
 #define MADARA_CONDITION_NOTIFY_ALL notify_all
@@ -0,0 +1,261 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_EXPRESSION_BYTECODE_CPP_
+#define _MADARA_EXPRESSION_BYTECODE_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/Bytecode.h"
+#include "madara/expression/ComponentNode.h"
+#include "madara/expression/VariableNode.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * Marks the reused operand stack as in use for the life of an evaluation
+ **/
+class RunningGuard
+{
+public:
+  RunningGuard(bool& running) : running_(running)
+  {
+    running_ = true;
+  }
+
+  ~RunningGuard()
+  {
+    running_ = false;
+  }
+
+private:
+  bool& running_;
+};
+}
+}
+}
+
+madara::expression::Bytecode::Bytecode() : running_(false) {}
+
+size_t madara::expression::Bytecode::emit(Opcodes opcode, uint32_t operand)
+{
+  Instruction instruction = {(uint32_t)opcode, operand};
+  code_.push_back(instruction);
+
+  return code_.size() - 1;
+}
+
+void madara::expression::Bytecode::patch(size_t jump)
+{
+  code_[jump].operand = (uint32_t)code_.size();
+}
+
+void madara::expression::Bytecode::emit_constant(
+    const knowledge::KnowledgeRecord& value)
+{
+  constants_.push_back(value);
+  emit(PUSH_CONSTANT, (uint32_t)(constants_.size() - 1));
+}
+
+void madara::expression::Bytecode::emit_node(ComponentNode* node)
+{
+  nodes_.push_back(node);
+  emit(EVALUATE_NODE, (uint32_t)(nodes_.size() - 1));
+}
+
+void madara::expression::Bytecode::emit_variable(
+    Opcodes opcode, VariableNode* node)
+{
+  if (opcode == LOAD_VARIABLE)
+  {
+    if (node->get_ref().is_valid())
+    {
+      references_.push_back(node->get_ref());
+      emit(LOAD_VARIABLE, (uint32_t)(references_.size() - 1));
+    }
+    else
+    {
+      emit_node(node);
+    }
+  }
+  else
+  {
+    variables_.push_back(node);
+    emit(opcode, (uint32_t)(variables_.size() - 1));
+  }
+}
+
+size_t madara::expression::Bytecode::size(void) const
+{
+  return code_.size();
+}
+
+size_t madara::expression::Bytecode::fallbacks(void) const
+{
+  return nodes_.size();
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::Bytecode::evaluate(
+    const knowledge::KnowledgeUpdateSettings& settings)
+{
+  // a function may evaluate the same expression from within a node
+  if (running_)
+  {
+    std::vector<knowledge::KnowledgeRecord> stack;
+    return run(settings, stack);
+  }
+
+  RunningGuard guard(running_);
+  return run(settings, stack_);
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::Bytecode::run(
+    const knowledge::KnowledgeUpdateSettings& settings,
+    std::vector<knowledge::KnowledgeRecord>& stack)
+{
+  typedef knowledge::KnowledgeRecord KnowledgeRecord;
+
+  const Instruction* code = code_.data();
+  const size_t end = code_.size();
+
+  // number of values on the stack, and the most there have been
+  size_t top = 0;
+  size_t used = 0;
+
+  for (size_t pc = 0; pc < end;)
+  {
+    const Instruction& instruction = code[pc++];
+
+    // make room for a push
+    if (top == stack.size())
+    {
+      stack.resize(stack.size() * 2 + 4);
+    }
+
+    switch (instruction.opcode)
+    {
+      case PUSH_CONSTANT:
+        stack[top++] = constants_[instruction.operand];
+        break;
+      case LOAD_VARIABLE:
+        stack[top++] =
+            *references_[instruction.operand].get_record_unsafe();
+        break;
+      case EVALUATE_NODE:
+        stack[top++] = nodes_[instruction.operand]->evaluate(settings);
+        break;
+      case STORE_VARIABLE:
+        variables_[instruction.operand]->set(stack[top - 1], settings);
+        break;
+      case INCREMENT_VARIABLE:
+        stack[top++] = variables_[instruction.operand]->inc(settings);
+        break;
+      case DECREMENT_VARIABLE:
+        stack[top++] = variables_[instruction.operand]->dec(settings);
+        break;
+      case ADD:
+        stack[top - 2] += stack[top - 1];
+        --top;
+        break;
+      case SUBTRACT:
+        stack[top - 2] = stack[top - 2] - stack[top - 1];
+        --top;
+        break;
+      case MULTIPLY:
+        stack[top - 2] *= stack[top - 1];
+        --top;
+        break;
+      case DIVIDE:
+        stack[top - 2] = stack[top - 2] / stack[top - 1];
+        --top;
+        break;
+      case MODULUS:
+        stack[top - 2] = stack[top - 2] % stack[top - 1];
+        --top;
+        break;
+      case LESS_THAN:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] < stack[top - 1]);
+        --top;
+        break;
+      case LESS_THAN_EQUAL:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] <= stack[top - 1]);
+        --top;
+        break;
+      case GREATER_THAN:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] > stack[top - 1]);
+        --top;
+        break;
+      case GREATER_THAN_EQUAL:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] >= stack[top - 1]);
+        --top;
+        break;
+      case EQUAL:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] == stack[top - 1]);
+        --top;
+        break;
+      case NOT_EQUAL:
+        stack[top - 2] = KnowledgeRecord(stack[top - 2] != stack[top - 1]);
+        --top;
+        break;
+      case MINIMUM:
+        if (stack[top - 1] < stack[top - 2])
+          stack[top - 2] = stack[top - 1];
+        --top;
+        break;
+      case MAXIMUM:
+        if (stack[top - 1] > stack[top - 2])
+          stack[top - 2] = stack[top - 1];
+        --top;
+        break;
+      case NOT:
+        stack[top - 1] = KnowledgeRecord(!stack[top - 1]);
+        break;
+      case NEGATE:
+        stack[top - 1] = -stack[top - 1];
+        break;
+      case POP:
+        --top;
+        break;
+      case JUMP:
+        pc = instruction.operand;
+        break;
+      case JUMP_IF_FALSE:
+        if (stack[--top].is_false())
+          pc = instruction.operand;
+        break;
+      case JUMP_IF_TRUE:
+        if (stack[--top].is_true())
+          pc = instruction.operand;
+        break;
+      case JUMP_IF_FALSE_KEEP:
+        if (stack[top - 1].is_false())
+          pc = instruction.operand;
+        break;
+    }
+
+    if (top > used)
+      used = top;
+  }
+
+  KnowledgeRecord result;
+
+  if (top > 0)
+  {
+    result = std::move(stack[top - 1]);
+  }
+
+  // don't hold on to values, which would keep shared arrays from being
+  // changed in place
+  for (size_t i = 0; i < used; ++i)
+  {
+    stack[i].clear_value();
+  }
+
+  return result;
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_EXPRESSION_BYTECODE_CPP_
@@ -0,0 +1,214 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_EXPRESSION_BYTECODE_H_
+#define _MADARA_EXPRESSION_BYTECODE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file Bytecode.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the Bytecode class, a flattened form of an
+ * expression tree that is evaluated by a stack machine
+ **/
+
+#include <vector>
+
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/knowledge/KnowledgeUpdateSettings.h"
+#include "madara/knowledge/VariableReference.h"
+#include "madara/utility/StdInt.h"
+
+namespace madara
+{
+namespace expression
+{
+// Forward declarations.
+class ComponentNode;
+class VariableNode;
+
+/**
+ * @class Bytecode
+ * @brief A pruned expression tree lowered into a flat list of stack
+ *        machine instructions. Operators whose nodes know how to lower
+ *        themselves (see ComponentNode::compile) become instructions
+ *        over pre-resolved variable references. Any other subtree is
+ *        kept as a single instruction that evaluates the node, so the
+ *        result of evaluating the bytecode is always that of the tree.
+ *
+ *        Bytecode refers to the nodes of the tree it was compiled from,
+ *        which must outlive it, and is evaluated with the context locked.
+ */
+class Bytecode
+{
+public:
+  /**
+   * Instructions of the stack machine. Values are pushed and popped
+   * from the top of an operand stack.
+   **/
+  enum Opcodes
+  {
+    /// pushes constant[operand]
+    PUSH_CONSTANT,
+    /// pushes the value of reference[operand]
+    LOAD_VARIABLE,
+    /// pushes the result of evaluating node[operand]
+    EVALUATE_NODE,
+    /// sets variable[operand] to the top, leaving it on the stack
+    STORE_VARIABLE,
+    /// increments variable[operand] and pushes the new value
+    INCREMENT_VARIABLE,
+    /// decrements variable[operand] and pushes the new value
+    DECREMENT_VARIABLE,
+    /// replaces the top two values with their sum
+    ADD,
+    /// replaces the top two values with their difference
+    SUBTRACT,
+    /// replaces the top two values with their product
+    MULTIPLY,
+    /// replaces the top two values with their quotient
+    DIVIDE,
+    /// replaces the top two values with their remainder
+    MODULUS,
+    /// replaces the top two values with 1 if less than, else 0
+    LESS_THAN,
+    /// replaces the top two values with 1 if less or equal, else 0
+    LESS_THAN_EQUAL,
+    /// replaces the top two values with 1 if greater than, else 0
+    GREATER_THAN,
+    /// replaces the top two values with 1 if greater or equal, else 0
+    GREATER_THAN_EQUAL,
+    /// replaces the top two values with 1 if equal, else 0
+    EQUAL,
+    /// replaces the top two values with 1 if not equal, else 0
+    NOT_EQUAL,
+    /// replaces the top two values with the lesser
+    MINIMUM,
+    /// replaces the top two values with the greater
+    MAXIMUM,
+    /// replaces the top with its logical negation
+    NOT,
+    /// replaces the top with its arithmetic negation
+    NEGATE,
+    /// discards the top
+    POP,
+    /// continues at instruction operand
+    JUMP,
+    /// pops the top, continuing at instruction operand if it is false
+    JUMP_IF_FALSE,
+    /// pops the top, continuing at instruction operand if it is true
+    JUMP_IF_TRUE,
+    /// continues at instruction operand if the top is false
+    JUMP_IF_FALSE_KEEP
+  };
+
+  /**
+   * An instruction and its operand
+   **/
+  struct Instruction
+  {
+    /// the operation, one of Opcodes
+    uint32_t opcode;
+
+    /// index of a constant, variable or node, or a jump target
+    uint32_t operand;
+  };
+
+  /**
+   * Constructor
+   **/
+  Bytecode();
+
+  /**
+   * Appends an instruction
+   * @param  opcode    the operation
+   * @param  operand   the operand of the operation
+   * @return the index of the instruction, for patch
+   **/
+  size_t emit(Opcodes opcode, uint32_t operand = 0);
+
+  /**
+   * Sets the target of a jump to the next instruction emitted
+   * @param  jump      the index of the jump instruction
+   **/
+  void patch(size_t jump);
+
+  /**
+   * Appends an instruction that pushes a constant
+   * @param  value     the constant
+   **/
+  void emit_constant(const knowledge::KnowledgeRecord& value);
+
+  /**
+   * Appends an instruction that pushes the result of evaluating a node
+   * @param  node      the node to evaluate
+   **/
+  void emit_node(ComponentNode* node);
+
+  /**
+   * Appends an instruction that reads, writes or changes a variable.
+   * Variables whose keys need expansion are evaluated as nodes.
+   * @param  opcode    LOAD_VARIABLE, STORE_VARIABLE, INCREMENT_VARIABLE
+   *                   or DECREMENT_VARIABLE
+   * @param  node      the variable
+   **/
+  void emit_variable(Opcodes opcode, VariableNode* node);
+
+  /**
+   * Evaluates the instructions
+   * @param  settings  settings for evaluating and setting knowledge
+   * @return the value of the expression
+   **/
+  knowledge::KnowledgeRecord evaluate(
+      const knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Returns the number of instructions
+   * @return the number of instructions
+   **/
+  size_t size(void) const;
+
+  /**
+   * Returns the number of subtrees that are evaluated as nodes
+   * @return the number of EVALUATE_NODE instructions
+   **/
+  size_t fallbacks(void) const;
+
+private:
+  /**
+   * Runs the instructions on an operand stack
+   * @param  settings  settings for evaluating and setting knowledge
+   * @param  stack     the operand stack, grown as needed
+   * @return the value of the expression
+   **/
+  knowledge::KnowledgeRecord run(
+      const knowledge::KnowledgeUpdateSettings& settings,
+      std::vector<knowledge::KnowledgeRecord>& stack);
+
+  /// the instructions
+  std::vector<Instruction> code_;
+
+  /// constants pushed by PUSH_CONSTANT
+  std::vector<knowledge::KnowledgeRecord> constants_;
+
+  /// pre-resolved references read by LOAD_VARIABLE
+  std::vector<knowledge::VariableReference> references_;
+
+  /// variables written by STORE_VARIABLE and its kin
+  std::vector<VariableNode*> variables_;
+
+  /// subtrees evaluated by EVALUATE_NODE
+  std::vector<ComponentNode*> nodes_;
+
+  /// operand stack reused between evaluations
+  std::vector<knowledge::KnowledgeRecord> stack_;
+
+  /// true while the reused stack is in use, e.g., by a recursive call
+  bool running_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_EXPRESSION_BYTECODE_H_
@@ -0,0 +1,129 @@
+/* -*- C++ -*- */
+#ifndef _COMPILED_LOGIC_NODE_CPP_
+#define _COMPILED_LOGIC_NODE_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "madara/expression/CompiledLogicNode.h"
+#include "madara/exceptions/FileException.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * Loads a shared library, which is unloaded with the last copy of the
+ * returned pointer
+ **/
+std::shared_ptr<void> load_library(const std::string& path)
+{
+#ifdef _WIN32
+  HMODULE handle = LoadLibraryA(path.c_str());
+
+  if (!handle)
+    return std::shared_ptr<void>();
+
+  return std::shared_ptr<void>(
+      (void*)handle, [](void* handle) { FreeLibrary((HMODULE)handle); });
+#else
+  void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+  if (!handle)
+    return std::shared_ptr<void>();
+
+  return std::shared_ptr<void>(handle, [](void* handle) { dlclose(handle); });
+#endif
+}
+
+/**
+ * Finds the function that creates the logic of a library
+ **/
+knowledge::CompiledLogicFactory find_factory(void* library)
+{
+#ifdef _WIN32
+  return (knowledge::CompiledLogicFactory)GetProcAddress(
+      (HMODULE)library, MADARA_COMPILED_LOGIC_FACTORY);
+#else
+  return (knowledge::CompiledLogicFactory)dlsym(
+      library, MADARA_COMPILED_LOGIC_FACTORY);
+#endif
+}
+}
+}
+}
+
+madara::expression::CompiledLogicNode::CompiledLogicNode(
+    knowledge::ThreadSafeContext& context, const std::string& path)
+  : ComponentNode(context.get_logger()), library_(load_library(path))
+{
+  if (!library_)
+  {
+    madara_logger_ptr_log(logger_, logger::LOG_ERROR,
+        "CompiledLogicNode: unable to load %s\n", path.c_str());
+
+    throw exceptions::FileException(
+        "CompiledLogicNode: unable to load " + path + "\n");
+  }
+
+  knowledge::CompiledLogicFactory factory = find_factory(library_.get());
+
+  if (!factory)
+  {
+    madara_logger_ptr_log(logger_, logger::LOG_ERROR,
+        "CompiledLogicNode: %s does not contain compiled logic\n",
+        path.c_str());
+
+    throw exceptions::FileException(
+        "CompiledLogicNode: " + path + " does not contain compiled logic\n");
+  }
+
+  logic_.reset(factory(context));
+
+  madara_logger_ptr_log(logger_, logger::LOG_MAJOR,
+      "CompiledLogicNode: loaded %s from %s\n", logic_->logic(),
+      path.c_str());
+}
+
+madara::expression::CompiledLogicNode::~CompiledLogicNode(void)
+{
+  // the code of the logic lives in the library
+  logic_.reset();
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::CompiledLogicNode::item(
+    void) const
+{
+  return knowledge::KnowledgeRecord(logic_->logic());
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::CompiledLogicNode::prune(
+    bool& can_change)
+{
+  can_change = true;
+
+  return knowledge::KnowledgeRecord();
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::CompiledLogicNode::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  return logic_->evaluate(settings);
+}
+
+std::string madara::expression::CompiledLogicNode::logic(void) const
+{
+  return logic_->logic();
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _COMPILED_LOGIC_NODE_CPP_ */
@@ -0,0 +1,84 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_COMPILED_LOGIC_NODE_H_
+#define _MADARA_COMPILED_LOGIC_NODE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <memory>
+#include <string>
+
+#include "madara/expression/ComponentNode.h"
+#include "madara/knowledge/CompiledLogic.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+
+namespace madara
+{
+namespace expression
+{
+// Forward declarations.
+class Visitor;
+
+/**
+ * @class CompiledLogicNode
+ * @brief Defines a node that evaluates logic loaded from a shared library
+ *        generated by karlc. The library stays loaded for the life of
+ *        the node.
+ */
+class CompiledLogicNode : public ComponentNode
+{
+public:
+  /**
+   * Constructor
+   * @param   context  the context the logic reads and changes
+   * @param   path     the path of the shared library
+   * @throw exceptions::FileException  the library could not be loaded or
+   *                                   does not contain compiled logic
+   **/
+  CompiledLogicNode(
+      knowledge::ThreadSafeContext& context, const std::string& path);
+
+  /**
+   * Destructor
+   **/
+  virtual ~CompiledLogicNode(void);
+
+  /**
+   * Returns the value of the node
+   * @return    value of the node
+   **/
+  virtual madara::knowledge::KnowledgeRecord item(void) const;
+
+  /**
+   * Prunes the expression tree of unnecessary nodes.
+   * @param     can_change   set to true, since the logic is opaque
+   * @return    the value of the node
+   **/
+  virtual madara::knowledge::KnowledgeRecord prune(bool& can_change);
+
+  /**
+   * Evaluates the loaded logic
+   * @param     settings     settings for evaluating the node
+   * @return    value of the logic
+   **/
+  virtual madara::knowledge::KnowledgeRecord evaluate(
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Returns the KaRL logic the library was generated from
+   * @return    the logic
+   **/
+  std::string logic(void) const;
+
+private:
+  /// the loaded library, unloaded when released
+  std::shared_ptr<void> library_;
+
+  /// the logic created by the library, destroyed before it is unloaded
+  std::unique_ptr<knowledge::CompiledLogic> logic_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_COMPILED_LOGIC_NODE_H_ */
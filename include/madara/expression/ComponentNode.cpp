@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/knowledge/KnowledgeRecord.h"
 
 madara::expression::ComponentNode::ComponentNode(logger::Logger& logger)
@@ -45,6 +46,18 @@ void madara::expression::ComponentNode::accept(
 {
 }
 
+// evaluate the node as a single instruction
+void madara::expression::ComponentNode::compile(Bytecode& program)
+{
+  program.emit_node(this);
+}
+
+// by default, nodes have no children
+void madara::expression::ComponentNode::get_children(
+    std::vector<ComponentNode**>&)
+{
+}
+
 void madara::expression::ComponentNode::set_logger(logger::Logger& logger)
 {
   logger_ = &logger;
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <deque>
+#include <vector>
 #include <stdexcept>
 #include "madara/knowledge/KnowledgeRecord.h"
 #include "madara/knowledge/KnowledgeUpdateSettings.h"
@@ -22,8 +23,9 @@ class ThreadSafeContext;
 
 namespace expression
 {
-// Forward declaration.
+// Forward declarations.
 class Visitor;
+class Bytecode;
 
 /**
  * @class ComponentNode
@@ -85,6 +87,21 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Lowers the node into bytecode. By default, the node is kept as a
+   * single instruction that evaluates it.
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
+  /**
+   * Returns the slots that hold the children of the node, so they can be
+   * replaced, e.g., by ExpressionProfile. By default, a node has no
+   * children.
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
   /**
    * Sets the logger for printing errors and debugging info
    * @param  logger the logger to use
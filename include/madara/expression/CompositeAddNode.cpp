@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeAddNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -98,6 +99,24 @@ void madara::expression::CompositeAddNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeAddNode::compile(Bytecode& program)
+{
+  if (nodes_.empty())
+  {
+    program.emit_constant(madara::knowledge::KnowledgeRecord());
+    return;
+  }
+
+  ComponentNodes::iterator i = nodes_.begin();
+  (*i)->compile(program);
+
+  for (++i; i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    program.emit(Bytecode::ADD);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _ADD_NODE_CPP_ */
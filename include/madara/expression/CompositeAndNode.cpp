@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeAndNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -94,6 +95,27 @@ void madara::expression::CompositeAndNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeAndNode::compile(Bytecode& program)
+{
+  std::vector<size_t> jumps;
+
+  // jump to the false result on the first false operand
+  for (ComponentNodes::iterator i = nodes_.begin(); i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    jumps.push_back(program.emit(Bytecode::JUMP_IF_FALSE));
+  }
+
+  program.emit_constant(madara::knowledge::KnowledgeRecord(1));
+  size_t end = program.emit(Bytecode::JUMP);
+
+  for (size_t jump : jumps)
+    program.patch(jump);
+
+  program.emit_constant(madara::knowledge::KnowledgeRecord(0));
+  program.patch(end);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* COMPOSITE_AND_NODE_CPP */
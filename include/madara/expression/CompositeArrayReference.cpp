@@ -3,6 +3,7 @@
 
 #include "madara/expression/Visitor.h"
 #include "madara/expression/CompositeArrayReference.h"
+#include "madara/expression/KeyExpansionCache.h"
 #include "madara/utility/Utility.h"
 #include "VariableExpander.h"
 
@@ -20,6 +21,14 @@ madara::expression::CompositeArrayReference::CompositeArrayReference(
   VariableExpander expander;
   ref_ = expander.expand(key, "CompositeArrayReference", context, logger_,
       key_expansion_necessary_, splitters_, tokens_, pivot_list_);
+
+  // remember what the key expands to for each value of its variables
+  if (key_expansion_necessary_)
+    expansion_.reset(new KeyExpansionCache(key, context_));
+}
+
+madara::expression::CompositeArrayReference::~CompositeArrayReference(void)
+{
 }
 
 std::string madara::expression::CompositeArrayReference::expand_key(void) const
@@ -61,6 +70,29 @@ std::string madara::expression::CompositeArrayReference::expand_key(void) const
     return key_;
 }
 
+bool madara::expression::CompositeArrayReference::find_expanded(
+    knowledge::VariableReference& variable, bool create) const
+{
+  return expansion_ && expansion_->find(variable, create);
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::CompositeArrayReference::retrieve(size_t index) const
+{
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, false))
+  {
+    // a missing variable reads as an empty record, as with get
+    if (ref.is_valid())
+      return ref.get_record_unsafe()->retrieve_index(index);
+
+    return knowledge::KnowledgeRecord().retrieve_index(index);
+  }
+
+  return context_.get(expand_key()).retrieve_index(index);
+}
+
 void madara::expression::CompositeArrayReference::accept(Visitor& visitor) const
 {
   visitor.visit(*this);
@@ -71,12 +103,7 @@ madara::expression::CompositeArrayReference::item() const
 {
   size_t index = right_->item().to_integer();
 
-  if (ref_.is_valid())
-  {
-    return ref_.get_record_unsafe()->retrieve_index(index);
-  }
-  else
-    return context_.get(expand_key()).retrieve_index(index);
+  return retrieve(index);
 }
 
 /// Prune the tree of unnecessary nodes.
@@ -136,12 +163,7 @@ madara::expression::CompositeArrayReference::evaluate(
 {
   size_t index = right_->evaluate(settings).to_integer();
 
-  if (ref_.is_valid())
-  {
-    return ref_.get_record_unsafe()->retrieve_index(index);
-  }
-  else
-    return context_.get(expand_key()).retrieve_index(index);
+  return retrieve(index);
 }
 
 const std::string& madara::expression::CompositeArrayReference::key() const
@@ -156,14 +178,16 @@ madara::expression::CompositeArrayReference::dec(
 {
   size_t index = size_t(right_->evaluate(settings).to_integer());
 
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
     if (!settings.always_overwrite && record->write_quality < record->quality)
-      return context_.retrieve_index(expand_key(), index, settings);
+      return record->retrieve_index(index);
 
     // cheaper to read than write, so check to see if
     // we actually need to update quality and status
@@ -172,7 +196,7 @@ madara::expression::CompositeArrayReference::dec(
 
     knowledge::KnowledgeRecord result(record->dec_index(index));
 
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return result;
   }
@@ -198,14 +222,16 @@ madara::expression::CompositeArrayReference::inc(
 {
   size_t index = size_t(right_->evaluate(settings).to_integer());
 
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
     if (!settings.always_overwrite && record->write_quality < record->quality)
-      return context_.retrieve_index(expand_key(), index, settings);
+      return record->retrieve_index(index);
 
     // cheaper to read than write, so check to see if
     // we actually need to update quality and status
@@ -214,7 +240,7 @@ madara::expression::CompositeArrayReference::inc(
 
     knowledge::KnowledgeRecord result(record->inc_index(index));
 
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return result;
   }
@@ -253,9 +279,11 @@ int madara::expression::CompositeArrayReference::set(
 {
   size_t index = size_t(right_->evaluate(settings).to_integer());
 
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
@@ -269,7 +297,7 @@ int madara::expression::CompositeArrayReference::set(
 
     record->set_index(index, value);
 
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return 0;
   }
@@ -282,9 +310,11 @@ int madara::expression::CompositeArrayReference::set(
 {
   size_t index = size_t(right_->evaluate(settings).to_integer());
 
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
@@ -298,7 +328,7 @@ int madara::expression::CompositeArrayReference::set(
 
     record->set_index(index, value);
 
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return 0;
   }
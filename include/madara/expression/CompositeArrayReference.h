@@ -4,6 +4,7 @@
 
 #ifndef _MADARA_NO_KARL_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@ namespace expression
 {
 // Forward declarations.
 class Visitor;
+class KeyExpansionCache;
 
 /**
  * @class CompositeArrayReference
@@ -37,6 +39,11 @@ public:
   CompositeArrayReference(const std::string& key, ComponentNode* index,
       madara::knowledge::ThreadSafeContext& context);
 
+  /**
+   * Destructor
+   **/
+  virtual ~CompositeArrayReference(void);
+
   /// Sets the value stored in the node.
   knowledge::KnowledgeRecord dec(
       const madara::knowledge::KnowledgeUpdateSettings& settings =
@@ -95,11 +102,32 @@ public:
   {
     if (ref_.is_valid())
       return ref_.get_record_unsafe();
-    else
-      return context_.get_record(expand_key());
+
+    knowledge::VariableReference ref;
+    if (find_expanded(ref, true))
+      return ref.get_record_unsafe();
+
+    return context_.get_record(expand_key());
   }
 
 private:
+  /**
+   * Finds the variable an expanded key refers to, without building the
+   * key when the same expansion was seen before
+   * @param  variable  the variable, or invalid if missing and not created
+   * @param  create    create the variable if it does not exist
+   * @return false if the key must be built with expand_key instead
+   **/
+  bool find_expanded(
+      knowledge::VariableReference& variable, bool create) const;
+
+  /**
+   * Reads an index of the variable
+   * @param  index     the index
+   * @return the value at the index
+   **/
+  madara::knowledge::KnowledgeRecord retrieve(size_t index) const;
+
   madara::knowledge::ThreadSafeContext& context_;
 
   /// Key for retrieving value of this variable.
@@ -114,6 +142,9 @@ private:
   std::vector<std::string> tokens_;
   std::vector<std::string> pivot_list_;
 
+  /// variables the key expanded to, if the key needs expansion
+  std::unique_ptr<KeyExpansionCache> expansion_;
+
   /// Reference to context for variable retrieval
 };
 }
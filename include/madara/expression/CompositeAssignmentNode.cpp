@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeAssignmentNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -123,6 +124,29 @@ void madara::expression::CompositeAssignmentNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeAssignmentNode::compile(Bytecode& program)
+{
+  if (var_)
+  {
+    right_->compile(program);
+    program.emit_variable(Bytecode::STORE_VARIABLE, var_);
+  }
+  else
+    program.emit_node(this);
+}
+
+madara::expression::VariableNode*
+madara::expression::CompositeAssignmentNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::CompositeAssignmentNode::get_array(void) const
+{
+  return array_;
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _ASSIGNMENT_NODE_CPP_ */
@@ -61,6 +61,24 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Lowers the node into bytecode
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
+  /**
+   * Returns the variable the node changes
+   * @return    the variable, or 0 if it is not a simple variable
+   **/
+  VariableNode* get_variable(void) const;
+
+  /**
+   * Returns the array index the node changes
+   * @return    the array reference, or 0 if it is a simple variable
+   **/
+  CompositeArrayReference* get_array(void) const;
+
 private:
   /**
    * Left should always be a variable node. Using VariableNode
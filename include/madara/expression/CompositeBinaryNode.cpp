@@ -26,6 +26,14 @@ madara::expression::CompositeBinaryNode::left(void) const
   return left_;
 }
 
+// Return the left and right child slots
+void madara::expression::CompositeBinaryNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&left_);
+  CompositeUnaryNode::get_children(children);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_LR_NODE_CPP_ */
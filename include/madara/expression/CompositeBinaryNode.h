@@ -40,6 +40,12 @@ public:
    **/
   virtual ComponentNode* left(void) const;
 
+  /**
+   * Returns the slots that hold the children of the node
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
 protected:
   /// left expression
   ComponentNode* left_;
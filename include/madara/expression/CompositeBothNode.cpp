@@ -10,6 +10,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeBothNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -83,6 +84,24 @@ void madara::expression::CompositeBothNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeBothNode::compile(Bytecode& program)
+{
+  if (nodes_.empty())
+  {
+    program.emit_constant(madara::knowledge::KnowledgeRecord());
+    return;
+  }
+
+  ComponentNodes::iterator i = nodes_.begin();
+  (*i)->compile(program);
+
+  for (++i; i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    program.emit(Bytecode::MAXIMUM);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_BOTH_NODE_CPP */
@@ -57,6 +57,12 @@ public:
    * @param    visitor   visitor instance to use
    **/
   virtual void accept(Visitor& visitor) const;
+
+  /**
+   * Lowers the node into bytecode
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
 };
 }
 }
@@ -10,6 +10,7 @@
 #include "madara/expression/CompositeBinaryNode.h"
 #include "madara/expression/CompositeDivideNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/LeafNode.h"
 
 // Ctor
@@ -109,6 +110,13 @@ void madara::expression::CompositeDivideNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeDivideNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::DIVIDE);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _DIVIDE_NODE_CPP_ */
@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeEqualityNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -100,6 +101,13 @@ void madara::expression::CompositeEqualityNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeEqualityNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::EQUAL);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _EQUALITY_NODE_CPP_ */
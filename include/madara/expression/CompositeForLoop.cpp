@@ -49,6 +49,13 @@ madara::knowledge::KnowledgeRecord madara::expression::CompositeForLoop::prune(
   // under any situation
   can_change = true;
 
+  // the body must be pruned too, e.g., so that the function calls in it
+  // set up their arguments. The condition and postcondition are variable
+  // nodes that need no pruning.
+  bool child_can_change = false;
+  precondition_->prune(child_can_change);
+  body_->prune(child_can_change);
+
   madara::knowledge::KnowledgeRecord zero;
   return zero;
 }
@@ -92,6 +99,39 @@ void madara::expression::CompositeForLoop::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeForLoop::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&precondition_);
+  children.push_back(&condition_);
+  children.push_back(&postcondition_);
+  children.push_back(&body_);
+}
+
+madara::expression::ComponentNode*
+madara::expression::CompositeForLoop::get_precondition(void) const
+{
+  return precondition_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::CompositeForLoop::get_condition(void) const
+{
+  return condition_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::CompositeForLoop::get_postcondition(void) const
+{
+  return postcondition_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::CompositeForLoop::get_body(void) const
+{
+  return body_;
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _FOR_LOOP_CPP_ */
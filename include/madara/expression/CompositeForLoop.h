@@ -67,6 +67,24 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Returns the slots that hold the children of the node
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
+  /// Return the expression evaluated before the loop.
+  ComponentNode* get_precondition(void) const;
+
+  /// Return the expression that must be true to continue looping.
+  ComponentNode* get_condition(void) const;
+
+  /// Return the expression evaluated after each iteration.
+  ComponentNode* get_postcondition(void) const;
+
+  /// Return the body of the loop.
+  ComponentNode* get_body(void) const;
+
 private:
   // variables context
   // madara::knowledge::ThreadSafeContext & context_;
@@ -31,6 +31,56 @@
 
 #endif
 
+#ifdef _MADARA_JAVA_
+
+namespace
+{
+/**
+ * The java classes and methods used to call java functions, looked up
+ * once and held by global references so the IDs stay valid
+ **/
+struct JavaFunctionClasses
+{
+  JavaFunctionClasses(JNIEnv* env)
+  {
+    jclass found =
+        madara::utility::java::find_class(env, "ai/madara/knowledge/Variables");
+    variables = (jclass)env->NewGlobalRef(found);
+    env->DeleteWeakGlobalRef(found);
+
+    found = madara::utility::java::find_class(
+        env, "ai/madara/knowledge/KnowledgeList");
+    list = (jclass)env->NewGlobalRef(found);
+    env->DeleteWeakGlobalRef(found);
+
+    found = madara::utility::java::find_class(
+        env, "ai/madara/knowledge/KnowledgeRecord");
+    record = (jclass)env->NewGlobalRef(found);
+    env->DeleteWeakGlobalRef(found);
+
+    from_pointer = env->GetStaticMethodID(
+        variables, "fromPointer", "(J)Lai/madara/knowledge/Variables;");
+    list_constructor = env->GetMethodID(list, "<init>", "([J)V");
+    get_pointer = env->GetMethodID(record, "getCPtr", "()J");
+  }
+
+  jclass variables;
+  jclass list;
+  jclass record;
+  jmethodID from_pointer;
+  jmethodID list_constructor;
+  jmethodID get_pointer;
+};
+
+JavaFunctionClasses& java_function_classes(JNIEnv* env)
+{
+  static JavaFunctionClasses classes(env);
+  return classes;
+}
+}
+
+#endif
+
 // Ctor
 
 madara::expression::CompositeFunctionNode::CompositeFunctionNode(
@@ -39,7 +89,14 @@ madara::expression::CompositeFunctionNode::CompositeFunctionNode(
   : CompositeTernaryNode(context.get_logger(), nodes),
     name_(name),
     context_(context),
-    function_(context.retrieve_function(name))
+    function_(context.retrieve_function(name)),
+    args_in_use_(false),
+    variables_(&context)
+#ifdef _MADARA_JAVA_
+    ,
+    java_target_(0),
+    java_filter_(0)
+#endif
 {
 }
 
@@ -71,6 +128,8 @@ madara::expression::CompositeFunctionNode::prune(bool& can_change)
   if (nodes_.size() > 0)
     compiled_args_.resize(nodes_.size());
 
+  args_.resize(nodes_.size());
+
   for (ComponentNodes::size_type i = 0; i < nodes_.size(); ++i)
   {
     bool arg_can_change = false;
@@ -94,15 +153,50 @@ madara::expression::CompositeFunctionNode::prune(bool& can_change)
   return result;
 }
 
+namespace
+{
+/**
+ * Marks a node's reusable arguments as held for the length of a call
+ **/
+class ArgumentsHold
+{
+public:
+  ArgumentsHold(bool& in_use) : in_use_(in_use), held_(!in_use)
+  {
+    in_use_ = true;
+  }
+
+  ~ArgumentsHold()
+  {
+    if (held_)
+      in_use_ = false;
+  }
+
+  bool held(void) const
+  {
+    return held_;
+  }
+
+private:
+  bool& in_use_;
+  bool held_;
+};
+}
+
 /// Evaluates the node and its children. This does not prune any of
 /// the expression tree, and is much faster than the prune function
 madara::knowledge::KnowledgeRecord
 madara::expression::CompositeFunctionNode::evaluate(
     const madara::knowledge::KnowledgeUpdateSettings& settings)
 {
-  madara::knowledge::FunctionArguments args;
   madara::knowledge::KnowledgeRecord result;
 
+  // reuse the node's arguments, unless a call in progress holds them
+  ArgumentsHold hold(args_in_use_);
+  madara::knowledge::FunctionArguments reentrant_args;
+  madara::knowledge::FunctionArguments& args =
+      hold.held() ? args_ : reentrant_args;
+
   args.resize(nodes_.size());
 
   int j = 0;
@@ -110,87 +204,82 @@ madara::expression::CompositeFunctionNode::evaluate(
   for (ComponentNodes::iterator i = nodes_.begin(); i != nodes_.end(); ++i, ++j)
   {
     args[j] = (*i)->evaluate(settings);
-    *(compiled_args_[j]) = args[j];
-  }
 
-  madara::knowledge::Variables variables;
-  variables.context_ = &context_;
+    // native functions take their arguments directly, so .0, .1, etc.
+    // are only set for the other kinds
+    if (!function_->is_native())
+      *(compiled_args_[j]) = args[j];
+  }
 
   madara_logger_ptr_log(logger_, logger::LOG_DETAILED,
       "Function %s is being called with %d args.\n", this->name_.c_str(),
       args.size());
 
+  // if the user has defined a native function, call it with the arguments
+  if (function_->is_native())
+    result = function_->native->call(args.data(), args.size());
+
   // if the user has defined a named function, return that
-  if (function_->is_extern_named())
-    result = function_->extern_named(name_.c_str(), args, variables);
+  else if (function_->is_extern_named())
+    result = function_->extern_named(name_.c_str(), args, variables_);
 
   // if the user has defined an unnamed function, return that
   else if (function_->is_extern_unnamed())
-    result = function_->extern_unnamed(args, variables);
+    result = function_->extern_unnamed(args, variables_);
 
 #ifdef _MADARA_JAVA_
   else if (function_->is_java_callable())
   {
     madara::utility::java::Acquire_VM jvm;
     JNIEnv* env = jvm.env;
+    JavaFunctionClasses& classes = java_function_classes(env);
 
     /**
      * Create the variables java object
      **/
-
-    jclass jvarClass =
-        madara::utility::java::find_class(env, "ai/madara/knowledge/Variables");
-    jclass jlistClass = madara::utility::java::find_class(
-        env, "ai/madara/knowledge/KnowledgeList");
-
-    jmethodID fromPointerCall = env->GetStaticMethodID(
-        jvarClass, "fromPointer", "(J)Lai/madara/knowledge/Variables;");
     jobject jvariables = env->CallStaticObjectMethod(
-        jvarClass, fromPointerCall, (jlong)&variables);
+        classes.variables, classes.from_pointer, (jlong)&variables_);
 
     // prep to create the KnowledgeList
-    jmethodID listConstructor = env->GetMethodID(jlistClass, "<init>", "([J)V");
-
     jlongArray ret = env->NewLongArray((jsize)args.size());
-    jlong* tmp = new jlong[(jsize)args.size()];
+    java_args_.resize(args.size());
 
     for (unsigned int x = 0; x < args.size(); x++)
     {
-      tmp[x] = (jlong)args[x].clone();
+      java_args_[x] = (jlong)args[x].clone();
     }
 
-    env->SetLongArrayRegion(ret, 0, (jsize)args.size(), tmp);
-    delete[] tmp;
+    env->SetLongArrayRegion(ret, 0, (jsize)args.size(), java_args_.data());
 
     // create the KnowledgeList
-    jobject jlist = env->NewObject(jlistClass, listConstructor, ret);
+    jobject jlist = env->NewObject(classes.list, classes.list_constructor, ret);
 
-    // get the filter's class
-    jclass filterClass = env->GetObjectClass(function_->java_object);
+    // look up the filter method again only if the function was redefined
+    if (java_target_ != function_->java_object)
+    {
+      jclass filterClass = env->GetObjectClass(function_->java_object);
 
-    // get the filter method
-    jmethodID filterMethod = env->GetMethodID(filterClass, "filter",
-        "(Lai/madara/knowledge/KnowledgeList;"
-        "Lai/madara/knowledge/Variables;)Lai/madara/knowledge/"
-        "KnowledgeRecord;");
+      java_filter_ = env->GetMethodID(filterClass, "filter",
+          "(Lai/madara/knowledge/KnowledgeList;"
+          "Lai/madara/knowledge/Variables;)Lai/madara/knowledge/"
+          "KnowledgeRecord;");
+      java_target_ = function_->java_object;
+
+      jvm.env->DeleteLocalRef(filterClass);
+    }
 
     // call the filter and hold the result
     jobject jresult = env->CallObjectMethod(
-        function_->java_object, filterMethod, jlist, jvariables);
+        function_->java_object, java_filter_, jlist, jvariables);
 
-    jmethodID getPtrMethod =
-        env->GetMethodID(env->GetObjectClass(jresult), "getCPtr", "()J");
-    jlong cptr = env->CallLongMethod(jresult, getPtrMethod);
+    jlong cptr = env->CallLongMethod(jresult, classes.get_pointer);
 
     result.deep_copy(*(madara::knowledge::KnowledgeRecord*)cptr);
 
     jvm.env->DeleteLocalRef(jresult);
-    jvm.env->DeleteLocalRef(filterClass);
     jvm.env->DeleteLocalRef(jlist);
     jvm.env->DeleteLocalRef(ret);
     jvm.env->DeleteLocalRef(jvariables);
-    jvm.env->DeleteWeakGlobalRef(jlistClass);
-    jvm.env->DeleteWeakGlobalRef(jvarClass);
   }
 #endif
 
@@ -198,7 +287,7 @@ madara::expression::CompositeFunctionNode::evaluate(
   else if (function_->is_python_callable())
     return boost::python::call<madara::knowledge::KnowledgeRecord>(
         function_->python_function.ptr(), boost::ref(args),
-        boost::ref(variables));
+        boost::ref(variables_));
 #endif
 
   else if (function_->is_uninitialized())
@@ -9,6 +9,7 @@
 #include "madara/expression/CompositeTernaryNode.h"
 #include "madara/knowledge/Functions.h"
 #include "madara/knowledge/ThreadSafeContext.h"
+#include "madara/knowledge/Variables.h"
 
 namespace madara
 {
@@ -20,6 +21,10 @@ class Visitor;
 /**
  * @class CompositeFunctionNode
  * @brief A composite node that calls a function
+ *
+ *        The function is looked up once, when the node is built, and the
+ *        argument storage is reused between calls, so calling a C++
+ *        function does not allocate unless the call reenters the node.
  */
 class CompositeFunctionNode : public CompositeTernaryNode
 {
@@ -78,6 +83,26 @@ private:
 
   // pointers to .1, .2, .3, etc.
   std::vector<knowledge::KnowledgeRecord*> compiled_args_;
+
+  // arguments, reused between calls
+  knowledge::FunctionArguments args_;
+
+  // true while args_ is held by a call, so reentrant calls use their own
+  bool args_in_use_;
+
+  // variables facade passed to external functions
+  knowledge::Variables variables_;
+
+#ifdef _MADARA_JAVA_
+  // the java object whose filter method is cached
+  jobject java_target_;
+
+  // the filter method of java_target_
+  jmethodID java_filter_;
+
+  // buffer for the record pointers passed to java, reused between calls
+  std::vector<jlong> java_args_;
+#endif
 };
 }
 }
@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeGreaterThanEqualNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -104,6 +105,14 @@ void madara::expression::CompositeGreaterThanEqualNode::accept(
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeGreaterThanEqualNode::compile(
+    Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::GREATER_THAN_EQUAL);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_GREATER_THAN_EQUAL_NODE_CPP_ */
@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeGreaterThanNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -101,6 +102,13 @@ void madara::expression::CompositeGreaterThanNode::accept(
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeGreaterThanNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::GREATER_THAN);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_GREATER_THAN_NODE_CPP_ */
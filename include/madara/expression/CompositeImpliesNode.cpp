@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeImpliesNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -108,6 +109,16 @@ void madara::expression::CompositeImpliesNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeImpliesNode::compile(Bytecode& program)
+{
+  // the value of left is the result, and right is only evaluated if true
+  left_->compile(program);
+  size_t end = program.emit(Bytecode::JUMP_IF_FALSE_KEEP);
+  right_->compile(program);
+  program.emit(Bytecode::POP);
+  program.patch(end);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_IMPLIES_NODE_CPP */
@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeInequalityNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -101,6 +102,13 @@ void madara::expression::CompositeInequalityNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeInequalityNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::NOT_EQUAL);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _INEQUALITY_NODE_CPP_ */
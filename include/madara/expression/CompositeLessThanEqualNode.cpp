@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeLessThanEqualNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -103,6 +104,13 @@ void madara::expression::CompositeLessThanEqualNode::accept(
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeLessThanEqualNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::LESS_THAN_EQUAL);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_LESS_THAN_EQUAL_NODE_CPP_ */
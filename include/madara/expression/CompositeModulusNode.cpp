@@ -10,6 +10,7 @@
 #include "madara/expression/CompositeBinaryNode.h"
 #include "madara/expression/CompositeModulusNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/LeafNode.h"
 
 madara::expression::CompositeModulusNode::CompositeModulusNode(
@@ -113,6 +114,13 @@ void madara::expression::CompositeModulusNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeModulusNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::MODULUS);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _MODULUS_NODE_CPP_ */
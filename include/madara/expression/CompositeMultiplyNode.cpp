@@ -10,6 +10,7 @@
 #include "madara/expression/CompositeBinaryNode.h"
 #include "madara/expression/CompositeMultiplyNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/LeafNode.h"
 
 madara::expression::CompositeMultiplyNode::CompositeMultiplyNode(
@@ -102,6 +103,24 @@ void madara::expression::CompositeMultiplyNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeMultiplyNode::compile(Bytecode& program)
+{
+  if (nodes_.empty())
+  {
+    program.emit_constant(madara::knowledge::KnowledgeRecord());
+    return;
+  }
+
+  ComponentNodes::iterator i = nodes_.begin();
+  (*i)->compile(program);
+
+  for (++i; i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    program.emit(Bytecode::MULTIPLY);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _MULTIPLY_NODE_CPP_ */
@@ -9,6 +9,7 @@
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/CompositeUnaryNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeNegateNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -83,6 +84,12 @@ void madara::expression::CompositeNegateNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeNegateNode::compile(Bytecode& program)
+{
+  right_->compile(program);
+  program.emit(Bytecode::NEGATE);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _NEGATE_NODE_CPP_ */
@@ -9,6 +9,7 @@
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/CompositeUnaryNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeNotNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -79,6 +80,12 @@ void madara::expression::CompositeNotNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeNotNode::compile(Bytecode& program)
+{
+  right_->compile(program);
+  program.emit(Bytecode::NOT);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _NOT_NODE_CPP_ */
@@ -9,6 +9,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeOrNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -92,6 +93,27 @@ void madara::expression::CompositeOrNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeOrNode::compile(Bytecode& program)
+{
+  std::vector<size_t> jumps;
+
+  // jump to the true result on the first true operand
+  for (ComponentNodes::iterator i = nodes_.begin(); i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    jumps.push_back(program.emit(Bytecode::JUMP_IF_TRUE));
+  }
+
+  program.emit_constant(madara::knowledge::KnowledgeRecord());
+  size_t end = program.emit(Bytecode::JUMP);
+
+  for (size_t jump : jumps)
+    program.patch(jump);
+
+  program.emit_constant(madara::knowledge::KnowledgeRecord(1));
+  program.patch(end);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* COMPOSITE_OR_NODE_CPP */
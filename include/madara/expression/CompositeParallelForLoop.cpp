@@ -0,0 +1,457 @@
+/* -*- C++ -*- */
+#ifndef _PARALLEL_FOR_LOOP_CPP_
+#define _PARALLEL_FOR_LOOP_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <stdlib.h>
+
+#include "madara/expression/CompositeParallelForLoop.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * Threads that help evaluate parallel loops. The pool is created on first
+ * use and lives until the program exits. Loops use as many threads as
+ * there are cores, or MADARA_PARALLEL_THREADS if it is set.
+ **/
+class LoopPool
+{
+public:
+  /**
+   * Returns the pool shared by all parallel loops
+   **/
+  static LoopPool& instance(void)
+  {
+    static LoopPool pool;
+    return pool;
+  }
+
+  /**
+   * Returns the number of threads in the pool
+   **/
+  size_t size(void) const
+  {
+    return workers_.size();
+  }
+
+  /**
+   * Runs a task in the calling thread and in every pool thread, returning
+   * when all of them have finished. The task should claim pieces of work
+   * until none are left.
+   * @param  task   the task to run
+   * @return false if the pool is busy with another loop, e.g., when loops
+   *         are nested, in which case the task has not been run
+   **/
+  bool run(const std::function<void()>& task)
+  {
+    bool idle = false;
+
+    if (!busy_.compare_exchange_strong(idle, true))
+      return false;
+
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      task_ = &task;
+      running_ = workers_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    task();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    task_ = nullptr;
+    busy_ = false;
+
+    return true;
+  }
+
+private:
+  LoopPool(void)
+  {
+    unsigned int threads = std::thread::hardware_concurrency();
+    const char* setting = getenv("MADARA_PARALLEL_THREADS");
+
+    if (setting)
+      threads = (unsigned int)atoi(setting);
+
+    // the thread that runs a loop is one of the threads
+    for (unsigned int i = 1; i < threads; ++i)
+      workers_.emplace_back([this] { work(); });
+  }
+
+  ~LoopPool(void)
+  {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      terminated_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread& worker : workers_)
+      worker.join();
+  }
+
+  void work(void)
+  {
+    uint64_t generation = 0;
+
+    for (;;)
+    {
+      const std::function<void()>* task;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] {
+          return terminated_ || generation != generation_;
+        });
+
+        if (terminated_)
+          return;
+
+        generation = generation_;
+        task = task_;
+      }
+
+      (*task)();
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (--running_ == 0)
+        done_.notify_all();
+    }
+  }
+
+  /// true while a loop is using the pool
+  std::atomic<bool> busy_{false};
+
+  /// protects the fields below
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void()>* task_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t running_ = 0;
+  bool terminated_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+/// chunks per thread, so threads that finish early can take more
+const size_t CHUNKS_PER_THREAD = 4;
+}
+}
+}
+
+madara::expression::CompositeParallelForLoop::CompositeParallelForLoop(
+    ComponentNode* precondition, VariableNode* variable, ComponentNode* bound,
+    const knowledge::KnowledgeRecord& bound_value, bool inclusive,
+    ComponentNode* step, const knowledge::KnowledgeRecord& step_value,
+    ComponentNode* body, const std::string& body_logic,
+    knowledge::ThreadSafeContext& context)
+  : ComponentNode(context.get_logger()),
+    context_(context),
+    precondition_(precondition),
+    variable_(variable),
+    bound_(bound),
+    bound_value_(bound_value),
+    inclusive_(inclusive),
+    step_(step),
+    step_value_(step_value),
+    body_(body),
+    body_logic_(body_logic)
+{
+}
+
+madara::expression::CompositeParallelForLoop::~CompositeParallelForLoop(void)
+{
+  delete precondition_;
+  delete variable_;
+  delete bound_;
+  delete step_;
+  delete body_;
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::CompositeParallelForLoop::item(void) const
+{
+  return knowledge::KnowledgeRecord("parallel for (;;)");
+}
+
+void madara::expression::CompositeParallelForLoop::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&precondition_);
+  children.push_back(&bound_);
+  children.push_back(&step_);
+  children.push_back(&body_);
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::CompositeParallelForLoop::prune(bool& can_change)
+{
+  can_change = true;
+
+  // prune the children, as CompositeForLoop does
+  bool child_can_change = false;
+  precondition_->prune(child_can_change);
+  variable_->prune(child_can_change);
+  body_->prune(child_can_change);
+
+  if (bound_)
+    bound_->prune(child_can_change);
+  if (step_)
+    step_->prune(child_can_change);
+
+  return knowledge::KnowledgeRecord();
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::CompositeParallelForLoop::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  typedef knowledge::KnowledgeRecord::Integer Integer;
+
+  knowledge::KnowledgeRecord first = precondition_->evaluate(settings);
+  knowledge::KnowledgeRecord bound =
+      bound_ ? bound_->evaluate(settings) : bound_value_;
+  knowledge::KnowledgeRecord step =
+      step_ ? step_->evaluate(settings) : step_value_;
+
+  LoopPool& pool = LoopPool::instance();
+
+  if (pool.size() == 0 || !first.is_integer_type() ||
+      !bound.is_integer_type() || !step.is_integer_type() ||
+      step.to_integer() <= 0)
+  {
+    return knowledge::KnowledgeRecord(run_sequential(settings));
+  }
+
+  Integer start = first.to_integer();
+  Integer end = bound.to_integer() + (inclusive_ ? 1 : 0);
+  Integer increment = step.to_integer();
+  Integer iterations = start < end ? (end - start - 1) / increment + 1 : 0;
+
+  size_t chunks = std::min(
+      (size_t)iterations, (pool.size() + 1) * CHUNKS_PER_THREAD);
+
+  if (chunks < 2 || !prepare_lanes(chunks))
+  {
+    return knowledge::KnowledgeRecord(run_sequential(settings));
+  }
+
+  madara_logger_ptr_log(logger_, logger::LOG_MAJOR,
+      "CompositeParallelForLoop::evaluate: Running %d iterations in %d "
+      "chunks\n",
+      (int)iterations, (int)chunks);
+
+  // split the range into contiguous chunks
+  Integer parts = (Integer)chunks;
+  Integer offset = 0;
+  for (size_t i = 0; i < chunks; ++i)
+  {
+    Lane& lane = *lanes_[i];
+    lane.first = start + offset * increment;
+    lane.iterations = iterations / parts + ((Integer)i < iterations % parts);
+    lane.error = nullptr;
+    offset += lane.iterations;
+  }
+
+  // lanes only record the globals they change, which are marked in the
+  // context with the caller's settings when they are merged
+  knowledge::KnowledgeUpdateSettings lane_settings(settings);
+  lane_settings.treat_globals_as_locals = false;
+  lane_settings.treat_locals_as_globals = false;
+  lane_settings.track_local_changes = false;
+  lane_settings.stream_changes = false;
+  lane_settings.signal_changes = false;
+
+  std::atomic<size_t> next(0);
+  std::function<void()> task = [&] {
+    for (size_t i = next++; i < chunks; i = next++)
+    {
+      run_lane(*lanes_[i], increment, lane_settings);
+    }
+  };
+
+  // another loop holds the pool, so this thread runs all of the chunks
+  if (!pool.run(task))
+    task();
+
+  for (size_t i = 0; i < chunks; ++i)
+  {
+    if (lanes_[i]->error)
+      std::rethrow_exception(lanes_[i]->error);
+  }
+
+  for (size_t i = 0; i < chunks; ++i)
+  {
+    merge_lane(*lanes_[i], settings);
+  }
+
+  // leave the loop variable where a sequential loop would
+  variable_->set(start + iterations * increment, settings);
+
+  return knowledge::KnowledgeRecord(iterations);
+}
+
+madara::knowledge::KnowledgeRecord::Integer
+madara::expression::CompositeParallelForLoop::run_sequential(
+    const knowledge::KnowledgeUpdateSettings& settings)
+{
+  knowledge::KnowledgeRecord::Integer count = 0;
+
+  for (;;)
+  {
+    knowledge::KnowledgeRecord bound =
+        bound_ ? bound_->evaluate(settings) : bound_value_;
+    knowledge::KnowledgeRecord value = variable_->evaluate(settings);
+
+    if (!(inclusive_ ? value <= bound : value < bound))
+      break;
+
+    body_->evaluate(settings);
+
+    knowledge::KnowledgeRecord step =
+        step_ ? step_->evaluate(settings) : step_value_;
+    variable_->set(variable_->evaluate(settings) + step, settings);
+
+    ++count;
+  }
+
+  return count;
+}
+
+bool madara::expression::CompositeParallelForLoop::prepare_lanes(size_t count)
+{
+  while (lanes_.size() < count)
+  {
+    std::unique_ptr<Lane> lane(new Lane());
+
+    lane->context.attach_logger(*logger_);
+    lane->context.fallback_ = &context_;
+    lane->body = lane->context.compile(body_logic_);
+    lane->variable = lane->context.get_ref(variable_->key());
+
+    lanes_.push_back(std::move(lane));
+  }
+
+  // compiling a lane's body created entries for the functions it calls
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (auto& function : lanes_[i]->context.functions_)
+    {
+      knowledge::FunctionMap::const_iterator found =
+          context_.functions_.find(function.first);
+
+      if (found == context_.functions_.end())
+      {
+        function.second = knowledge::Function();
+      }
+      // KaRL functions are compiled against the context, not the lane
+      else if (found->second.is_karl_expression() ||
+#ifdef _MADARA_JAVA_
+               found->second.is_java_callable() ||
+#endif
+#ifdef _MADARA_PYTHON_CALLBACKS_
+               found->second.is_python_callable() ||
+#endif
+               found->second.is_record_filter())
+      {
+        madara_logger_ptr_log(logger_, logger::LOG_MAJOR,
+            "CompositeParallelForLoop::prepare_lanes: %s cannot be called "
+            "in parallel. Running the loop sequentially.\n",
+            function.first.c_str());
+
+        return false;
+      }
+      else
+      {
+        function.second = found->second;
+      }
+    }
+  }
+
+  return true;
+}
+
+void madara::expression::CompositeParallelForLoop::run_lane(Lane& lane,
+    knowledge::KnowledgeRecord::Integer step,
+    const knowledge::KnowledgeUpdateSettings& settings)
+{
+  knowledge::ThreadSafeContext& context = lane.context;
+
+  try
+  {
+    // the context does not change until every lane is done, so lanes can
+    // read it without locking
+    for (auto& entry : context.map_)
+    {
+      const knowledge::KnowledgeMap::value_type* found =
+          context_.find_unsafe(entry.first);
+
+      if (found)
+        entry.second = found->second;
+      else
+        entry.second = knowledge::KnowledgeRecord();
+    }
+
+    context.changed_map_.clear();
+    context.local_changed_map_.clear();
+
+    knowledge::KnowledgeRecord::Integer value = lane.first;
+    ComponentNode* body = lane.body.get_root();
+
+    for (knowledge::KnowledgeRecord::Integer i = 0; i < lane.iterations;
+         ++i, value += step)
+    {
+      lane.variable.get_record_unsafe()->set_value(value);
+      body->evaluate(settings);
+    }
+  }
+  catch (...)
+  {
+    lane.error = std::current_exception();
+  }
+}
+
+void madara::expression::CompositeParallelForLoop::merge_lane(
+    Lane& lane, const knowledge::KnowledgeUpdateSettings& settings)
+{
+  for (const auto& changed : lane.context.changed_map_)
+  {
+    const knowledge::KnowledgeRecord& value =
+        *changed.second.get_record_unsafe();
+    knowledge::VariableReference variable(
+        context_.emplace_unsafe(changed.first));
+    knowledge::KnowledgeRecord* record = variable.get_record_unsafe();
+
+    // the same checks as VariableNode::set
+    if (settings.always_overwrite || record->write_quality >= record->quality)
+    {
+      if (record->write_quality != record->quality)
+        record->quality = record->write_quality;
+
+      record->set_value(value);
+
+      context_.mark_and_signal(variable, settings);
+    }
+  }
+
+  lane.context.changed_map_.clear();
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _PARALLEL_FOR_LOOP_CPP_ */
@@ -0,0 +1,190 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_COMPOSITE_PARALLEL_FOR_LOOP_H_
+#define _MADARA_COMPOSITE_PARALLEL_FOR_LOOP_H_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "madara/expression/ComponentNode.h"
+#include "madara/expression/VariableNode.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+
+namespace madara
+{
+namespace expression
+{
+/**
+ * @class CompositeParallelForLoop
+ * @brief A for loop whose iterations are split across a thread pool,
+ *        e.g., .i[0->n).parallel (agent{.i}.score = agent{.i}.x * 2).
+ *
+ *        The index range is computed once. Each contiguous chunk of it runs
+ *        in a private copy of the context that reads variables from the
+ *        original as needed. Afterwards, the globals each chunk changed are
+ *        written to the original context in chunk order, so the last
+ *        iteration to change a global wins, as it would sequentially.
+ *        Changes to locals (variables that start with '.') stay private.
+ *
+ *        Loops without an increasing integer range, or that call
+ *        functions defined in KaRL, run sequentially. Loops use as many
+ *        threads as there are cores, or the MADARA_PARALLEL_THREADS
+ *        environment variable if it is set.
+ */
+class CompositeParallelForLoop : public ComponentNode
+{
+public:
+  /**
+   * Constructor
+   * @param   precondition  sets the loop variable to its first value
+   * @param   variable      the loop variable
+   * @param   bound         the loop bound, or null to use bound_value
+   * @param   bound_value   the loop bound if bound is null
+   * @param   inclusive     true if the loop includes the bound
+   * @param   step          the loop increment, or null to use step_value
+   * @param   step_value    the loop increment if step is null
+   * @param   body          the loop body
+   * @param   body_logic    the KaRL logic of the body
+   * @param   context       context for variable lookups
+   **/
+  CompositeParallelForLoop(ComponentNode* precondition, VariableNode* variable,
+      ComponentNode* bound, const knowledge::KnowledgeRecord& bound_value,
+      bool inclusive, ComponentNode* step,
+      const knowledge::KnowledgeRecord& step_value, ComponentNode* body,
+      const std::string& body_logic, knowledge::ThreadSafeContext& context);
+
+  /**
+   * Destructor
+   **/
+  virtual ~CompositeParallelForLoop(void);
+
+  /**
+   * Returns the printable character of the node
+   * @return    value of the node
+   **/
+  virtual madara::knowledge::KnowledgeRecord item(void) const;
+
+  /**
+   * Prunes the expression tree of unnecessary nodes.
+   * @param     can_change   set to true, since the body changes variables
+   * @return    zero
+   **/
+  virtual madara::knowledge::KnowledgeRecord prune(bool& can_change);
+
+  /**
+   * Evaluates the loop
+   * @param     settings     settings for evaluating the node
+   * @return    the number of times the body was evaluated
+   **/
+  virtual madara::knowledge::KnowledgeRecord evaluate(
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Returns the slots that hold the children of the node. Lanes evaluate
+   * their own copies of the body, which are not included.
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
+private:
+  /**
+   * A private copy of the context that evaluates one chunk of the loop
+   **/
+  struct Lane
+  {
+    /// the private context, which reads missing variables from the loop's
+    knowledge::ThreadSafeContext context;
+
+    /// the body, compiled against the private context
+    knowledge::CompiledExpression body;
+
+    /// the loop variable in the private context
+    knowledge::VariableReference variable;
+
+    /// the first value of the loop variable in this chunk
+    knowledge::KnowledgeRecord::Integer first = 0;
+
+    /// the number of iterations in this chunk
+    knowledge::KnowledgeRecord::Integer iterations = 0;
+
+    /// an exception thrown by the body, if any
+    std::exception_ptr error;
+  };
+
+  /**
+   * Evaluates the loop in the calling thread
+   * @param     settings     settings for evaluating the node
+   * @return    the number of times the body was evaluated
+   **/
+  knowledge::KnowledgeRecord::Integer run_sequential(
+      const knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Creates lanes until there are at least count of them and readies
+   * them for evaluation
+   * @param     count        the number of lanes needed
+   * @return    false if the body cannot be evaluated in a lane
+   **/
+  bool prepare_lanes(size_t count);
+
+  /**
+   * Refreshes a lane's copies of variables from the context and evaluates
+   * its chunk. Called from pool threads.
+   * @param     lane         the lane to evaluate
+   * @param     step         the loop increment
+   * @param     settings     settings for evaluating the body
+   **/
+  void run_lane(Lane& lane, knowledge::KnowledgeRecord::Integer step,
+      const knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Writes the globals a lane changed into the context
+   * @param     lane         the lane to merge
+   * @param     settings     settings for marking the changes
+   **/
+  void merge_lane(
+      Lane& lane, const knowledge::KnowledgeUpdateSettings& settings);
+
+  /// the context of the loop
+  knowledge::ThreadSafeContext& context_;
+
+  /// sets the loop variable to its first value
+  ComponentNode* precondition_;
+
+  /// the loop variable
+  VariableNode* variable_;
+
+  /// the loop bound, if not a constant
+  ComponentNode* bound_;
+
+  /// the loop bound, if a constant
+  knowledge::KnowledgeRecord bound_value_;
+
+  /// true if the loop includes the bound
+  bool inclusive_;
+
+  /// the loop increment, if not a constant
+  ComponentNode* step_;
+
+  /// the loop increment, if a constant
+  knowledge::KnowledgeRecord step_value_;
+
+  /// the loop body, for sequential evaluation
+  ComponentNode* body_;
+
+  /// the logic of the body, compiled again for each lane
+  std::string body_logic_;
+
+  /// private contexts, reused across evaluations
+  std::vector<std::unique_ptr<Lane>> lanes_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_COMPOSITE_PARALLEL_FOR_LOOP_H_ */
@@ -9,6 +9,7 @@
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/CompositeUnaryNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositePredecrementNode.h"
 #include "madara/expression/LeafNode.h"
 #include "madara/expression/VariableNode.h"
@@ -105,6 +106,20 @@ void madara::expression::CompositePredecrementNode::accept(
   visitor.visit(*this);
 }
 
+void madara::expression::CompositePredecrementNode::compile(Bytecode& program)
+{
+  if (var_)
+    program.emit_variable(Bytecode::DECREMENT_VARIABLE, var_);
+  else
+    program.emit_node(this);
+}
+
+madara::expression::VariableNode*
+madara::expression::CompositePredecrementNode::get_variable(void) const
+{
+  return var_;
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_PREDECREMENT_NODE_CPP_ */
@@ -64,6 +64,18 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Lowers the node into bytecode
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
+  /**
+   * Returns the variable the node changes
+   * @return    the variable, or 0 if it is not a simple variable
+   **/
+  VariableNode* get_variable(void) const;
+
 private:
   /// variable holder
   VariableNode* var_;
@@ -10,6 +10,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeReturnRightNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -83,6 +84,24 @@ void madara::expression::CompositeReturnRightNode::accept(
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeReturnRightNode::compile(Bytecode& program)
+{
+  if (nodes_.empty())
+  {
+    program.emit_constant(madara::knowledge::KnowledgeRecord());
+    return;
+  }
+
+  // only the value of the last expression is kept
+  for (ComponentNodes::iterator i = nodes_.begin(); i != nodes_.end(); ++i)
+  {
+    if (i != nodes_.begin())
+      program.emit(Bytecode::POP);
+
+    (*i)->compile(program);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_RETURN_RIGHT_NODE_CPP_ */
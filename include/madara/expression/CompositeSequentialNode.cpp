@@ -10,6 +10,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeSequentialNode.h"
 #include "madara/expression/LeafNode.h"
 
@@ -81,6 +82,24 @@ void madara::expression::CompositeSequentialNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeSequentialNode::compile(Bytecode& program)
+{
+  if (nodes_.empty())
+  {
+    program.emit_constant(madara::knowledge::KnowledgeRecord());
+    return;
+  }
+
+  ComponentNodes::iterator i = nodes_.begin();
+  (*i)->compile(program);
+
+  for (++i; i != nodes_.end(); ++i)
+  {
+    (*i)->compile(program);
+    program.emit(Bytecode::MINIMUM);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_SEQUENTIAL_NODE_CPP */
@@ -6,6 +6,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/CompositeBinaryNode.h"
 #include "madara/expression/CompositeSubtractNode.h"
 #include "madara/expression/LeafNode.h"
@@ -108,6 +109,13 @@ void madara::expression::CompositeSubtractNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::CompositeSubtractNode::compile(Bytecode& program)
+{
+  left_->compile(program);
+  right_->compile(program);
+  program.emit(Bytecode::SUBTRACT);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _SUBTRACT_NODE_CPP_ */
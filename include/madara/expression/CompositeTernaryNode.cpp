@@ -42,6 +42,21 @@ void madara::expression::CompositeTernaryNode::accept(
   (void)visitor;
 }
 
+const madara::expression::ComponentNodes&
+madara::expression::CompositeTernaryNode::nodes(void) const
+{
+  return nodes_;
+}
+
+void madara::expression::CompositeTernaryNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  for (ComponentNode*& node : nodes_)
+  {
+    children.push_back(&node);
+  }
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _TERNARY_NODE_CPP_ */
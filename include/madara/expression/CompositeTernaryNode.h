@@ -70,6 +70,18 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Returns the contained expressions
+   * @return    the expressions, in order
+   **/
+  const ComponentNodes& nodes(void) const;
+
+  /**
+   * Returns the slots that hold the children of the node
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
 protected:
   ComponentNodes nodes_;
 };
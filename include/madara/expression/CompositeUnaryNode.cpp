@@ -25,6 +25,13 @@ madara::expression::CompositeUnaryNode::right(void) const
   return right_;
 }
 
+// Return the right child slot
+void madara::expression::CompositeUnaryNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&right_);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _COMPOSITE_NODE_CPP_ */
@@ -37,6 +37,12 @@ public:
    **/
   virtual ComponentNode* right(void) const;
 
+  /**
+   * Returns the slots that hold the children of the node
+   * @param     children     the list to append the slots to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
 protected:
   /// Right expression
   ComponentNode* right_;
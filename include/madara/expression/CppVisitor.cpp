@@ -0,0 +1,861 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_CPP_VISITOR_CPP_
+#define _MADARA_CPP_VISITOR_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <iomanip>
+#include <limits>
+#include <math.h>
+
+#include "madara/expression/CppVisitor.h"
+#include "madara/expression/ComponentNode.h"
+#include "madara/expression/CompositeAddNode.h"
+#include "madara/expression/CompositeAndNode.h"
+#include "madara/expression/CompositeAssignmentNode.h"
+#include "madara/expression/CompositeBothNode.h"
+#include "madara/expression/CompositeDivideNode.h"
+#include "madara/expression/CompositeEqualityNode.h"
+#include "madara/expression/CompositeGreaterThanEqualNode.h"
+#include "madara/expression/CompositeGreaterThanNode.h"
+#include "madara/expression/CompositeImpliesNode.h"
+#include "madara/expression/CompositeInequalityNode.h"
+#include "madara/expression/CompositeLessThanEqualNode.h"
+#include "madara/expression/CompositeLessThanNode.h"
+#include "madara/expression/CompositeModulusNode.h"
+#include "madara/expression/CompositeMultiplyNode.h"
+#include "madara/expression/CompositeNegateNode.h"
+#include "madara/expression/CompositeNotNode.h"
+#include "madara/expression/CompositeOrNode.h"
+#include "madara/expression/CompositePredecrementNode.h"
+#include "madara/expression/CompositePreincrementNode.h"
+#include "madara/expression/CompositeReturnRightNode.h"
+#include "madara/expression/CompositeSequentialNode.h"
+#include "madara/expression/CompositeSubtractNode.h"
+#include "madara/expression/LeafNode.h"
+#include "madara/expression/VariableNode.h"
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * Quotes a string as a C++ string literal
+ **/
+std::string quote(const std::string& value)
+{
+  std::stringstream buffer;
+  buffer << '"';
+
+  for (unsigned char c : value)
+  {
+    if (c == '"' || c == '\\')
+      buffer << '\\' << c;
+    else if (c == '\n')
+      buffer << "\\n";
+    else if (c == '\t')
+      buffer << "\\t";
+    else if (c < 32 || c > 126)
+    {
+      // octal escapes are never continued by the characters after them
+      buffer << '\\' << std::oct << std::setw(3) << std::setfill('0')
+             << (int)c << std::dec;
+    }
+    else
+      buffer << c;
+  }
+
+  buffer << '"';
+  return buffer.str();
+}
+}
+}
+}
+
+madara::expression::CppVisitor::CppVisitor() : indent_(4), temps_(0) {}
+
+madara::expression::CppVisitor::~CppVisitor(void) {}
+
+bool madara::expression::CppVisitor::generate(const ComponentNode* root)
+{
+  body_.str("");
+  indent_ = 4;
+  temps_ = 0;
+  constants_.clear();
+  variables_.clear();
+  unsupported_.clear();
+
+  std::string result = root ? emit(root) : temp("KnowledgeRecord(0)");
+  line("return " + result + ";");
+
+  return unsupported_.empty();
+}
+
+std::string madara::expression::CppVisitor::source(
+    const std::string& logic) const
+{
+  std::stringstream buffer;
+
+  buffer << "// Generated by karlc from the following KaRL logic:\n//\n";
+
+  std::stringstream lines(logic);
+  for (std::string current; std::getline(lines, current);)
+  {
+    buffer << "//   " << current << "\n";
+  }
+
+  buffer << "\n#include \"madara/knowledge/CompiledLogic.h\"\n\n";
+  buffer << "namespace\n{\n";
+  buffer << "typedef madara::knowledge::KnowledgeRecord KnowledgeRecord;\n";
+  buffer << "typedef madara::knowledge::KnowledgeUpdateSettings "
+            "KnowledgeUpdateSettings;\n";
+  buffer << "typedef madara::knowledge::VariableReference "
+            "VariableReference;\n\n";
+
+  buffer << "class GeneratedLogic : public "
+            "madara::knowledge::CompiledLogic\n{\npublic:\n";
+  buffer << "  GeneratedLogic(madara::knowledge::ThreadSafeContext& context)\n";
+  buffer << "    : CompiledLogic(context)\n  {\n";
+
+  for (size_t i = 0; i < constants_.size(); ++i)
+  {
+    buffer << "    c" << i << "_ = " << constants_[i] << ";\n";
+  }
+
+  for (auto& variable : variables_)
+  {
+    buffer << "    v" << variable.second << "_ = get_ref("
+           << quote(variable.first) << ");\n";
+  }
+
+  buffer << "  }\n\n";
+  buffer << "  const char* logic(void) const override\n  {\n";
+  buffer << "    return " << quote(logic) << ";\n  }\n\n";
+  buffer << "  KnowledgeRecord evaluate(\n";
+  buffer << "      const KnowledgeUpdateSettings& settings) override\n  {\n";
+  buffer << body_.str();
+  buffer << "  }\n\nprivate:\n";
+
+  for (size_t i = 0; i < constants_.size(); ++i)
+  {
+    buffer << "  KnowledgeRecord c" << i << "_;\n";
+  }
+
+  for (size_t i = 0; i < variables_.size(); ++i)
+  {
+    buffer << "  VariableReference v" << i << "_;\n";
+  }
+
+  buffer << "};\n}\n\n";
+  buffer << "MADARA_COMPILED_LOGIC_EXPORT madara::knowledge::CompiledLogic*\n";
+  buffer << "madara_create_compiled_logic("
+            "madara::knowledge::ThreadSafeContext& context)\n{\n";
+  buffer << "  return new GeneratedLogic(context);\n}\n";
+
+  return buffer.str();
+}
+
+const std::vector<std::string>& madara::expression::CppVisitor::unsupported(
+    void) const
+{
+  return unsupported_;
+}
+
+std::string madara::expression::CppVisitor::emit(const ComponentNode* node)
+{
+  result_.clear();
+  node->accept(*this);
+
+  // nodes without a visit of their own do not set a result
+  if (result_.empty())
+  {
+    reject("ComponentNode");
+  }
+
+  return result_;
+}
+
+void madara::expression::CppVisitor::line(const std::string& code)
+{
+  body_ << std::string(indent_, ' ') << code << "\n";
+}
+
+std::string madara::expression::CppVisitor::temp(const std::string& init)
+{
+  std::string name = "t" + std::to_string(temps_++);
+
+  if (init.empty())
+    line("KnowledgeRecord " + name + ";");
+  else
+    line("KnowledgeRecord " + name + "(" + init + ");");
+
+  return name;
+}
+
+std::string madara::expression::CppVisitor::constant(
+    const knowledge::KnowledgeRecord& value)
+{
+  typedef knowledge::KnowledgeRecord::Integer Integer;
+  std::stringstream init;
+
+  if (value.type() == knowledge::KnowledgeRecord::INTEGER)
+  {
+    Integer integer = value.to_integer();
+
+    // the most negative integer cannot be written as a literal
+    if (integer == std::numeric_limits<Integer>::min())
+      init << "KnowledgeRecord(KnowledgeRecord::Integer(" << integer + 1
+           << "LL - 1))";
+    else
+      init << "KnowledgeRecord(KnowledgeRecord::Integer(" << integer << "LL))";
+  }
+  else if (value.type() == knowledge::KnowledgeRecord::DOUBLE &&
+           isfinite(value.to_double()))
+  {
+    std::stringstream literal;
+    literal << std::setprecision(17) << value.to_double();
+
+    // keep the literal a double, e.g., 1.0 instead of 1
+    std::string text = literal.str();
+    if (text.find_first_of(".e") == std::string::npos)
+      text += ".0";
+
+    init << "KnowledgeRecord(" << text << ")";
+  }
+  else if (value.type() == knowledge::KnowledgeRecord::STRING)
+  {
+    init << "KnowledgeRecord(std::string(" << quote(value.to_string())
+         << "))";
+  }
+  else if (!value.exists())
+  {
+    init << "KnowledgeRecord()";
+  }
+  else
+  {
+    return "";
+  }
+
+  constants_.push_back(init.str());
+  return "c" + std::to_string(constants_.size() - 1) + "_";
+}
+
+std::string madara::expression::CppVisitor::variable(const std::string& key)
+{
+  if (key.find('{') != std::string::npos)
+    return "";
+
+  auto found = variables_.emplace(key, variables_.size()).first;
+  return "v" + std::to_string(found->second) + "_";
+}
+
+void madara::expression::CppVisitor::reject(const std::string& type)
+{
+  unsupported_.push_back(type);
+  result_ = temp();
+}
+
+void madara::expression::CppVisitor::visit(const LeafNode& node)
+{
+  std::string value = constant(node.item());
+
+  if (value.empty())
+    reject("LeafNode");
+  else
+    result_ = value;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeConstArray&)
+{
+  reject("CompositeConstArray");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeArrayReference&)
+{
+  reject("CompositeArrayReference");
+}
+
+void madara::expression::CppVisitor::visit(const VariableNode& node)
+{
+  std::string target = variable(node.key());
+
+  // values are copied when read, as the tree does
+  if (target.empty())
+    reject("VariableNode");
+  else
+    result_ = temp("get(" + target + ")");
+}
+
+void madara::expression::CppVisitor::visit(const VariableDecrementNode&)
+{
+  reject("VariableDecrementNode");
+}
+
+void madara::expression::CppVisitor::visit(const VariableDivideNode&)
+{
+  reject("VariableDivideNode");
+}
+
+void madara::expression::CppVisitor::visit(const VariableIncrementNode&)
+{
+  reject("VariableIncrementNode");
+}
+
+void madara::expression::CppVisitor::visit(const VariableMultiplyNode&)
+{
+  reject("VariableMultiplyNode");
+}
+
+void madara::expression::CppVisitor::visit(const VariableCompareNode&)
+{
+  reject("VariableCompareNode");
+}
+
+void madara::expression::CppVisitor::visit(const ListNode&)
+{
+  reject("ListNode");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeNegateNode& node)
+{
+  result_ = temp("-" + emit(node.right()));
+}
+
+void madara::expression::CppVisitor::visit(const CompositePostdecrementNode&)
+{
+  reject("CompositePostdecrementNode");
+}
+
+void madara::expression::CppVisitor::visit(const CompositePostincrementNode&)
+{
+  reject("CompositePostincrementNode");
+}
+
+void madara::expression::CppVisitor::visit(
+    const CompositePredecrementNode& node)
+{
+  std::string target;
+
+  if (node.get_variable())
+    target = variable(node.get_variable()->key());
+
+  if (target.empty())
+  {
+    reject("CompositePredecrementNode");
+    return;
+  }
+
+  result_ = temp("dec(" + target + ", settings)");
+}
+
+void madara::expression::CppVisitor::visit(
+    const CompositePreincrementNode& node)
+{
+  std::string target;
+
+  if (node.get_variable())
+    target = variable(node.get_variable()->key());
+
+  if (target.empty())
+  {
+    reject("CompositePreincrementNode");
+    return;
+  }
+
+  result_ = temp("inc(" + target + ", settings)");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeSquareRootNode&)
+{
+  reject("CompositeSquareRootNode");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeNotNode& node)
+{
+  result_ = temp("KnowledgeRecord(!" + emit(node.right()) + ")");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeAddNode& node)
+{
+  const ComponentNodes& nodes = node.nodes();
+
+  if (nodes.empty())
+  {
+    result_ = temp();
+    return;
+  }
+
+  std::string result = temp(emit(nodes.front()));
+
+  for (auto i = nodes.begin() + 1; i != nodes.end(); ++i)
+  {
+    std::string value = emit(*i);
+    line(result + " += " + value + ";");
+  }
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeAssignmentNode& node)
+{
+  std::string target;
+
+  if (node.get_variable())
+    target = variable(node.get_variable()->key());
+
+  if (target.empty())
+  {
+    reject("CompositeAssignmentNode");
+    return;
+  }
+
+  std::string value = emit(node.right());
+  line("set(" + target + ", " + value + ", settings);");
+
+  result_ = value;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeAndNode& node)
+{
+  // break out of the block at the first false operand
+  std::string result = temp("KnowledgeRecord(1)");
+
+  line("do");
+  line("{");
+  indent_ += 2;
+
+  for (const ComponentNode* child : node.nodes())
+  {
+    line("if (" + emit(child) + ".is_false())");
+    line("{");
+    line("  " + result + " = KnowledgeRecord(0);");
+    line("  break;");
+    line("}");
+  }
+
+  indent_ -= 2;
+  line("} while (false);");
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeOrNode& node)
+{
+  // break out of the block at the first true operand
+  std::string result = temp("");
+
+  line("do");
+  line("{");
+  indent_ += 2;
+
+  for (const ComponentNode* child : node.nodes())
+  {
+    line("if (" + emit(child) + ".is_true())");
+    line("{");
+    line("  " + result + " = KnowledgeRecord(1);");
+    line("  break;");
+    line("}");
+  }
+
+  indent_ -= 2;
+  line("} while (false);");
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeEqualityNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " == " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeInequalityNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " != " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(
+    const CompositeGreaterThanEqualNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " >= " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeGreaterThanNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " > " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(
+    const CompositeLessThanEqualNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " <= " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeLessThanNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp("KnowledgeRecord(" + left + " < " + right + ")");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeSubtractNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp(left + " - " + right);
+}
+
+void madara::expression::CppVisitor::visit(const CompositeDivideNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp(left + " / " + right);
+}
+
+void madara::expression::CppVisitor::visit(const CompositeMultiplyNode& node)
+{
+  const ComponentNodes& nodes = node.nodes();
+
+  if (nodes.empty())
+  {
+    result_ = temp();
+    return;
+  }
+
+  std::string result = temp(emit(nodes.front()));
+
+  for (auto i = nodes.begin() + 1; i != nodes.end(); ++i)
+  {
+    std::string value = emit(*i);
+    line(result + " *= " + value + ";");
+  }
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeModulusNode& node)
+{
+  std::string left = emit(node.left());
+  std::string right = emit(node.right());
+  result_ = temp(left + " % " + right);
+}
+
+void madara::expression::CppVisitor::visit(const CompositeBothNode& node)
+{
+  const ComponentNodes& nodes = node.nodes();
+
+  if (nodes.empty())
+  {
+    result_ = temp();
+    return;
+  }
+
+  std::string result = temp(emit(nodes.front()));
+
+  for (auto i = nodes.begin() + 1; i != nodes.end(); ++i)
+  {
+    std::string value = emit(*i);
+    line("if (" + value + " > " + result + ")");
+    line("  " + result + " = " + value + ";");
+  }
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeReturnRightNode& node)
+{
+  result_ = "";
+
+  // only the value of the last expression is kept
+  for (const ComponentNode* child : node.nodes())
+    result_ = emit(child);
+
+  if (result_.empty())
+    result_ = temp();
+}
+
+void madara::expression::CppVisitor::visit(const CompositeSequentialNode& node)
+{
+  const ComponentNodes& nodes = node.nodes();
+
+  if (nodes.empty())
+  {
+    result_ = temp();
+    return;
+  }
+
+  std::string result = temp(emit(nodes.front()));
+
+  for (auto i = nodes.begin() + 1; i != nodes.end(); ++i)
+  {
+    std::string value = emit(*i);
+    line("if (" + value + " < " + result + ")");
+    line("  " + result + " = " + value + ";");
+  }
+
+  result_ = result;
+}
+
+void madara::expression::CppVisitor::visit(const CompositeFunctionNode&)
+{
+  reject("CompositeFunctionNode");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeForLoop&)
+{
+  reject("CompositeForLoop");
+}
+
+void madara::expression::CppVisitor::visit(const CompositeImpliesNode& node)
+{
+  // the value of left is the result, and right is only evaluated if true
+  std::string left = emit(node.left());
+
+  line("if (" + left + ".is_true())");
+  line("{");
+  indent_ += 2;
+  emit(node.right());
+  indent_ -= 2;
+  line("}");
+
+  result_ = left;
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallClearVariable&)
+{
+  reject("SystemCallClearVariable");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallCos&)
+{
+  reject("SystemCallCos");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallDeleteVariable&)
+{
+  reject("SystemCallDeleteVariable");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallEval&)
+{
+  reject("SystemCallEval");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallExpandEnv&)
+{
+  reject("SystemCallExpandEnv");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallExpandStatement&)
+{
+  reject("SystemCallExpandStatement");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallFragment&)
+{
+  reject("SystemCallFragment");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallGeneric&)
+{
+  reject("SystemCallGeneric");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallGetClock&)
+{
+  reject("SystemCallGetClock");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallGetTime&)
+{
+  reject("SystemCallGetTime");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallGetTimeSeconds&)
+{
+  reject("SystemCallGetTimeSeconds");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallIsinf&)
+{
+  reject("SystemCallIsinf");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallLogLevel&)
+{
+  reject("SystemCallLogLevel");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallPow&)
+{
+  reject("SystemCallPow");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallPrint&)
+{
+  reject("SystemCallPrint");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallPrintSystemCalls&)
+{
+  reject("SystemCallPrintSystemCalls");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallRandDouble&)
+{
+  reject("SystemCallRandDouble");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallRandInt&)
+{
+  reject("SystemCallRandInt");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallReadFile&)
+{
+  reject("SystemCallReadFile");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSetClock&)
+{
+  reject("SystemCallSetClock");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSin&)
+{
+  reject("SystemCallSin");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSize&)
+{
+  reject("SystemCallSize");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSleep&)
+{
+  reject("SystemCallSleep");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSqrt&)
+{
+  reject("SystemCallSqrt");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallTan&)
+{
+  reject("SystemCallTan");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToBuffer&)
+{
+  reject("SystemCallToBuffer");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToDouble&)
+{
+  reject("SystemCallToDouble");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToDoubles&)
+{
+  reject("SystemCallToDoubles");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToHostDirs&)
+{
+  reject("SystemCallToHostDirs");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToInteger&)
+{
+  reject("SystemCallToInteger");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToIntegers&)
+{
+  reject("SystemCallToIntegers");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallToString&)
+{
+  reject("SystemCallToString");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallType&)
+{
+  reject("SystemCallType");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVadd&)
+{
+  reject("SystemCallVadd");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVclamp&)
+{
+  reject("SystemCallVclamp");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVdot&)
+{
+  reject("SystemCallVdot");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVmax&)
+{
+  reject("SystemCallVmax");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVmin&)
+{
+  reject("SystemCallVmin");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVmul&)
+{
+  reject("SystemCallVmul");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVscale&)
+{
+  reject("SystemCallVscale");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallVsum&)
+{
+  reject("SystemCallVsum");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallWriteFile&)
+{
+  reject("SystemCallWriteFile");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSetFixed&)
+{
+  reject("SystemCallSetFixed");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSetPrecision&)
+{
+  reject("SystemCallSetPrecision");
+}
+
+void madara::expression::CppVisitor::visit(const SystemCallSetScientific&)
+{
+  reject("SystemCallSetScientific");
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_CPP_VISITOR_CPP_
@@ -0,0 +1,388 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_CPP_VISITOR_H_
+#define _MADARA_CPP_VISITOR_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file CppVisitor.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the CppVisitor class, which generates C++ from a
+ * pruned expression tree for karlc
+ **/
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "madara/expression/Visitor.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/MadaraExport.h"
+
+namespace madara
+{
+namespace expression
+{
+class ComponentNode;
+
+/**
+ * @class CppVisitor
+ * @brief Generates a C++ source file from a pruned expression tree. The
+ *        source defines a knowledge::CompiledLogic whose evaluate has the
+ *        same effect as evaluating the tree, reading and writing
+ *        variables through references resolved when it is created. It
+ *        is built into a shared library and loaded with
+ *        KnowledgeBase::load_compiled_logic.
+ *
+ *        Only the arithmetic, comparison, logical, sequence and
+ *        assignment operators over constants and variables without key
+ *        expansion are supported. Other nodes, e.g., function calls,
+ *        system calls, arrays and for loops, are listed by unsupported.
+ */
+class MADARA_EXPORT CppVisitor : public Visitor
+{
+public:
+  /**
+   * Constructor
+   **/
+  CppVisitor();
+
+  /**
+   * Generates code for a tree, replacing any code generated before
+   * @param  root      the root of a pruned tree
+   * @return true if every node in the tree is supported
+   **/
+  bool generate(const ComponentNode* root);
+
+  /**
+   * Returns the source file for the generated code
+   * @param  logic     the KaRL logic the tree was compiled from
+   * @return the C++ source
+   **/
+  std::string source(const std::string& logic) const;
+
+  /**
+   * Returns the nodes that could not be generated
+   * @return the types of the unsupported nodes
+   **/
+  const std::vector<std::string>& unsupported(void) const;
+
+  /// Generates code for a LeafNode.
+  virtual void visit(const LeafNode& node);
+
+  /// Generates code for a CompositeConstArray.
+  virtual void visit(const CompositeConstArray& node);
+
+  /// Generates code for a CompositeArrayReference.
+  virtual void visit(const CompositeArrayReference& node);
+
+  /// Generates code for a VariableNode.
+  virtual void visit(const VariableNode& node);
+
+  /// Generates code for a VariableDecrementNode.
+  virtual void visit(const VariableDecrementNode& node);
+
+  /// Generates code for a VariableDivideNode.
+  virtual void visit(const VariableDivideNode& node);
+
+  /// Generates code for a VariableIncrementNode.
+  virtual void visit(const VariableIncrementNode& node);
+
+  /// Generates code for a VariableMultiplyNode.
+  virtual void visit(const VariableMultiplyNode& node);
+
+  /// Generates code for a VariableCompareNode.
+  virtual void visit(const VariableCompareNode& node);
+
+  /// Generates code for a ListNode.
+  virtual void visit(const ListNode& node);
+
+  /// Generates code for a CompositeNegateNode.
+  virtual void visit(const CompositeNegateNode& node);
+
+  /// Generates code for a CompositePostdecrementNode.
+  virtual void visit(const CompositePostdecrementNode& node);
+
+  /// Generates code for a CompositePostincrementNode.
+  virtual void visit(const CompositePostincrementNode& node);
+
+  /// Generates code for a CompositePredecrementNode.
+  virtual void visit(const CompositePredecrementNode& node);
+
+  /// Generates code for a CompositePreincrementNode.
+  virtual void visit(const CompositePreincrementNode& node);
+
+  /// Generates code for a CompositeSquareRootNode.
+  virtual void visit(const CompositeSquareRootNode& node);
+
+  /// Generates code for a CompositeNotNode.
+  virtual void visit(const CompositeNotNode& node);
+
+  /// Generates code for a CompositeAddNode.
+  virtual void visit(const CompositeAddNode& node);
+
+  /// Generates code for a CompositeAssignmentNode.
+  virtual void visit(const CompositeAssignmentNode& node);
+
+  /// Generates code for a CompositeAndNode.
+  virtual void visit(const CompositeAndNode& node);
+
+  /// Generates code for a CompositeOrNode.
+  virtual void visit(const CompositeOrNode& node);
+
+  /// Generates code for a CompositeEqualityNode.
+  virtual void visit(const CompositeEqualityNode& node);
+
+  /// Generates code for a CompositeInequalityNode.
+  virtual void visit(const CompositeInequalityNode& node);
+
+  /// Generates code for a CompositeGreaterThanEqualNode.
+  virtual void visit(const CompositeGreaterThanEqualNode& node);
+
+  /// Generates code for a CompositeGreaterThanNode.
+  virtual void visit(const CompositeGreaterThanNode& node);
+
+  /// Generates code for a CompositeLessThanEqualNode.
+  virtual void visit(const CompositeLessThanEqualNode& node);
+
+  /// Generates code for a CompositeLessThanNode.
+  virtual void visit(const CompositeLessThanNode& node);
+
+  /// Generates code for a CompositeSubtractNode.
+  virtual void visit(const CompositeSubtractNode& node);
+
+  /// Generates code for a CompositeDivideNode.
+  virtual void visit(const CompositeDivideNode& node);
+
+  /// Generates code for a CompositeMultiplyNode.
+  virtual void visit(const CompositeMultiplyNode& node);
+
+  /// Generates code for a CompositeModulusNode.
+  virtual void visit(const CompositeModulusNode& node);
+
+  /// Generates code for a CompositeBothNode.
+  virtual void visit(const CompositeBothNode& node);
+
+  /// Generates code for a CompositeReturnRightNode.
+  virtual void visit(const CompositeReturnRightNode& node);
+
+  /// Generates code for a CompositeSequentialNode.
+  virtual void visit(const CompositeSequentialNode& node);
+
+  /// Generates code for a CompositeFunctionNode.
+  virtual void visit(const CompositeFunctionNode& node);
+
+  /// Generates code for a CompositeForLoop.
+  virtual void visit(const CompositeForLoop& node);
+
+  /// Generates code for a CompositeImpliesNode.
+  virtual void visit(const CompositeImpliesNode& node);
+
+  /// Generates code for a SystemCallClearVariable.
+  virtual void visit(const SystemCallClearVariable& node);
+
+  /// Generates code for a SystemCallCos.
+  virtual void visit(const SystemCallCos& node);
+
+  /// Generates code for a SystemCallDeleteVariable.
+  virtual void visit(const SystemCallDeleteVariable& node);
+
+  /// Generates code for a SystemCallEval.
+  virtual void visit(const SystemCallEval& node);
+
+  /// Generates code for a SystemCallExpandEnv.
+  virtual void visit(const SystemCallExpandEnv& node);
+
+  /// Generates code for a SystemCallExpandStatement.
+  virtual void visit(const SystemCallExpandStatement& node);
+
+  /// Generates code for a SystemCallFragment.
+  virtual void visit(const SystemCallFragment& node);
+
+  /// Generates code for a SystemCallGeneric.
+  virtual void visit(const SystemCallGeneric& node);
+
+  /// Generates code for a SystemCallGetClock.
+  virtual void visit(const SystemCallGetClock& node);
+
+  /// Generates code for a SystemCallGetTime.
+  virtual void visit(const SystemCallGetTime& node);
+
+  /// Generates code for a SystemCallGetTimeSeconds.
+  virtual void visit(const SystemCallGetTimeSeconds& node);
+
+  /// Generates code for a SystemCallIsinf.
+  virtual void visit(const SystemCallIsinf& node);
+
+  /// Generates code for a SystemCallLogLevel.
+  virtual void visit(const SystemCallLogLevel& node);
+
+  /// Generates code for a SystemCallPow.
+  virtual void visit(const SystemCallPow& node);
+
+  /// Generates code for a SystemCallPrint.
+  virtual void visit(const SystemCallPrint& node);
+
+  /// Generates code for a SystemCallPrintSystemCalls.
+  virtual void visit(const SystemCallPrintSystemCalls& node);
+
+  /// Generates code for a SystemCallRandDouble.
+  virtual void visit(const SystemCallRandDouble& node);
+
+  /// Generates code for a SystemCallRandInt.
+  virtual void visit(const SystemCallRandInt& node);
+
+  /// Generates code for a SystemCallReadFile.
+  virtual void visit(const SystemCallReadFile& node);
+
+  /// Generates code for a SystemCallSetClock.
+  virtual void visit(const SystemCallSetClock& node);
+
+  /// Generates code for a SystemCallSin.
+  virtual void visit(const SystemCallSin& node);
+
+  /// Generates code for a SystemCallSize.
+  virtual void visit(const SystemCallSize& node);
+
+  /// Generates code for a SystemCallSleep.
+  virtual void visit(const SystemCallSleep& node);
+
+  /// Generates code for a SystemCallSqrt.
+  virtual void visit(const SystemCallSqrt& node);
+
+  /// Generates code for a SystemCallTan.
+  virtual void visit(const SystemCallTan& node);
+
+  /// Generates code for a SystemCallToBuffer.
+  virtual void visit(const SystemCallToBuffer& node);
+
+  /// Generates code for a SystemCallToDouble.
+  virtual void visit(const SystemCallToDouble& node);
+
+  /// Generates code for a SystemCallToDoubles.
+  virtual void visit(const SystemCallToDoubles& node);
+
+  /// Generates code for a SystemCallToHostDirs.
+  virtual void visit(const SystemCallToHostDirs& node);
+
+  /// Generates code for a SystemCallToInteger.
+  virtual void visit(const SystemCallToInteger& node);
+
+  /// Generates code for a SystemCallToIntegers.
+  virtual void visit(const SystemCallToIntegers& node);
+
+  /// Generates code for a SystemCallToString.
+  virtual void visit(const SystemCallToString& node);
+
+  /// Generates code for a SystemCallType.
+  virtual void visit(const SystemCallType& node);
+
+  /// Generates code for a SystemCallVadd.
+  virtual void visit(const SystemCallVadd& node);
+
+  /// Generates code for a SystemCallVclamp.
+  virtual void visit(const SystemCallVclamp& node);
+
+  /// Generates code for a SystemCallVdot.
+  virtual void visit(const SystemCallVdot& node);
+
+  /// Generates code for a SystemCallVmax.
+  virtual void visit(const SystemCallVmax& node);
+
+  /// Generates code for a SystemCallVmin.
+  virtual void visit(const SystemCallVmin& node);
+
+  /// Generates code for a SystemCallVmul.
+  virtual void visit(const SystemCallVmul& node);
+
+  /// Generates code for a SystemCallVscale.
+  virtual void visit(const SystemCallVscale& node);
+
+  /// Generates code for a SystemCallVsum.
+  virtual void visit(const SystemCallVsum& node);
+
+  /// Generates code for a SystemCallWriteFile.
+  virtual void visit(const SystemCallWriteFile& node);
+
+  /// Generates code for a SystemCallSetFixed.
+  virtual void visit(const SystemCallSetFixed& node);
+
+  /// Generates code for a SystemCallSetPrecision.
+  virtual void visit(const SystemCallSetPrecision& node);
+
+  /// Generates code for a SystemCallSetScientific.
+  virtual void visit(const SystemCallSetScientific& node);
+
+  /// No-op destructor
+  virtual ~CppVisitor(void);
+
+private:
+  /**
+   * Generates the code for a node
+   * @param  node      the node
+   * @return an expression holding the value of the node
+   **/
+  std::string emit(const ComponentNode* node);
+
+  /**
+   * Appends a line of code to the body of evaluate
+   * @param  code      the line, without indentation
+   **/
+  void line(const std::string& code);
+
+  /**
+   * Declares a new temporary
+   * @param  init      the initializer of the temporary, if any
+   * @return the name of the temporary
+   **/
+  std::string temp(const std::string& init = "");
+
+  /**
+   * Returns the member that holds a constant
+   * @param  value     the constant
+   * @return the member, or empty if the type is not supported
+   **/
+  std::string constant(const knowledge::KnowledgeRecord& value);
+
+  /**
+   * Returns the member that references a variable
+   * @param  key       the name of the variable
+   * @return the member, or empty if the key needs expansion
+   **/
+  std::string variable(const std::string& key);
+
+  /**
+   * Records a node that could not be generated
+   * @param  type      the type of the node
+   **/
+  void reject(const std::string& type);
+
+  /// the body of evaluate
+  std::stringstream body_;
+
+  /// the expression holding the value of the last node generated
+  std::string result_;
+
+  /// the indentation of the next line of the body
+  size_t indent_;
+
+  /// the number of temporaries declared
+  size_t temps_;
+
+  /// initializers of the constant members
+  std::vector<std::string> constants_;
+
+  /// the keys of the variable members, and their indices
+  std::map<std::string, size_t> variables_;
+
+  /// the types of the nodes that could not be generated
+  std::vector<std::string> unsupported_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_CPP_VISITOR_H_
@@ -0,0 +1,663 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_DEPENDENCY_VISITOR_CPP_
+#define _MADARA_DEPENDENCY_VISITOR_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/DependencyVisitor.h"
+#include "madara/expression/ComponentNode.h"
+#include "madara/expression/CompositeAddNode.h"
+#include "madara/expression/CompositeAndNode.h"
+#include "madara/expression/CompositeArrayReference.h"
+#include "madara/expression/CompositeAssignmentNode.h"
+#include "madara/expression/CompositeBothNode.h"
+#include "madara/expression/CompositeConstArray.h"
+#include "madara/expression/CompositeDivideNode.h"
+#include "madara/expression/CompositeEqualityNode.h"
+#include "madara/expression/CompositeForLoop.h"
+#include "madara/expression/CompositeFunctionNode.h"
+#include "madara/expression/CompositeGreaterThanEqualNode.h"
+#include "madara/expression/CompositeGreaterThanNode.h"
+#include "madara/expression/CompositeImpliesNode.h"
+#include "madara/expression/CompositeInequalityNode.h"
+#include "madara/expression/CompositeLessThanEqualNode.h"
+#include "madara/expression/CompositeLessThanNode.h"
+#include "madara/expression/CompositeModulusNode.h"
+#include "madara/expression/CompositeMultiplyNode.h"
+#include "madara/expression/CompositeNegateNode.h"
+#include "madara/expression/CompositeNotNode.h"
+#include "madara/expression/CompositeOrNode.h"
+#include "madara/expression/CompositePostdecrementNode.h"
+#include "madara/expression/CompositePostincrementNode.h"
+#include "madara/expression/CompositePredecrementNode.h"
+#include "madara/expression/CompositePreincrementNode.h"
+#include "madara/expression/CompositeReturnRightNode.h"
+#include "madara/expression/CompositeSequentialNode.h"
+#include "madara/expression/CompositeSquareRootNode.h"
+#include "madara/expression/CompositeSubtractNode.h"
+#include "madara/expression/CompositeTernaryNode.h"
+#include "madara/expression/LeafNode.h"
+#include "madara/expression/ListNode.h"
+#include "madara/expression/SystemCallClearVariable.h"
+#include "madara/expression/SystemCallCos.h"
+#include "madara/expression/SystemCallDeleteVariable.h"
+#include "madara/expression/SystemCallEval.h"
+#include "madara/expression/SystemCallExpandEnv.h"
+#include "madara/expression/SystemCallExpandStatement.h"
+#include "madara/expression/SystemCallFragment.h"
+#include "madara/expression/SystemCallGeneric.h"
+#include "madara/expression/SystemCallGetClock.h"
+#include "madara/expression/SystemCallGetTime.h"
+#include "madara/expression/SystemCallGetTimeSeconds.h"
+#include "madara/expression/SystemCallIsinf.h"
+#include "madara/expression/SystemCallLogLevel.h"
+#include "madara/expression/SystemCallPow.h"
+#include "madara/expression/SystemCallPrint.h"
+#include "madara/expression/SystemCallPrintSystemCalls.h"
+#include "madara/expression/SystemCallRandDouble.h"
+#include "madara/expression/SystemCallRandInt.h"
+#include "madara/expression/SystemCallReadFile.h"
+#include "madara/expression/SystemCallSetClock.h"
+#include "madara/expression/SystemCallSetFixed.h"
+#include "madara/expression/SystemCallSetPrecision.h"
+#include "madara/expression/SystemCallSetScientific.h"
+#include "madara/expression/SystemCallSin.h"
+#include "madara/expression/SystemCallSize.h"
+#include "madara/expression/SystemCallSleep.h"
+#include "madara/expression/SystemCallSqrt.h"
+#include "madara/expression/SystemCallTan.h"
+#include "madara/expression/SystemCallToBuffer.h"
+#include "madara/expression/SystemCallToDouble.h"
+#include "madara/expression/SystemCallToDoubles.h"
+#include "madara/expression/SystemCallToHostDirs.h"
+#include "madara/expression/SystemCallToInteger.h"
+#include "madara/expression/SystemCallToIntegers.h"
+#include "madara/expression/SystemCallToString.h"
+#include "madara/expression/SystemCallType.h"
+#include "madara/expression/SystemCallVadd.h"
+#include "madara/expression/SystemCallVclamp.h"
+#include "madara/expression/SystemCallVdot.h"
+#include "madara/expression/SystemCallVmax.h"
+#include "madara/expression/SystemCallVmin.h"
+#include "madara/expression/SystemCallVmul.h"
+#include "madara/expression/SystemCallVscale.h"
+#include "madara/expression/SystemCallVsum.h"
+#include "madara/expression/SystemCallWriteFile.h"
+#include "madara/expression/VariableCompareNode.h"
+#include "madara/expression/VariableDecrementNode.h"
+#include "madara/expression/VariableDivideNode.h"
+#include "madara/expression/VariableIncrementNode.h"
+#include "madara/expression/VariableMultiplyNode.h"
+#include "madara/expression/VariableNode.h"
+
+madara::expression::DependencyVisitor::DependencyVisitor()
+  : dynamic_(false), visited_(false)
+{
+}
+
+madara::expression::DependencyVisitor::~DependencyVisitor(void) {}
+
+void madara::expression::DependencyVisitor::collect(const ComponentNode* root)
+{
+  walk(root);
+}
+
+const std::set<std::string>& madara::expression::DependencyVisitor::reads(
+    void) const
+{
+  return reads_;
+}
+
+bool madara::expression::DependencyVisitor::is_dynamic(void) const
+{
+  return dynamic_;
+}
+
+void madara::expression::DependencyVisitor::walk(const ComponentNode* node)
+{
+  if (node == 0)
+    return;
+
+  // nodes without a visit, e.g., parallel for loops, could read anything
+  visited_ = false;
+  node->accept(*this);
+
+  if (!visited_)
+    dynamic_ = true;
+}
+
+void madara::expression::DependencyVisitor::operands(const ComponentNode& node)
+{
+  visited_ = true;
+
+  const CompositeTernaryNode* list =
+      dynamic_cast<const CompositeTernaryNode*>(&node);
+
+  if (list)
+  {
+    for (const ComponentNode* operand : list->nodes())
+      walk(operand);
+  }
+  else
+  {
+    walk(node.left());
+    walk(node.right());
+  }
+
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::read(const std::string& key)
+{
+  visited_ = true;
+
+  // expanded keys name different variables as other variables change
+  if (key.find('{') != std::string::npos)
+    dynamic_ = true;
+  else
+    reads_.insert(key);
+}
+
+void madara::expression::DependencyVisitor::target(const VariableNode* variable,
+    const CompositeArrayReference* array, bool reads)
+{
+  visited_ = true;
+
+  const std::string* key = 0;
+
+  if (variable)
+    key = &variable->key();
+  else if (array)
+  {
+    key = &array->key();
+    walk(array->right());
+  }
+  else
+    return;
+
+  if (reads)
+    read(*key);
+  else if (key->find('{') != std::string::npos)
+    dynamic_ = true;
+
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::unknown(void)
+{
+  visited_ = true;
+  dynamic_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(const LeafNode&)
+{
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeConstArray& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeArrayReference& node)
+{
+  target(0, &node, true);
+}
+
+void madara::expression::DependencyVisitor::visit(const VariableNode& node)
+{
+  read(node.key());
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const VariableDecrementNode& node)
+{
+  target(node.get_variable(), node.get_array(), true);
+  walk(node.get_rhs());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const VariableDivideNode& node)
+{
+  target(node.get_variable(), node.get_array(), true);
+  walk(node.get_rhs());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const VariableIncrementNode& node)
+{
+  target(node.get_variable(), node.get_array(), true);
+  walk(node.get_rhs());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const VariableMultiplyNode& node)
+{
+  target(node.get_variable(), node.get_array(), true);
+  walk(node.get_rhs());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const VariableCompareNode& node)
+{
+  target(node.get_variable(), node.get_array(), true);
+  walk(node.get_rhs());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(const ListNode&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeNegateNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositePostdecrementNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositePostincrementNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositePredecrementNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositePreincrementNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeSquareRootNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeNotNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeAddNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeAssignmentNode& node)
+{
+  target(node.get_variable(), node.get_array(), false);
+  walk(node.right());
+  visited_ = true;
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeAndNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeOrNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeEqualityNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeInequalityNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeGreaterThanEqualNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeGreaterThanNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeLessThanEqualNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeLessThanNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeSubtractNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeDivideNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeMultiplyNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeModulusNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeBothNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeReturnRightNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeSequentialNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeFunctionNode&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const CompositeForLoop&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const CompositeImpliesNode& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallClearVariable& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallCos& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallDeleteVariable& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallEval&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallExpandEnv& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallExpandStatement&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallFragment& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallGeneric&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallGetClock&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallGetTime&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallGetTimeSeconds&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallIsinf& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallLogLevel& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallPow& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallPrint&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallPrintSystemCalls& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallRandDouble&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallRandInt&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallReadFile&)
+{
+  unknown();
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallSetClock& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallSin& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallSize& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallSleep& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallSqrt& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallTan& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToBuffer& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToDouble& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToDoubles& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToHostDirs& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToInteger& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToIntegers& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallToString& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallType& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVadd& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVclamp& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVdot& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVmax& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVmin& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVmul& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVscale& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(const SystemCallVsum& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallWriteFile& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallSetFixed& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallSetPrecision& node)
+{
+  operands(node);
+}
+
+void madara::expression::DependencyVisitor::visit(
+    const SystemCallSetScientific& node)
+{
+  operands(node);
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_DEPENDENCY_VISITOR_CPP_
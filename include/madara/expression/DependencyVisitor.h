@@ -0,0 +1,363 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_DEPENDENCY_VISITOR_H_
+#define _MADARA_DEPENDENCY_VISITOR_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file DependencyVisitor.h
+ *
+ * This file contains the DependencyVisitor class, which finds the
+ * variables a pruned expression tree reads
+ **/
+
+#include <set>
+#include <string>
+
+#include "madara/expression/Visitor.h"
+#include "madara/MadaraExport.h"
+
+namespace madara
+{
+namespace expression
+{
+class ComponentNode;
+class CompositeArrayReference;
+
+/**
+ * @class DependencyVisitor
+ * @brief Collects the names of the variables an expression tree reads, so
+ *        the tree need only be evaluated again when one of them changes.
+ *
+ *        Trees whose reads cannot be known before they are evaluated are
+ *        marked dynamic. These are trees that expand keys, e.g.,
+ *        agent{.id}, call functions, loop, evaluate logic at runtime with
+ *        #eval or #print, or read the time, random numbers or files.
+ *        Variables that are only assigned are not reads.
+ */
+class MADARA_EXPORT DependencyVisitor : public Visitor
+{
+public:
+  /**
+   * Constructor
+   **/
+  DependencyVisitor();
+
+  /**
+   * Collects the variables a tree reads, adding them to those collected
+   * from other trees
+   * @param  root      the root of a pruned tree
+   **/
+  void collect(const ComponentNode* root);
+
+  /**
+   * Returns the names of the variables read
+   * @return the variable names
+   **/
+  const std::set<std::string>& reads(void) const;
+
+  /**
+   * Checks if the reads depend on the values of variables or on the
+   * environment, so the tree must be evaluated whenever it is needed
+   * @return true if reads are not the only inputs of the tree
+   **/
+  bool is_dynamic(void) const;
+
+  /// Collects the variables a LeafNode reads.
+  virtual void visit(const LeafNode& node);
+
+  /// Collects the variables a CompositeConstArray reads.
+  virtual void visit(const CompositeConstArray& node);
+
+  /// Collects the variables a CompositeArrayReference reads.
+  virtual void visit(const CompositeArrayReference& node);
+
+  /// Collects the variables a VariableNode reads.
+  virtual void visit(const VariableNode& node);
+
+  /// Collects the variables a VariableDecrementNode reads.
+  virtual void visit(const VariableDecrementNode& node);
+
+  /// Collects the variables a VariableDivideNode reads.
+  virtual void visit(const VariableDivideNode& node);
+
+  /// Collects the variables a VariableIncrementNode reads.
+  virtual void visit(const VariableIncrementNode& node);
+
+  /// Collects the variables a VariableMultiplyNode reads.
+  virtual void visit(const VariableMultiplyNode& node);
+
+  /// Collects the variables a VariableCompareNode reads.
+  virtual void visit(const VariableCompareNode& node);
+
+  /// Collects the variables a ListNode reads.
+  virtual void visit(const ListNode& node);
+
+  /// Collects the variables a CompositeNegateNode reads.
+  virtual void visit(const CompositeNegateNode& node);
+
+  /// Collects the variables a CompositePostdecrementNode reads.
+  virtual void visit(const CompositePostdecrementNode& node);
+
+  /// Collects the variables a CompositePostincrementNode reads.
+  virtual void visit(const CompositePostincrementNode& node);
+
+  /// Collects the variables a CompositePredecrementNode reads.
+  virtual void visit(const CompositePredecrementNode& node);
+
+  /// Collects the variables a CompositePreincrementNode reads.
+  virtual void visit(const CompositePreincrementNode& node);
+
+  /// Collects the variables a CompositeSquareRootNode reads.
+  virtual void visit(const CompositeSquareRootNode& node);
+
+  /// Collects the variables a CompositeNotNode reads.
+  virtual void visit(const CompositeNotNode& node);
+
+  /// Collects the variables a CompositeAddNode reads.
+  virtual void visit(const CompositeAddNode& node);
+
+  /// Collects the variables a CompositeAssignmentNode reads.
+  virtual void visit(const CompositeAssignmentNode& node);
+
+  /// Collects the variables a CompositeAndNode reads.
+  virtual void visit(const CompositeAndNode& node);
+
+  /// Collects the variables a CompositeOrNode reads.
+  virtual void visit(const CompositeOrNode& node);
+
+  /// Collects the variables a CompositeEqualityNode reads.
+  virtual void visit(const CompositeEqualityNode& node);
+
+  /// Collects the variables a CompositeInequalityNode reads.
+  virtual void visit(const CompositeInequalityNode& node);
+
+  /// Collects the variables a CompositeGreaterThanEqualNode reads.
+  virtual void visit(const CompositeGreaterThanEqualNode& node);
+
+  /// Collects the variables a CompositeGreaterThanNode reads.
+  virtual void visit(const CompositeGreaterThanNode& node);
+
+  /// Collects the variables a CompositeLessThanEqualNode reads.
+  virtual void visit(const CompositeLessThanEqualNode& node);
+
+  /// Collects the variables a CompositeLessThanNode reads.
+  virtual void visit(const CompositeLessThanNode& node);
+
+  /// Collects the variables a CompositeSubtractNode reads.
+  virtual void visit(const CompositeSubtractNode& node);
+
+  /// Collects the variables a CompositeDivideNode reads.
+  virtual void visit(const CompositeDivideNode& node);
+
+  /// Collects the variables a CompositeMultiplyNode reads.
+  virtual void visit(const CompositeMultiplyNode& node);
+
+  /// Collects the variables a CompositeModulusNode reads.
+  virtual void visit(const CompositeModulusNode& node);
+
+  /// Collects the variables a CompositeBothNode reads.
+  virtual void visit(const CompositeBothNode& node);
+
+  /// Collects the variables a CompositeReturnRightNode reads.
+  virtual void visit(const CompositeReturnRightNode& node);
+
+  /// Collects the variables a CompositeSequentialNode reads.
+  virtual void visit(const CompositeSequentialNode& node);
+
+  /// Collects the variables a CompositeFunctionNode reads.
+  virtual void visit(const CompositeFunctionNode& node);
+
+  /// Collects the variables a CompositeForLoop reads.
+  virtual void visit(const CompositeForLoop& node);
+
+  /// Collects the variables a CompositeImpliesNode reads.
+  virtual void visit(const CompositeImpliesNode& node);
+
+  /// Collects the variables a SystemCallClearVariable reads.
+  virtual void visit(const SystemCallClearVariable& node);
+
+  /// Collects the variables a SystemCallCos reads.
+  virtual void visit(const SystemCallCos& node);
+
+  /// Collects the variables a SystemCallDeleteVariable reads.
+  virtual void visit(const SystemCallDeleteVariable& node);
+
+  /// Collects the variables a SystemCallEval reads.
+  virtual void visit(const SystemCallEval& node);
+
+  /// Collects the variables a SystemCallExpandEnv reads.
+  virtual void visit(const SystemCallExpandEnv& node);
+
+  /// Collects the variables a SystemCallExpandStatement reads.
+  virtual void visit(const SystemCallExpandStatement& node);
+
+  /// Collects the variables a SystemCallFragment reads.
+  virtual void visit(const SystemCallFragment& node);
+
+  /// Collects the variables a SystemCallGeneric reads.
+  virtual void visit(const SystemCallGeneric& node);
+
+  /// Collects the variables a SystemCallGetClock reads.
+  virtual void visit(const SystemCallGetClock& node);
+
+  /// Collects the variables a SystemCallGetTime reads.
+  virtual void visit(const SystemCallGetTime& node);
+
+  /// Collects the variables a SystemCallGetTimeSeconds reads.
+  virtual void visit(const SystemCallGetTimeSeconds& node);
+
+  /// Collects the variables a SystemCallIsinf reads.
+  virtual void visit(const SystemCallIsinf& node);
+
+  /// Collects the variables a SystemCallLogLevel reads.
+  virtual void visit(const SystemCallLogLevel& node);
+
+  /// Collects the variables a SystemCallPow reads.
+  virtual void visit(const SystemCallPow& node);
+
+  /// Collects the variables a SystemCallPrint reads.
+  virtual void visit(const SystemCallPrint& node);
+
+  /// Collects the variables a SystemCallPrintSystemCalls reads.
+  virtual void visit(const SystemCallPrintSystemCalls& node);
+
+  /// Collects the variables a SystemCallRandDouble reads.
+  virtual void visit(const SystemCallRandDouble& node);
+
+  /// Collects the variables a SystemCallRandInt reads.
+  virtual void visit(const SystemCallRandInt& node);
+
+  /// Collects the variables a SystemCallReadFile reads.
+  virtual void visit(const SystemCallReadFile& node);
+
+  /// Collects the variables a SystemCallSetClock reads.
+  virtual void visit(const SystemCallSetClock& node);
+
+  /// Collects the variables a SystemCallSin reads.
+  virtual void visit(const SystemCallSin& node);
+
+  /// Collects the variables a SystemCallSize reads.
+  virtual void visit(const SystemCallSize& node);
+
+  /// Collects the variables a SystemCallSleep reads.
+  virtual void visit(const SystemCallSleep& node);
+
+  /// Collects the variables a SystemCallSqrt reads.
+  virtual void visit(const SystemCallSqrt& node);
+
+  /// Collects the variables a SystemCallTan reads.
+  virtual void visit(const SystemCallTan& node);
+
+  /// Collects the variables a SystemCallToBuffer reads.
+  virtual void visit(const SystemCallToBuffer& node);
+
+  /// Collects the variables a SystemCallToDouble reads.
+  virtual void visit(const SystemCallToDouble& node);
+
+  /// Collects the variables a SystemCallToDoubles reads.
+  virtual void visit(const SystemCallToDoubles& node);
+
+  /// Collects the variables a SystemCallToHostDirs reads.
+  virtual void visit(const SystemCallToHostDirs& node);
+
+  /// Collects the variables a SystemCallToInteger reads.
+  virtual void visit(const SystemCallToInteger& node);
+
+  /// Collects the variables a SystemCallToIntegers reads.
+  virtual void visit(const SystemCallToIntegers& node);
+
+  /// Collects the variables a SystemCallToString reads.
+  virtual void visit(const SystemCallToString& node);
+
+  /// Collects the variables a SystemCallType reads.
+  virtual void visit(const SystemCallType& node);
+
+  /// Collects the variables a SystemCallVadd reads.
+  virtual void visit(const SystemCallVadd& node);
+
+  /// Collects the variables a SystemCallVclamp reads.
+  virtual void visit(const SystemCallVclamp& node);
+
+  /// Collects the variables a SystemCallVdot reads.
+  virtual void visit(const SystemCallVdot& node);
+
+  /// Collects the variables a SystemCallVmax reads.
+  virtual void visit(const SystemCallVmax& node);
+
+  /// Collects the variables a SystemCallVmin reads.
+  virtual void visit(const SystemCallVmin& node);
+
+  /// Collects the variables a SystemCallVmul reads.
+  virtual void visit(const SystemCallVmul& node);
+
+  /// Collects the variables a SystemCallVscale reads.
+  virtual void visit(const SystemCallVscale& node);
+
+  /// Collects the variables a SystemCallVsum reads.
+  virtual void visit(const SystemCallVsum& node);
+
+  /// Collects the variables a SystemCallWriteFile reads.
+  virtual void visit(const SystemCallWriteFile& node);
+
+  /// Collects the variables a SystemCallSetFixed reads.
+  virtual void visit(const SystemCallSetFixed& node);
+
+  /// Collects the variables a SystemCallSetPrecision reads.
+  virtual void visit(const SystemCallSetPrecision& node);
+
+  /// Collects the variables a SystemCallSetScientific reads.
+  virtual void visit(const SystemCallSetScientific& node);
+
+  /// No-op destructor
+  virtual ~DependencyVisitor(void);
+
+private:
+  /**
+   * Visits a node, marking the tree dynamic if the node does not accept
+   * visitors
+   * @param  node      the node, or 0
+   **/
+  void walk(const ComponentNode* node);
+
+  /**
+   * Visits the operands of a node
+   * @param  node      the node
+   **/
+  void operands(const ComponentNode& node);
+
+  /**
+   * Records a read of a variable
+   * @param  key       the name of the variable
+   **/
+  void read(const std::string& key);
+
+  /**
+   * Records the variable a node assigns or changes
+   * @param  variable  the variable, or 0 for an array index
+   * @param  array     the array index, or 0 for a variable
+   * @param  reads     true if the node reads the variable before changing it
+   **/
+  void target(const VariableNode* variable,
+      const CompositeArrayReference* array, bool reads);
+
+  /**
+   * Marks the tree dynamic
+   **/
+  void unknown(void);
+
+  /// the names of the variables read
+  std::set<std::string> reads_;
+
+  /// true if the reads cannot be known before evaluation
+  bool dynamic_;
+
+  /// true once the current node has been visited
+  bool visited_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_DEPENDENCY_VISITOR_H_
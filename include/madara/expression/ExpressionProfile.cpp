@@ -0,0 +1,284 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_EXPRESSION_PROFILE_CPP_
+#define _MADARA_EXPRESSION_PROFILE_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "madara/expression/ExpressionProfile.h"
+#include "madara/expression/CompositeArrayReference.h"
+#include "madara/expression/LeafNode.h"
+#include "madara/expression/PrintVisitor.h"
+#include "madara/expression/VariableNode.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * A profiled node, in the order of a depth-first walk of the tree
+ **/
+struct Entry
+{
+  /// the wrapper of the node
+  const ProfiledNode* node;
+
+  /// the number of profiled parents
+  size_t depth;
+
+  /// the index of the profiled parent
+  size_t parent;
+
+  /// the source of the node on one line
+  std::string source;
+};
+
+/**
+ * Returns true if parents do not look for the type of a node, so it can
+ * be wrapped
+ **/
+bool is_profiled(const ComponentNode* node)
+{
+  return dynamic_cast<const LeafNode*>(node) == 0 &&
+         dynamic_cast<const VariableNode*>(node) == 0 &&
+         dynamic_cast<const CompositeArrayReference*>(node) == 0;
+}
+
+/**
+ * Prints the source of a node on a single line of at most width characters
+ **/
+std::string source(const ComponentNode* node, size_t width)
+{
+  PrintVisitor printer;
+  std::string result = printer.print(node);
+
+  for (char& c : result)
+  {
+    if (c == '\n' || c == '\r' || c == '\t')
+      c = ' ';
+  }
+
+  if (width >= 3 && result.size() > width)
+    result = result.substr(0, width - 3) + "...";
+
+  return result;
+}
+
+/**
+ * Lists the profiled nodes under a node
+ **/
+void collect(ComponentNode* node, size_t depth, size_t parent, size_t width,
+    std::vector<Entry>& entries)
+{
+  std::vector<ComponentNode**> children;
+  node->get_children(children);
+
+  for (ComponentNode** child : children)
+  {
+    ProfiledNode* profiled = dynamic_cast<ProfiledNode*>(*child);
+
+    if (profiled)
+    {
+      Entry entry = {
+          profiled, depth + 1, parent, source(profiled->get_node(), width)};
+      entries.push_back(entry);
+
+      collect(profiled->get_node(), depth + 1, entries.size() - 1, width,
+          entries);
+    }
+    else if (*child)
+    {
+      collect(*child, depth, parent, width, entries);
+    }
+  }
+}
+
+/**
+ * Lists the wrapper of the root, followed by the profiled nodes of the tree
+ **/
+std::vector<Entry> profiled_nodes(const ProfiledNode& root, size_t width)
+{
+  std::vector<Entry> entries;
+
+  if (root.get_node())
+  {
+    Entry entry = {&root, 0, 0, source(root.get_node(), width)};
+    entries.push_back(entry);
+
+    collect(root.get_node(), 0, 0, width, entries);
+  }
+
+  return entries;
+}
+}
+}
+}
+
+madara::expression::ExpressionProfile::ExpressionProfile(
+    logger::Logger& logger,
+    const madara::utility::Refcounter<ComponentNode>& root)
+  : logger_(&logger), tree_(root), root_(logger, tree_.get_ptr(), false)
+{
+  if (tree_.get_ptr())
+    wrap(tree_.get_ptr());
+}
+
+madara::expression::ExpressionProfile::~ExpressionProfile(void)
+{
+  if (tree_.get_ptr())
+    unwrap(tree_.get_ptr());
+}
+
+madara::expression::ComponentNode*
+madara::expression::ExpressionProfile::get_root(void)
+{
+  return &root_;
+}
+
+uint64_t madara::expression::ExpressionProfile::calls(void) const
+{
+  return root_.calls();
+}
+
+uint64_t madara::expression::ExpressionProfile::total_ns(void) const
+{
+  return root_.inclusive_ns();
+}
+
+void madara::expression::ExpressionProfile::reset(void)
+{
+  std::vector<Entry> entries = profiled_nodes(root_, 0);
+
+  for (Entry& entry : entries)
+  {
+    const_cast<ProfiledNode*>(entry.node)->reset();
+  }
+}
+
+std::string madara::expression::ExpressionProfile::annotate(
+    size_t width) const
+{
+  std::vector<Entry> entries = profiled_nodes(root_, width);
+
+  double total = (double)root_.inclusive_ns();
+
+  std::stringstream buffer;
+  buffer.imbue(std::locale::classic());
+
+  buffer << std::setw(10) << "calls" << std::setw(14) << "total (us)"
+         << std::setw(14) << "self (us)" << std::setw(8) << "self %"
+         << "  source\n";
+
+  buffer << std::fixed;
+
+  for (const Entry& entry : entries)
+  {
+    double self = (double)entry.node->exclusive_ns();
+
+    buffer << std::setw(10) << entry.node->calls() << std::setprecision(3)
+           << std::setw(14) << entry.node->inclusive_ns() / 1000.0
+           << std::setw(14) << self / 1000.0 << std::setprecision(1)
+           << std::setw(8) << (total > 0 ? 100 * self / total : 0.0) << "  "
+           << std::string(entry.depth * 2, ' ') << entry.source << "\n";
+  }
+
+  return buffer.str();
+}
+
+std::string madara::expression::ExpressionProfile::folded(size_t width) const
+{
+  std::vector<Entry> entries = profiled_nodes(root_, width);
+
+  // parents are listed before their children
+  std::vector<std::string> stacks(entries.size());
+  std::stringstream buffer;
+  buffer.imbue(std::locale::classic());
+
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    std::string frame = entries[i].source;
+
+    for (char& c : frame)
+    {
+      if (c == ';')
+        c = ',';
+    }
+
+    stacks[i] = i == 0 ? frame : stacks[entries[i].parent] + ";" + frame;
+
+    if (entries[i].node->exclusive_ns() > 0)
+    {
+      buffer << stacks[i] << " " << entries[i].node->exclusive_ns() << "\n";
+    }
+  }
+
+  return buffer.str();
+}
+
+void madara::expression::ExpressionProfile::wrap(ComponentNode* node)
+{
+  std::vector<ComponentNode**> children;
+  node->get_children(children);
+
+  for (ComponentNode** child : children)
+  {
+    if (*child == 0)
+      continue;
+
+    ProfiledNode* profiled = dynamic_cast<ProfiledNode*>(*child);
+
+    // another profile of the same tree already wrapped the node
+    if (profiled)
+    {
+      ++profiled->profiles;
+      wrap(profiled->get_node());
+    }
+    else if (is_profiled(*child))
+    {
+      wrap(*child);
+      *child = new ProfiledNode(*logger_, *child);
+    }
+    else
+    {
+      wrap(*child);
+    }
+  }
+}
+
+void madara::expression::ExpressionProfile::unwrap(ComponentNode* node)
+{
+  std::vector<ComponentNode**> children;
+  node->get_children(children);
+
+  for (ComponentNode** child : children)
+  {
+    if (*child == 0)
+      continue;
+
+    ProfiledNode* profiled = dynamic_cast<ProfiledNode*>(*child);
+
+    if (profiled)
+    {
+      unwrap(profiled->get_node());
+
+      if (--profiled->profiles == 0)
+      {
+        *child = profiled->release();
+        delete profiled;
+      }
+    }
+    else
+    {
+      unwrap(*child);
+    }
+  }
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_EXPRESSION_PROFILE_CPP_
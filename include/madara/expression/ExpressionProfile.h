@@ -0,0 +1,130 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_EXPRESSION_PROFILE_H_
+#define _MADARA_EXPRESSION_PROFILE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file ExpressionProfile.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the ExpressionProfile class, which records how often
+ * each node of an expression tree is evaluated and how long it takes
+ **/
+
+#include <string>
+
+#include "madara/expression/ComponentNode.h"
+#include "madara/expression/ProfiledNode.h"
+#include "madara/utility/Refcounter.h"
+#include "madara/MadaraExport.h"
+
+namespace madara
+{
+namespace expression
+{
+/**
+ * @class ExpressionProfile
+ * @brief Profiles an expression tree by wrapping its nodes in ProfiledNode
+ *        for as long as the profile exists. Constants, variables and array
+ *        indices are not wrapped, because their parents find them by type,
+ *        so their time counts toward their parents.
+ *
+ *        The counts include the evaluations of every tree that shares
+ *        the nodes, which is why CompiledExpression profiles a tree of
+ *        its own. Profiles must not be created or destroyed while the
+ *        tree is being evaluated. Reading and resetting the counts is
+ *        always safe.
+ */
+class MADARA_EXPORT ExpressionProfile
+{
+public:
+  /**
+   * Constructor. Keeps the tree alive until the profile is destroyed.
+   * @param  logger   the logger to use for printing
+   * @param  root     the root of the tree to profile
+   **/
+  ExpressionProfile(logger::Logger& logger,
+      const madara::utility::Refcounter<ComponentNode>& root);
+
+  /**
+   * Destructor. Removes the wrappers from the tree.
+   **/
+  ~ExpressionProfile(void);
+
+  // profiles own the wrappers, so they may not be copied
+  ExpressionProfile(const ExpressionProfile&) = delete;
+  ExpressionProfile& operator=(const ExpressionProfile&) = delete;
+
+  /**
+   * Returns the node to evaluate to profile the tree
+   * @return the wrapped root
+   **/
+  ComponentNode* get_root(void);
+
+  /**
+   * Returns the number of evaluations of the tree
+   * @return the number of completed evaluations
+   **/
+  uint64_t calls(void) const;
+
+  /**
+   * Returns the time spent evaluating the tree
+   * @return the time in nanoseconds
+   **/
+  uint64_t total_ns(void) const;
+
+  /**
+   * Sets all counts and times back to zero
+   **/
+  void reset(void);
+
+  /**
+   * Prints each profiled node on its own line, indented under its parent,
+   * with its calls, total and self time in microseconds, its share of the
+   * time spent in the tree, and its source
+   * @param  width    the maximum length of the source on a line
+   * @return the annotated source
+   **/
+  std::string annotate(size_t width = 60) const;
+
+  /**
+   * Prints the profile as folded stacks, one line per node with the
+   * sources of the node and its parents separated by semicolons and
+   * followed by its self time in nanoseconds. This is the input format
+   * of flame graph tools, e.g., flamegraph.pl. Semicolons in sources are
+   * printed as commas.
+   * @param  width    the maximum length of the source of a node
+   * @return the folded stacks
+   **/
+  std::string folded(size_t width = 60) const;
+
+private:
+  /**
+   * Wraps the children of a node, and their children
+   * @param  node     the node to wrap the children of
+   **/
+  void wrap(ComponentNode* node);
+
+  /**
+   * Removes the wrappers of this profile from the children of a node,
+   * and their children
+   * @param  node     the node to unwrap the children of
+   **/
+  void unwrap(ComponentNode* node);
+
+  /// handle for logging information
+  logger::Logger* logger_;
+
+  /// the profiled tree, kept alive by the profile
+  madara::utility::Refcounter<ComponentNode> tree_;
+
+  /// the wrapper of the root, which the tree does not hold
+  ProfiledNode root_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_EXPRESSION_PROFILE_H_
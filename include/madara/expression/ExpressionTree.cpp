@@ -12,9 +12,11 @@
 #include <stdexcept>
 
 #include "madara/expression/ComponentNode.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/Iterator.h"
 #include "madara/expression/IteratorImpl.h"
 #include "madara/expression/ExpressionTree.h"
+#include "madara/expression/ExpressionProfile.h"
 #include "madara/expression/LeafNode.h"
 
 namespace madara
@@ -166,7 +168,10 @@ madara::expression::ExpressionTree::ExpressionTree(logger::Logger& logger,
 
 madara::expression::ExpressionTree::ExpressionTree(
     logger::Logger& logger, const madara::expression::ExpressionTree& t)
-  : logger_(&logger), root_(t.root_)
+  : logger_(&logger),
+    root_(t.root_),
+    bytecode_(t.bytecode_),
+    profile_(t.profile_)
 {
 }
 
@@ -181,6 +186,8 @@ void madara::expression::ExpressionTree::operator=(
   {
     logger_ = t.logger_;
     root_ = t.root_;
+    bytecode_ = t.bytecode_;
+    profile_ = t.profile_;
   }
 }
 
@@ -207,6 +214,10 @@ madara::knowledge::KnowledgeRecord madara::expression::ExpressionTree::prune(
   bool root_can_change = false;
   madara::knowledge::KnowledgeRecord root_value;
 
+  // pruning may delete nodes that the bytecode or profile refers to
+  bytecode_.reset();
+  profile_.reset();
+
   if (this->root_.get_ptr())
   {
     root_value = this->root_->prune(root_can_change);
@@ -224,12 +235,67 @@ madara::knowledge::KnowledgeRecord madara::expression::ExpressionTree::prune(
 madara::knowledge::KnowledgeRecord madara::expression::ExpressionTree::evaluate(
     const madara::knowledge::KnowledgeUpdateSettings& settings)
 {
-  if (root_.get_ptr() != 0)
+  if (profile_)
+    return profile_->get_root()->evaluate(settings);
+  else if (bytecode_)
+    return bytecode_->evaluate(settings);
+  else if (root_.get_ptr() != 0)
     return root_->evaluate(settings);
   else
     return madara::knowledge::KnowledgeRecord(0);
 }
 
+size_t madara::expression::ExpressionTree::compile_bytecode(void)
+{
+  bytecode_.reset();
+
+  if (root_.get_ptr() != 0)
+  {
+    std::shared_ptr<Bytecode> bytecode = std::make_shared<Bytecode>();
+    root_->compile(*bytecode);
+    bytecode_ = bytecode;
+
+    madara_logger_ptr_log(logger_, logger::LOG_MINOR,
+        "ExpressionTree::compile_bytecode: "
+        "%d instructions, %d evaluated as nodes\n",
+        (int)bytecode_->size(), (int)bytecode_->fallbacks());
+
+    return bytecode_->size();
+  }
+
+  return 0;
+}
+
+bool madara::expression::ExpressionTree::has_bytecode(void) const
+{
+  return (bool)bytecode_;
+}
+
+std::shared_ptr<madara::expression::ExpressionProfile>
+madara::expression::ExpressionTree::enable_profiling(void)
+{
+  if (!profile_ && root_.get_ptr() != 0)
+  {
+    profile_ = std::make_shared<ExpressionProfile>(*logger_, root_);
+
+    madara_logger_ptr_log(logger_, logger::LOG_MINOR,
+        "ExpressionTree::enable_profiling: profiling tree\n");
+  }
+
+  return profile_;
+}
+
+void madara::expression::ExpressionTree::disable_profiling(void)
+{
+  profile_.reset();
+}
+
+std::shared_ptr<madara::expression::ExpressionProfile>
+madara::expression::ExpressionTree::get_profile(void) const
+{
+  return profile_;
+}
+
 // return root pointer
 madara::expression::ComponentNode* madara::expression::ExpressionTree::get_root(
     void)
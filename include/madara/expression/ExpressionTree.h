@@ -7,6 +7,7 @@
 
 #include <string>
 #include <stdexcept>
+#include <memory>
 #include "madara/utility/Refcounter.h"
 
 #include "madara/logger/GlobalLogger.h"
@@ -20,6 +21,8 @@ namespace expression
 // Forward declarations.
 class ExpressionTreeIterator;
 class ExpressionTreeConstIterator;
+class Bytecode;
+class ExpressionProfile;
 
 /**
  * @class ExpressionTree
@@ -99,6 +102,43 @@ public:
       const madara::knowledge::KnowledgeUpdateSettings& settings =
           knowledge::KnowledgeUpdateSettings());
 
+  /**
+   * Lowers the tree into bytecode, which is used by evaluate from then
+   * on. The tree should already be pruned.
+   * @return the number of instructions in the bytecode
+   **/
+  size_t compile_bytecode(void);
+
+  /**
+   * Checks if the tree has been lowered into bytecode
+   * @return true if evaluate uses bytecode
+   **/
+  bool has_bytecode(void) const;
+
+  /**
+   * Starts counting the evaluations of each node and the time spent in
+   * them. Evaluations do not use bytecode while profiling. Copies made
+   * afterwards share the profile. The nodes are wrapped in place, so
+   * other trees that share them, e.g., trees from the interpreter cache,
+   * are profiled too, and must not be evaluated while profiling is
+   * enabled or disabled. CompiledExpression::enable_profiling profiles
+   * a tree of its own.
+   * @return the profile
+   **/
+  std::shared_ptr<ExpressionProfile> enable_profiling(void);
+
+  /**
+   * Stops profiling. The nodes are unwrapped when the last copy of the
+   * tree that shares the profile stops profiling.
+   **/
+  void disable_profiling(void);
+
+  /**
+   * Returns the profile of the tree
+   * @return the profile, or null if the tree is not being profiled
+   **/
+  std::shared_ptr<ExpressionProfile> get_profile(void) const;
+
   /**
    * Returns the left expression of this tree
    * @return    left expression
@@ -155,6 +195,12 @@ private:
 
   /// root of the expression tree
   madara::utility::Refcounter<ComponentNode> root_;
+
+  /// the tree lowered into bytecode, if it has been compiled
+  std::shared_ptr<Bytecode> bytecode_;
+
+  /// the profile of the tree, if it is being profiled
+  std::shared_ptr<ExpressionProfile> profile_;
 };
 }
 }
@@ -43,6 +43,7 @@
 #include "madara/expression/CompositeReturnRightNode.h"
 #include "madara/expression/CompositeFunctionNode.h"
 #include "madara/expression/CompositeForLoop.h"
+#include "madara/expression/CompositeParallelForLoop.h"
 #include "madara/expression/CompositeSequentialNode.h"
 #include "madara/expression/CompositeSquareRootNode.h"
 #include "madara/expression/CompositeImpliesNode.h"
@@ -82,6 +83,14 @@
 #include "madara/expression/SystemCallToIntegers.h"
 #include "madara/expression/SystemCallToString.h"
 #include "madara/expression/SystemCallType.h"
+#include "madara/expression/SystemCallVadd.h"
+#include "madara/expression/SystemCallVclamp.h"
+#include "madara/expression/SystemCallVdot.h"
+#include "madara/expression/SystemCallVmax.h"
+#include "madara/expression/SystemCallVmin.h"
+#include "madara/expression/SystemCallVmul.h"
+#include "madara/expression/SystemCallVscale.h"
+#include "madara/expression/SystemCallVsum.h"
 #include "madara/expression/SystemCallWriteFile.h"
 #include "madara/expression/Interpreter.h"
 
@@ -1618,6 +1627,33 @@ public:
   madara::knowledge::ThreadSafeContext& context_;
 };
 
+/**
+ * @class ParallelForLoop
+ * @brief Iterative looping node of the parse tree whose iterations are
+ *        evaluated in parallel
+ */
+
+class ParallelForLoop : public ForLoop
+{
+public:
+  /// constructor
+  ParallelForLoop(Symbol* precondition, VariableCompare* condition,
+      VariableIncrement* postcondition, Symbol* body,
+      const std::string& variable, const std::string& body_logic,
+      madara::knowledge::ThreadSafeContext& context);
+
+  /// destructor
+  virtual ~ParallelForLoop(void);
+
+  /// builds an equivalent ExpressionTree node
+  virtual ComponentNode* build(void);
+
+  VariableCompare* compare_;
+  VariableIncrement* increment_;
+  std::string variable_;
+  std::string body_logic_;
+};
+
 /**
  * @class Negate
  * @brief Negate node of the parse tree
@@ -1878,6 +1914,50 @@ private:
   const char* name_;
   fn_type fn_;
 };
+
+/**
+ * @class VectorSystemCall
+ * @brief A system call that does arithmetic over whole arrays, e.g., #vadd.
+ *        Node is the SystemCallVectorNode subclass the call builds.
+ */
+template<typename Node>
+class VectorSystemCall : public SystemCall
+{
+public:
+  /// constructor
+  VectorSystemCall(
+      madara::knowledge::ThreadSafeContext& context, const char* fn_name)
+    : SystemCall(context), name_(fn_name)
+  {
+  }
+
+  /// returns the precedence level
+  virtual int add_precedence(int accumulated_precedence)
+  {
+    return this->precedence_ = VARIABLE_PRECEDENCE + accumulated_precedence;
+  }
+
+  /// builds an equivalent ExpressionTree node
+  virtual ComponentNode* build(void)
+  {
+    if (left_ || right_)
+    {
+      std::stringstream str;
+      str << name_ << "::build: KARL COMPILE ERROR: " << name_
+          << " has a left or right child. Likely missing a semi-colon";
+      std::string s = str.str();
+
+      madara_logger_ptr_log(logger_, logger::LOG_ERROR, "%s\n", s.c_str());
+
+      throw exceptions::KarlException(s);
+    }
+
+    return new Node(context_, nodes_);
+  }
+
+private:
+  const char* name_;
+};
 }
 }
 
@@ -3330,6 +3410,34 @@ madara::expression::ComponentNode* madara::expression::ForLoop::build()
   }
 }
 
+// constructor
+madara::expression::ParallelForLoop::ParallelForLoop(Symbol* precondition,
+    VariableCompare* condition, VariableIncrement* postcondition, Symbol* body,
+    const std::string& variable, const std::string& body_logic,
+    madara::knowledge::ThreadSafeContext& context)
+  : ForLoop(precondition, condition, postcondition, body, context),
+    compare_(condition),
+    increment_(postcondition),
+    variable_(variable),
+    body_logic_(body_logic)
+{
+}
+
+// destructor
+madara::expression::ParallelForLoop::~ParallelForLoop(void) {}
+
+// builds an equivalent ExpressionTree node
+madara::expression::ComponentNode*
+madara::expression::ParallelForLoop::build()
+{
+  return new CompositeParallelForLoop(precondition_->build(),
+      new VariableNode(variable_, context_),
+      compare_->rhs_ ? compare_->rhs_->build() : 0, compare_->value_,
+      compare_->compare_type_ == VariableCompareNode::LESS_THAN_EQUAL,
+      increment_->right_ ? increment_->right_->build() : 0,
+      increment_->value_, body_->build(), body_logic_, context_);
+}
+
 // constructor
 madara::expression::Postdecrement::Postdecrement(logger::Logger& logger)
   : UnaryOperator(logger, 0, NEGATE_PRECEDENCE)
@@ -4724,11 +4832,32 @@ madara::expression::ComponentNode* madara::expression::Divide::build(void)
 }
 
 // constructor
-madara::expression::Interpreter::Interpreter() {}
+madara::expression::Interpreter::Interpreter()
+{
+  cache_stats_.capacity = DEFAULT_CACHE_CAPACITY;
+}
 
 // destructor
 madara::expression::Interpreter::~Interpreter() {}
 
+void madara::expression::Interpreter::set_cache_capacity(size_t capacity)
+{
+  cache_stats_.capacity = capacity;
+  evict();
+}
+
+void madara::expression::Interpreter::evict(void)
+{
+  while (cache_stats_.capacity > 0 && cache_.size() > cache_stats_.capacity)
+  {
+    cache_index_.erase(cache_.back().first);
+    cache_.pop_back();
+    ++cache_stats_.evictions;
+  }
+
+  cache_stats_.size = cache_.size();
+}
+
 // extracts precondition, condition, postcondition, and body from input
 void madara::expression::Interpreter::handle_for_loop(
     madara::knowledge::ThreadSafeContext& context, std::string& variable,
@@ -5051,10 +5180,37 @@ void madara::expression::Interpreter::handle_for_loop(
   for (++i; i < input.length() && is_whitespace(input[i]); ++i)
     ;
 
+  // a .parallel before the body splits the iterations across threads
+  bool parallel = false;
+  std::string::size_type body_begin = 0;
+
+  if (input.compare(i, 9, ".parallel") == 0)
+  {
+    std::string::size_type next = i + 9;
+
+    for (; next < input.length() && is_whitespace(input[next]); ++next)
+      ;
+
+    if (next < input.length() && input[next] == '(')
+    {
+      parallel = variable.find('{') == std::string::npos;
+      i = next;
+
+      if (!parallel)
+      {
+        madara_logger_log(context.get_logger(), logger::LOG_WARNING,
+            "KaRL: For loop: %s needs expansion, so the loop cannot be "
+            "parallel\n",
+            variable.c_str());
+      }
+    }
+  }
+
   // can't have a body without a parenthesis or brace
   if (i < input.length() && input[i] == '(')
   {
     ++i;
+    body_begin = i;
     lastValidInput = 0;
 
     madara_logger_log(context.get_logger(), logger::LOG_DETAILED,
@@ -5132,8 +5288,25 @@ void madara::expression::Interpreter::handle_for_loop(
         var_node, cond_val, user_cond, compare_type, context);
     condition->add_precedence(accumulated_precedence + FOR_LOOP_PRECEDENCE);
 
-    Symbol* op =
-        new ForLoop(precondition, condition, postcondition, body, context);
+    Symbol* op;
+
+    if (parallel)
+    {
+      // the body, without its closing parenthesis
+      std::string body_logic = input.substr(body_begin, i - 1 - body_begin);
+
+      madara_logger_log(context.get_logger(), logger::LOG_DETAILED,
+          "KaRL: For loop: Body of parallel loop is %s\n",
+          body_logic.c_str());
+
+      op = new ParallelForLoop(precondition, condition, postcondition, body,
+          variable, body_logic, context);
+    }
+    else
+    {
+      op = new ForLoop(precondition, condition, postcondition, body, context);
+    }
+
     op->add_precedence(accumulated_precedence);
 
     precedence_insert(context, op, list);
@@ -5620,6 +5793,40 @@ void madara::expression::Interpreter::system_call_insert(
           call = new Type(context);
         }
         break;
+      case 'v':
+        if (name == "#vadd")
+        {
+          call = new VectorSystemCall<SystemCallVadd>(context, "#vadd");
+        }
+        else if (name == "#vclamp")
+        {
+          call = new VectorSystemCall<SystemCallVclamp>(context, "#vclamp");
+        }
+        else if (name == "#vdot")
+        {
+          call = new VectorSystemCall<SystemCallVdot>(context, "#vdot");
+        }
+        else if (name == "#vmax")
+        {
+          call = new VectorSystemCall<SystemCallVmax>(context, "#vmax");
+        }
+        else if (name == "#vmin")
+        {
+          call = new VectorSystemCall<SystemCallVmin>(context, "#vmin");
+        }
+        else if (name == "#vmul")
+        {
+          call = new VectorSystemCall<SystemCallVmul>(context, "#vmul");
+        }
+        else if (name == "#vscale")
+        {
+          call = new VectorSystemCall<SystemCallVscale>(context, "#vscale");
+        }
+        else if (name == "#vsum")
+        {
+          call = new VectorSystemCall<SystemCallVsum>(context, "#vsum");
+        }
+        break;
       case 'w':
         if (name == "#write_file")
         {
@@ -6636,12 +6843,24 @@ void madara::expression::Interpreter::handle_parenthesis(
 // converts a string and context into a parse tree, and builds an
 // expression tree out of the parse tree
 madara::expression::ExpressionTree madara::expression::Interpreter::interpret(
-    knowledge::ThreadSafeContext& context, const std::string& input)
+    knowledge::ThreadSafeContext& context, const std::string& input,
+    bool cached)
 {
-  // return the cached expression tree if it exists
-  ExpressionTreeMap::const_iterator found = cache_.find(input);
-  if (found != cache_.end())
-    return found->second;
+  if (cached)
+  {
+    // return the cached expression tree if it exists
+    auto found = cache_index_.find(input);
+    if (found != cache_index_.end())
+    {
+      ++cache_stats_.hits;
+
+      // move the expression to the most recently used end
+      cache_.splice(cache_.begin(), cache_, found->second);
+      return found->second->second;
+    }
+
+    ++cache_stats_.misses;
+  }
 
   ::std::list<Symbol*> list;
   // list.clear ();
@@ -6697,7 +6916,12 @@ madara::expression::ExpressionTree madara::expression::Interpreter::interpret(
     delete list.back();
 
     // store this optimized tree into cached memory
-    cache_[input] = tree;
+    if (cached)
+    {
+      cache_.emplace_front(input, tree);
+      cache_index_[input] = cache_.begin();
+      evict();
+    }
 
     return tree;
   }
@@ -16,6 +16,8 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <utility>
 
 #include "madara/knowledge/KnowledgeRecord.h"
 #include "madara/expression/ExpressionTree.h"
@@ -30,6 +32,29 @@ class Symbol;
 
 typedef std::map<std::string, ExpressionTree> ExpressionTreeMap;
 
+/**
+ * @struct ExpressionCacheStats
+ * @brief Statistics of the cache of compiled expressions in an
+ *        Interpreter, for sizing the cache
+ **/
+struct ExpressionCacheStats
+{
+  /// the most expressions kept, 0 if unbounded
+  size_t capacity = 0;
+
+  /// the expressions currently kept
+  size_t size = 0;
+
+  /// interpretations answered from the cache
+  size_t hits = 0;
+
+  /// interpretations that had to be compiled
+  size_t misses = 0;
+
+  /// expressions dropped to stay within capacity
+  size_t evictions = 0;
+};
+
 /**
  * @class Interpreter
  * @brief Parses incoming expression strings into a parse tree and
@@ -56,11 +81,14 @@ public:
    * Compiles an expression into an expression tree.
    * @param    context    interpreter context
    * @param    input      expression to compile
+   * @param    cached     if true, the tree is shared through the cache
+   *                      with every other interpretation of input. If
+   *                      false, the tree is built anew and not cached.
    * @return   expression tree to evaluate
    * @throw exceptions::KarlException failure during interpret
    **/
-  ExpressionTree interpret(
-      madara::knowledge::ThreadSafeContext& context, const std::string& input);
+  ExpressionTree interpret(madara::knowledge::ThreadSafeContext& context,
+      const std::string& input, bool cached = true);
 
   /**
    * Checks a character to see if it is a string literal
@@ -118,6 +146,28 @@ public:
    **/
   inline bool delete_expression(const std::string& expression);
 
+  /**
+   * Sets the most expressions the cache keeps. When full, the least
+   * recently interpreted expression is dropped. Trees already handed
+   * out remain valid.
+   * @param    capacity        the most expressions, or 0 for no limit
+   **/
+  void set_cache_capacity(size_t capacity);
+
+  /**
+   * Returns the statistics of the expression cache
+   * @return   capacity, size, hits, misses and evictions
+   **/
+  inline ExpressionCacheStats get_cache_stats(void) const;
+
+  /**
+   * Resets the hit, miss and eviction counts of the expression cache
+   **/
+  inline void reset_cache_stats(void);
+
+  /// the default capacity of the expression cache
+  static const size_t DEFAULT_CACHE_CAPACITY = 10000;
+
 private:
   /**
    * extracts precondition, condition, postcondition, and body from input
@@ -249,10 +299,25 @@ private:
       const std::string& input, std::string::size_type& i,
       Symbol*& lastValidInput, bool& handled, int& accumulated_precedence,
       ::std::list<Symbol*>& list, bool build_argument_list = false);
+  /**
+   * Drops least recently used expressions until the cache is within
+   * its capacity
+   **/
+  void evict(void);
+
+  /// cached expressions, from most to least recently used
+  typedef std::list<std::pair<std::string, ExpressionTree>> ExpressionCache;
+
   /**
    * Cache of expressions that have been previously compiled
    **/
-  ExpressionTreeMap cache_;
+  ExpressionCache cache_;
+
+  /// hashed index of cache_ by expression
+  std::unordered_map<std::string, ExpressionCache::iterator> cache_index_;
+
+  /// statistics of the cache, including its capacity
+  ExpressionCacheStats cache_stats_;
 };
 }
 }
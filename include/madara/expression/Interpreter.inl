@@ -70,7 +70,29 @@ inline bool madara::expression::Interpreter::is_whitespace(char input)
 inline bool madara::expression::Interpreter::delete_expression(
     const std::string& expression)
 {
-  return cache_.erase(expression) == 1;
+  auto found = cache_index_.find(expression);
+
+  if (found == cache_index_.end())
+    return false;
+
+  cache_.erase(found->second);
+  cache_index_.erase(found);
+  cache_stats_.size = cache_.size();
+
+  return true;
+}
+
+inline madara::expression::ExpressionCacheStats
+madara::expression::Interpreter::get_cache_stats(void) const
+{
+  return cache_stats_;
+}
+
+inline void madara::expression::Interpreter::reset_cache_stats(void)
+{
+  cache_stats_.hits = 0;
+  cache_stats_.misses = 0;
+  cache_stats_.evictions = 0;
 }
 
 #endif  // _MADARA_NO_KARL_
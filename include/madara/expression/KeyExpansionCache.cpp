@@ -0,0 +1,116 @@
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/KeyExpansionCache.h"
+
+madara::expression::KeyExpansionCache::KeyExpansionCache(
+    const std::string& key, knowledge::ThreadSafeContext& context)
+  : context_(context), supported_(true), erasures_(context.erasures_)
+{
+  size_t start = 0;
+
+  for (size_t opener = key.find('{'); opener != std::string::npos;
+       opener = key.find('{', start))
+  {
+    size_t closer = key.find('}', opener);
+
+    // nested braces expand in more than one pass and are not cached
+    if (closer == std::string::npos || closer == opener + 1 ||
+        key.find('{', opener + 1) < closer)
+    {
+      supported_ = false;
+      return;
+    }
+
+    literals_.push_back(key.substr(start, opener - start));
+    inner_keys_.push_back(key.substr(opener + 1, closer - opener - 1));
+    start = closer + 1;
+  }
+
+  literals_.push_back(key.substr(start));
+
+  inners_.resize(inner_keys_.size());
+  values_.resize(inner_keys_.size());
+}
+
+size_t madara::expression::KeyExpansionCache::ValuesHash::operator()(
+    const std::vector<knowledge::KnowledgeRecord::Integer>& values) const
+{
+  size_t result = 0;
+
+  for (knowledge::KnowledgeRecord::Integer value : values)
+  {
+    result ^= std::hash<knowledge::KnowledgeRecord::Integer>()(value) +
+              0x9e3779b9 + (result << 6) + (result >> 2);
+  }
+
+  return result;
+}
+
+bool madara::expression::KeyExpansionCache::find(
+    knowledge::VariableReference& variable, bool create)
+{
+  if (!supported_)
+    return false;
+
+  // erased variables may be referenced by entries or inners_
+  if (erasures_ != context_.erasures_)
+  {
+    entries_.clear();
+    inners_.assign(inner_keys_.size(), knowledge::VariableReference());
+    erasures_ = context_.erasures_;
+  }
+
+  knowledge::KnowledgeReferenceSettings settings(false);
+
+  for (size_t i = 0; i < inners_.size(); ++i)
+  {
+    // the inner variables are created, as expand_key does
+    if (!inners_[i].is_valid())
+      inners_[i] = context_.get_ref(inner_keys_[i], settings);
+
+    const knowledge::KnowledgeRecord* value = inners_[i].get_record_unsafe();
+
+    // other types print differently depending on settings
+    if (value->type() != knowledge::KnowledgeRecord::INTEGER)
+      return false;
+
+    values_[i] = value->to_integer();
+  }
+
+  Entries::const_iterator found = entries_.find(values_);
+
+  if (found != entries_.end())
+  {
+    variable = found->second;
+    return true;
+  }
+
+  std::string key(literals_[0]);
+
+  for (size_t i = 0; i < values_.size(); ++i)
+  {
+    key += std::to_string(values_[i]);
+    key += literals_[i + 1];
+  }
+
+  if (create)
+    variable = context_.get_ref(key, settings);
+  else
+  {
+    // reading a missing variable does not create it
+    const knowledge::ThreadSafeContext& context = context_;
+    variable = context.get_ref(key, settings);
+  }
+
+  if (variable.is_valid())
+  {
+    if (entries_.size() >= MAX_ENTRIES)
+      entries_.clear();
+
+    entries_.emplace(values_, variable);
+  }
+
+  return true;
+}
+
+#endif  // _MADARA_NO_KARL_
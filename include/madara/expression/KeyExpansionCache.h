@@ -0,0 +1,104 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_EXPRESSION_KEY_EXPANSION_CACHE_H_
+#define _MADARA_EXPRESSION_KEY_EXPANSION_CACHE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file KeyExpansionCache.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the KeyExpansionCache class, which remembers the
+ * variables that brace-templated keys expanded to
+ **/
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+#include "madara/knowledge/VariableReference.h"
+
+namespace madara
+{
+namespace expression
+{
+/**
+ * @class KeyExpansionCache
+ * @brief Resolves a key like agent.{.id}.pos.{.i} to the variable it
+ *        expands to, remembering the variable for each combination of
+ *        the inner variables' values. A repeated combination costs a
+ *        hash lookup instead of building the key and searching the
+ *        context. Only keys without nested braces whose inner variables
+ *        hold integers are handled. Every entry is dropped when the
+ *        context erases variables, since references may dangle.
+ *        Callers must hold the context lock.
+ **/
+class KeyExpansionCache
+{
+public:
+  /**
+   * Constructor
+   * @param   key      the key, containing braces
+   * @param   context  the context holding the variables
+   **/
+  KeyExpansionCache(
+      const std::string& key, knowledge::ThreadSafeContext& context);
+
+  /**
+   * Finds the variable the key currently expands to
+   * @param   variable the variable, or an invalid reference if it does
+   *                   not exist and create is false
+   * @param   create   create the variable if it does not exist
+   * @return  true if the key was handled. If false, the caller must
+   *          expand the key itself.
+   **/
+  bool find(knowledge::VariableReference& variable, bool create);
+
+  /// the most combinations remembered before all are dropped
+  static const size_t MAX_ENTRIES = 65536;
+
+private:
+  /// Hashes the values of the inner variables
+  struct ValuesHash
+  {
+    size_t operator()(
+        const std::vector<knowledge::KnowledgeRecord::Integer>& values) const;
+  };
+
+  typedef std::unordered_map<std::vector<knowledge::KnowledgeRecord::Integer>,
+      knowledge::VariableReference, ValuesHash>
+      Entries;
+
+  /// the context holding the variables
+  knowledge::ThreadSafeContext& context_;
+
+  /// false if the key has nested braces
+  bool supported_;
+
+  /// text around the inner variables, one more than inners_
+  std::vector<std::string> literals_;
+
+  /// names of the inner variables
+  std::vector<std::string> inner_keys_;
+
+  /// the inner variables, resolved on first use
+  std::vector<knowledge::VariableReference> inners_;
+
+  /// scratch space for the current values of the inner variables
+  std::vector<knowledge::KnowledgeRecord::Integer> values_;
+
+  /// variables by the values of the inner variables
+  Entries entries_;
+
+  /// erasures from the context when the references were resolved
+  uint64_t erasures_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_EXPRESSION_KEY_EXPANSION_CACHE_H_
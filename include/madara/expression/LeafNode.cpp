@@ -8,6 +8,7 @@
 
 #include "madara/expression/ComponentNode.h"
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/LeafNode.h"
 
 // Ctor
@@ -78,6 +79,11 @@ void madara::expression::LeafNode::accept(Visitor& visitor) const
   visitor.visit(*this);
 }
 
+void madara::expression::LeafNode::compile(Bytecode& program)
+{
+  program.emit_constant(item_);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 #endif /* _LEAF_NODE_CPP_ */
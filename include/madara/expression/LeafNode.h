@@ -84,6 +84,12 @@ public:
    **/
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Lowers the node into bytecode
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
 private:
   /// Integer value associated with the operand.
   madara::knowledge::KnowledgeRecord item_;
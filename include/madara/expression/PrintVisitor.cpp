@@ -2,170 +2,711 @@
 #ifndef _PRINT_VISITOR_CPP_
 #define _PRINT_VISITOR_CPP_
 
-#ifdef _USE_VISITORS_
+#ifndef _MADARA_NO_KARL_
 
-#include <iostream>
+#include <string>
 
-#include "madara/expression/LeafNode.h"
-#include "madara/expression/VariableNode.h"
-#include "madara/expression/VariableDecrementNode.h"
-#include "madara/expression/VariableDivideNode.h"
-#include "madara/expression/VariableIncrementNode.h"
-#include "madara/expression/VariableMultiplyNode.h"
-#include "madara/expression/VariableCompareNode.h"
-#include "madara/expression/ListNode.h"
-#include "madara/expression/CompositeNegateNode.h"
-#include "madara/expression/CompositePredecrementNode.h"
-#include "madara/expression/CompositePreincrementNode.h"
-#include "madara/expression/CompositeNotNode.h"
+#include "madara/expression/PrintVisitor.h"
+#include "madara/expression/ComponentNode.h"
 #include "madara/expression/CompositeAddNode.h"
-#include "madara/expression/CompositeAssignmentNode.h"
 #include "madara/expression/CompositeAndNode.h"
-#include "madara/expression/CompositeOrNode.h"
+#include "madara/expression/CompositeArrayReference.h"
+#include "madara/expression/CompositeAssignmentNode.h"
+#include "madara/expression/CompositeBothNode.h"
+#include "madara/expression/CompositeConstArray.h"
+#include "madara/expression/CompositeDivideNode.h"
 #include "madara/expression/CompositeEqualityNode.h"
-#include "madara/expression/CompositeInequalityNode.h"
+#include "madara/expression/CompositeForLoop.h"
+#include "madara/expression/CompositeFunctionNode.h"
 #include "madara/expression/CompositeGreaterThanEqualNode.h"
 #include "madara/expression/CompositeGreaterThanNode.h"
+#include "madara/expression/CompositeImpliesNode.h"
+#include "madara/expression/CompositeInequalityNode.h"
 #include "madara/expression/CompositeLessThanEqualNode.h"
 #include "madara/expression/CompositeLessThanNode.h"
-#include "madara/expression/CompositeSubtractNode.h"
-#include "madara/expression/CompositeDivideNode.h"
-#include "madara/expression/CompositeMultiplyNode.h"
 #include "madara/expression/CompositeModulusNode.h"
-#include "madara/expression/CompositeBothNode.h"
+#include "madara/expression/CompositeMultiplyNode.h"
+#include "madara/expression/CompositeNegateNode.h"
+#include "madara/expression/CompositeNotNode.h"
+#include "madara/expression/CompositeOrNode.h"
+#include "madara/expression/CompositePostdecrementNode.h"
+#include "madara/expression/CompositePostincrementNode.h"
+#include "madara/expression/CompositePredecrementNode.h"
+#include "madara/expression/CompositePreincrementNode.h"
+#include "madara/expression/CompositeReturnRightNode.h"
 #include "madara/expression/CompositeSequentialNode.h"
-#include "madara/expression/CompositeFunctionNode.h"
-#include "madara/expression/CompositeForLoop.h"
-#include "madara/expression/CompositeImpliesNode.h"
-#include "madara/expression/PrintVisitor.h"
-#include "madara/logger/Logger.h"
-#include "madara/logger/GlobalLogger.h"
+#include "madara/expression/CompositeSquareRootNode.h"
+#include "madara/expression/CompositeSubtractNode.h"
+#include "madara/expression/CompositeTernaryNode.h"
+#include "madara/expression/LeafNode.h"
+#include "madara/expression/ListNode.h"
+#include "madara/expression/SystemCallClearVariable.h"
+#include "madara/expression/SystemCallCos.h"
+#include "madara/expression/SystemCallDeleteVariable.h"
+#include "madara/expression/SystemCallEval.h"
+#include "madara/expression/SystemCallExpandEnv.h"
+#include "madara/expression/SystemCallExpandStatement.h"
+#include "madara/expression/SystemCallFragment.h"
+#include "madara/expression/SystemCallGeneric.h"
+#include "madara/expression/SystemCallGetClock.h"
+#include "madara/expression/SystemCallGetTime.h"
+#include "madara/expression/SystemCallGetTimeSeconds.h"
+#include "madara/expression/SystemCallIsinf.h"
+#include "madara/expression/SystemCallLogLevel.h"
+#include "madara/expression/SystemCallPow.h"
+#include "madara/expression/SystemCallPrint.h"
+#include "madara/expression/SystemCallPrintSystemCalls.h"
+#include "madara/expression/SystemCallRandDouble.h"
+#include "madara/expression/SystemCallRandInt.h"
+#include "madara/expression/SystemCallReadFile.h"
+#include "madara/expression/SystemCallSetClock.h"
+#include "madara/expression/SystemCallSetFixed.h"
+#include "madara/expression/SystemCallSetPrecision.h"
+#include "madara/expression/SystemCallSetScientific.h"
+#include "madara/expression/SystemCallSin.h"
+#include "madara/expression/SystemCallSize.h"
+#include "madara/expression/SystemCallSleep.h"
+#include "madara/expression/SystemCallSqrt.h"
+#include "madara/expression/SystemCallTan.h"
+#include "madara/expression/SystemCallToBuffer.h"
+#include "madara/expression/SystemCallToDouble.h"
+#include "madara/expression/SystemCallToDoubles.h"
+#include "madara/expression/SystemCallToHostDirs.h"
+#include "madara/expression/SystemCallToInteger.h"
+#include "madara/expression/SystemCallToIntegers.h"
+#include "madara/expression/SystemCallToString.h"
+#include "madara/expression/SystemCallType.h"
+#include "madara/expression/SystemCallVadd.h"
+#include "madara/expression/SystemCallVclamp.h"
+#include "madara/expression/SystemCallVdot.h"
+#include "madara/expression/SystemCallVmax.h"
+#include "madara/expression/SystemCallVmin.h"
+#include "madara/expression/SystemCallVmul.h"
+#include "madara/expression/SystemCallVscale.h"
+#include "madara/expression/SystemCallVsum.h"
+#include "madara/expression/SystemCallWriteFile.h"
+#include "madara/expression/VariableCompareNode.h"
+#include "madara/expression/VariableDecrementNode.h"
+#include "madara/expression/VariableDivideNode.h"
+#include "madara/expression/VariableIncrementNode.h"
+#include "madara/expression/VariableMultiplyNode.h"
+#include "madara/expression/VariableNode.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+/**
+ * Prints a constant as a KaRL literal
+ **/
+std::string literal(const knowledge::KnowledgeRecord& value)
+{
+  if (value.is_string_type())
+    return "\"" + value.to_string() + "\"";
+  else if (value.is_array_type())
+    return "[" + value.to_string(", ") + "]";
+  else
+    return value.to_string();
+}
+}
+}
+}
+
+madara::expression::PrintVisitor::PrintVisitor()
+  : atomic_(true), visited_(false)
+{
+}
 
-/// visit function - prints LeafNode contents to std::cout
+madara::expression::PrintVisitor::~PrintVisitor(void) {}
 
-void madara::expression::PrintVisitor::visit(const LeafNode& node) {}
+std::string madara::expression::PrintVisitor::print(const ComponentNode* node)
+{
+  if (node == 0)
+    return "";
+
+  visited_ = false;
+  node->accept(*this);
+
+  // nodes without a visit are printed as what they store
+  if (!visited_)
+    emit(node->item().to_string(), true);
+
+  return result_;
+}
 
-/// visit function - prints VariableNode value to std::cout
-void madara::expression::PrintVisitor::visit(const VariableNode& node) {}
+std::string madara::expression::PrintVisitor::operand(
+    const ComponentNode* node)
+{
+  std::string source = print(node);
+
+  if (!atomic_)
+    source = "(" + source + ")";
+
+  return source;
+}
+
+void madara::expression::PrintVisitor::emit(
+    const std::string& source, bool atomic)
+{
+  result_ = source;
+  atomic_ = atomic;
+  visited_ = true;
+}
+
+void madara::expression::PrintVisitor::unary(
+    const std::string& op, const ComponentNode* node, bool prefix)
+{
+  std::string source = operand(node);
+  emit(prefix ? op + source : source + op, false);
+}
+
+void madara::expression::PrintVisitor::binary(
+    const std::string& op, const ComponentNode& node)
+{
+  std::string left = operand(node.left());
+  std::string right = operand(node.right());
+  emit(left + " " + op + " " + right, false);
+}
+
+void madara::expression::PrintVisitor::list(
+    const std::string& op, const CompositeTernaryNode& node, bool nested)
+{
+  std::string source;
+
+  for (const ComponentNode* child : node.nodes())
+  {
+    if (!source.empty())
+      source += op;
+
+    source += nested ? operand(child) : print(child);
+  }
+
+  emit(source, false);
+}
+
+void madara::expression::PrintVisitor::call(
+    const std::string& name, const CompositeTernaryNode& node)
+{
+  std::string args;
+
+  for (const ComponentNode* child : node.nodes())
+  {
+    if (!args.empty())
+      args += ", ";
+
+    args += print(child);
+  }
+
+  emit(name + " (" + args + ")", true);
+}
+
+void madara::expression::PrintVisitor::modify(const VariableNode* variable,
+    const CompositeArrayReference* array, const std::string& op,
+    const ComponentNode* rhs, const knowledge::KnowledgeRecord& value)
+{
+  std::string target;
+
+  if (variable)
+    target = variable->key();
+  else if (array)
+    target = print(array);
+
+  std::string source;
+
+  if (rhs)
+    source = operand(rhs);
+  else
+    source = literal(value);
+
+  emit(target + " " + op + " " + source, false);
+}
+
+void madara::expression::PrintVisitor::visit(const LeafNode& node)
+{
+  emit(literal(node.item()), true);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeConstArray& node)
+{
+  std::string values;
+
+  for (const ComponentNode* child : node.nodes())
+  {
+    if (!values.empty())
+      values += ", ";
+
+    values += print(child);
+  }
+
+  emit("[" + values + "]", true);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const CompositeArrayReference& node)
+{
+  std::string index = print(node.right());
+  emit(node.key() + "[" + index + "]", true);
+}
+
+void madara::expression::PrintVisitor::visit(const VariableNode& node)
+{
+  emit(node.key(), true);
+}
 
-/// visit function - prints VariableDecrementNode value to std::cout
 void madara::expression::PrintVisitor::visit(const VariableDecrementNode& node)
 {
+  modify(node.get_variable(), node.get_array(), "-=", node.get_rhs(),
+      node.get_value());
 }
 
-/// visit function - prints VariableDivideNode value to std::cout
-void madara::expression::PrintVisitor::visit(const VariableDivideNode& node) {}
+void madara::expression::PrintVisitor::visit(const VariableDivideNode& node)
+{
+  modify(node.get_variable(), node.get_array(), "/=", node.get_rhs(),
+      node.get_value());
+}
 
-/// visit function - prints VariableIncrementNode value to std::cout
 void madara::expression::PrintVisitor::visit(const VariableIncrementNode& node)
 {
+  modify(node.get_variable(), node.get_array(), "+=", node.get_rhs(),
+      node.get_value());
 }
 
-/// visit function - prints VariableMultiplyNode value to std::cout
 void madara::expression::PrintVisitor::visit(const VariableMultiplyNode& node)
 {
+  modify(node.get_variable(), node.get_array(), "*=", node.get_rhs(),
+      node.get_value());
 }
 
-/// visit function - prints VariableCompareNode value to std::cout
-void madara::expression::PrintVisitor::visit(const VariableCompareNode& node) {}
+void madara::expression::PrintVisitor::visit(const VariableCompareNode& node)
+{
+  std::string op(">");
+
+  switch (node.get_compare_type())
+  {
+  case VariableCompareNode::LESS_THAN:
+    op = "<";
+    break;
+  case VariableCompareNode::LESS_THAN_EQUAL:
+    op = "<=";
+    break;
+  case VariableCompareNode::EQUAL:
+    op = "==";
+    break;
+  case VariableCompareNode::GREATER_THAN_EQUAL:
+    op = ">=";
+    break;
+  default:
+    break;
+  }
+
+  modify(node.get_variable(), node.get_array(), op, node.get_rhs(),
+      node.get_value());
+}
 
-/// visit function - prints ListNode value to std::cout
-void madara::expression::PrintVisitor::visit(const ListNode& node) {}
+void madara::expression::PrintVisitor::visit(const ListNode&)
+{
+  emit("", true);
+}
 
-/// visit function - prints CompositeNegateNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeNegateNode&) {}
+void madara::expression::PrintVisitor::visit(const CompositeNegateNode& node)
+{
+  unary("-", node.right(), true);
+}
 
-/// visit function - prints CompositeNegateNode contents to std::cout
+void madara::expression::PrintVisitor::visit(
+    const CompositePostdecrementNode& node)
+{
+  unary("--", node.right(), false);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositePredecrementNode&)
+void madara::expression::PrintVisitor::visit(
+    const CompositePostincrementNode& node)
 {
+  unary("++", node.right(), false);
 }
 
-/// visit function - prints CompositeNegateNode contents to std::cout
+void madara::expression::PrintVisitor::visit(
+    const CompositePredecrementNode& node)
+{
+  unary("--", node.right(), true);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositePreincrementNode&)
+void madara::expression::PrintVisitor::visit(
+    const CompositePreincrementNode& node)
 {
+  unary("++", node.right(), true);
 }
 
-/// visit function - prints CompositeNotNode contents to std::cout
+void madara::expression::PrintVisitor::visit(
+    const CompositeSquareRootNode& node)
+{
+  std::string value = print(node.right());
+  emit("#sqrt (" + value + ")", true);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeNotNode&) {}
+void madara::expression::PrintVisitor::visit(const CompositeNotNode& node)
+{
+  unary("!", node.right(), true);
+}
 
-/// visit function - prints CompositeAddNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const CompositeAddNode& node)
+{
+  list(" + ", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeAddNode&) {}
+void madara::expression::PrintVisitor::visit(
+    const CompositeAssignmentNode& node)
+{
+  // assignments bind looser than any operator but the sequences
+  std::string target = node.get_variable()
+                           ? print(node.get_variable())
+                           : print(node.get_array());
+  std::string value = print(node.right());
+  emit(target + " = " + value, false);
+}
 
-/// visit function - prints CompositeAndNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const CompositeAndNode& node)
+{
+  list(" && ", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeAndNode&) {}
+void madara::expression::PrintVisitor::visit(const CompositeOrNode& node)
+{
+  list(" || ", node);
+}
 
-/// visit function - prints CompositeOrNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const CompositeEqualityNode& node)
+{
+  binary("==", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeOrNode&) {}
+void madara::expression::PrintVisitor::visit(
+    const CompositeInequalityNode& node)
+{
+  binary("!=", node);
+}
 
-/// visit function - prints CompositeEqualityNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeEqualityNode&) {}
+void madara::expression::PrintVisitor::visit(
+    const CompositeGreaterThanEqualNode& node)
+{
+  binary(">=", node);
+}
 
-/// visit function - prints CompositeInequalityNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeInequalityNode&) {}
+void madara::expression::PrintVisitor::visit(
+    const CompositeGreaterThanNode& node)
+{
+  binary(">", node);
+}
 
-/// visit function - prints CompositeGreaterThanEqualNode contents to std::cout
 void madara::expression::PrintVisitor::visit(
-    const CompositeGreaterThanEqualNode&)
+    const CompositeLessThanEqualNode& node)
 {
+  binary("<=", node);
 }
 
-/// visit function - prints CompositeGreaterThanNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeGreaterThanNode&) {}
+void madara::expression::PrintVisitor::visit(const CompositeLessThanNode& node)
+{
+  binary("<", node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeSubtractNode& node)
+{
+  binary("-", node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeDivideNode& node)
+{
+  binary("/", node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeMultiplyNode& node)
+{
+  list(" * ", node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeModulusNode& node)
+{
+  binary("%", node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeBothNode& node)
+{
+  list("; ", node, false);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const CompositeReturnRightNode& node)
+{
+  list(" ;> ", node, false);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const CompositeSequentialNode& node)
+{
+  list(", ", node, false);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeFunctionNode& node)
+{
+  // the item of a function call is its name followed by ()
+  std::string name = node.item().to_string();
+
+  if (name.size() >= 2 && name.compare(name.size() - 2, 2, "()") == 0)
+    name.resize(name.size() - 2);
+
+  call(name, node);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeForLoop& node)
+{
+  std::string precondition = print(node.get_precondition());
+  std::string condition = print(node.get_condition());
+  std::string postcondition = print(node.get_postcondition());
+  std::string body = print(node.get_body());
+
+  emit("for (" + precondition + "; " + condition + "; " + postcondition +
+           ") (" + body + ")",
+      true);
+}
+
+void madara::expression::PrintVisitor::visit(const CompositeImpliesNode& node)
+{
+  binary("=>", node);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const SystemCallClearVariable& node)
+{
+  call("#clear_var", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallCos& node)
+{
+  call("#cos", node);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const SystemCallDeleteVariable& node)
+{
+  call("#delete_var", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallEval& node)
+{
+  call("#eval", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallExpandEnv& node)
+{
+  call("#expand_env", node);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const SystemCallExpandStatement& node)
+{
+  call("#expand_statement", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallFragment& node)
+{
+  call("#fragment", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallGeneric& node)
+{
+  call(node.name(), node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallGetClock& node)
+{
+  call("#get_clock", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallGetTime& node)
+{
+  call("#get_time", node);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const SystemCallGetTimeSeconds& node)
+{
+  call("#get_time_seconds", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallIsinf& node)
+{
+  call("#isinf", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallLogLevel& node)
+{
+  call("#log_level", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallPow& node)
+{
+  call("#pow", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallPrint& node)
+{
+  call("#print", node);
+}
+
+void madara::expression::PrintVisitor::visit(
+    const SystemCallPrintSystemCalls& node)
+{
+  call("#print_system_calls", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallRandDouble& node)
+{
+  call("#rand_double", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallRandInt& node)
+{
+  call("#rand_int", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallReadFile& node)
+{
+  call("#read_file", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallSetClock& node)
+{
+  call("#set_clock", node);
+}
 
-/// visit function - prints CompositeLessThanEqualNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeLessThanEqualNode&)
+void madara::expression::PrintVisitor::visit(const SystemCallSin& node)
 {
+  call("#sin", node);
 }
 
-/// visit function - prints CompositeLessThanNode contents to std::cout
-void madara::expression::PrintVisitor::visit(const CompositeLessThanNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallSize& node)
+{
+  call("#size", node);
+}
 
-/// visit function - prints CompositeAssignmentNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallSleep& node)
+{
+  call("#sleep", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeAssignmentNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallSqrt& node)
+{
+  call("#sqrt", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallTan& node)
+{
+  call("#tan", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallToBuffer& node)
+{
+  call("#to_buffer", node);
+}
+
+void madara::expression::PrintVisitor::visit(const SystemCallToDouble& node)
+{
+  call("#to_double", node);
+}
 
-/// visit function - prints CompositeSubtractNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallToDoubles& node)
+{
+  call("#to_doubles", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeSubtractNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallToHostDirs& node)
+{
+  call("#to_host_dirs", node);
+}
 
-/// visit function - prints CompositeDivideNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallToInteger& node)
+{
+  call("#to_integer", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeDivideNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallToIntegers& node)
+{
+  call("#to_integers", node);
+}
 
-/// visit function - prints CompositeMultiplyNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallToString& node)
+{
+  call("#to_string", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeMultiplyNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallType& node)
+{
+  call("#type", node);
+}
 
-/// visit function - prints CompositeModulusNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallVadd& node)
+{
+  call("#vadd", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeModulusNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallVclamp& node)
+{
+  call("#vclamp", node);
+}
 
-/// visit function - prints CompositeBothNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallVdot& node)
+{
+  call("#vdot", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeBothNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallVmax& node)
+{
+  call("#vmax", node);
+}
 
-/// visit function - prints CompositeSequentialNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallVmin& node)
+{
+  call("#vmin", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeSequentialNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallVmul& node)
+{
+  call("#vmul", node);
+}
 
-/// visit function - prints CompositeFunctionNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallVscale& node)
+{
+  call("#vscale", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeFunctionNode&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallVsum& node)
+{
+  call("#vsum", node);
+}
 
-/// visit function - prints CompositeForLoop contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallWriteFile& node)
+{
+  call("#write_file", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeForLoop&) {}
+void madara::expression::PrintVisitor::visit(const SystemCallSetFixed& node)
+{
+  call("#set_fixed", node);
+}
 
-/// visit function - prints CompositeImpliesNode contents to std::cout
+void madara::expression::PrintVisitor::visit(const SystemCallSetPrecision& node)
+{
+  call("#set_precision", node);
+}
 
-void madara::expression::PrintVisitor::visit(const CompositeImpliesNode&) {}
+void madara::expression::PrintVisitor::visit(
+    const SystemCallSetScientific& node)
+{
+  call("#set_scientific", node);
+}
 
-#endif  // _USE_VISITORS_
+#endif  // _MADARA_NO_KARL_
 
 #endif /* _PRINT_VISITOR_CPP_ */
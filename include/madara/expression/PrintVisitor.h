@@ -2,212 +2,373 @@
 #ifndef _MADARA_PRINT_VISITOR_H_
 #define _MADARA_PRINT_VISITOR_H_
 
-#ifdef _USE_VISITORS_
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file PrintVisitor.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the PrintVisitor class, which prints an expression
+ * tree back into KaRL source
+ **/
+
+#include <string>
 
 #include "madara/expression/Visitor.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/MadaraExport.h"
 
 namespace madara
 {
 namespace expression
 {
+class ComponentNode;
+class CompositeArrayReference;
+class CompositeTernaryNode;
+
 /**
  * @class PrintVisitor
- * @brief This class serves as a visitor for printing the contents of
- *        nodes to @a std::cout.
+ * @brief Prints an expression tree as KaRL source. Operands that are
+ *        operators themselves are parenthesized, so the source does not
+ *        keep the original formatting, and for loops are printed in C
+ *        form. Nodes without a visit, e.g., parallel for loops, are
+ *        printed as their item.
  */
-
-class PrintVisitor : public Visitor
+class MADARA_EXPORT PrintVisitor : public Visitor
 {
 public:
   /**
-   * Prints a constant
-   * @param     node  the node to evaluate
+   * Constructor
    **/
-  virtual void visit(const LeafNode& node);
+  PrintVisitor();
 
   /**
-   * Prints a variable
-   * @param     node  the node to evaluate
+   * Prints a node and its children
+   * @param  node      the node to print
+   * @return the KaRL source of the node
    **/
+  std::string print(const ComponentNode* node);
+
+  /// Prints a LeafNode.
+  virtual void visit(const LeafNode& node);
+
+  /// Prints a CompositeConstArray.
+  virtual void visit(const CompositeConstArray& node);
+
+  /// Prints a CompositeArrayReference.
+  virtual void visit(const CompositeArrayReference& node);
+
+  /// Prints a VariableNode.
   virtual void visit(const VariableNode& node);
 
-  /**
-   * Prints a variable decrementer node
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a VariableDecrementNode.
   virtual void visit(const VariableDecrementNode& node);
 
-  /**
-   * Prints a variable divider node
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a VariableDivideNode.
   virtual void visit(const VariableDivideNode& node);
 
-  /**
-   * Prints a variable incrementer node
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a VariableIncrementNode.
   virtual void visit(const VariableIncrementNode& node);
 
-  /**
-   * Prints a variable multiplier node
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a VariableMultiplyNode.
   virtual void visit(const VariableMultiplyNode& node);
 
-  /**
-   * Prints a variable incrementer node
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a VariableCompareNode.
   virtual void visit(const VariableCompareNode& node);
 
-  /**
-   * Prints a list
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a ListNode.
   virtual void visit(const ListNode& node);
 
-  /**
-   * Prints an integer negation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeNegateNode.
   virtual void visit(const CompositeNegateNode& node);
 
-  /**
-   * Prints a predecrement
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositePostdecrementNode.
+  virtual void visit(const CompositePostdecrementNode& node);
+
+  /// Prints a CompositePostincrementNode.
+  virtual void visit(const CompositePostincrementNode& node);
+
+  /// Prints a CompositePredecrementNode.
   virtual void visit(const CompositePredecrementNode& node);
 
-  /**
-   * Prints a preincrement
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositePreincrementNode.
   virtual void visit(const CompositePreincrementNode& node);
 
-  /**
-   * Prints a logical not
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeSquareRootNode.
+  virtual void visit(const CompositeSquareRootNode& node);
+
+  /// Prints a CompositeNotNode.
   virtual void visit(const CompositeNotNode& node);
 
-  /**
-   * Prints an addition
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeAddNode.
   virtual void visit(const CompositeAddNode& node);
 
-  /**
-   * Prints an assignment to a variable
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeAssignmentNode.
   virtual void visit(const CompositeAssignmentNode& node);
 
-  /**
-   * Prints a logical and
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeAndNode.
   virtual void visit(const CompositeAndNode& node);
 
-  /**
-   * Prints a logical or
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeOrNode.
   virtual void visit(const CompositeOrNode& node);
 
-  /**
-   * Prints an equality operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeEqualityNode.
   virtual void visit(const CompositeEqualityNode& node);
 
-  /**
-   * Prints an inequality operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeInequalityNode.
   virtual void visit(const CompositeInequalityNode& node);
 
-  /**
-   * Prints a greater-than-or-equal-to operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeGreaterThanEqualNode.
   virtual void visit(const CompositeGreaterThanEqualNode& node);
 
-  /**
-   * Prints a less-than operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeGreaterThanNode.
   virtual void visit(const CompositeGreaterThanNode& node);
 
-  /**
-   * Prints a less-than-or-equal-to operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeLessThanEqualNode.
   virtual void visit(const CompositeLessThanEqualNode& node);
 
-  /**
-   * Prints a less-than operation
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeLessThanNode.
   virtual void visit(const CompositeLessThanNode& node);
 
-  /**
-   * Prints a subtraction
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeSubtractNode.
   virtual void visit(const CompositeSubtractNode& node);
 
-  /**
-   * Prints a division
-   * @param     node  the node to evaluate
-   **/
+  /// Prints a CompositeDivideNode.
   virtual void visit(const CompositeDivideNode& node);
 
+  /// Prints a CompositeMultiplyNode.
+  virtual void visit(const CompositeMultiplyNode& node);
+
+  /// Prints a CompositeModulusNode.
+  virtual void visit(const CompositeModulusNode& node);
+
+  /// Prints a CompositeBothNode.
+  virtual void visit(const CompositeBothNode& node);
+
+  /// Prints a CompositeReturnRightNode.
+  virtual void visit(const CompositeReturnRightNode& node);
+
+  /// Prints a CompositeSequentialNode.
+  virtual void visit(const CompositeSequentialNode& node);
+
+  /// Prints a CompositeFunctionNode.
+  virtual void visit(const CompositeFunctionNode& node);
+
+  /// Prints a CompositeForLoop.
+  virtual void visit(const CompositeForLoop& node);
+
+  /// Prints a CompositeImpliesNode.
+  virtual void visit(const CompositeImpliesNode& node);
+
+  /// Prints a SystemCallClearVariable.
+  virtual void visit(const SystemCallClearVariable& node);
+
+  /// Prints a SystemCallCos.
+  virtual void visit(const SystemCallCos& node);
+
+  /// Prints a SystemCallDeleteVariable.
+  virtual void visit(const SystemCallDeleteVariable& node);
+
+  /// Prints a SystemCallEval.
+  virtual void visit(const SystemCallEval& node);
+
+  /// Prints a SystemCallExpandEnv.
+  virtual void visit(const SystemCallExpandEnv& node);
+
+  /// Prints a SystemCallExpandStatement.
+  virtual void visit(const SystemCallExpandStatement& node);
+
+  /// Prints a SystemCallFragment.
+  virtual void visit(const SystemCallFragment& node);
+
+  /// Prints a SystemCallGeneric.
+  virtual void visit(const SystemCallGeneric& node);
+
+  /// Prints a SystemCallGetClock.
+  virtual void visit(const SystemCallGetClock& node);
+
+  /// Prints a SystemCallGetTime.
+  virtual void visit(const SystemCallGetTime& node);
+
+  /// Prints a SystemCallGetTimeSeconds.
+  virtual void visit(const SystemCallGetTimeSeconds& node);
+
+  /// Prints a SystemCallIsinf.
+  virtual void visit(const SystemCallIsinf& node);
+
+  /// Prints a SystemCallLogLevel.
+  virtual void visit(const SystemCallLogLevel& node);
+
+  /// Prints a SystemCallPow.
+  virtual void visit(const SystemCallPow& node);
+
+  /// Prints a SystemCallPrint.
+  virtual void visit(const SystemCallPrint& node);
+
+  /// Prints a SystemCallPrintSystemCalls.
+  virtual void visit(const SystemCallPrintSystemCalls& node);
+
+  /// Prints a SystemCallRandDouble.
+  virtual void visit(const SystemCallRandDouble& node);
+
+  /// Prints a SystemCallRandInt.
+  virtual void visit(const SystemCallRandInt& node);
+
+  /// Prints a SystemCallReadFile.
+  virtual void visit(const SystemCallReadFile& node);
+
+  /// Prints a SystemCallSetClock.
+  virtual void visit(const SystemCallSetClock& node);
+
+  /// Prints a SystemCallSin.
+  virtual void visit(const SystemCallSin& node);
+
+  /// Prints a SystemCallSize.
+  virtual void visit(const SystemCallSize& node);
+
+  /// Prints a SystemCallSleep.
+  virtual void visit(const SystemCallSleep& node);
+
+  /// Prints a SystemCallSqrt.
+  virtual void visit(const SystemCallSqrt& node);
+
+  /// Prints a SystemCallTan.
+  virtual void visit(const SystemCallTan& node);
+
+  /// Prints a SystemCallToBuffer.
+  virtual void visit(const SystemCallToBuffer& node);
+
+  /// Prints a SystemCallToDouble.
+  virtual void visit(const SystemCallToDouble& node);
+
+  /// Prints a SystemCallToDoubles.
+  virtual void visit(const SystemCallToDoubles& node);
+
+  /// Prints a SystemCallToHostDirs.
+  virtual void visit(const SystemCallToHostDirs& node);
+
+  /// Prints a SystemCallToInteger.
+  virtual void visit(const SystemCallToInteger& node);
+
+  /// Prints a SystemCallToIntegers.
+  virtual void visit(const SystemCallToIntegers& node);
+
+  /// Prints a SystemCallToString.
+  virtual void visit(const SystemCallToString& node);
+
+  /// Prints a SystemCallType.
+  virtual void visit(const SystemCallType& node);
+
+  /// Prints a SystemCallVadd.
+  virtual void visit(const SystemCallVadd& node);
+
+  /// Prints a SystemCallVclamp.
+  virtual void visit(const SystemCallVclamp& node);
+
+  /// Prints a SystemCallVdot.
+  virtual void visit(const SystemCallVdot& node);
+
+  /// Prints a SystemCallVmax.
+  virtual void visit(const SystemCallVmax& node);
+
+  /// Prints a SystemCallVmin.
+  virtual void visit(const SystemCallVmin& node);
+
+  /// Prints a SystemCallVmul.
+  virtual void visit(const SystemCallVmul& node);
+
+  /// Prints a SystemCallVscale.
+  virtual void visit(const SystemCallVscale& node);
+
+  /// Prints a SystemCallVsum.
+  virtual void visit(const SystemCallVsum& node);
+
+  /// Prints a SystemCallWriteFile.
+  virtual void visit(const SystemCallWriteFile& node);
+
+  /// Prints a SystemCallSetFixed.
+  virtual void visit(const SystemCallSetFixed& node);
+
+  /// Prints a SystemCallSetPrecision.
+  virtual void visit(const SystemCallSetPrecision& node);
+
+  /// Prints a SystemCallSetScientific.
+  virtual void visit(const SystemCallSetScientific& node);
+
+  /// No-op destructor
+  virtual ~PrintVisitor(void);
+
+private:
   /**
-   * Prints a multiplication
-   * @param     node  the node to evaluate
+   * Prints a node that is an operand of another operator
+   * @param  node      the operand
+   * @return the source, parenthesized if the operand is an operator
    **/
-  virtual void visit(const CompositeMultiplyNode& node);
+  std::string operand(const ComponentNode* node);
 
   /**
-   * Prints a remainder operation
-   * @param     node  the node to evaluate
+   * Sets the source of the node being visited
+   * @param  source    the source
+   * @param  atomic    true if the source never needs parentheses
    **/
-  virtual void visit(const CompositeModulusNode& node);
+  void emit(const std::string& source, bool atomic);
 
   /**
-   * Prints a left and right expression
-   * @param     node  the node to evaluate
+   * Prints a prefix or postfix unary operator
+   * @param  op        the operator
+   * @param  node      the operand
+   * @param  prefix    true if the operator comes before the operand
    **/
-  virtual void visit(const CompositeBothNode& node);
+  void unary(const std::string& op, const ComponentNode* node, bool prefix);
 
   /**
-   * Prints a left and right expression
-   * @param     node  the node to evaluate
+   * Prints a binary operator
+   * @param  op        the operator
+   * @param  node      the node with left and right operands
    **/
-  virtual void visit(const CompositeSequentialNode& node);
+  void binary(const std::string& op, const ComponentNode& node);
 
   /**
-   * Prints a function
-   * @param     node  the node to evaluate
+   * Prints the operands of an n-ary operator separated by the operator
+   * @param  op        the operator
+   * @param  node      the node with the operands
+   * @param  nested    true if operators as operands need parentheses,
+   *                   false for sequences, which bind the loosest
    **/
-  virtual void visit(const CompositeFunctionNode& node);
+  void list(const std::string& op, const CompositeTernaryNode& node,
+      bool nested = true);
 
   /**
-   * Prints a for loop
-   * @param     node  the node to evaluate
+   * Prints a system call
+   * @param  name      the name of the call, including the #
+   * @param  node      the node with the arguments
    **/
-  virtual void visit(const CompositeForLoop& node);
+  void call(const std::string& name, const CompositeTernaryNode& node);
 
   /**
-   * Prints an inference rule
-   * @param     node  the node to evaluate
+   * Prints an operator that changes a variable or array index
+   * @param  variable  the variable, or 0 for an array index
+   * @param  array     the array index, or 0 for a variable
+   * @param  op        the operator
+   * @param  rhs       the right hand side, or 0 to print value
+   * @param  value     the constant right hand side
    **/
-  virtual void visit(const CompositeImpliesNode& node);
+  void modify(const VariableNode* variable,
+      const CompositeArrayReference* array, const std::string& op,
+      const ComponentNode* rhs, const knowledge::KnowledgeRecord& value);
+
+  /// the source of the last node printed
+  std::string result_;
+
+  /// true if result_ does not need parentheses as an operand
+  bool atomic_;
+
+  /// true if the last node accepted had a visit
+  bool visited_;
 };
 }
 }
 
-#endif  // _USE_VISITORS_
+#endif  // _MADARA_NO_KARL_
 
-#endif /* _MADARA_PRINT_VISITOR_H_ */
+#endif  // _MADARA_PRINT_VISITOR_H_
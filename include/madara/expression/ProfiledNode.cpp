@@ -0,0 +1,176 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_PROFILED_NODE_CPP_
+#define _MADARA_PROFILED_NODE_CPP_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <chrono>
+
+#include "madara/expression/ProfiledNode.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Returns the nanoseconds this thread has spent in profiled children of
+ * the node it is evaluating
+ **/
+uint64_t& child_time(void)
+{
+  static thread_local uint64_t time = 0;
+  return time;
+}
+
+/**
+ * Records an evaluation when it finishes, even by exception
+ **/
+class Sample
+{
+public:
+  Sample(std::atomic<uint64_t>& calls, std::atomic<uint64_t>& inclusive,
+      std::atomic<uint64_t>& exclusive)
+    : calls_(calls),
+      inclusive_(inclusive),
+      exclusive_(exclusive),
+      outer_(child_time()),
+      start_(Clock::now())
+  {
+    child_time() = 0;
+  }
+
+  ~Sample()
+  {
+    uint64_t elapsed =
+        (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start_)
+            .count();
+    uint64_t children = child_time();
+
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    inclusive_.fetch_add(elapsed, std::memory_order_relaxed);
+    exclusive_.fetch_add(
+        elapsed > children ? elapsed - children : 0, std::memory_order_relaxed);
+
+    // the parent's children include all of this node
+    child_time() = outer_ + elapsed;
+  }
+
+private:
+  std::atomic<uint64_t>& calls_;
+  std::atomic<uint64_t>& inclusive_;
+  std::atomic<uint64_t>& exclusive_;
+  uint64_t outer_;
+  Clock::time_point start_;
+};
+}
+}
+}
+
+madara::expression::ProfiledNode::ProfiledNode(
+    logger::Logger& logger, ComponentNode* node, bool owned)
+  : ComponentNode(logger),
+    profiles(1),
+    node_(node),
+    owned_(owned),
+    calls_(0),
+    inclusive_(0),
+    exclusive_(0)
+{
+}
+
+madara::expression::ProfiledNode::~ProfiledNode(void)
+{
+  if (owned_)
+    delete node_;
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::ProfiledNode::item(
+    void) const
+{
+  return node_->item();
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::ProfiledNode::prune(
+    bool& can_change)
+{
+  return node_->prune(can_change);
+}
+
+madara::knowledge::KnowledgeRecord madara::expression::ProfiledNode::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  Sample sample(calls_, inclusive_, exclusive_);
+  return node_->evaluate(settings);
+}
+
+madara::expression::ComponentNode* madara::expression::ProfiledNode::left(
+    void) const
+{
+  return node_->left();
+}
+
+madara::expression::ComponentNode* madara::expression::ProfiledNode::right(
+    void) const
+{
+  return node_->right();
+}
+
+void madara::expression::ProfiledNode::accept(Visitor& visitor) const
+{
+  node_->accept(visitor);
+}
+
+void madara::expression::ProfiledNode::compile(Bytecode& program)
+{
+  node_->compile(program);
+}
+
+void madara::expression::ProfiledNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&node_);
+}
+
+madara::expression::ComponentNode* madara::expression::ProfiledNode::get_node(
+    void) const
+{
+  return node_;
+}
+
+madara::expression::ComponentNode* madara::expression::ProfiledNode::release(
+    void)
+{
+  owned_ = false;
+  return node_;
+}
+
+uint64_t madara::expression::ProfiledNode::calls(void) const
+{
+  return calls_.load(std::memory_order_relaxed);
+}
+
+uint64_t madara::expression::ProfiledNode::inclusive_ns(void) const
+{
+  return inclusive_.load(std::memory_order_relaxed);
+}
+
+uint64_t madara::expression::ProfiledNode::exclusive_ns(void) const
+{
+  return exclusive_.load(std::memory_order_relaxed);
+}
+
+void madara::expression::ProfiledNode::reset(void)
+{
+  calls_.store(0, std::memory_order_relaxed);
+  inclusive_.store(0, std::memory_order_relaxed);
+  exclusive_.store(0, std::memory_order_relaxed);
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_PROFILED_NODE_CPP_ */
@@ -0,0 +1,162 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_PROFILED_NODE_H_
+#define _MADARA_PROFILED_NODE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file ProfiledNode.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the ProfiledNode class, which counts the evaluations
+ * of the node it wraps and the time spent in them
+ **/
+
+#include <atomic>
+#include <vector>
+
+#include "madara/expression/ComponentNode.h"
+#include "madara/utility/StdInt.h"
+
+namespace madara
+{
+namespace expression
+{
+/**
+ * @class ProfiledNode
+ * @brief Wraps a node of a profiled expression tree, counting its
+ *        evaluations, the nanoseconds spent in them (inclusive), and the
+ *        nanoseconds not spent in profiled children (exclusive). Every
+ *        other operation is passed through, so parents and visitors see
+ *        the wrapped node.
+ *
+ * @see   ExpressionProfile, which inserts and removes the wrappers
+ */
+class ProfiledNode : public ComponentNode
+{
+public:
+  /**
+   * Constructor
+   * @param  logger   the logger to use for printing
+   * @param  node     the node to wrap
+   * @param  owned    true if the wrapper deletes the node
+   **/
+  ProfiledNode(logger::Logger& logger, ComponentNode* node, bool owned = true);
+
+  /**
+   * Destructor
+   **/
+  virtual ~ProfiledNode(void);
+
+  /**
+   * Returns the value of the wrapped node
+   * @return    value of the node
+   **/
+  virtual madara::knowledge::KnowledgeRecord item(void) const;
+
+  /**
+   * Prunes the wrapped node
+   * @param     can_change   set to true if variable nodes are contained
+   * @return    value of current contained expression tree
+   **/
+  virtual madara::knowledge::KnowledgeRecord prune(bool& can_change);
+
+  /**
+   * Evaluates the wrapped node, recording the call and its time
+   * @param     settings     settings for evaluating the node
+   * @return    value of current contained expression tree
+   **/
+  virtual madara::knowledge::KnowledgeRecord evaluate(
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Returns the left expression of the wrapped node
+   * @return    a pointer to the left expression
+   **/
+  virtual ComponentNode* left(void) const;
+
+  /**
+   * Returns the right expression of the wrapped node
+   * @return    a pointer to the right expression
+   **/
+  virtual ComponentNode* right(void) const;
+
+  /**
+   * Passes a visitor to the wrapped node
+   * @param    visitor   visitor instance to use
+   **/
+  virtual void accept(Visitor& visitor) const;
+
+  /**
+   * Lowers the wrapped node into bytecode. Bytecode is not profiled.
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
+  /**
+   * Returns the slot of the wrapped node
+   * @param     children     the list to append the slot to
+   **/
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
+  /**
+   * Returns the wrapped node
+   * @return    the node
+   **/
+  ComponentNode* get_node(void) const;
+
+  /**
+   * Stops owning the wrapped node
+   * @return    the node, which the caller now owns
+   **/
+  ComponentNode* release(void);
+
+  /**
+   * Returns the number of evaluations
+   * @return    the number of completed evaluations
+   **/
+  uint64_t calls(void) const;
+
+  /**
+   * Returns the time spent evaluating the node and its children
+   * @return    the time in nanoseconds
+   **/
+  uint64_t inclusive_ns(void) const;
+
+  /**
+   * Returns the time spent evaluating the node, but not in profiled
+   * children
+   * @return    the time in nanoseconds
+   **/
+  uint64_t exclusive_ns(void) const;
+
+  /**
+   * Sets the counts and times back to zero
+   **/
+  void reset(void);
+
+  /// the number of profiles that share the wrapper
+  size_t profiles;
+
+private:
+  /// the wrapped node
+  ComponentNode* node_;
+
+  /// true if the wrapper deletes the node
+  bool owned_;
+
+  /// the number of completed evaluations
+  std::atomic<uint64_t> calls_;
+
+  /// nanoseconds spent in the node and its children
+  std::atomic<uint64_t> inclusive_;
+
+  /// nanoseconds spent in the node, but not in profiled children
+  std::atomic<uint64_t> exclusive_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_PROFILED_NODE_H_ */
@@ -267,6 +267,43 @@ madara::expression::SystemCallPrintSystemCalls::prune(bool& can_change)
                       "    DOUBLE_ARRAY = 128\n"
                       "    IMAGE_JPEG = 256\n";
 
+    calls_["#vadd"] =
+        "\n#vadd (target, array, value):\n"
+        "  Adds value, which is an array or a number, to the elements of\n"
+        "  array and stores the result in the variable target. Returns the\n"
+        "  number of elements written. Results are doubles if any argument\n"
+        "  is a double. Arrays of different sizes are cut to the shortest.\n";
+
+    calls_["#vclamp"] =
+        "\n#vclamp (target, array, low, high):\n"
+        "  Stores the elements of array, limited to [low, high], in the\n"
+        "  variable target. Returns the number of elements written.\n";
+
+    calls_["#vdot"] = "\n#vdot (array1, array2):\n"
+                      "  Returns the dot product of two arrays.\n";
+
+    calls_["#vmax"] =
+        "\n#vmax (array):\n"
+        "  Returns the largest element of array, or nothing if empty.\n";
+
+    calls_["#vmin"] =
+        "\n#vmin (array):\n"
+        "  Returns the smallest element of array, or nothing if empty.\n";
+
+    calls_["#vmul"] =
+        "\n#vmul (target, array, value):\n"
+        "  Multiplies the elements of array by value, which is an array or\n"
+        "  a number, and stores the result in the variable target. @see\n"
+        "  #vadd.\n";
+
+    calls_["#vscale"] =
+        "\n#vscale (target, array, factor):\n"
+        "  Multiplies the elements of array by a number and stores the\n"
+        "  result in the variable target. @see #vadd.\n";
+
+    calls_["#vsum"] = "\n#vsum (array):\n"
+                      "  Returns the sum of the elements of array.\n";
+
     calls_["#write_file"] =
         "\n#write_file (filename, value):\n"
         "  Writes the value to a file. Supports all MADARA types.\n"
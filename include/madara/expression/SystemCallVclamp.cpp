@@ -0,0 +1,41 @@
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/SystemCallVclamp.h"
+#include "madara/expression/Visitor.h"
+
+madara::expression::SystemCallVclamp::SystemCallVclamp(
+    madara::knowledge::ThreadSafeContext& context, const ComponentNodes& nodes)
+  : SystemCallVectorNode(context, nodes, "#vclamp")
+{
+}
+
+// Dtor
+madara::expression::SystemCallVclamp::~SystemCallVclamp(void) {}
+
+/// Prune the tree of unnecessary nodes.
+/// Returns evaluation of the node and sets can_change appropriately.
+/// if this node can be changed, that means it shouldn't be pruned.
+madara::knowledge::KnowledgeRecord madara::expression::SystemCallVclamp::prune(
+    bool& can_change)
+{
+  return prune_arguments(can_change, 4, true);
+}
+
+/// Evaluates the node and its children. This does not prune any of
+/// the expression tree, and is much faster than the prune function
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVclamp::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  return evaluate_elementwise(CLAMP, settings);
+}
+
+// accept a visitor
+void madara::expression::SystemCallVclamp::accept(
+    madara::expression::Visitor& visitor) const
+{
+  visitor.visit(*this);
+}
+
+#endif  // _MADARA_NO_KARL_
@@ -0,0 +1,488 @@
+
+#ifndef _MADARA_NO_KARL_
+
+#include <algorithm>
+#include <sstream>
+
+#include "madara/expression/LeafNode.h"
+#include "madara/expression/SystemCallVectorNode.h"
+#include "madara/expression/VariableNode.h"
+#include "madara/expression/Visitor.h"
+
+namespace madara
+{
+namespace expression
+{
+namespace
+{
+typedef knowledge::KnowledgeRecord::Integer Integer;
+
+/**
+ * An argument of a vector call. Arrays are read in place from the record
+ * that holds them.
+ **/
+struct Operand
+{
+  /// the record the argument was read from
+  const knowledge::KnowledgeRecord* source = nullptr;
+
+  /// holds arguments that are not variables, or copies of variables
+  /// that the call is about to overwrite
+  knowledge::KnowledgeRecord value;
+
+  /// the elements, if the argument is an INTEGER_ARRAY
+  const Integer* integers = nullptr;
+
+  /// the elements, if the argument is a DOUBLE_ARRAY
+  const double* doubles = nullptr;
+
+  /// the number of elements
+  size_t size = 0;
+
+  /// true if the argument is an array
+  bool array = false;
+
+  /// true if the argument is a double or an array of doubles
+  bool is_double = false;
+
+  void scalar(Integer& result) const
+  {
+    result = source->to_integer();
+  }
+
+  void scalar(double& result) const
+  {
+    result = source->to_double();
+  }
+
+  /**
+   * Points the elements at the source's arrays
+   **/
+  void view(void)
+  {
+    integers = nullptr;
+    doubles = nullptr;
+    size = 0;
+    array = true;
+
+    const std::vector<Integer>* ints = source->peek_integers();
+    const std::vector<double>* reals = source->peek_doubles();
+
+    if (ints)
+    {
+      integers = ints->data();
+      size = ints->size();
+    }
+    else if (reals)
+    {
+      doubles = reals->data();
+      size = reals->size();
+    }
+    else
+    {
+      array = false;
+    }
+  }
+
+  /**
+   * Keeps the elements alive, and unchanged, while the source is written
+   **/
+  void keep(void)
+  {
+    if (source != &value)
+    {
+      // a record with history may drop its newest entry when written
+      value = source->has_history() ? source->get_newest() : *source;
+      source = &value;
+      view();
+    }
+  }
+};
+
+/**
+ * Reads an argument of a vector call
+ * @param  node      the argument
+ * @param  settings  settings for evaluating the argument
+ * @param  array     true to convert scalars into arrays of one element
+ * @param  operand   the argument that was read
+ **/
+void read(ComponentNode* node,
+    const knowledge::KnowledgeUpdateSettings& settings, bool array,
+    Operand& operand)
+{
+  VariableNode* variable = dynamic_cast<VariableNode*>(node);
+
+  if (variable)
+  {
+    operand.source = variable->get_record();
+  }
+  else
+  {
+    operand.value = node->evaluate(settings);
+    operand.source = &operand.value;
+  }
+
+  operand.is_double = operand.source->is_double_type();
+  operand.view();
+
+  if (array && !operand.array)
+  {
+    if (operand.is_double)
+    {
+      knowledge::KnowledgeRecord converted(operand.source->to_doubles());
+      operand.value = std::move(converted);
+    }
+    else
+    {
+      knowledge::KnowledgeRecord converted(operand.source->to_integers());
+      operand.value = std::move(converted);
+    }
+
+    operand.source = &operand.value;
+    operand.view();
+  }
+}
+
+/*
+ * The kernels are plain loops over contiguous elements, which compilers
+ * turn into SIMD instructions. Reductions keep independent partial
+ * results so the additions do not all wait on one another, so sums of
+ * doubles may differ in the last bits from adding the elements in order.
+ */
+
+template<typename T, typename A, typename B>
+void add(T* out, const A* a, const B* b, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    out[i] = (T)a[i] + (T)b[i];
+}
+
+template<typename T, typename A>
+void add(T* out, const A* a, T b, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    out[i] = (T)a[i] + b;
+}
+
+template<typename T, typename A, typename B>
+void multiply(T* out, const A* a, const B* b, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    out[i] = (T)a[i] * (T)b[i];
+}
+
+template<typename T, typename A>
+void multiply(T* out, const A* a, T b, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    out[i] = (T)a[i] * b;
+}
+
+template<typename T, typename A>
+void clamp(T* out, const A* a, T low, T high, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    T value = (T)a[i];
+    value = value < low ? low : value;
+    out[i] = value > high ? high : value;
+  }
+}
+
+template<typename T, typename A, typename B>
+T dot(const A* a, const B* b, size_t size)
+{
+  T sums[4] = {0, 0, 0, 0};
+  size_t i = 0;
+
+  for (; i + 4 <= size; i += 4)
+  {
+    sums[0] += (T)a[i] * (T)b[i];
+    sums[1] += (T)a[i + 1] * (T)b[i + 1];
+    sums[2] += (T)a[i + 2] * (T)b[i + 2];
+    sums[3] += (T)a[i + 3] * (T)b[i + 3];
+  }
+
+  for (; i < size; ++i)
+    sums[0] += (T)a[i] * (T)b[i];
+
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+template<typename T>
+T sum(const T* a, size_t size)
+{
+  T sums[4] = {0, 0, 0, 0};
+  size_t i = 0;
+
+  for (; i + 4 <= size; i += 4)
+  {
+    sums[0] += a[i];
+    sums[1] += a[i + 1];
+    sums[2] += a[i + 2];
+    sums[3] += a[i + 3];
+  }
+
+  for (; i < size; ++i)
+    sums[0] += a[i];
+
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+template<typename T>
+T minimum(const T* a, size_t size)
+{
+  T result = a[0];
+
+  for (size_t i = 1; i < size; ++i)
+    result = a[i] < result ? a[i] : result;
+
+  return result;
+}
+
+template<typename T>
+T maximum(const T* a, size_t size)
+{
+  T result = a[0];
+
+  for (size_t i = 1; i < size; ++i)
+    result = a[i] > result ? a[i] : result;
+
+  return result;
+}
+
+/**
+ * Applies an element-wise operation once the type of a is known
+ * @param  first   b as a number, if it is not an array
+ * @param  second  c as a number
+ **/
+template<typename T, typename A>
+void elementwise(SystemCallVectorNode::Operation operation, T* out,
+    const A* a, const Operand& b, T first, T second, size_t size)
+{
+  switch (operation)
+  {
+    case SystemCallVectorNode::ADD:
+      if (b.integers)
+        add(out, a, b.integers, size);
+      else if (b.doubles)
+        add(out, a, b.doubles, size);
+      else
+        add(out, a, first, size);
+      break;
+    case SystemCallVectorNode::MULTIPLY:
+      if (b.integers)
+        multiply(out, a, b.integers, size);
+      else if (b.doubles)
+        multiply(out, a, b.doubles, size);
+      else
+        multiply(out, a, first, size);
+      break;
+    case SystemCallVectorNode::SCALE:
+      multiply(out, a, first, size);
+      break;
+    default:
+      clamp(out, a, first, second, size);
+      break;
+  }
+}
+
+/**
+ * Computes a dot product once the type of a is known
+ **/
+template<typename T, typename A>
+T dot_operand(const A* a, const Operand& b, size_t size)
+{
+  return b.integers ? dot<T>(a, b.integers, size) : dot<T>(a, b.doubles, size);
+}
+}
+}
+}
+
+madara::expression::SystemCallVectorNode::SystemCallVectorNode(
+    madara::knowledge::ThreadSafeContext& context, const ComponentNodes& nodes,
+    const char* name)
+  : SystemCallNode(context, nodes), name_(name)
+{
+}
+
+// Dtor
+madara::expression::SystemCallVectorNode::~SystemCallVectorNode(void) {}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVectorNode::item(void) const
+{
+  return madara::knowledge::KnowledgeRecord(nodes_.size());
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVectorNode::prune_arguments(
+    bool& can_change, size_t count, bool writes)
+{
+  // the arrays in variables can always change
+  can_change = true;
+
+  if (nodes_.size() != count ||
+      (writes && dynamic_cast<VariableNode*>(nodes_[0]) == 0))
+  {
+    std::stringstream buffer;
+    buffer << "madara::expression::SystemCallVectorNode: "
+              "KARL COMPILE ERROR: System call "
+           << name_ << " requires " << count << " argument"
+           << (count > 1 ? "s" : "");
+
+    if (writes)
+      buffer << ", the first of which is the variable to write";
+
+    buffer << "\n";
+
+    madara_logger_ptr_log(
+        logger_, logger::LOG_ERROR, "%s", buffer.str().c_str());
+
+    throw exceptions::KarlException(buffer.str());
+  }
+
+  for (size_t i = writes ? 1 : 0; i < nodes_.size(); ++i)
+  {
+    bool arg_can_change = false;
+    knowledge::KnowledgeRecord result = nodes_[i]->prune(arg_can_change);
+
+    if (!arg_can_change && dynamic_cast<LeafNode*>(nodes_[i]) == 0)
+    {
+      delete nodes_[i];
+      nodes_[i] = new LeafNode(*(this->logger_), result);
+    }
+  }
+
+  return knowledge::KnowledgeRecord();
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVectorNode::evaluate_elementwise(
+    Operation operation,
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  bool pairwise = operation == ADD || operation == MULTIPLY;
+  Operand a, b, c;
+
+  // a scalar second argument is applied to every element
+  read(nodes_[1], settings, true, a);
+  read(nodes_[2], settings, false, b);
+
+  if (operation == CLAMP)
+    read(nodes_[3], settings, false, c);
+
+  // prune made sure the first argument is a variable
+  VariableNode* target = static_cast<VariableNode*>(nodes_[0]);
+  knowledge::KnowledgeRecord* record = target->get_record();
+
+  // notice that we assume the context is locked
+  // check if we have the appropriate write quality
+  if (!settings.always_overwrite && record->write_quality < record->quality)
+  {
+    return knowledge::KnowledgeRecord(Integer(0));
+  }
+
+  if (record->write_quality != record->quality)
+    record->quality = record->write_quality;
+
+  bool doubles = a.is_double || b.is_double || c.is_double;
+  size_t size = pairwise && b.array ? std::min(a.size, b.size) : a.size;
+
+  // the record keeps its array, and is written in place, only if it
+  // already holds an array of the result's type
+  if (record->has_history() ||
+      record->type() != (doubles ? knowledge::KnowledgeRecord::DOUBLE_ARRAY
+                                 : knowledge::KnowledgeRecord::INTEGER_ARRAY))
+  {
+    if (a.source == record)
+      a.keep();
+    if (b.source == record)
+      b.keep();
+    if (c.source == record)
+      c.keep();
+  }
+
+  madara_logger_ptr_log(logger_, logger::LOG_MINOR,
+      "madara::expression::SystemCallVectorNode: "
+      "System call %s is writing %d elements to %s\n",
+      name_, (int)size, target->key().c_str());
+
+  if (doubles)
+  {
+    double first = 0, second = 0;
+    b.scalar(first);
+    if (operation == CLAMP)
+      c.scalar(second);
+
+    double* out = record->resize_doubles(size).data();
+
+    if (a.integers)
+      elementwise(operation, out, a.integers, b, first, second, size);
+    else
+      elementwise(operation, out, a.doubles, b, first, second, size);
+  }
+  else
+  {
+    Integer first = 0, second = 0;
+    b.scalar(first);
+    if (operation == CLAMP)
+      c.scalar(second);
+
+    Integer* out = record->resize_integers(size).data();
+    elementwise(operation, out, a.integers, b, first, second, size);
+  }
+
+  target->mark_modified(settings);
+
+  return knowledge::KnowledgeRecord(Integer(size));
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVectorNode::evaluate_reduction(
+    Operation operation,
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  Operand a, b;
+
+  read(nodes_[0], settings, true, a);
+
+  if (operation == DOT)
+  {
+    read(nodes_[1], settings, true, b);
+
+    size_t size = std::min(a.size, b.size);
+
+    if (a.is_double || b.is_double)
+    {
+      return knowledge::KnowledgeRecord(
+          a.integers ? dot_operand<double>(a.integers, b, size)
+                     : dot_operand<double>(a.doubles, b, size));
+    }
+
+    return knowledge::KnowledgeRecord(
+        dot_operand<Integer>(a.integers, b, size));
+  }
+
+  if (operation == SUM)
+  {
+    return a.is_double ? knowledge::KnowledgeRecord(sum(a.doubles, a.size))
+                       : knowledge::KnowledgeRecord(sum(a.integers, a.size));
+  }
+
+  if (a.size == 0)
+    return knowledge::KnowledgeRecord();
+
+  if (operation == MIN)
+  {
+    return a.is_double
+               ? knowledge::KnowledgeRecord(minimum(a.doubles, a.size))
+               : knowledge::KnowledgeRecord(minimum(a.integers, a.size));
+  }
+
+  return a.is_double
+             ? knowledge::KnowledgeRecord(maximum(a.doubles, a.size))
+             : knowledge::KnowledgeRecord(maximum(a.integers, a.size));
+}
+
+#endif  // _MADARA_NO_KARL_
@@ -0,0 +1,105 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_SYSTEM_CALL_VECTOR_NODE_H_
+#define _MADARA_SYSTEM_CALL_VECTOR_NODE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <string>
+#include <stdexcept>
+#include "madara/utility/StdInt.h"
+#include "madara/expression/SystemCallNode.h"
+
+namespace madara
+{
+namespace expression
+{
+/**
+ * @class SystemCallVectorNode
+ * @brief Base class for system calls that do arithmetic over whole
+ *        INTEGER_ARRAY and DOUBLE_ARRAY records, e.g., #vadd and #vsum.
+ *
+ *        Arrays held by variables are read from the context without
+ *        copying them, and arrays are written into the target variable's
+ *        record, reusing its storage if no other record shares it. Results
+ *        are doubles if any argument is a double, and integers otherwise.
+ *        Arrays of different sizes are truncated to the shortest.
+ */
+class SystemCallVectorNode : public SystemCallNode
+{
+public:
+  /**
+   * Constructor
+   * @param   context   the context that holds the variables
+   * @param   nodes     the arguments of the call
+   * @param   name      the name of the call, e.g., "#vadd"
+   **/
+  SystemCallVectorNode(madara::knowledge::ThreadSafeContext& context,
+      const ComponentNodes& nodes, const char* name);
+
+  /**
+   * Destructor
+   **/
+  virtual ~SystemCallVectorNode(void);
+
+  /**
+   * Returns the value of the node
+   * @return    value of the node
+   **/
+  virtual madara::knowledge::KnowledgeRecord item(void) const;
+
+  /// The arithmetic done by a call
+  enum Operation
+  {
+    ADD,
+    MULTIPLY,
+    SCALE,
+    CLAMP,
+    DOT,
+    SUM,
+    MIN,
+    MAX
+  };
+
+protected:
+  /**
+   * Checks the arguments and prunes the ones that cannot change
+   * @param     can_change   set to true, since the call reads variables
+   * @param     count        the number of arguments the call requires
+   * @param     writes       true if the first argument is the variable
+   *                         the call writes
+   * @return    an empty record
+   **/
+  madara::knowledge::KnowledgeRecord prune_arguments(
+      bool& can_change, size_t count, bool writes);
+
+  /**
+   * Writes the result of an element-wise operation into the variable
+   * named by the first argument
+   * @param     operation    ADD, MULTIPLY, SCALE or CLAMP
+   * @param     settings     settings for evaluating and writing
+   * @return    the number of elements written
+   **/
+  madara::knowledge::KnowledgeRecord evaluate_elementwise(
+      Operation operation,
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Reduces the arguments to a single number
+   * @param     operation    DOT, SUM, MIN or MAX
+   * @param     settings     settings for evaluating the arguments
+   * @return    the result, or an empty record for the MIN or MAX of an
+   *            empty array
+   **/
+  madara::knowledge::KnowledgeRecord evaluate_reduction(
+      Operation operation,
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /// the name of the call, for error messages
+  const char* name_;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_SYSTEM_CALL_VECTOR_NODE_H_ */
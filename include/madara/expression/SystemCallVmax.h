@@ -0,0 +1,59 @@
+/* -*- C++ -*- */
+#ifndef _MADARA_SYSTEM_CALL_VMAX_H_
+#define _MADARA_SYSTEM_CALL_VMAX_H_
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/SystemCallVectorNode.h"
+
+namespace madara
+{
+namespace expression
+{
+// Forward declaration.
+class Visitor;
+
+/**
+ * @class SystemCallVmax
+ * @brief Returns the largest element of an array
+ */
+class SystemCallVmax : public SystemCallVectorNode
+{
+public:
+  /**
+   * Constructor
+   **/
+  SystemCallVmax(madara::knowledge::ThreadSafeContext& context,
+      const ComponentNodes& nodes);
+
+  /**
+   * Destructor
+   **/
+  virtual ~SystemCallVmax(void);
+
+  /**
+   * Prunes the expression tree of unnecessary nodes.
+   * @param     can_change   set to true if variable nodes are contained
+   * @return    value of current contained expression tree
+   **/
+  virtual madara::knowledge::KnowledgeRecord prune(bool& can_change);
+
+  /**
+   * Evaluates the expression tree.
+   * @return    value of current contained expression tree
+   **/
+  virtual madara::knowledge::KnowledgeRecord evaluate(
+      const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+  /**
+   * Accepts a visitor subclassed from the Visitor class
+   * @param    visitor   visitor instance to use
+   **/
+  virtual void accept(Visitor& visitor) const;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif /* _MADARA_SYSTEM_CALL_VMAX_H_ */
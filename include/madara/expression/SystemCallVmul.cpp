@@ -0,0 +1,40 @@
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/SystemCallVmul.h"
+#include "madara/expression/Visitor.h"
+
+madara::expression::SystemCallVmul::SystemCallVmul(
+    madara::knowledge::ThreadSafeContext& context, const ComponentNodes& nodes)
+  : SystemCallVectorNode(context, nodes, "#vmul")
+{
+}
+
+// Dtor
+madara::expression::SystemCallVmul::~SystemCallVmul(void) {}
+
+/// Prune the tree of unnecessary nodes.
+/// Returns evaluation of the node and sets can_change appropriately.
+/// if this node can be changed, that means it shouldn't be pruned.
+madara::knowledge::KnowledgeRecord madara::expression::SystemCallVmul::prune(
+    bool& can_change)
+{
+  return prune_arguments(can_change, 3, true);
+}
+
+/// Evaluates the node and its children. This does not prune any of
+/// the expression tree, and is much faster than the prune function
+madara::knowledge::KnowledgeRecord madara::expression::SystemCallVmul::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  return evaluate_elementwise(MULTIPLY, settings);
+}
+
+// accept a visitor
+void madara::expression::SystemCallVmul::accept(
+    madara::expression::Visitor& visitor) const
+{
+  visitor.visit(*this);
+}
+
+#endif  // _MADARA_NO_KARL_
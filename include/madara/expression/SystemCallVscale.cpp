@@ -0,0 +1,41 @@
+
+#ifndef _MADARA_NO_KARL_
+
+#include "madara/expression/SystemCallVscale.h"
+#include "madara/expression/Visitor.h"
+
+madara::expression::SystemCallVscale::SystemCallVscale(
+    madara::knowledge::ThreadSafeContext& context, const ComponentNodes& nodes)
+  : SystemCallVectorNode(context, nodes, "#vscale")
+{
+}
+
+// Dtor
+madara::expression::SystemCallVscale::~SystemCallVscale(void) {}
+
+/// Prune the tree of unnecessary nodes.
+/// Returns evaluation of the node and sets can_change appropriately.
+/// if this node can be changed, that means it shouldn't be pruned.
+madara::knowledge::KnowledgeRecord madara::expression::SystemCallVscale::prune(
+    bool& can_change)
+{
+  return prune_arguments(can_change, 3, true);
+}
+
+/// Evaluates the node and its children. This does not prune any of
+/// the expression tree, and is much faster than the prune function
+madara::knowledge::KnowledgeRecord
+madara::expression::SystemCallVscale::evaluate(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  return evaluate_elementwise(SCALE, settings);
+}
+
+// accept a visitor
+void madara::expression::SystemCallVscale::accept(
+    madara::expression::Visitor& visitor) const
+{
+  visitor.visit(*this);
+}
+
+#endif  // _MADARA_NO_KARL_
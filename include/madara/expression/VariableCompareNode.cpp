@@ -159,4 +159,39 @@ KnowledgeRecord madara::expression::VariableCompareNode::evaluate(
   return knowledge::KnowledgeRecord(result);
 }
 
+madara::expression::VariableNode*
+madara::expression::VariableCompareNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::VariableCompareNode::get_array(void) const
+{
+  return array_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::VariableCompareNode::get_rhs(void) const
+{
+  return rhs_;
+}
+
+const madara::knowledge::KnowledgeRecord&
+madara::expression::VariableCompareNode::get_value(void) const
+{
+  return value_;
+}
+
+int madara::expression::VariableCompareNode::get_compare_type(void) const
+{
+  return compare_type_;
+}
+
+void madara::expression::VariableCompareNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&rhs_);
+}
+
 #endif  // _MADARA_NO_KARL_
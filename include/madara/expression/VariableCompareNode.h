@@ -70,6 +70,24 @@ public:
   /// Define the @a accept() operation used for the Visitor pattern.
   virtual void accept(Visitor& visitor) const;
 
+  /// Return the variable the node compares, or 0 for an array index.
+  VariableNode* get_variable(void) const;
+
+  /// Return the array index the node compares, or 0 for a variable.
+  CompositeArrayReference* get_array(void) const;
+
+  /// Return the right hand side, or 0 if the node uses a constant.
+  ComponentNode* get_rhs(void) const;
+
+  /// Return the constant right hand side, used if get_rhs returns 0.
+  const madara::knowledge::KnowledgeRecord& get_value(void) const;
+
+  /// Return the comparison, one of Comparators.
+  int get_compare_type(void) const;
+
+  /// Append the slot of the right hand side to children.
+  virtual void get_children(std::vector<ComponentNode**>& children);
+
 private:
   /// variable holder
   VariableNode* var_;
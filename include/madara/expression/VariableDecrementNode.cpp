@@ -144,4 +144,34 @@ madara::expression::VariableDecrementNode::evaluate(
   return rhs;
 }
 
+madara::expression::VariableNode*
+madara::expression::VariableDecrementNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::VariableDecrementNode::get_array(void) const
+{
+  return array_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::VariableDecrementNode::get_rhs(void) const
+{
+  return rhs_;
+}
+
+const madara::knowledge::KnowledgeRecord&
+madara::expression::VariableDecrementNode::get_value(void) const
+{
+  return value_;
+}
+
+void madara::expression::VariableDecrementNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&rhs_);
+}
+
 #endif  // _MADARA_NO_KARL_
@@ -149,4 +149,34 @@ madara::expression::VariableDivideNode::evaluate(
   return rhs;
 }
 
+madara::expression::VariableNode*
+madara::expression::VariableDivideNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::VariableDivideNode::get_array(void) const
+{
+  return array_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::VariableDivideNode::get_rhs(void) const
+{
+  return rhs_;
+}
+
+const madara::knowledge::KnowledgeRecord&
+madara::expression::VariableDivideNode::get_value(void) const
+{
+  return value_;
+}
+
+void madara::expression::VariableDivideNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&rhs_);
+}
+
 #endif  // _MADARA_NO_KARL_
@@ -145,4 +145,34 @@ madara::expression::VariableIncrementNode::evaluate(
   return rhs;
 }
 
+madara::expression::VariableNode*
+madara::expression::VariableIncrementNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::VariableIncrementNode::get_array(void) const
+{
+  return array_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::VariableIncrementNode::get_rhs(void) const
+{
+  return rhs_;
+}
+
+const madara::knowledge::KnowledgeRecord&
+madara::expression::VariableIncrementNode::get_value(void) const
+{
+  return value_;
+}
+
+void madara::expression::VariableIncrementNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&rhs_);
+}
+
 #endif  // _MADARA_NO_KARL_
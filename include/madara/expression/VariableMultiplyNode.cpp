@@ -142,4 +142,34 @@ madara::expression::VariableMultiplyNode::evaluate(
   return rhs;
 }
 
+madara::expression::VariableNode*
+madara::expression::VariableMultiplyNode::get_variable(void) const
+{
+  return var_;
+}
+
+madara::expression::CompositeArrayReference*
+madara::expression::VariableMultiplyNode::get_array(void) const
+{
+  return array_;
+}
+
+madara::expression::ComponentNode*
+madara::expression::VariableMultiplyNode::get_rhs(void) const
+{
+  return rhs_;
+}
+
+const madara::knowledge::KnowledgeRecord&
+madara::expression::VariableMultiplyNode::get_value(void) const
+{
+  return value_;
+}
+
+void madara::expression::VariableMultiplyNode::get_children(
+    std::vector<ComponentNode**>& children)
+{
+  children.push_back(&rhs_);
+}
+
 #endif  // _MADARA_NO_KARL_
@@ -1,7 +1,9 @@
 
 #ifndef _MADARA_NO_KARL_
 #include "madara/expression/Visitor.h"
+#include "madara/expression/Bytecode.h"
 #include "madara/expression/VariableNode.h"
+#include "madara/expression/KeyExpansionCache.h"
 #include "madara/utility/Utility.h"
 #include "VariableExpander.h"
 
@@ -76,6 +78,9 @@ madara::expression::VariableNode::VariableNode(
 
       throw exceptions::KarlException(buffer.str());
     }
+
+    // remember what the key expands to for each value of its variables
+    expansion_.reset(new KeyExpansionCache(key, context_));
   }
   // no variable expansion necessary. Create a hard link to the ref_->
   // this will save us lots of clock cycles each variable access or
@@ -86,6 +91,8 @@ madara::expression::VariableNode::VariableNode(
   }
 }
 
+madara::expression::VariableNode::~VariableNode(void) {}
+
 std::string madara::expression::VariableNode::expand_opener(
     size_t opener, size_t& closer) const
 {
@@ -216,18 +223,47 @@ std::string madara::expression::VariableNode::expand_key(void) const
     return key_;
 }
 
+bool madara::expression::VariableNode::find_expanded(
+    knowledge::VariableReference& variable, bool create) const
+{
+  return expansion_ && expansion_->find(variable, create);
+}
+
+madara::knowledge::KnowledgeRecord
+madara::expression::VariableNode::get_expanded(
+    const madara::knowledge::KnowledgeReferenceSettings& settings) const
+{
+  knowledge::VariableReference ref;
+
+  if (find_expanded(ref, false))
+  {
+    // a missing variable reads as an empty record, as with get
+    if (ref.is_valid())
+      return *ref.get_record_unsafe();
+
+    return knowledge::KnowledgeRecord();
+  }
+
+  return context_.get(expand_key(), settings);
+}
+
 void madara::expression::VariableNode::accept(Visitor& visitor) const
 {
   visitor.visit(*this);
 }
 
+void madara::expression::VariableNode::compile(Bytecode& program)
+{
+  program.emit_variable(Bytecode::LOAD_VARIABLE, this);
+}
+
 madara::knowledge::KnowledgeRecord madara::expression::VariableNode::item()
     const
 {
   if (ref_.is_valid())
     return *ref_.get_record_unsafe();
   else
-    return context_.get(expand_key());
+    return get_expanded();
 }
 
 /// Prune the tree of unnecessary nodes.
@@ -245,7 +281,7 @@ madara::knowledge::KnowledgeRecord madara::expression::VariableNode::prune(
   if (ref_.is_valid())
     return *ref_.get_record_unsafe();
   else
-    return context_.get(expand_key());
+    return get_expanded();
 }
 
 /// Evaluates the node and its children.
@@ -255,7 +291,7 @@ madara::knowledge::KnowledgeRecord madara::expression::VariableNode::evaluate(
   if (ref_.is_valid())
     return *ref_.get_record_unsafe();
   else
-    return context_.get(expand_key(), settings);
+    return get_expanded(settings);
 }
 
 const std::string& madara::expression::VariableNode::key() const
@@ -263,6 +299,12 @@ const std::string& madara::expression::VariableNode::key() const
   return key_;
 }
 
+const madara::knowledge::VariableReference&
+madara::expression::VariableNode::get_ref(void) const
+{
+  return ref_;
+}
+
 int madara::expression::VariableNode::set(
     const madara::knowledge::KnowledgeRecord& value,
     const madara::knowledge::KnowledgeUpdateSettings& settings)
@@ -276,7 +318,7 @@ int madara::expression::VariableNode::set(
       "Attempting to set variable %s to a KnowledgeRecord parameter (%s).\n",
       key_.c_str(), value.to_string().c_str());
 
-  if (!ref.is_valid())
+  if (!ref.is_valid() && !find_expanded(ref, true))
   {
     ref = context_.get_ref(key_, settings);
   }
@@ -312,6 +354,19 @@ int madara::expression::VariableNode::set(
   return result;
 }
 
+void madara::expression::VariableNode::mark_modified(
+    const madara::knowledge::KnowledgeUpdateSettings& settings)
+{
+  knowledge::VariableReference ref = ref_;
+
+  if (!ref.is_valid() && !find_expanded(ref, true))
+  {
+    ref = context_.get_ref(expand_key(), settings);
+  }
+
+  context_.mark_and_signal(ref, settings);
+}
+
 int madara::expression::VariableNode::set(
     const madara::knowledge::KnowledgeRecord::Integer& value,
     const madara::knowledge::KnowledgeUpdateSettings& settings)
@@ -349,9 +404,11 @@ int madara::expression::VariableNode::set(const std::string& value,
 madara::knowledge::KnowledgeRecord madara::expression::VariableNode::dec(
     const madara::knowledge::KnowledgeUpdateSettings& settings)
 {
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
@@ -365,8 +422,7 @@ madara::knowledge::KnowledgeRecord madara::expression::VariableNode::dec(
 
     --(*record);
 
-    std::string expanded_key(expand_key());
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return *record;
   }
@@ -377,9 +433,11 @@ madara::knowledge::KnowledgeRecord madara::expression::VariableNode::dec(
 madara::knowledge::KnowledgeRecord madara::expression::VariableNode::inc(
     const madara::knowledge::KnowledgeUpdateSettings& settings)
 {
-  if (ref_.is_valid())
+  knowledge::VariableReference ref = ref_;
+
+  if (ref.is_valid() || find_expanded(ref, true))
   {
-    auto record = ref_.get_record_unsafe();
+    auto record = ref.get_record_unsafe();
 
     // notice that we assume the context is locked
     // check if we have the appropriate write quality
@@ -393,8 +451,7 @@ madara::knowledge::KnowledgeRecord madara::expression::VariableNode::inc(
 
     ++(*record);
 
-    std::string expanded_key(expand_key());
-    context_.mark_and_signal(ref_);
+    context_.mark_and_signal(ref);
 
     return *record;
   }
@@ -4,6 +4,7 @@
 
 #ifndef _MADARA_NO_KARL_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@ namespace expression
 {
 // Forward declarations.
 class Visitor;
+class KeyExpansionCache;
 
 /**
  * @class VariableNode
@@ -32,6 +34,9 @@ public:
   VariableNode(
       const std::string& key, madara::knowledge::ThreadSafeContext& context);
 
+  /// Dtor.
+  virtual ~VariableNode(void);
+
   /// Return the item stored in the node.
   virtual madara::knowledge::KnowledgeRecord item(void) const;
 
@@ -83,9 +88,19 @@ public:
   /// Return the variable key.
   const std::string& key(void) const;
 
+  /// Return the reference to the variable, which is only valid if the
+  /// key needs no expansion.
+  const madara::knowledge::VariableReference& get_ref(void) const;
+
   /// Define the @a accept() operation used for the Visitor pattern.
   virtual void accept(Visitor& visitor) const;
 
+  /**
+   * Lowers the node into bytecode
+   * @param     program      the bytecode to append instructions to
+   **/
+  virtual void compile(Bytecode& program);
+
   /**
    * Retrieves the underlying knowledge::KnowledgeRecord in the context (useful
    *for system calls).
@@ -95,13 +110,44 @@ public:
   {
     if (ref_.is_valid())
       return ref_.get_record_unsafe();
-    else
-      return context_.get_record(expand_key());
+
+    knowledge::VariableReference ref;
+    if (find_expanded(ref, true))
+      return ref.get_record_unsafe();
+
+    return context_.get_record(expand_key());
   }
 
+  /**
+   * Marks the variable as changed after its record was changed in place
+   * through get_record, as set does after an assignment
+   * @param  settings  settings for marking the change
+   **/
+  void mark_modified(const madara::knowledge::KnowledgeUpdateSettings&
+          settings = knowledge::KnowledgeUpdateSettings());
+
 private:
   std::string expand_opener(size_t opener, size_t& closer) const;
 
+  /**
+   * Finds the variable an expanded key refers to, without building the
+   * key when the same expansion was seen before
+   * @param  variable  the variable, or invalid if missing and not created
+   * @param  create    create the variable if it does not exist
+   * @return false if the key must be built with expand_key instead
+   **/
+  bool find_expanded(
+      knowledge::VariableReference& variable, bool create) const;
+
+  /**
+   * Reads the variable when the key needs expansion
+   * @param  settings  settings for referring to the variable
+   * @return the value of the variable
+   **/
+  madara::knowledge::KnowledgeRecord get_expanded(
+      const madara::knowledge::KnowledgeReferenceSettings& settings =
+          knowledge::KnowledgeReferenceSettings()) const;
+
   /// Key for retrieving value of this variable.
   const std::string key_;
   madara::knowledge::VariableReference ref_;
@@ -113,6 +159,9 @@ private:
 
   std::vector<size_t> markers_;
 
+  /// variables the key expanded to, if the key needs expansion
+  std::unique_ptr<KeyExpansionCache> expansion_;
+
   /// Reference to context for variable retrieval
 };
 }
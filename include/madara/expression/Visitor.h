@@ -79,6 +79,14 @@ class SystemCallToInteger;
 class SystemCallToIntegers;
 class SystemCallToString;
 class SystemCallType;
+class SystemCallVadd;
+class SystemCallVclamp;
+class SystemCallVdot;
+class SystemCallVmax;
+class SystemCallVmin;
+class SystemCallVmul;
+class SystemCallVscale;
+class SystemCallVsum;
 class SystemCallWriteFile;
 
 /**
@@ -302,6 +310,30 @@ public:
   /// Visit a SystemCallType.
   virtual void visit(const SystemCallType& node) = 0;
 
+  /// Visit a SystemCallVadd.
+  virtual void visit(const SystemCallVadd& node) = 0;
+
+  /// Visit a SystemCallVclamp.
+  virtual void visit(const SystemCallVclamp& node) = 0;
+
+  /// Visit a SystemCallVdot.
+  virtual void visit(const SystemCallVdot& node) = 0;
+
+  /// Visit a SystemCallVmax.
+  virtual void visit(const SystemCallVmax& node) = 0;
+
+  /// Visit a SystemCallVmin.
+  virtual void visit(const SystemCallVmin& node) = 0;
+
+  /// Visit a SystemCallVmul.
+  virtual void visit(const SystemCallVmul& node) = 0;
+
+  /// Visit a SystemCallVscale.
+  virtual void visit(const SystemCallVscale& node) = 0;
+
+  /// Visit a SystemCallVsum.
+  virtual void visit(const SystemCallVsum& node) = 0;
+
   /// Visit a SystemCallWriteFile.
   virtual void visit(const SystemCallWriteFile& node) = 0;
 
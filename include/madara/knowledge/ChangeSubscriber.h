@@ -0,0 +1,47 @@
+#ifndef _MADARA_KNOWLEDGE_CHANGE_SUBSCRIBER_H_
+#define _MADARA_KNOWLEDGE_CHANGE_SUBSCRIBER_H_
+
+/**
+ * @file ChangeSubscriber.h
+ *
+ * This file contains the ChangeSubscriber interface, which is notified
+ * when the variables it subscribes to in a ThreadSafeContext change
+ **/
+
+#include "madara/knowledge/VariableReference.h"
+
+namespace madara
+{
+namespace knowledge
+{
+/**
+ * @class ChangeSubscriber
+ * @brief Interface for objects notified of changes to specific variables.
+ *        Subscribe with ThreadSafeContext::subscribe.
+ */
+class ChangeSubscriber
+{
+public:
+  /**
+   * Destructor
+   **/
+  virtual ~ChangeSubscriber() = default;
+
+  /**
+   * Called when a subscribed variable is modified. The context is locked
+   * during the call, so implementations should only note the change.
+   * @param  variable   the modified variable
+   **/
+  virtual void modified(const VariableReference& variable) = 0;
+
+  /**
+   * Called when variables are erased from the context, which removes every
+   * subscription. Subscribers that need further notifications must
+   * subscribe again, outside of the call. The context is locked.
+   **/
+  virtual void unsubscribed(void) = 0;
+};
+}
+}
+
+#endif  // _MADARA_KNOWLEDGE_CHANGE_SUBSCRIBER_H_
@@ -0,0 +1,50 @@
+#include <algorithm>
+
+#include "madara/knowledge/ChangeWaiter.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+
+madara::knowledge::ChangeWaiterGuard::ChangeWaiterGuard(
+    ThreadSafeContext& context)
+  : context_(context), per_variable_(false)
+{
+}
+
+madara::knowledge::ChangeWaiterGuard::~ChangeWaiterGuard()
+{
+  context_.remove_waiter(waiter_);
+}
+
+#ifndef _MADARA_NO_KARL_
+
+void madara::knowledge::ChangeWaiterGuard::subscribe(
+    CompiledExpression& expression)
+{
+  per_variable_ = context_.add_waiter(waiter_, expression);
+}
+
+#endif  // _MADARA_NO_KARL_
+
+void madara::knowledge::ChangeWaiterGuard::wait(
+    double max_wait_time, double elapsed)
+{
+  if (per_variable_)
+  {
+    // stop at the deadline, even if nothing changes
+    double timeout = -1.0;
+    if (max_wait_time >= 0)
+      timeout = std::max(0.0, max_wait_time - elapsed);
+
+    context_.wait_for_change(waiter_, timeout);
+  }
+  else
+  {
+    context_.wait_for_change(true);
+  }
+}
+
+void madara::knowledge::ChangeWaiterGuard::pass_on(void)
+{
+  // pass the wakeup on to the next waiter on the context
+  if (!per_variable_)
+    context_.signal();
+}
@@ -0,0 +1,136 @@
+#ifndef _MADARA_KNOWLEDGE_CHANGE_WAITER_H_
+#define _MADARA_KNOWLEDGE_CHANGE_WAITER_H_
+
+/**
+ * @file ChangeWaiter.h
+ *
+ * This file contains the ChangeWaiter class, which lets a thread sleep
+ * until one of the variables it subscribed to in a ThreadSafeContext
+ * changes, and the ChangeWaiterGuard class, which wait statements use
+ * to sleep between evaluations
+ **/
+
+#include <string>
+#include <vector>
+#include "madara/MadaraExport.h"
+#include "madara/LockType.h"
+#include "madara/knowledge/ChangeSubscriber.h"
+
+namespace madara
+{
+namespace knowledge
+{
+class ThreadSafeContext;
+class CompiledExpression;
+
+/**
+ * @class ChangeWaiter
+ * @brief A condition that is signalled only when a subscribed variable
+ *        changes, so that threads waiting on different variables do not
+ *        wake each other. Subscribe with ThreadSafeContext::add_waiter and
+ *        wait with ThreadSafeContext::wait_for_change.
+ */
+class ChangeWaiter : public ChangeSubscriber
+{
+public:
+  /**
+   * Constructor
+   **/
+  ChangeWaiter() : changed(false), subscribed(false) {}
+
+  /**
+   * Wakes the waiting thread
+   **/
+  virtual void modified(const VariableReference&)
+  {
+    changed = true;
+    condition.MADARA_CONDITION_NOTIFY_ONE();
+  }
+
+  /**
+   * Wakes the waiting thread, which subscribes again
+   **/
+  virtual void unsubscribed(void)
+  {
+    subscribed = false;
+    changed = true;
+    condition.MADARA_CONDITION_NOTIFY_ONE();
+  }
+
+  /// the variables the waiter subscribes to
+  std::vector<std::string> reads;
+
+  /// true if a subscribed variable changed since the last wait
+  bool changed;
+
+  /// true if the waiter is subscribed to the variables it reads
+  bool subscribed;
+
+  /// the condition the waiting thread sleeps on
+  MADARA_CONDITION_TYPE condition;
+};
+
+/**
+ * @class ChangeWaiterGuard
+ * @brief Sleeps between the evaluations of a wait statement. Once
+ *        subscribed to an expression whose variables are known, only
+ *        changes to those variables wake it. Otherwise any change to the
+ *        context does. The waiter is removed from the context when the
+ *        guard is destroyed, including by exception.
+ */
+class MADARA_EXPORT ChangeWaiterGuard
+{
+public:
+  /**
+   * Constructor
+   * @param  context     the context the wait statement evaluates in
+   **/
+  ChangeWaiterGuard(ThreadSafeContext& context);
+
+  /**
+   * Destructor. Removes the waiter from the context.
+   **/
+  ~ChangeWaiterGuard();
+
+  // the context holds the address of the waiter
+  ChangeWaiterGuard(const ChangeWaiterGuard&) = delete;
+  ChangeWaiterGuard& operator=(const ChangeWaiterGuard&) = delete;
+
+#ifndef _MADARA_NO_KARL_
+  /**
+   * Subscribes to the variables an expression reads, if they are known.
+   * The caller must hold the lock on the context.
+   * @param  expression  the expression the wait statement evaluates
+   **/
+  void subscribe(CompiledExpression& expression);
+#endif  // _MADARA_NO_KARL_
+
+  /**
+   * Waits for a change that may change the result of the expression.
+   * The caller must not hold the lock on the context.
+   * @param  max_wait_time  the maximum time of the wait statement in
+   *                        seconds, or a negative number for no limit
+   * @param  elapsed        the time the wait statement has taken
+   **/
+  void wait(double max_wait_time, double elapsed);
+
+  /**
+   * Passes the wakeup on to the next thread waiting on the context, if
+   * any change to the context wakes this one
+   **/
+  void pass_on(void);
+
+private:
+  /// the context the wait statement evaluates in
+  ThreadSafeContext& context_;
+
+  /// the waiter subscribed to the variables of the expression
+  ChangeWaiter waiter_;
+
+  /// true if the waiter is subscribed to the variables it reads
+  bool per_variable_;
+};
+}
+}
+
+#endif  // _MADARA_KNOWLEDGE_CHANGE_WAITER_H_
@@ -1,17 +1,18 @@
 #include "madara/knowledge/CompiledExpression.h"
+#include "madara/knowledge/ThreadSafeContext.h"
 #include "madara/expression/ExpressionTree.h"
 #include "madara/logger/GlobalLogger.h"
 
 #ifndef _MADARA_NO_KARL_
 
 madara::knowledge::CompiledExpression::CompiledExpression()
-  : expression(*logger::global_logger.get())
+  : context(0), expression(*logger::global_logger.get())
 {
 }
 
 madara::knowledge::CompiledExpression::CompiledExpression(
     const CompiledExpression& ce)
-  : logic(ce.logic), expression(ce.expression)
+  : logic(ce.logic), context(ce.context), expression(ce.expression)
 {
 }
 
@@ -26,12 +27,52 @@ madara::knowledge::CompiledExpression::get_root(void)
   return expression.get_root();
 }
 
+size_t madara::knowledge::CompiledExpression::compile_bytecode(void)
+{
+  return expression.compile_bytecode();
+}
+
+bool madara::knowledge::CompiledExpression::has_bytecode(void) const
+{
+  return expression.has_bytecode();
+}
+
+std::shared_ptr<madara::expression::ExpressionProfile>
+madara::knowledge::CompiledExpression::enable_profiling(void)
+{
+  // profiles wrap the nodes of the tree in place, and the interpreter
+  // shares the tree with every expression compiled from the same logic
+  if (!expression.get_profile() && context)
+  {
+    bool bytecode = expression.has_bytecode();
+
+    expression = context->compile(logic, false).expression;
+
+    if (bytecode)
+      expression.compile_bytecode();
+  }
+
+  return expression.enable_profiling();
+}
+
+void madara::knowledge::CompiledExpression::disable_profiling(void)
+{
+  expression.disable_profiling();
+}
+
+std::shared_ptr<madara::expression::ExpressionProfile>
+madara::knowledge::CompiledExpression::get_profile(void) const
+{
+  return expression.get_profile();
+}
+
 void madara::knowledge::CompiledExpression::operator=(
     const CompiledExpression& ce)
 {
   if (this != &ce)
   {
     logic = ce.logic;
+    context = ce.context;
     expression = ce.expression;
   }
 }
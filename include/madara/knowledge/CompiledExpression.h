@@ -14,6 +14,7 @@
 #include <string>
 #include "madara/MadaraExport.h"
 #include "madara/expression/ExpressionTree.h"
+#include "madara/expression/ExpressionProfile.h"
 
 namespace madara
 {
@@ -69,10 +70,49 @@ public:
    **/
   expression::ComponentNode* get_root(void);
 
+  /**
+   * Lowers the expression into bytecode for a stack machine, which
+   * evaluates it without walking the tree. Results are the same as
+   * evaluating the tree. Copies made afterwards share the bytecode.
+   * @return the number of instructions in the bytecode
+   **/
+  size_t compile_bytecode(void);
+
+  /**
+   * Checks if the expression has been lowered into bytecode
+   * @return true if evaluations use bytecode
+   **/
+  bool has_bytecode(void) const;
+
+  /**
+   * Starts counting the evaluations of each part of the expression and
+   * the time spent in them. The expression is given a tree of its own
+   * to profile, so other expressions compiled from the same logic are
+   * not slowed or counted. Copies made afterwards share the profile.
+   * Must not be called while this expression is being evaluated.
+   * @return the profile, which can be printed with
+   *         ExpressionProfile::annotate or ExpressionProfile::folded
+   **/
+  std::shared_ptr<expression::ExpressionProfile> enable_profiling(void);
+
+  /**
+   * Stops profiling the expression
+   **/
+  void disable_profiling(void);
+
+  /**
+   * Returns the profile of the expression
+   * @return the profile, or null if the expression is not being profiled
+   **/
+  std::shared_ptr<expression::ExpressionProfile> get_profile(void) const;
+
 private:
   /// the logic that was compiled
   std::string logic;
 
+  /// the context that compiled the logic, if it can compile it again
+  ThreadSafeContext* context;
+
   /// the expression tree
   madara::expression::ExpressionTree expression;
 };
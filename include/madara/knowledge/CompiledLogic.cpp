@@ -0,0 +1,71 @@
+#include "madara/knowledge/CompiledLogic.h"
+
+#ifndef _MADARA_NO_KARL_
+
+madara::knowledge::CompiledLogic::CompiledLogic(ThreadSafeContext& context)
+  : context_(context)
+{
+}
+
+madara::knowledge::CompiledLogic::~CompiledLogic() {}
+
+madara::knowledge::VariableReference
+madara::knowledge::CompiledLogic::get_ref(const std::string& key)
+{
+  return context_.get_ref(key);
+}
+
+void madara::knowledge::CompiledLogic::set(const VariableReference& variable,
+    const KnowledgeRecord& value, const KnowledgeUpdateSettings& settings)
+{
+  KnowledgeRecord* record = variable.get_record_unsafe();
+
+  // the same checks and signals as VariableNode::set
+  if (settings.always_overwrite || record->write_quality >= record->quality)
+  {
+    if (record->write_quality != record->quality)
+      record->quality = record->write_quality;
+
+    *record = value;
+
+    context_.mark_and_signal(variable);
+  }
+}
+
+madara::knowledge::KnowledgeRecord madara::knowledge::CompiledLogic::inc(
+    const VariableReference& variable, const KnowledgeUpdateSettings& settings)
+{
+  KnowledgeRecord* record = variable.get_record_unsafe();
+
+  if (settings.always_overwrite || record->write_quality >= record->quality)
+  {
+    if (record->write_quality != record->quality)
+      record->quality = record->write_quality;
+
+    ++(*record);
+
+    context_.mark_and_signal(variable);
+  }
+
+  return *record;
+}
+
+madara::knowledge::KnowledgeRecord madara::knowledge::CompiledLogic::dec(
+    const VariableReference& variable, const KnowledgeUpdateSettings& settings)
+{
+  KnowledgeRecord* record = variable.get_record_unsafe();
+
+  if (settings.always_overwrite || record->write_quality >= record->quality)
+  {
+    if (record->write_quality != record->quality)
+      record->quality = record->write_quality;
+
+    --(*record);
+
+    context_.mark_and_signal(variable);
+  }
+
+  return *record;
+}
+
+#endif  // _MADARA_NO_KARL_
@@ -0,0 +1,134 @@
+#ifndef _MADARA_KNOWLEDGE_COMPILED_LOGIC_H_
+#define _MADARA_KNOWLEDGE_COMPILED_LOGIC_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file CompiledLogic.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the CompiledLogic class, the base of KaRL logic
+ * that was generated as C++ by karlc and built into a shared library
+ **/
+
+#include <string>
+
+#include "madara/MadaraExport.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/knowledge/KnowledgeUpdateSettings.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+#include "madara/knowledge/VariableReference.h"
+
+/**
+ * Exports the function that creates the logic of a shared library
+ **/
+#ifdef _WIN32
+#define MADARA_COMPILED_LOGIC_EXPORT extern "C" __declspec(dllexport)
+#else
+#define MADARA_COMPILED_LOGIC_EXPORT \
+  extern "C" __attribute__((visibility("default")))
+#endif
+
+/// name of the function that creates the logic of a shared library
+#define MADARA_COMPILED_LOGIC_FACTORY "madara_create_compiled_logic"
+
+namespace madara
+{
+namespace knowledge
+{
+/**
+ * @class CompiledLogic
+ * @brief KaRL logic generated as C++ (see karlc) and loaded from a
+ *        shared library with KnowledgeBase::load_compiled_logic.
+ *        Evaluating it has the same effect on the context as evaluating
+ *        the expression tree it was generated from. It is evaluated
+ *        with the context locked.
+ **/
+class MADARA_EXPORT CompiledLogic
+{
+public:
+  /**
+   * Constructor
+   * @param  context   the context the logic reads and changes
+   **/
+  CompiledLogic(ThreadSafeContext& context);
+
+  /**
+   * Destructor
+   **/
+  virtual ~CompiledLogic();
+
+  /**
+   * Evaluates the logic
+   * @param  settings  settings for evaluating and setting knowledge
+   * @return the value of the logic
+   **/
+  virtual KnowledgeRecord evaluate(
+      const KnowledgeUpdateSettings& settings) = 0;
+
+  /**
+   * Returns the KaRL logic the code was generated from
+   * @return the logic
+   **/
+  virtual const char* logic(void) const = 0;
+
+protected:
+  /**
+   * Gets a reference to a variable
+   * @param  key       the name of the variable
+   * @return the reference
+   **/
+  VariableReference get_ref(const std::string& key);
+
+  /**
+   * Reads a variable
+   * @param  variable  the variable
+   * @return the value of the variable
+   **/
+  inline const KnowledgeRecord& get(const VariableReference& variable) const
+  {
+    return *variable.get_record_unsafe();
+  }
+
+  /**
+   * Sets a variable, as an assignment in KaRL does
+   * @param  variable  the variable
+   * @param  value     the new value
+   * @param  settings  settings for setting knowledge
+   **/
+  void set(const VariableReference& variable, const KnowledgeRecord& value,
+      const KnowledgeUpdateSettings& settings);
+
+  /**
+   * Increments a variable, as ++ in KaRL does
+   * @param  variable  the variable
+   * @param  settings  settings for setting knowledge
+   * @return the new value of the variable
+   **/
+  KnowledgeRecord inc(const VariableReference& variable,
+      const KnowledgeUpdateSettings& settings);
+
+  /**
+   * Decrements a variable, as -- in KaRL does
+   * @param  variable  the variable
+   * @param  settings  settings for setting knowledge
+   * @return the new value of the variable
+   **/
+  KnowledgeRecord dec(const VariableReference& variable,
+      const KnowledgeUpdateSettings& settings);
+
+  /// the context the logic reads and changes
+  ThreadSafeContext& context_;
+};
+
+/**
+ * Signature of the function a shared library exports, as
+ * MADARA_COMPILED_LOGIC_FACTORY, to create its logic
+ **/
+typedef CompiledLogic* (*CompiledLogicFactory)(ThreadSafeContext& context);
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_KNOWLEDGE_COMPILED_LOGIC_H_
@@ -2,11 +2,13 @@
 #ifndef _MADARA_EXTERNAL_FUNCTIONS_H_
 #define _MADARA_EXTERNAL_FUNCTIONS_H_
 
+#include <memory>
 #include <string>
 #include "madara/MadaraExport.h"
 #include "madara/knowledge/FunctionArguments.h"
 #include "madara/knowledge/KnowledgeRecord.h"
 #include "madara/knowledge/KnowledgeUpdateSettings.h"
+#include "madara/knowledge/NativeFunction.h"
 #include "madara/expression/ExpressionTree.h"
 #include "madara/filters/RecordFilter.h"
 #include "madara/logger/GlobalLogger.h"
@@ -34,6 +36,15 @@ namespace knowledge
 {
 class Variables;
 class ThreadSafeContext;
+}
+
+namespace transport
+{
+class TransportContext;
+}
+
+namespace knowledge
+{
 
 typedef madara::knowledge::KnowledgeRecord VALUE_TYPE;
 
@@ -55,7 +66,9 @@ public:
     KARL_EXPRESSION = 3,
     PYTHON_CALLABLE = 4,
     JAVA_CALLABLE = 5,
-    FUNCTOR = 6
+    FUNCTOR = 6,
+    RECORD_FILTER = 7,
+    NATIVE = 8
   };
 
   /**
@@ -70,6 +83,7 @@ public:
 #endif  // _MADARA_NO_KARL_
 
       functor(0),
+      record_filter(0),
       type(UNINITIALIZED)
   {
   }
@@ -86,6 +100,7 @@ public:
 #endif  // _MADARA_NO_KARL_
 
       functor(0),
+      record_filter(0),
       type(EXTERN_UNNAMED)
   {
   }
@@ -102,6 +117,7 @@ public:
 #endif  // _MADARA_NO_KARL_
 
       functor(0),
+      record_filter(0),
       type(EXTERN_NAMED)
   {
   }
@@ -115,6 +131,7 @@ public:
       extern_unnamed(0),
       function_contents(func),
       functor(0),
+      record_filter(0),
       type(KARL_EXPRESSION)
   {
   }
@@ -133,10 +150,47 @@ public:
 #endif  // _MADARA_NO_KARL_
 
       functor(filter),
+      record_filter(0),
       type(FUNCTOR)
   {
   }
 
+  /**
+   * Constructor for a record filter that changes the record in place
+   **/
+  Function(void (*filter)(KnowledgeRecord&, const std::string&,
+      transport::TransportContext&))
+    : extern_named(0),
+      extern_unnamed(0),
+
+#ifndef _MADARA_NO_KARL_
+      function_contents(*logger::global_logger.get()),
+#endif  // _MADARA_NO_KARL_
+
+      functor(0),
+      record_filter(filter),
+      type(RECORD_FILTER)
+  {
+  }
+
+  /**
+   * Constructor for a function with native argument and return types
+   **/
+  Function(std::shared_ptr<NativeFunction> func)
+    : extern_named(0),
+      extern_unnamed(0),
+
+#ifndef _MADARA_NO_KARL_
+      function_contents(*logger::global_logger.get()),
+#endif  // _MADARA_NO_KARL_
+
+      functor(0),
+      record_filter(0),
+      native(std::move(func)),
+      type(NATIVE)
+  {
+  }
+
   inline bool is_extern_unnamed(void) const
   {
     return type == EXTERN_UNNAMED && extern_unnamed;
@@ -157,6 +211,16 @@ public:
     return type == FUNCTOR;
   }
 
+  inline bool is_record_filter(void) const
+  {
+    return type == RECORD_FILTER && record_filter;
+  }
+
+  inline bool is_native(void) const
+  {
+    return type == NATIVE && native;
+  }
+
   inline bool is_uninitialized(void) const
   {
     return type == UNINITIALIZED;
@@ -176,6 +240,13 @@ public:
 
   filters::RecordFilter* functor;
 
+  // record filter that needs no argument packing
+  void (*record_filter)(
+      KnowledgeRecord&, const std::string&, transport::TransportContext&);
+
+  // function with native argument and return types
+  std::shared_ptr<NativeFunction> native;
+
   // type of function definition
   int type;
 
@@ -0,0 +1,50 @@
+#ifndef _MADARA_KNOWLEDGE_KEY_CHANGES_H_
+#define _MADARA_KNOWLEDGE_KEY_CHANGES_H_
+
+/**
+ * @file KeyChanges.h
+ *
+ * This file contains the KeyChanges struct, which lists the variables
+ * created and erased under a prefix of a ThreadSafeContext
+ **/
+
+#include <string>
+#include <vector>
+#include "madara/utility/StdInt.h"
+
+namespace madara
+{
+namespace knowledge
+{
+/**
+ * @class KeyChanges
+ * @brief The variables created and erased under a prefix since a
+ *        generation of the context's key log. Returned by
+ *        ThreadSafeContext::get_key_changes.
+ */
+struct KeyChanges
+{
+  /// the generation the changes reach, to pass to the next call
+  uint64_t generation = 0;
+
+  /**
+   * False if the log does not reach back to the requested generation,
+   * e.g., because the context was cleared. The caller must then read
+   * all keys under the prefix again.
+   **/
+  bool complete = false;
+
+  /**
+   * Keys that exist now but did not at the requested generation. Keys
+   * that were erased and created again are also in removed, so apply
+   * removed first.
+   **/
+  std::vector<std::string> added;
+
+  /// keys that existed at the requested generation but were erased
+  std::vector<std::string> removed;
+};
+}
+}
+
+#endif  // _MADARA_KNOWLEDGE_KEY_CHANGES_H_
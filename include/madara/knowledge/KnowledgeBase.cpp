@@ -40,6 +40,10 @@ KnowledgeRecord KnowledgeBase::wait(
 
     KnowledgeRecord last_value;
 
+    // waiters on expressions that read known variables are woken only by
+    // changes to those variables, rather than by every change
+    ChangeWaiterGuard waiter(*context_);
+
     // print the post statement at highest log level (cannot be masked)
     if (settings.pre_print_statement != "")
       context_->print(settings.pre_print_statement, logger::LOG_ALWAYS);
@@ -60,6 +64,9 @@ KnowledgeRecord KnowledgeBase::wait(
           last_value.to_string().c_str());
 
       send_modifieds("KnowledgeBase:wait", settings);
+
+      if (!last_value.to_integer() && settings.poll_frequency <= 0)
+        waiter.subscribe(expression);
     }
 
     // wait for expression to be true
@@ -77,7 +84,9 @@ KnowledgeRecord KnowledgeBase::wait(
         enforcer.sleep_until_next();
       }
       else
-        context_->wait_for_change(true);
+      {
+        waiter.wait(settings.max_wait_time, enforcer.duration_ds());
+      }
 
       // relock - basically we need to evaluate the tree again, and
       // we can't have a bunch of people changing the variables as
@@ -100,7 +109,7 @@ KnowledgeRecord KnowledgeBase::wait(
         send_modifieds("KnowledgeBase:wait", settings);
       }
 
-      context_->signal();
+      waiter.pass_on();
     }  // end while (!last)
 
     if (enforcer.is_done())
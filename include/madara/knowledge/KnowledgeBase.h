@@ -901,6 +901,36 @@ public:
    **/
   CompiledExpression compile(const std::string& expression);
 
+  /**
+   * Loads logic that karlc generated as C++ and that was built into a
+   * shared library. The result is evaluated like a compiled expression.
+   *
+   * @param path               path to the shared library
+   * @return                   the loaded logic
+   * @throw exceptions::FileException  the library could not be loaded or
+   *                                   does not contain compiled logic
+   **/
+  CompiledExpression load_compiled_logic(const std::string& path);
+
+  /**
+   * Sets the most expressions kept in the cache used by compile and
+   * evaluate. When full, the least recently compiled expression is
+   * dropped. Expressions already compiled remain valid.
+   * @param capacity           the most expressions, or 0 for no limit
+   **/
+  void set_expression_cache_capacity(size_t capacity);
+
+  /**
+   * Returns the statistics of the expression cache, e.g., to size it
+   * @return                   capacity, size, hits, misses and evictions
+   **/
+  expression::ExpressionCacheStats get_expression_cache_stats(void) const;
+
+  /**
+   * Resets the hit, miss and eviction counts of the expression cache
+   **/
+  void reset_expression_cache_stats(void);
+
   /**
    * Evaluates an expression
    *
@@ -934,6 +964,49 @@ public:
   madara::knowledge::KnowledgeRecord evaluate(expression::ComponentNode* root,
       const EvalSettings& settings = EvalSettings());
 
+  /**
+   * Adds a reactive rule. evaluate_rules evaluates the rule again only
+   * after a variable it reads has changed, instead of every time.
+   *
+   * @param logic           KaRL rule
+   * @return                index of the rule
+   * @throw exceptions::KarlException  failure during compile
+   **/
+  size_t add_rule(const std::string& logic);
+
+  /**
+   * Adds a reactive rule
+   *
+   * @param logic           KaRL rule (result of compile)
+   * @return                index of the rule
+   **/
+  size_t add_rule(const CompiledExpression& logic);
+
+  /**
+   * Evaluates the reactive rules whose inputs changed since they were
+   * last evaluated, in the order they were added. Rules that expand keys,
+   * call functions, loop or read the time are always evaluated.
+   *
+   * @param settings        Settings for evaluating and printing
+   * @return                number of rules evaluated
+   * @throw exceptions::KarlException  failure during evaluate
+   **/
+  size_t evaluate_rules(const EvalSettings& settings = EvalSettings());
+
+  /**
+   * Returns the result of the last evaluation of a reactive rule
+   *
+   * @param rule            index of the rule
+   * @return                result, or an empty record if the rule has
+   *                        not been evaluated
+   **/
+  madara::knowledge::KnowledgeRecord get_rule_result(size_t rule);
+
+  /**
+   * Removes all reactive rules
+   **/
+  void clear_rules(void);
+
   /**
    * Waits for an expression to be non-zero.
    * Always disseminates modifications.
@@ -1011,6 +1084,26 @@ public:
   void define_function(
       const std::string& name, const CompiledExpression& expression);
 
+  /**
+   * Defines a function with native argument and return types
+   * @param  name       name of the function
+   * @param  func       function to call with this name
+   **/
+  void define_function(
+      const std::string& name, std::shared_ptr<NativeFunction> func);
+
+  /**
+   * Defines a function with native argument and return types, e.g.,
+   * define_function<double(double, double)> ("distance", distance).
+   * KaRL calls convert their arguments with knowledge_cast and pass them
+   * directly, without packing them into FunctionArguments.
+   * @param  name       name of the function
+   * @param  func       function pointer, functor or lambda to call
+   * @tparam Signature  the signature to call func with, e.g., R(Args...)
+   **/
+  template<typename Signature, typename Callable>
+  void define_function(const std::string& name, Callable func);
+
 #endif  // _MADARA_NO_KARL_
 
   /**
@@ -1379,6 +1472,22 @@ public:
    **/
   const ThreadSafeContext& get_context(void) const;
 
+  /**
+   * Enables or disables the hash index over variable names. With the
+   * index, lookups by name are average constant time instead of
+   * logarithmic in the number of variables, at the cost of extra memory
+   * per variable. Prefix operations always use the ordered map. This
+   * is best called right after construction.
+   * @param enable   true to build and maintain the index
+   **/
+  void enable_hash_index(bool enable = true);
+
+  /**
+   * Checks if lookups by name use the hash index
+   * @return  true if the hash index is enabled
+   **/
+  bool has_hash_index(void) const;
+
   /**
    * Gets the log level
    * @return the maximum detail level to print
@@ -1675,6 +1784,16 @@ public:
       const std::string& prefix = "KnowledgeBase::send_modifieds",
       const EvalSettings& settings = EvalSettings::SEND);
 
+  /**
+   * Waits for transports configured with async_send to finish sending
+   * everything queued by previous send_modifieds calls. Do not call
+   * this while holding a ContextGuard on this knowledge base.
+   * @param   max_wait    maximum seconds to wait per transport.
+   *                      Negative waits forever.
+   * @return  true if all send queues were flushed, false on timeout
+   **/
+  bool flush_sends(double max_wait = -1.0);
+
   /**
    * Clear all modifications to the knowledge base. This action may
    * be useful if you are wanting to keep local changes but not
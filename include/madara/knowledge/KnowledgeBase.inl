@@ -1147,6 +1147,39 @@ inline CompiledExpression KnowledgeBase::compile(const std::string& expression)
   return result;
 }
 
+inline CompiledExpression KnowledgeBase::load_compiled_logic(
+    const std::string& path)
+{
+  CompiledExpression result;
+
+  if (impl_.get())
+  {
+    result = impl_->load_compiled_logic(path);
+  }
+  else if (context_)
+  {
+    result = context_->load_compiled_logic(path);
+  }
+
+  return result;
+}
+
+inline void KnowledgeBase::set_expression_cache_capacity(size_t capacity)
+{
+  get_context().set_expression_cache_capacity(capacity);
+}
+
+inline expression::ExpressionCacheStats
+KnowledgeBase::get_expression_cache_stats(void) const
+{
+  return get_context().get_expression_cache_stats();
+}
+
+inline void KnowledgeBase::reset_expression_cache_stats(void)
+{
+  get_context().reset_expression_cache_stats();
+}
+
 // evaluate a knowledge expression and choose to send any modifications
 inline KnowledgeRecord KnowledgeBase::evaluate(
     const std::string& expression, const EvalSettings& settings)
@@ -1202,6 +1235,82 @@ inline KnowledgeRecord KnowledgeBase::evaluate(
   return result;
 }
 
+inline size_t KnowledgeBase::add_rule(const std::string& logic)
+{
+  size_t result = 0;
+
+  if (impl_.get())
+  {
+    result = impl_->add_rule(logic);
+  }
+  else if (context_)
+  {
+    result = context_->add_rule(context_->compile(logic));
+  }
+
+  return result;
+}
+
+inline size_t KnowledgeBase::add_rule(const CompiledExpression& logic)
+{
+  size_t result = 0;
+
+  if (impl_.get())
+  {
+    result = impl_->add_rule(logic);
+  }
+  else if (context_)
+  {
+    result = context_->add_rule(logic);
+  }
+
+  return result;
+}
+
+inline size_t KnowledgeBase::evaluate_rules(const EvalSettings& settings)
+{
+  size_t result = 0;
+
+  if (impl_.get())
+  {
+    result = impl_->evaluate_rules(settings);
+  }
+  else if (context_)
+  {
+    result = context_->evaluate_rules(settings);
+  }
+
+  return result;
+}
+
+inline KnowledgeRecord KnowledgeBase::get_rule_result(size_t rule)
+{
+  KnowledgeRecord result;
+
+  if (impl_.get())
+  {
+    result = impl_->get_rule_result(rule);
+  }
+  else if (context_)
+  {
+    result = context_->get_rule_result(rule);
+  }
+
+  return result;
+}
+
+inline void KnowledgeBase::clear_rules(void)
+{
+  if (impl_.get())
+  {
+    impl_->clear_rules();
+  }
+  else if (context_)
+  {
+    context_->clear_rules();
+  }
+}
+
 // Defines a function
 inline void KnowledgeBase::define_function(const std::string& name,
     KnowledgeRecord (*func)(const char*, FunctionArguments&, Variables&))
@@ -1300,6 +1409,27 @@ inline void KnowledgeBase::define_function(
   }
 }
 
+inline void KnowledgeBase::define_function(
+    const std::string& name, std::shared_ptr<NativeFunction> func)
+{
+  if (impl_.get())
+  {
+    impl_->define_function(name, std::move(func));
+  }
+  else if (context_)
+  {
+    context_->define_function(name, std::move(func));
+  }
+}
+
+template<typename Signature, typename Callable>
+inline void KnowledgeBase::define_function(
+    const std::string& name, Callable func)
+{
+  define_function(name,
+      std::make_shared<TypedFunction<Signature, Callable>>(std::move(func)));
+}
+
 inline KnowledgeRecord KnowledgeBase::wait(
     const std::string& expression, const WaitSettings& settings)
 {
@@ -1409,6 +1539,16 @@ inline const ThreadSafeContext& KnowledgeBase::get_context(void) const
   return *result;
 }
 
+inline void KnowledgeBase::enable_hash_index(bool enable)
+{
+  get_context().enable_hash_index(enable);
+}
+
+inline bool KnowledgeBase::has_hash_index(void) const
+{
+  return get_context().has_hash_index();
+}
+
 inline void KnowledgeBase::clear_modifieds(void)
 {
   if (context_)
@@ -1463,6 +1603,18 @@ inline int KnowledgeBase::send_modifieds(
   return result;
 }
 
+inline bool KnowledgeBase::flush_sends(double max_wait)
+{
+  bool result = true;
+
+  if (impl_.get())
+  {
+    result = impl_->flush_sends(max_wait);
+  }
+
+  return result;
+}
+
 inline std::string KnowledgeBase::debug_modifieds(void) const
 {
   std::string result = "";
@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <random>
+#include <algorithm>
 
 namespace utility = madara::utility;
 
@@ -221,6 +222,17 @@ CompiledExpression KnowledgeBaseImpl::compile(const std::string& expression)
   return map_.compile(expression);
 }
 
+CompiledExpression KnowledgeBaseImpl::load_compiled_logic(
+    const std::string& path)
+{
+  madara_logger_log(map_.get_logger(), logger::LOG_MAJOR,
+      "KnowledgeBaseImpl::load_compiled_logic:"
+      " loading %s\n",
+      path.c_str());
+
+  return map_.load_compiled_logic(path);
+}
+
 KnowledgeRecord KnowledgeBaseImpl::wait(
     const std::string& expression, const WaitSettings& settings)
 {
@@ -238,6 +250,10 @@ KnowledgeRecord KnowledgeBaseImpl::wait(
   if (settings.pre_print_statement != "")
     map_.print(settings.pre_print_statement, logger::LOG_EMERGENCY);
 
+  // waiters on expressions that read known variables are woken only by
+  // changes to those variables, rather than by every change
+  ChangeWaiterGuard waiter(map_);
+
   // lock the context
 
   KnowledgeRecord last_value;
@@ -257,6 +273,9 @@ KnowledgeRecord KnowledgeBaseImpl::wait(
         last_value.to_string().c_str());
 
     send_modifieds("KnowledgeBaseImpl:wait", settings);
+
+    if (!last_value.to_integer() && settings.poll_frequency <= 0)
+      waiter.subscribe(ce);
   }
 
   // wait for expression to be true
@@ -275,7 +294,7 @@ KnowledgeRecord KnowledgeBaseImpl::wait(
     }
     else
     {
-      map_.wait_for_change(true);
+      waiter.wait(settings.max_wait_time, enforcer.duration_ds());
     }
 
     // relock - basically we need to evaluate the tree again, and
@@ -298,7 +317,8 @@ KnowledgeRecord KnowledgeBaseImpl::wait(
 
       send_modifieds("KnowledgeBaseImpl:wait", settings);
     }
-    map_.signal();
+
+    waiter.pass_on();
 
   }  // end while (!last)
 
@@ -385,6 +405,50 @@ KnowledgeRecord KnowledgeBaseImpl::evaluate(
   return last_value;
 }
 
+size_t KnowledgeBaseImpl::add_rule(const std::string& logic)
+{
+  return map_.add_rule(compile(logic));
+}
+
+size_t KnowledgeBaseImpl::add_rule(const CompiledExpression& logic)
+{
+  return map_.add_rule(logic);
+}
+
+size_t KnowledgeBaseImpl::evaluate_rules(const EvalSettings& settings)
+{
+  size_t evaluated = 0;
+
+  // print the post statement at highest log level (cannot be masked)
+  if (settings.pre_print_statement != "")
+    map_.print(settings.pre_print_statement, logger::LOG_ALWAYS);
+
+  // lock the context from being updated by any ongoing threads
+  {
+    MADARA_GUARD_TYPE guard(map_.mutex_);
+
+    evaluated = map_.evaluate_rules(settings);
+
+    send_modifieds("KnowledgeBaseImpl:evaluate_rules", settings);
+
+    // print the post statement at highest log level (cannot be masked)
+    if (settings.post_print_statement != "")
+      map_.print(settings.post_print_statement, logger::LOG_ALWAYS);
+  }
+
+  return evaluated;
+}
+
+KnowledgeRecord KnowledgeBaseImpl::get_rule_result(size_t rule)
+{
+  return map_.get_rule_result(rule);
+}
+
+void KnowledgeBaseImpl::clear_rules(void)
+{
+  map_.clear_rules();
+}
+
 #endif  // _MADARA_NO_KARL_
 
 int KnowledgeBaseImpl::send_modifieds(
@@ -406,7 +470,10 @@ int KnowledgeBaseImpl::send_modifieds(
         // send across each transport
         for (auto& transport : transports_)
         {
-          transport->send_data(modified);
+          if (transport->is_async_send())
+            transport->queue_data(modified);
+          else
+            transport->send_data(modified);
         }
 
         // reset the modified map
@@ -431,7 +498,10 @@ int KnowledgeBaseImpl::send_modifieds(
           // send across each transport
           for (auto& transport : transports_)
           {
-            transport->send_data(allowed_modifieds);
+            if (transport->is_async_send())
+              transport->queue_data(allowed_modifieds);
+            else
+              transport->send_data(allowed_modifieds);
           }
 
           // reset modified list for the allowed modifications
@@ -475,5 +545,37 @@ int KnowledgeBaseImpl::send_modifieds(
 
   return result;
 }
+
+bool KnowledgeBaseImpl::flush_sends(double max_wait)
+{
+  std::vector<transport::Base*> transports;
+
+  {
+    MADARA_GUARD_TYPE guard(map_.mutex_);
+
+    for (auto& transport : transports_)
+    {
+      if (transport->is_async_send())
+        transports.push_back(transport.get());
+    }
+  }
+
+  bool result = true;
+
+  for (auto transport : transports)
+  {
+    if (!transport->flush_sends(max_wait))
+    {
+      madara_logger_log(map_.get_logger(), logger::LOG_MAJOR,
+          "KnowledgeBaseImpl::flush_sends:"
+          " timed out with %d batches still queued\n",
+          (int)transport->pending_sends());
+
+      result = false;
+    }
+  }
+
+  return result;
+}
 }
 }
@@ -333,6 +333,17 @@ public:
    **/
   CompiledExpression compile(const std::string& expression);
 
+  /**
+   * Loads logic that karlc generated as C++ and that was built into a
+   * shared library. The result is evaluated like a compiled expression.
+   *
+   * @param path               path to the shared library
+   * @return                   the loaded logic
+   * @throw exceptions::FileException  the library could not be loaded or
+   *                                   does not contain compiled logic
+   **/
+  CompiledExpression load_compiled_logic(const std::string& path);
+
   /**
    * Evaluates an expression. Always disseminates modifications.
    *
@@ -375,6 +386,49 @@ public:
   madara::knowledge::KnowledgeRecord evaluate(expression::ComponentNode* root,
       const EvalSettings& settings = EvalSettings());
 
+  /**
+   * Adds a reactive rule. evaluate_rules evaluates the rule again only
+   * after a variable it reads has changed, instead of every time.
+   *
+   * @param logic           KaRL rule
+   * @return                index of the rule
+   * @throw exceptions::KarlException  failure during compile
+   **/
+  size_t add_rule(const std::string& logic);
+
+  /**
+   * Adds a reactive rule
+   *
+   * @param logic           KaRL rule (result of compile)
+   * @return                index of the rule
+   **/
+  size_t add_rule(const CompiledExpression& logic);
+
+  /**
+   * Evaluates the reactive rules whose inputs changed since they were
+   * last evaluated, in the order they were added. Rules that expand keys,
+   * call functions, loop or read the time are always evaluated.
+   *
+   * @param settings        Settings for evaluating and printing
+   * @return                number of rules evaluated
+   * @throw exceptions::KarlException  failure during evaluate
+   **/
+  size_t evaluate_rules(const EvalSettings& settings = EvalSettings());
+
+  /**
+   * Returns the result of the last evaluation of a reactive rule
+   *
+   * @param rule            index of the rule
+   * @return                result, or an empty record if the rule has
+   *                        not been evaluated
+   **/
+  madara::knowledge::KnowledgeRecord get_rule_result(size_t rule);
+
+  /**
+   * Removes all reactive rules
+   **/
+  void clear_rules(void);
+
   /**
    * Waits for an expression to be non-zero.
    * Always disseminates modifications.
@@ -462,6 +516,14 @@ public:
   void define_function(
       const std::string& name, const CompiledExpression& expression);
 
+  /**
+   * Defines a function with native argument and return types
+   * @param  name       name of the function
+   * @param  func       function to call with this name
+   **/
+  void define_function(
+      const std::string& name, std::shared_ptr<NativeFunction> func);
+
 #endif  // _MADARA_NO_KARL_
 
   /**
@@ -708,11 +770,6 @@ public:
    **/
   void clear_map(void);
 
-  /**
-   * Clears the permanent knowledge rules (unimplemented)
-   **/
-  void clear_rules(void);
-
   /**
    * Acquires the recursive lock on the knowledge base. This will
    * block any other thread from updating or using the knowledge
@@ -1042,6 +1099,16 @@ public:
   MADARA_EXPORT int send_modifieds(const std::string& prefix,
       const EvalSettings& settings = EvalSettings::SEND);
 
+  /**
+   * Waits for transports with async_send enabled to finish sending
+   * what has been queued so far. Do not call while holding a
+   * ContextGuard on this knowledge base.
+   * @param   max_wait    maximum seconds to wait per transport.
+   *                      Negative waits forever.
+   * @return  true if all send queues were flushed
+   **/
+  bool flush_sends(double max_wait = -1.0);
+
   /**
    * Wait for a change to happen to the context (e.g., from transports)
    **/
@@ -373,6 +373,12 @@ inline void KnowledgeBaseImpl::define_function(
   map_.define_function(name, expression);
 }
 
+inline void KnowledgeBaseImpl::define_function(
+    const std::string& name, std::shared_ptr<NativeFunction> func)
+{
+  map_.define_function(name, std::move(func));
+}
+
 inline KnowledgeRecord KnowledgeBaseImpl::wait(const std::string& expression)
 {
   CompiledExpression compiled = compile(expression);
@@ -128,6 +128,8 @@ public:
     ALL_TYPES = ALL_PRIMITIVE_TYPES | ALL_FILE_TYPES,
     ALL_CLEARABLES = ALL_ARRAYS | ALL_TEXT_FORMATS | ALL_FILE_TYPES | ANY,
     BUFFER = (1UL << 31),
+    // on the wire only, marks an array value that patches a previous one
+    ARRAY_DELTA = (1UL << 30),
   };
 
   typedef int64_t Integer;
@@ -642,6 +644,42 @@ public:
    **/
   std::shared_ptr<const std::vector<double>> share_doubles() const;
 
+  /**
+   * Reads the elements of an integer array in place. Unlike
+   * share_integers, this does not mark the record as shared, so it can
+   * still be changed in place.
+   * @return the elements, or null if this record is not an integer
+   *         array. Only valid until the record is changed.
+   **/
+  const std::vector<Integer>* peek_integers(void) const;
+
+  /**
+   * Reads the elements of a double array in place. @see peek_integers.
+   * @return the elements, or null if this record is not a double array.
+   *         Only valid until the record is changed.
+   **/
+  const std::vector<double>* peek_doubles(void) const;
+
+  /**
+   * Makes this record an integer array of the given size, and returns the
+   * elements for writing in place. If the record already holds an integer
+   * array, it keeps its values, and the array is resized in place unless
+   * another record shares it. Otherwise, a new array of zeros is created.
+   * Records with history get a new newest entry, which keeps the values
+   * of the previous newest entry if it is an array of the same type.
+   * @param  size   the number of elements
+   * @return the elements, only valid until the record is changed
+   **/
+  std::vector<Integer>& resize_integers(size_t size);
+
+  /**
+   * Makes this record a double array of the given size, and returns the
+   * elements for writing in place. @see resize_integers.
+   * @param  size   the number of elements
+   * @return the elements, only valid until the record is changed
+   **/
+  std::vector<double>& resize_doubles(size_t size);
+
   /**
    * @return a shared_ptr, sharing with the internal one.
    * If this record is not a binary file value, returns NULL shared_ptr
@@ -1471,7 +1509,11 @@ public:
 
   /**
    * Reads a KnowledgeRecord instance from a buffer and updates
-   * the amount of buffer room remaining.
+   * the amount of buffer room remaining. If this record already holds
+   * a string, file, or array that no other record shares, its storage
+   * is reused for a value of the same kind instead of being reallocated.
+   * An array delta patches this record's array in place, and is treated
+   * as malformed unless can_apply_delta is true.
    * @param     buffer     the readable buffer where data is stored
    * @param     buffer_remaining  the count of bytes remaining in the
    *                              buffer to read
@@ -1479,6 +1521,32 @@ public:
    **/
   const char* read(const char* buffer, int64_t& buffer_remaining);
 
+  /**
+   * Reads only the name of a variable from a buffer, leaving the
+   * buffer positioned at the type and value. Reuses the capacity of
+   * key, so reading many updates into one string does not allocate.
+   * @param     buffer     the readable buffer where data is stored
+   * @param     key        the name of the variable
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer to read
+   * @return    current buffer position for next read
+   **/
+  static const char* read_key(
+      const char* buffer, std::string& key, int64_t& buffer_remaining);
+
+  /**
+   * Steps over the type and value of an update in a buffer without
+   * decoding it. Useful for validating an update, or passing over one
+   * that will be rejected.
+   * @param     buffer     the readable buffer where data is stored
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer to read. Negative if the value
+   *                              does not fit in the buffer.
+   * @return    current buffer position for next read
+   **/
+  static const char* skip_value(
+      const char* buffer, int64_t& buffer_remaining);
+
   /**
    * Reads a KnowledgeRecord instance from a buffer and updates
    * the amount of buffer room remaining.
@@ -1566,6 +1634,127 @@ public:
    **/
   char* write(char* buffer, uint32_t key_id, int64_t& buffer_remaining) const;
 
+  /**
+   * Writes only the name of a variable to a buffer, in the format
+   * read by read_key
+   * @param     buffer     the buffer to write to
+   * @param     key        the name of the variable
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @return    current buffer position for the type and value
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  static char* write_key(
+      char* buffer, const std::string& key, int64_t& buffer_remaining);
+
+  /**
+   * Returns the size write_delta needs to encode this array as the
+   * elements that changed since base
+   * @param     base       a previous value of this record
+   * @return    the encoded size, or -1 if base is not an array of the
+   *            same type and size as this record
+   **/
+  int64_t get_delta_encoded_size(const KnowledgeRecord& base) const;
+
+  /**
+   * Writes this array to a buffer as only the ranges of elements that
+   * differ from a previous value. A receiver can only apply the result
+   * to a record that holds base and whose clock is base_clock. If base
+   * is not an array of the same type and size, the whole value is
+   * written instead, as with write.
+   *
+   * Output Format:
+   *
+   * [type | value_size | toi | base_clock | elements | base_hash |
+   * ranges | list of ranges]<br />
+   * type = 32 bit unsigned integer, the array type | ARRAY_DELTA<br />
+   * value_size = 32 bit unsigned integer, bytes after the toi<br />
+   * base_clock = 64 bit unsigned integer, clock of base at the receiver<br />
+   * elements = 32 bit unsigned integer, size of the array<br />
+   * base_hash = 64 bit unsigned integer, hash of the elements of base,
+   * so that a value another writer set at the same clock is not
+   * patched<br />
+   * ranges = 32 bit unsigned integer, number of ranges<br />
+   * range = [start | count | count elements], 32 bit start and count
+   *
+   * @param     buffer     the buffer to write to
+   * @param     base       the value the receiver is expected to hold
+   * @param     base_clock the clock the receiver holds base at
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @return    current buffer position for next write
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  char* write_delta(char* buffer, const KnowledgeRecord& base,
+      uint64_t base_clock, int64_t& buffer_remaining) const;
+
+  /**
+   * Checks if the value at the front of a buffer was written by
+   * write_delta
+   * @param     buffer     the update, positioned at its type
+   * @param     buffer_remaining  the count of bytes remaining in buffer
+   * @return    true if the value is an array delta
+   **/
+  static bool is_array_delta(const char* buffer, int64_t buffer_remaining);
+
+  /**
+   * Checks if this record holds the value an array delta was computed
+   * from, so that read can patch it. The clock, size and a hash of the
+   * elements must all match. Records with history are checked against
+   * their newest value, and the delta is read into a copy of it.
+   * @param     buffer     the update, positioned at its type
+   * @param     buffer_remaining  the count of bytes remaining in buffer
+   * @return    true if read will apply the delta to this record, or to
+   *            the newest value of its history
+   **/
+  bool can_apply_delta(const char* buffer, int64_t buffer_remaining) const;
+
+private:
+  /**
+   * Hashes the elements of an array, the same on any host
+   **/
+  template<typename T>
+  static uint64_t hash_elements(const std::vector<T>& values);
+
+  /**
+   * Hashes the elements of this record's array, which write_delta sends
+   * as base_hash
+   **/
+  uint64_t get_array_hash(void) const;
+
+  /**
+   * Calls func (start, count) for each run of elements of values that
+   * differ from the same elements of base
+   **/
+  template<typename T, typename Func>
+  static void for_each_changed_range(
+      const std::vector<T>& values, const std::vector<T>& base, Func func);
+
+  /**
+   * Writes each run of elements that changed since base, as
+   * [start | count | count elements], and counts the runs
+   **/
+  template<typename T>
+  static char* write_changed_ranges(char* buffer, const std::vector<T>& values,
+      const std::vector<T>& base, uint32_t& ranges);
+
+  /**
+   * Patches values with ranges written by write_changed_ranges
+   * @param   check_only  only check that the ranges are well formed
+   * @return  false if a range does not fit the values or the buffer
+   **/
+  template<typename T>
+  static bool patch_ranges(std::vector<T>& values, const char* buffer,
+      uint32_t ranges, uint32_t size, bool check_only);
+
+  /**
+   * Applies an array delta of a given size to this record's array
+   * @return  false if the delta does not fit this record
+   **/
+  bool apply_delta(uint32_t type, const char* buffer, uint32_t size);
+
+public:
+
   /**
    * Apply the knowledge record to a context, given some quality and clock
    **/
@@ -1103,15 +1103,34 @@ inline const char* KnowledgeRecord::read(
   // Remove the value from the buffer
   if (buffer_remaining >= int64_t(buff_value_size))
   {
+    if (type & ARRAY_DELTA)
+    {
+      // patches the array in place, keeping its type
+      if (!apply_delta(type, buffer, buff_value_size))
+      {
+        buffer_remaining = -1;
+        return buffer;
+      }
+
+      buffer += buff_value_size;
+      buffer_remaining -= sizeof(char) * buff_value_size;
+
+      return buffer;
+    }
+
     if (is_string_type(type))
     {
-      if (buff_value_size >= 1)
+      size_t length = buff_value_size >= 1 ? buff_value_size - 1 : 0;
+
+      // reuse the string if nothing else is looking at it
+      if (is_string_type(type_) && str_value_.use_count() == 1)
       {
-        emplace_string(buffer, buff_value_size - 1);
+        str_value_->assign(buffer, length);
+        shared_ = OWNED;
       }
       else
       {
-        emplace_string();
+        emplace_string(buffer, length);
       }
     }
 
@@ -1124,17 +1143,17 @@ inline const char* KnowledgeRecord::read(
 
     else if (type == INTEGER_ARRAY)
     {
-      std::vector<Integer> tmp;
-      tmp.reserve(size);
-
-      for (uint32_t i = 0; i < size; ++i)
+      if (type_ != INTEGER_ARRAY || int_array_.use_count() != 1)
       {
-        Integer cur;
-        memcpy(&cur, buffer + i * sizeof(cur), sizeof(cur));
-        tmp.emplace_back(madara::utility::endian_swap(cur));
+        emplace_integers();
       }
 
-      emplace_integers(std::move(tmp));
+      std::vector<Integer>& values = *int_array_;
+      values.resize(size);
+
+      madara::utility::endian_swap_64(values.data(), buffer, size);
+
+      shared_ = OWNED;
     }
 
     else if (type == DOUBLE)
@@ -1146,23 +1165,32 @@ inline const char* KnowledgeRecord::read(
 
     else if (type == DOUBLE_ARRAY)
     {
-      std::vector<double> tmp;
-      tmp.reserve(size);
-
-      for (uint32_t i = 0; i < size; ++i)
+      if (type_ != DOUBLE_ARRAY || double_array_.use_count() != 1)
       {
-        double cur;
-        memcpy(&cur, buffer + i * sizeof(cur), sizeof(cur));
-        tmp.emplace_back(madara::utility::endian_swap(cur));
+        emplace_doubles();
       }
 
-      emplace_doubles(std::move(tmp));
+      std::vector<double>& values = *double_array_;
+      values.resize(size);
+
+      madara::utility::endian_swap_64(values.data(), buffer, size);
+
+      shared_ = OWNED;
     }
 
     else if (is_binary_file_type(type))
     {
       const unsigned char* b = (const unsigned char*)buffer;
-      emplace_file(b, b + size);
+
+      if (is_binary_file_type(type_) && file_value_.use_count() == 1)
+      {
+        file_value_->assign(b, b + size);
+        shared_ = OWNED;
+      }
+      else
+      {
+        emplace_file(b, b + size);
+      }
     }
 
     else if (is_any_type(type))
@@ -1194,6 +1222,17 @@ inline const char* KnowledgeRecord::read(
 {
   // format is [key_size | key | type | value_size | value]
 
+  buffer = read_key(buffer, key, buffer_remaining);
+
+  // read the type and data
+  buffer = read(buffer, buffer_remaining);
+
+  return buffer;
+}
+
+inline const char* KnowledgeRecord::read_key(
+    const char* buffer, std::string& key, int64_t& buffer_remaining)
+{
   uint32_t key_size(0);
 
   // Remove the key size from the buffer
@@ -1222,12 +1261,202 @@ inline const char* KnowledgeRecord::read(
   }
   buffer_remaining -= sizeof(char) * int64_t(key_size);
 
-  // read the type and data
-  buffer = read(buffer, buffer_remaining);
+  return buffer;
+}
+
+inline const char* KnowledgeRecord::skip_value(
+    const char* buffer, int64_t& buffer_remaining)
+{
+  // format is [type | value_size | toi | value]
+
+  uint32_t type = INTEGER;
+  uint32_t size = 0;
+  uint64_t value_size = 0;
+
+  if (buffer_remaining < (int64_t)(sizeof(type) + sizeof(size)))
+  {
+    buffer_remaining = -1;
+    return buffer;
+  }
+
+  memcpy(&type, buffer, sizeof(type));
+  type = madara::utility::endian_swap(type);
+  buffer += sizeof(type);
+
+  memcpy(&size, buffer, sizeof(size));
+  size = madara::utility::endian_swap(size);
+  buffer += sizeof(size);
+
+  if (is_integer_type(type))
+    value_size = (uint64_t)size * sizeof(Integer);
+  else if (is_double_type(type))
+    value_size = (uint64_t)size * sizeof(double);
+  else
+    value_size = size;
+
+  buffer_remaining -= sizeof(type) + sizeof(size) + sizeof(toi_);
+
+  if (buffer_remaining < (int64_t)value_size)
+  {
+    buffer_remaining = -1;
+    return buffer;
+  }
+
+  buffer += sizeof(toi_) + value_size;
+  buffer_remaining -= value_size;
 
   return buffer;
 }
 
+inline bool KnowledgeRecord::is_array_delta(
+    const char* buffer, int64_t buffer_remaining)
+{
+  uint32_t type = 0;
+
+  if (buffer_remaining < (int64_t)sizeof(type))
+    return false;
+
+  memcpy(&type, buffer, sizeof(type));
+  type = madara::utility::endian_swap(type);
+
+  return (type & ARRAY_DELTA) != 0;
+}
+
+inline bool KnowledgeRecord::can_apply_delta(
+    const char* buffer, int64_t buffer_remaining) const
+{
+  // format is [type | value_size | toi | base_clock | elements |
+  //            base_hash | ...]
+
+  uint32_t type = 0;
+  uint64_t base_clock = 0;
+  uint32_t elements = 0;
+  uint64_t base_hash = 0;
+  size_t offset = sizeof(type) + sizeof(uint32_t) + sizeof(toi_);
+
+  if (buffer_remaining < (int64_t)(offset + sizeof(base_clock) +
+                                   sizeof(elements) + sizeof(base_hash)))
+    return false;
+
+  memcpy(&type, buffer, sizeof(type));
+  type = madara::utility::endian_swap(type);
+
+  memcpy(&base_clock, buffer + offset, sizeof(base_clock));
+  base_clock = madara::utility::endian_swap(base_clock);
+
+  memcpy(&elements, buffer + offset + sizeof(base_clock), sizeof(elements));
+  elements = madara::utility::endian_swap(elements);
+
+  memcpy(&base_hash, buffer + offset + sizeof(base_clock) + sizeof(elements),
+      sizeof(base_hash));
+  base_hash = madara::utility::endian_swap(base_hash);
+
+  // records with history are patched from their newest value
+  if (has_history() && buf_->empty())
+    return false;
+
+  const KnowledgeRecord& value = has_history() ? ref_newest() : *this;
+
+  // writers that set different values at the same clock leave records
+  // that only the hash tells apart
+  return (type & ARRAY_DELTA) && (type & ~ARRAY_DELTA) == value.type_ &&
+         is_array_type(value.type_) && clock == base_clock &&
+         value.size() == elements && value.get_array_hash() == base_hash;
+}
+
+template<typename T>
+inline bool KnowledgeRecord::patch_ranges(std::vector<T>& values,
+    const char* buffer, uint32_t ranges, uint32_t size, bool check_only)
+{
+  for (uint32_t i = 0; i < ranges; ++i)
+  {
+    uint32_t start = 0;
+    uint32_t count = 0;
+
+    if (size < sizeof(start) + sizeof(count))
+      return false;
+
+    memcpy(&start, buffer, sizeof(start));
+    start = madara::utility::endian_swap(start);
+    buffer += sizeof(start);
+
+    memcpy(&count, buffer, sizeof(count));
+    count = madara::utility::endian_swap(count);
+    buffer += sizeof(count);
+
+    size -= sizeof(start) + sizeof(count);
+
+    if ((uint64_t)start + count > values.size() ||
+        (uint64_t)count * sizeof(T) > size)
+      return false;
+
+    if (!check_only)
+    {
+      madara::utility::endian_swap_64(values.data() + start, buffer, count);
+    }
+
+    buffer += count * sizeof(T);
+    size -= count * sizeof(T);
+  }
+
+  return true;
+}
+
+inline bool KnowledgeRecord::apply_delta(
+    uint32_t type, const char* buffer, uint32_t size)
+{
+  // format is [base_clock | elements | base_hash | ranges | list of ranges]
+
+  uint32_t elements = 0;
+  uint32_t ranges = 0;
+  size_t header_size =
+      sizeof(uint64_t) + sizeof(elements) + sizeof(uint64_t) + sizeof(ranges);
+
+  if ((type & ~ARRAY_DELTA) != type_ || !is_array_type(type_) ||
+      size < header_size)
+    return false;
+
+  memcpy(&elements, buffer + sizeof(uint64_t), sizeof(elements));
+  elements = madara::utility::endian_swap(elements);
+
+  memcpy(&ranges, buffer + sizeof(uint64_t) + sizeof(elements) +
+                      sizeof(uint64_t),
+      sizeof(ranges));
+  ranges = madara::utility::endian_swap(ranges);
+
+  if (elements != this->size())
+    return false;
+
+  buffer += header_size;
+  size -= (uint32_t)header_size;
+
+  // check every range before changing anything, so that a malformed
+  // delta leaves the value as it was
+  if (type_ == INTEGER_ARRAY)
+  {
+    if (!patch_ranges(*int_array_, buffer, ranges, size, true))
+      return false;
+
+    // never patch storage that another record is looking at
+    if (int_array_.use_count() != 1)
+      emplace_integers(*int_array_);
+
+    shared_ = OWNED;
+    return patch_ranges(*int_array_, buffer, ranges, size, false);
+  }
+  else
+  {
+    if (!patch_ranges(*double_array_, buffer, ranges, size, true))
+      return false;
+
+    if (double_array_.use_count() != 1)
+      emplace_doubles(*double_array_);
+
+    shared_ = OWNED;
+    return patch_ranges(*double_array_, buffer, ranges, size, false);
+  }
+}
+
 inline const char* KnowledgeRecord::read(
     const char* buffer, uint32_t& key_id, int64_t& buffer_remaining)
 {
@@ -1617,6 +1846,112 @@ KnowledgeRecord::share_doubles() const
   return nullptr;
 }
 
+inline const std::vector<KnowledgeRecord::Integer>*
+KnowledgeRecord::peek_integers(void) const
+{
+  if (type_ == INTEGER_ARRAY)
+  {
+    return int_array_.get();
+  }
+  else if (has_history() && !buf_->empty())
+  {
+    return ref_newest().peek_integers();
+  }
+  return nullptr;
+}
+
+inline const std::vector<double>* KnowledgeRecord::peek_doubles(void) const
+{
+  if (type_ == DOUBLE_ARRAY)
+  {
+    return double_array_.get();
+  }
+  else if (has_history() && !buf_->empty())
+  {
+    return ref_newest().peek_doubles();
+  }
+  return nullptr;
+}
+
+inline std::vector<KnowledgeRecord::Integer>&
+KnowledgeRecord::resize_integers(size_t size)
+{
+  if (has_history())
+  {
+    // the new entry starts with the elements of the newest one
+    std::vector<Integer> values(size);
+    const std::vector<Integer>* newest = peek_integers();
+
+    if (newest)
+      std::copy(newest->begin(),
+          newest->begin() + std::min(size, newest->size()), values.begin());
+
+    emplace_integers(std::move(values));
+    return *ref_newest().int_array_;
+  }
+
+  // copies of this record share the array until one of them changes it
+  if (type_ == INTEGER_ARRAY && int_array_.use_count() == 1)
+  {
+    int_array_->resize(size);
+  }
+  else if (type_ == INTEGER_ARRAY)
+  {
+    std::vector<Integer> values;
+    values.reserve(size);
+    values.assign(int_array_->begin(),
+        int_array_->begin() + std::min(size, int_array_->size()));
+    values.resize(size);
+    emplace_integers(std::move(values));
+  }
+  else
+  {
+    emplace_integers(size);
+  }
+
+  shared_ = OWNED;
+  return *int_array_;
+}
+
+inline std::vector<double>& KnowledgeRecord::resize_doubles(size_t size)
+{
+  if (has_history())
+  {
+    // the new entry starts with the elements of the newest one
+    std::vector<double> values(size);
+    const std::vector<double>* newest = peek_doubles();
+
+    if (newest)
+      std::copy(newest->begin(),
+          newest->begin() + std::min(size, newest->size()), values.begin());
+
+    emplace_doubles(std::move(values));
+    return *ref_newest().double_array_;
+  }
+
+  // copies of this record share the array until one of them changes it
+  if (type_ == DOUBLE_ARRAY && double_array_.use_count() == 1)
+  {
+    double_array_->resize(size);
+  }
+  else if (type_ == DOUBLE_ARRAY)
+  {
+    std::vector<double> values;
+    values.reserve(size);
+    values.assign(double_array_->begin(),
+        double_array_->begin() + std::min(size, double_array_->size()));
+    values.resize(size);
+    emplace_doubles(std::move(values));
+  }
+  else
+  {
+    emplace_doubles(size);
+  }
+
+  shared_ = OWNED;
+  return *double_array_;
+}
+
 inline std::shared_ptr<const std::vector<unsigned char>>
 KnowledgeRecord::share_binary() const
 {
@@ -1757,14 +2092,7 @@ inline char* KnowledgeRecord::write(
       if (buffer_remaining >= int64_t(size * sizeof(Integer)))
       {
         // convert integers to network byte order
-        const Integer* ptr_temp = &(*int_array_)[0];
-        Integer* target_buffer = (Integer*)buffer;
-
-        for (uint32_t i = 0; i < size; ++i, ++ptr_temp, ++target_buffer)
-        {
-          integer_temp = madara::utility::endian_swap(*ptr_temp);
-          memcpy(target_buffer, &integer_temp, sizeof(Integer));
-        }
+        madara::utility::endian_swap_64(buffer, int_array_->data(), size);
 
         size_intermediate = size * sizeof(Integer);
       }
@@ -1783,15 +2111,8 @@ inline char* KnowledgeRecord::write(
     {
       if (buffer_remaining >= int64_t(size * sizeof(double)))
       {
-        // convert integers to network byte order
-        const double* ptr_temp = &(*double_array_)[0];
-        double* target_buffer = (double*)buffer;
-
-        for (uint32_t i = 0; i < size; ++i, ++ptr_temp, ++target_buffer)
-        {
-          double_temp = madara::utility::endian_swap(*ptr_temp);
-          memcpy(target_buffer, &double_temp, sizeof(double_temp));
-        }
+        // convert doubles to network byte order
+        madara::utility::endian_swap_64(buffer, double_array_->data(), size);
 
         size_intermediate = size * sizeof(double);
 
@@ -1878,9 +2199,6 @@ inline char* KnowledgeRecord::write(
 {
   // format is [key_size | key | type | value_size | value]
 
-  uint32_t key_size = uint32_t(key.size() + 1);
-  uint32_t uint32_temp;
-
   int64_t encoded_size = get_encoded_size(key);
 
   if (buffer_remaining >= encoded_size)
@@ -1890,33 +2208,181 @@ inline char* KnowledgeRecord::write(
         " encoding %" PRId64 " byte message\n",
         encoded_size);
 
-    // Remove the key size from the buffer
-    if (buffer_remaining >= (int64_t)sizeof(key_size))
+    buffer = write_key(buffer, key, buffer_remaining);
+
+    // write the type and value of the record
+    buffer = write(buffer, buffer_remaining);
+  }
+  else
+  {
+    std::stringstream buffer;
+    buffer << "KnowledgeRecord::write: ";
+    buffer << encoded_size << " byte encoding cannot fit in ";
+    buffer << buffer_remaining << " byte buffer\n";
+
+    madara_logger_ptr_log(logger_, logger::LOG_ERROR, buffer.str().c_str());
+
+    throw exceptions::MemoryException(buffer.str());
+  }
+  return buffer;
+}
+
+inline char* KnowledgeRecord::write_key(
+    char* buffer, const std::string& key, int64_t& buffer_remaining)
+{
+  // format is [key_size | key]
+
+  uint32_t key_size = uint32_t(key.size() + 1);
+
+  if (buffer_remaining < (int64_t)(sizeof(key_size) + key_size))
+  {
+    std::stringstream buffer;
+    buffer << "KnowledgeRecord::write_key: ";
+    buffer << key_size << " byte key cannot fit in ";
+    buffer << buffer_remaining << " byte buffer\n";
+
+    throw exceptions::MemoryException(buffer.str());
+  }
+
+  uint32_t uint32_temp = madara::utility::endian_swap(key_size);
+  memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+  buffer += sizeof(key_size);
+
+  // copy the string and set null terminator in buffer
+  memcpy(buffer, key.c_str(), key_size - 1);
+  buffer[key_size - 1] = 0;
+  buffer += sizeof(char) * key_size;
+
+  buffer_remaining -= sizeof(key_size) + sizeof(char) * key_size;
+
+  return buffer;
+}
+
+template<typename T>
+inline uint64_t KnowledgeRecord::hash_elements(const std::vector<T>& values)
+{
+  // FNV-1a over the bits of each element rather than each byte, which
+  // is plenty to tell apart values that were not meant to be the same
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (const T& value : values)
+  {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    hash = (hash ^ bits) * 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+inline uint64_t KnowledgeRecord::get_array_hash(void) const
+{
+  if (type_ == INTEGER_ARRAY)
+    return hash_elements(*int_array_);
+  else if (type_ == DOUBLE_ARRAY)
+    return hash_elements(*double_array_);
+
+  return 0;
+}
+
+template<typename T, typename Func>
+inline void KnowledgeRecord::for_each_changed_range(
+    const std::vector<T>& values, const std::vector<T>& base, Func func)
+{
+  size_t size = values.size();
+  size_t i = 0;
+
+  // compare bytes, so that NaNs that did not change are not sent
+  const auto changed = [&](size_t index) {
+    return memcmp(&values[index], &base[index], sizeof(T)) != 0;
+  };
+
+  while (i < size)
+  {
+    if (!changed(i))
     {
-      uint32_temp = madara::utility::endian_swap(key_size);
-      memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
-      buffer += sizeof(key_size);
+      ++i;
+      continue;
     }
-    buffer_remaining -= sizeof(key_size);
 
-    // Remove the key from the buffer
-    if (buffer_remaining >= (int64_t)sizeof(char) * key_size)
-    {
-      // copy the string and set null terminator in buffer
-      strncpy(buffer, key.c_str(), key_size - 1);
-      buffer[key_size - 1] = 0;
+    size_t start = i;
 
-      buffer += sizeof(char) * key_size;
-    }
-    buffer_remaining -= sizeof(char) * key_size;
+    while (i < size && changed(i))
+      ++i;
 
-    // write the type and value of the record
-    buffer = write(buffer, buffer_remaining);
+    func((uint32_t)start, (uint32_t)(i - start));
   }
+}
+
+template<typename T>
+inline char* KnowledgeRecord::write_changed_ranges(char* buffer,
+    const std::vector<T>& values, const std::vector<T>& base, uint32_t& ranges)
+{
+  ranges = 0;
+
+  for_each_changed_range(values, base, [&](uint32_t start, uint32_t count) {
+    uint32_t uint32_temp = madara::utility::endian_swap(start);
+    memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+    buffer += sizeof(uint32_temp);
+
+    uint32_temp = madara::utility::endian_swap(count);
+    memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+    buffer += sizeof(uint32_temp);
+
+    madara::utility::endian_swap_64(buffer, values.data() + start, count);
+    buffer += count * sizeof(T);
+
+    ++ranges;
+  });
+
+  return buffer;
+}
+
+inline int64_t KnowledgeRecord::get_delta_encoded_size(
+    const KnowledgeRecord& base) const
+{
+  if (!is_array_type(type_) || base.type_ != type_ || base.size() != size())
+    return -1;
+
+  // [type | value_size | toi | base_clock | elements | base_hash | ranges]
+  int64_t buffer_size(sizeof(type_) + sizeof(uint32_t) + sizeof(toi_) +
+                      sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t) +
+                      sizeof(uint32_t));
+
+  int64_t element_size =
+      type_ == INTEGER_ARRAY ? sizeof(Integer) : sizeof(double);
+
+  const auto add_range = [&](uint32_t, uint32_t count) {
+    buffer_size += sizeof(uint32_t) * 2 + count * element_size;
+  };
+
+  if (type_ == INTEGER_ARRAY)
+    for_each_changed_range(*int_array_, *base.int_array_, add_range);
   else
+    for_each_changed_range(*double_array_, *base.double_array_, add_range);
+
+  return buffer_size;
+}
+
+inline char* KnowledgeRecord::write_delta(char* buffer,
+    const KnowledgeRecord& base, uint64_t base_clock,
+    int64_t& buffer_remaining) const
+{
+  // format is [type | value_size | toi | base_clock | elements |
+  //            base_hash | ranges | list of ranges]
+
+  int64_t encoded_size = get_delta_encoded_size(base);
+
+  if (encoded_size < 0)
+  {
+    return write(buffer, buffer_remaining);
+  }
+
+  if (buffer_remaining < encoded_size)
   {
     std::stringstream buffer;
-    buffer << "KnowledgeRecord::write: ";
+    buffer << "KnowledgeRecord::write_delta: ";
     buffer << encoded_size << " byte encoding cannot fit in ";
     buffer << buffer_remaining << " byte buffer\n";
 
@@ -1924,6 +2390,57 @@ inline char* KnowledgeRecord::write(
 
     throw exceptions::MemoryException(buffer.str());
   }
+
+  madara_logger_ptr_log(logger_, logger::LOG_MINOR,
+      "KnowledgeRecord::write_delta:"
+      " encoding %" PRId64 " byte delta of %" PRId64 " byte array\n",
+      encoded_size, get_encoded_size());
+
+  uint32_t uint32_temp = madara::utility::endian_swap(
+      (uint32_t)(type_ | ARRAY_DELTA));
+  memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+  buffer += sizeof(uint32_temp);
+
+  // everything after the toi is the value
+  uint32_temp = madara::utility::endian_swap((uint32_t)(
+      encoded_size - sizeof(type_) - sizeof(uint32_t) - sizeof(toi_)));
+  memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+  buffer += sizeof(uint32_temp);
+
+  decltype(toi_) toi_temp = madara::utility::endian_swap(toi_);
+  memcpy(buffer, &toi_temp, sizeof(toi_temp));
+  buffer += sizeof(toi_temp);
+
+  uint64_t uint64_temp = madara::utility::endian_swap(base_clock);
+  memcpy(buffer, &uint64_temp, sizeof(uint64_temp));
+  buffer += sizeof(uint64_temp);
+
+  uint32_temp = madara::utility::endian_swap(size());
+  memcpy(buffer, &uint32_temp, sizeof(uint32_temp));
+  buffer += sizeof(uint32_temp);
+
+  uint64_temp = madara::utility::endian_swap(base.get_array_hash());
+  memcpy(buffer, &uint64_temp, sizeof(uint64_temp));
+  buffer += sizeof(uint64_temp);
+
+  // the number of ranges is known once they are written
+  char* ranges_location = buffer;
+  buffer += sizeof(uint32_t);
+
+  uint32_t ranges = 0;
+
+  if (type_ == INTEGER_ARRAY)
+    buffer =
+        write_changed_ranges(buffer, *int_array_, *base.int_array_, ranges);
+  else
+    buffer = write_changed_ranges(
+        buffer, *double_array_, *base.double_array_, ranges);
+
+  uint32_temp = madara::utility::endian_swap(ranges);
+  memcpy(ranges_location, &uint32_temp, sizeof(uint32_temp));
+
+  buffer_remaining -= encoded_size;
+
   return buffer;
 }
 
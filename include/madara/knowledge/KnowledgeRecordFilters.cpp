@@ -72,6 +72,33 @@ void madara::knowledge::KnowledgeRecordFilters::add(uint32_t types,
   }
 }
 
+void madara::knowledge::KnowledgeRecordFilters::add(uint32_t types,
+    void (*function)(KnowledgeRecord&, const std::string&,
+        transport::TransportContext&))
+{
+  if (function != 0)
+  {
+    madara_logger_cond_log(context_, context_->get_logger(),
+        logger::global_logger.get(), logger::LOG_MAJOR,
+        "KnowledgeRecordFilters::add: "
+        "Adding C in-place record filter\n");
+
+    // start with 1st bit, check every bit until types is 0
+    for (uint32_t cur = 1; types > 0; cur <<= 1)
+    {
+      // if current is set in the bitmask
+      if (madara::utility::bitmask_check(types, cur))
+      {
+        // remove the filter list from the type cur
+        filters_[cur].push_back(Function(function));
+      }
+
+      // remove the current flag from the types
+      types = madara::utility::bitmask_remove(types, cur);
+    }
+  }
+}
+
 void madara::knowledge::KnowledgeRecordFilters::add(void (*function)(
     KnowledgeMap&, const transport::TransportContext&, Variables&))
 {
@@ -276,6 +303,78 @@ void madara::knowledge::KnowledgeRecordFilters::print_num_filters(void) const
   }
 }
 
+namespace
+{
+/**
+ * Sets a string argument, unless it already holds the value, so that
+ * arguments that rarely change are not reallocated for every record
+ **/
+inline void set_string_argument(
+    madara::knowledge::KnowledgeRecord& argument, const std::string& value)
+{
+  if (argument.type() != madara::knowledge::KnowledgeRecord::STRING ||
+      *argument.share_string() != value)
+  {
+    argument.set_value(value);
+  }
+}
+}
+
+madara::knowledge::KnowledgeRecordFilters::ScratchLease::ScratchLease(
+    const KnowledgeRecordFilters& filters)
+  : filters_(filters)
+{
+}
+
+madara::knowledge::KnowledgeRecordFilters::ScratchLease::~ScratchLease()
+{
+  if (scratch_)
+  {
+    FunctionArguments& arguments = scratch_->arguments;
+
+    // don't hold on to the filtered value or records added by filters,
+    // which would keep shared arrays from being changed in place
+    if (arguments.size() > madara::filters::TOTAL_ARGUMENTS)
+    {
+      arguments.resize(madara::filters::TOTAL_ARGUMENTS);
+    }
+
+    if (arguments.size() > 0)
+    {
+      arguments[0].clear_value();
+    }
+
+    MADARA_GUARD_TYPE guard(filters_.scratch_mutex_);
+    filters_.scratch_pool_.push_back(std::move(scratch_));
+  }
+}
+
+madara::knowledge::KnowledgeRecordFilters::FilterScratch&
+madara::knowledge::KnowledgeRecordFilters::ScratchLease::get(void)
+{
+  if (!scratch_)
+  {
+    {
+      MADARA_GUARD_TYPE guard(filters_.scratch_mutex_);
+
+      if (filters_.scratch_pool_.size() > 0)
+      {
+        scratch_ = std::move(filters_.scratch_pool_.back());
+        filters_.scratch_pool_.pop_back();
+      }
+    }
+
+    if (!scratch_)
+    {
+      scratch_.reset(new FilterScratch());
+    }
+
+    scratch_->variables.context_ = filters_.context_;
+  }
+
+  return *scratch_;
+}
+
 madara::knowledge::KnowledgeRecord
 madara::knowledge::KnowledgeRecordFilters::filter(
     const knowledge::KnowledgeRecord& input, const std::string& name,
@@ -295,15 +394,28 @@ madara::knowledge::KnowledgeRecordFilters::filter(
         "Entering record filter logic\n");
 
     const FilterChain& chain = type_match->second;
-    FunctionArguments arguments;
 
-    // JVMs appear to do strange things with the stack on jni_attach
-    std::unique_ptr<Variables> heap_variables(new Variables());
-
-    heap_variables->context_ = context_;
+    // arguments are only packed if a filter in the chain needs them
+    ScratchLease scratch(*this);
 
     for (FilterChain::const_iterator i = chain.begin(); i != chain.end(); ++i)
     {
+      if (i->is_record_filter())
+      {
+        madara_logger_cond_log(context_, context_->get_logger(),
+            logger::global_logger.get(), logger::LOG_MAJOR,
+            "KnowledgeRecordFilters::filter: "
+            "Calling in-place C filter\n");
+
+        i->record_filter(result, name, transport_context);
+        continue;
+      }
+
+      FunctionArguments& arguments = scratch.get().arguments;
+
+      // JVMs appear to do strange things with the stack on jni_attach
+      Variables* heap_variables = &scratch.get().variables;
+
       madara_logger_cond_log(context_, context_->get_logger(),
           logger::global_logger.get(), logger::LOG_MAJOR,
           "KnowledgeRecordFilters::filter: "
@@ -316,10 +428,14 @@ madara::knowledge::KnowledgeRecordFilters::filter(
 
       arguments.resize(madara::filters::TOTAL_ARGUMENTS);
 
+      // second argument is the variable name, if applicable
       if (name != "")
       {
-        // second argument is the variable name, if applicable
-        arguments[1].set_value(name);
+        set_string_argument(arguments[1], name);
+      }
+      else if (arguments[1].exists())
+      {
+        arguments[1].clear_value();
       }
 
       // third argument is the operation being performed
@@ -343,10 +459,10 @@ madara::knowledge::KnowledgeRecordFilters::filter(
           KnowledgeRecord::Integer(transport_context.get_current_time()));
 
       // seventh argument is the networking domain
-      arguments[7].set_value(transport_context.get_domain());
+      set_string_argument(arguments[7], transport_context.get_domain());
 
       // eighth argument is the update originator
-      arguments[8].set_value(transport_context.get_originator());
+      set_string_argument(arguments[8], transport_context.get_originator());
 
       // setup arguments to the function
       arguments[0] = result;
@@ -364,7 +480,7 @@ madara::knowledge::KnowledgeRecordFilters::filter(
             "KnowledgeRecordFilters::filter: "
             "Calling functor filter\n");
 
-        result = i->functor->filter(arguments, *heap_variables.get());
+        result = i->functor->filter(arguments, *heap_variables);
       }
 #ifdef _MADARA_JAVA_
       else if (i->is_java_callable())
@@ -388,22 +504,23 @@ madara::knowledge::KnowledgeRecordFilters::filter(
         jmethodID fromPointerCall = jvm.env->GetStaticMethodID(
             jvarClass, "fromPointer", "(J)Lai/madara/knowledge/Variables;");
         jobject jvariables = jvm.env->CallStaticObjectMethod(
-            jvarClass, fromPointerCall, (jlong)heap_variables.get());
+            jvarClass, fromPointerCall, (jlong)heap_variables);
 
         // prep to create the KnowledgeList
         jmethodID listConstructor =
             jvm.env->GetMethodID(jlistClass, "<init>", "([J)V");
 
         jlongArray ret = jvm.env->NewLongArray((jsize)arguments.size());
-        jlong* tmp = new jlong[(jsize)arguments.size()];
+        std::vector<jlong>& tmp = scratch.get().java_arguments;
+        tmp.resize(arguments.size());
 
         for (unsigned int x = 0; x < arguments.size(); x++)
         {
           tmp[x] = (jlong)arguments[x].clone();
         }
 
-        jvm.env->SetLongArrayRegion(ret, 0, (jsize)arguments.size(), tmp);
-        delete[] tmp;
+        jvm.env->SetLongArrayRegion(
+            ret, 0, (jsize)arguments.size(), tmp.data());
 
         // create the KnowledgeList
         jobject jlist = jvm.env->NewObject(jlistClass, listConstructor, ret);
@@ -495,7 +612,7 @@ madara::knowledge::KnowledgeRecordFilters::filter(
         // some guides have stated that we should let python handle exceptions
         result = boost::python::call<madara::knowledge::KnowledgeRecord>(
             i->python_function.ptr(), boost::ref(arguments),
-            boost::ref(*heap_variables.get()));
+            boost::ref(*heap_variables));
       }
 #endif
 
@@ -507,7 +624,7 @@ madara::knowledge::KnowledgeRecordFilters::filter(
             "KnowledgeRecordFilters::filter: "
             "Calling unnamed C filter\n");
 
-        result = i->extern_unnamed(arguments, *heap_variables.get());
+        result = i->extern_unnamed(arguments, *heap_variables);
       }
 
       // did the filter add records to be sent?
@@ -558,9 +675,8 @@ void madara::knowledge::KnowledgeRecordFilters::filter(KnowledgeMap& records,
         "Entering aggregate filter method\n");
 
     // JVMs appear to do strange things with the stack on jni_attach
-    std::unique_ptr<Variables> heap_variables(new Variables());
-
-    heap_variables->context_ = context_;
+    ScratchLease scratch(*this);
+    Variables* heap_variables = &scratch.get().variables;
 
     for (AggregateFilters::const_iterator i = aggregate_filters_.begin();
          i != aggregate_filters_.end(); ++i)
@@ -573,7 +689,7 @@ void madara::knowledge::KnowledgeRecordFilters::filter(KnowledgeMap& records,
             "KnowledgeRecordFilters::filter: "
             "Checking vars for null\n");
 
-        Variables* vars = heap_variables.get();
+        Variables* vars = heap_variables;
         if (vars)
         {
           madara_logger_cond_log(context_, context_->get_logger(),
@@ -620,7 +736,7 @@ void madara::knowledge::KnowledgeRecordFilters::filter(KnowledgeMap& records,
         jmethodID varfromPointerCall = jvm.env->GetStaticMethodID(
             jvarClass, "fromPointer", "(J)Lai/madara/knowledge/Variables;");
         jobject jvariables = jvm.env->CallStaticObjectMethod(
-            jvarClass, varfromPointerCall, (jlong)heap_variables.get());
+            jvarClass, varfromPointerCall, (jlong)heap_variables);
 
         jmethodID packetfromPointerCall =
             jvm.env->GetStaticMethodID(jpacketClass, "fromPointer",
@@ -684,14 +800,14 @@ void madara::knowledge::KnowledgeRecordFilters::filter(KnowledgeMap& records,
         // some guides have stated that we should let python handle exceptions
         boost::python::call<madara::knowledge::KnowledgeRecord>(
             i->python_function.ptr(), boost::ref(records),
-            boost::ref(transport_context), boost::ref(*heap_variables.get()));
+            boost::ref(transport_context), boost::ref(*heap_variables));
       }
 #endif
 
       // if the function is not zero
       else if (i->is_extern_unnamed())
       {
-        i->unnamed_filter(records, transport_context, *heap_variables.get());
+        i->unnamed_filter(records, transport_context, *heap_variables);
       }
     }
   }
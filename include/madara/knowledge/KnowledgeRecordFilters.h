@@ -15,6 +15,8 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <memory>
+#include "madara/LockType.h"
 #include "madara/knowledge/KnowledgeRecord.h"
 #include "madara/knowledge/Functions.h"
 #include "madara/knowledge/ThreadSafeContext.h"
@@ -81,6 +83,19 @@ public:
   void add(uint32_t types,
       knowledge::KnowledgeRecord (*function)(FunctionArguments&, Variables&));
 
+  /**
+   * Adds a filter that changes the record in place, without the
+   * FunctionArguments and Variables other filters are called with.
+   * Setting the record to a default KnowledgeRecord removes the
+   * variable from the operation.
+   * @param   types      the types to add the filter to
+   * @param   function   the function that will take the knowledge record,
+   *                     the name of the variable and the transport context
+   **/
+  void add(uint32_t types,
+      void (*function)(KnowledgeRecord&, const std::string&,
+          transport::TransportContext&));
+
   /**
    * Adds an aggregate filter
    * @param function     the function that will filter the aggregation
@@ -266,6 +281,70 @@ protected:
    * Context used by this filter
    **/
   ThreadSafeContext* context_;
+
+  /**
+   * State reused between calls to filters, so that filtering a record
+   * does not allocate its arguments each time
+   **/
+  struct FilterScratch
+  {
+    /// arguments passed to record filters
+    FunctionArguments arguments;
+
+    /// variables passed to filters, on the heap for JVM attachment
+    Variables variables;
+
+#ifdef _MADARA_JAVA_
+    /// pointers to the arguments passed to Java filters
+    std::vector<jlong> java_arguments;
+#endif
+  };
+
+  /**
+   * Lends a FilterScratch from the pool for the duration of a call to
+   * the filters, and returns it to the pool when destroyed
+   **/
+  class ScratchLease
+  {
+  public:
+    /**
+     * Constructor
+     * @param  filters   the filters whose pool is borrowed from
+     **/
+    ScratchLease(const KnowledgeRecordFilters& filters);
+
+    /**
+     * Destructor. Returns the scratch state to the pool.
+     **/
+    ~ScratchLease();
+
+    /**
+     * Returns the scratch state, taking it from the pool on first use
+     * @return  the scratch state
+     **/
+    FilterScratch& get(void);
+
+  private:
+    ScratchLease(const ScratchLease&) = delete;
+    void operator=(const ScratchLease&) = delete;
+
+    /// the filters whose pool is borrowed from
+    const KnowledgeRecordFilters& filters_;
+
+    /// the borrowed scratch state, or null if not yet used
+    std::unique_ptr<FilterScratch> scratch_;
+  };
+
+  /**
+   * Scratch state not in use. Grows to the number of threads that
+   * filter at once. Not copied with the filters.
+   **/
+  mutable std::vector<std::unique_ptr<FilterScratch>> scratch_pool_;
+
+  /**
+   * Protects the scratch pool from concurrent read threads
+   **/
+  mutable MADARA_LOCK_TYPE scratch_mutex_;
 };
 }
 }
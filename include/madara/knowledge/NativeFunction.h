@@ -0,0 +1,134 @@
+#ifndef _MADARA_KNOWLEDGE_NATIVE_FUNCTION_H_
+#define _MADARA_KNOWLEDGE_NATIVE_FUNCTION_H_
+
+#include <type_traits>
+#include <utility>
+#include "madara/knowledge/KnowledgeRecord.h"
+
+/**
+ * @file NativeFunction.h
+ *
+ * This file contains the NativeFunction interface and the TypedFunction
+ * template, which let C++ functions with ordinary argument and return types
+ * be called from KaRL without packing arguments into a FunctionArguments
+ * vector, e.g., kb.define_function<double(double, double)> ("hypot", hypot)
+ **/
+
+namespace madara
+{
+namespace knowledge
+{
+/**
+ * @class NativeFunction
+ * @brief Interface for functions that take their arguments as an array of
+ *        records that the calling node owns and reuses between calls
+ */
+class NativeFunction
+{
+public:
+  /**
+   * Destructor
+   **/
+  virtual ~NativeFunction() = default;
+
+  /**
+   * Calls the function
+   * @param  args    the evaluated arguments of the call
+   * @param  count   the number of arguments
+   * @return the result of the function
+   **/
+  virtual KnowledgeRecord call(const KnowledgeRecord* args, size_t count) = 0;
+};
+
+namespace impl
+{
+/// A list of argument indices
+template<size_t... Indices>
+struct indices
+{
+};
+
+/// Builds indices<0, 1, ..., Count - 1>
+template<size_t Count, size_t... Indices>
+struct make_indices : make_indices<Count - 1, Count - 1, Indices...>
+{
+};
+
+template<size_t... Indices>
+struct make_indices<0, Indices...>
+{
+  typedef indices<Indices...> type;
+};
+
+/**
+ * Returns an argument of a call, or an empty record if the call was
+ * given too few arguments
+ **/
+inline const KnowledgeRecord& native_argument(
+    const KnowledgeRecord* args, size_t count, size_t index)
+{
+  static const KnowledgeRecord missing;
+  return index < count ? args[index] : missing;
+}
+}
+
+/**
+ * @class TypedFunction
+ * @brief Adapts a callable with the signature R(Args...) to the
+ *        NativeFunction interface. Arguments are converted with
+ *        knowledge_cast, and the result is converted back to a record.
+ *        Missing arguments are converted from an empty record, and extra
+ *        arguments are ignored.
+ */
+template<typename Signature, typename Callable>
+class TypedFunction;
+
+template<typename R, typename... Args, typename Callable>
+class TypedFunction<R(Args...), Callable> : public NativeFunction
+{
+public:
+  /**
+   * Constructor
+   * @param  callable   the function to call
+   **/
+  TypedFunction(Callable callable) : callable_(std::move(callable)) {}
+
+  /**
+   * Calls the function
+   * @param  args    the evaluated arguments of the call
+   * @param  count   the number of arguments
+   * @return the result of the function
+   **/
+  virtual KnowledgeRecord call(const KnowledgeRecord* args, size_t count)
+  {
+    return invoke(args, count,
+        typename impl::make_indices<sizeof...(Args)>::type(),
+        std::is_void<R>());
+  }
+
+private:
+  template<size_t... Indices>
+  KnowledgeRecord invoke(const KnowledgeRecord* args, size_t count,
+      impl::indices<Indices...>, std::false_type)
+  {
+    return knowledge_cast(callable_(
+        knowledge_cast<typename std::decay<Args>::type>(
+            impl::native_argument(args, count, Indices))...));
+  }
+
+  template<size_t... Indices>
+  KnowledgeRecord invoke(const KnowledgeRecord* args, size_t count,
+      impl::indices<Indices...>, std::true_type)
+  {
+    callable_(knowledge_cast<typename std::decay<Args>::type>(
+        impl::native_argument(args, count, Indices))...);
+    return KnowledgeRecord();
+  }
+
+  /// the function to call
+  Callable callable_;
+};
+}
+}
+
+#endif  // _MADARA_KNOWLEDGE_NATIVE_FUNCTION_H_
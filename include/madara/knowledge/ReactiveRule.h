@@ -0,0 +1,80 @@
+#ifndef _MADARA_KNOWLEDGE_REACTIVE_RULE_H_
+#define _MADARA_KNOWLEDGE_REACTIVE_RULE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+/**
+ * @file ReactiveRule.h
+ *
+ * This file contains the ReactiveRule class, which holds a rule that
+ * ThreadSafeContext::evaluate_rules evaluates only when its inputs change
+ **/
+
+#include <string>
+#include <vector>
+#include "madara/knowledge/ChangeSubscriber.h"
+#include "madara/knowledge/CompiledExpression.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+
+namespace madara
+{
+namespace knowledge
+{
+/**
+ * @class ReactiveRule
+ * @brief A compiled expression with the result of its last evaluation and
+ *        a flag that is set when a variable it reads changes
+ */
+class ReactiveRule : public ChangeSubscriber
+{
+public:
+  /**
+   * Constructor
+   * @param  logic     the compiled rule
+   **/
+  ReactiveRule(const CompiledExpression& logic)
+    : logic(logic), dynamic(false), dirty(true), subscribed(false)
+  {
+  }
+
+  /**
+   * Marks the rule for evaluation
+   **/
+  virtual void modified(const VariableReference&)
+  {
+    dirty = true;
+  }
+
+  /**
+   * Marks the rule for evaluation and for subscribing again
+   **/
+  virtual void unsubscribed(void)
+  {
+    dirty = true;
+    subscribed = false;
+  }
+
+  /// the compiled rule
+  CompiledExpression logic;
+
+  /// the variables the rule reads
+  std::vector<std::string> reads;
+
+  /// the result of the last evaluation
+  KnowledgeRecord result;
+
+  /// true if the inputs of the rule are not known until it is evaluated
+  bool dynamic;
+
+  /// true if an input has changed since the last evaluation
+  bool dirty;
+
+  /// true if the rule is subscribed to the variables it reads
+  bool subscribed;
+};
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_KNOWLEDGE_REACTIVE_RULE_H_
@@ -2,6 +2,7 @@
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <algorithm>
 #include <memory>
 
 #include <string.h>
@@ -19,6 +20,8 @@
 #include "madara/knowledge/ContextGuard.h"
 
 #include "madara/expression/Interpreter.h"
+#include "madara/expression/CompiledLogicNode.h"
+#include "madara/expression/DependencyVisitor.h"
 #include "madara/transport/Transport.h"
 
 #include "madara/knowledge/CheckpointPlayer.h"
@@ -48,6 +51,9 @@ ThreadSafeContext::ThreadSafeContext()
 // destructor
 ThreadSafeContext::~ThreadSafeContext(void)
 {
+  // subscribers may outlive the context, e.g., containers::Counter
+  clear_subscriptions();
+
 #ifndef _MADARA_NO_KARL_
   delete interpreter_;
 #endif  // _MADARA_NO_KARL_
@@ -76,9 +82,8 @@ KnowledgeRecord* ThreadSafeContext::get_record(
   if (*key_ptr == "")
     return 0;
 
-  // if the variable doesn't exist, hash maps create a record automatically
-  // when used in this manner
-  return &map_[*key_ptr];
+  // if the variable doesn't exist, create a record
+  return &emplace_unsafe(*key_ptr)->second;
 }
 
 VariableReference ThreadSafeContext::get_ref(
@@ -102,14 +107,7 @@ VariableReference ThreadSafeContext::get_ref(
     return {};
   }
 
-  auto iter = map_.lower_bound(*key_ptr);
-  if (iter == map_.end() || iter->first != *key_ptr)
-  {
-    iter = map_.emplace_hint(iter, std::piecewise_construct,
-        std::forward_as_tuple(*key_ptr), std::forward_as_tuple());
-  }
-
-  return &*iter;
+  return emplace_unsafe(*key_ptr);
 }
 
 VariableReference ThreadSafeContext::get_ref(
@@ -117,7 +115,7 @@ VariableReference ThreadSafeContext::get_ref(
 {
   std::string key_actual;
   const std::string* key_ptr;
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   VariableReference record;
 
@@ -135,8 +133,7 @@ VariableReference ThreadSafeContext::get_ref(
     return {};
   }
 
-  KnowledgeMap::const_iterator found = map_.find(*key_ptr);
-  return {const_cast<VariableReference::pair_ptr>(&*found)};
+  return {const_cast<VariableReference::pair_ptr>(find_unsafe(*key_ptr))};
 }
 
 // set the value of a variable
@@ -280,7 +277,7 @@ uint32_t ThreadSafeContext::get_quality(
   // enter the mutex
   std::string key_actual;
   const std::string* key_ptr;
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
@@ -291,13 +288,10 @@ uint32_t ThreadSafeContext::get_quality(
     key_ptr = &key;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  const KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
-  // create the variable if it has never been written to before
-  // and update its current value quality to the quality parameter
-
-  if (found != map_.end())
-    return map_[*key_ptr].quality;
+  if (found)
+    return found->second.quality;
 
   // default quality is 0
   return 0;
@@ -311,7 +305,7 @@ uint32_t ThreadSafeContext::get_write_quality(
   // enter the mutex
   std::string key_actual;
   const std::string* key_ptr;
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
@@ -322,13 +316,10 @@ uint32_t ThreadSafeContext::get_write_quality(
     key_ptr = &key;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
-
-  // create the variable if it has never been written to before
-  // and update its current value quality to the quality parameter
+  const KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
-  if (found != map_.end())
-    return map_[*key_ptr].write_quality;
+  if (found)
+    return found->second.write_quality;
 
   // default quality is 0
   return 0;
@@ -358,16 +349,19 @@ uint32_t ThreadSafeContext::set_quality(const std::string& key,
     return 0;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // create the variable if it has never been written to before
   // and update its current value quality to the quality parameter
 
-  if (found == map_.end() || force_update || quality > found->second.quality)
-    map_[*key_ptr].quality = quality;
+  if (!found || force_update || quality > found->second.quality)
+  {
+    found = emplace_unsafe(*key_ptr);
+    found->second.quality = quality;
+  }
 
   // return current quality
-  return map_[*key_ptr].quality;
+  return found->second.quality;
 }
 
 /// Set quality of this process writing to a variable
@@ -389,7 +383,7 @@ void ThreadSafeContext::set_write_quality(const std::string& key,
 
   // create the variable if it has never been written to before
   // and update its local process write quality to the quality parameter
-  map_[*key_ptr].write_quality = quality;
+  emplace_unsafe(*key_ptr)->second.write_quality = quality;
 }
 
 /// Set if the variable value will be different. Always updates clock to
@@ -420,10 +414,10 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
     return -1;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // if it's found, then compare the value
-  if (!settings.always_overwrite && found != map_.end())
+  if (!settings.always_overwrite && found)
   {
     // setup a rhs
     KnowledgeRecord rhs;
@@ -445,9 +439,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
   }
   else
   {
-    auto ret = map_.emplace(std::piecewise_construct,
-        std::forward_as_tuple(*key_ptr), std::make_tuple());
-    found = ret.first;
+    found = emplace_unsafe(*key_ptr);
   }
 
   KnowledgeRecord& record = found->second;
@@ -472,7 +464,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
     record.clock = clock_;
     record.set_toi(utility::get_time());
 
-    mark_and_signal(&*found, settings);
+    mark_and_signal(found, settings);
   }
 
   // value was changed
@@ -506,10 +498,10 @@ int ThreadSafeContext::set_if_unequal(const std::string& key, double value,
     return -1;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // if it's found, then compare the value
-  if (!settings.always_overwrite && found != map_.end())
+  if (!settings.always_overwrite && found)
   {
     // setup a rhs
     KnowledgeRecord rhs;
@@ -531,9 +523,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key, double value,
   }
   else
   {
-    auto ret = map_.emplace(std::piecewise_construct,
-        std::forward_as_tuple(*key_ptr), std::make_tuple());
-    found = ret.first;
+    found = emplace_unsafe(*key_ptr);
   }
 
   KnowledgeRecord& record = found->second;
@@ -557,7 +547,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key, double value,
     record.clock = clock_;
     record.set_toi(utility::get_time());
 
-    mark_and_signal(&*found, settings);
+    mark_and_signal(found, settings);
   }
 
   // value was changed
@@ -592,10 +582,10 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
     return -1;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // if it's found, then compare the value
-  if (!settings.always_overwrite && found != map_.end())
+  if (!settings.always_overwrite && found)
   {
     // setup a rhs
     KnowledgeRecord rhs;
@@ -617,9 +607,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
   }
   else
   {
-    auto ret = map_.emplace(std::piecewise_construct,
-        std::forward_as_tuple(*key_ptr), std::make_tuple());
-    found = ret.first;
+    found = emplace_unsafe(*key_ptr);
   }
 
   KnowledgeRecord& record = found->second;
@@ -644,7 +632,7 @@ int ThreadSafeContext::set_if_unequal(const std::string& key,
     record.set_toi(utility::get_time());
 
     // otherwise set the value
-    mark_and_signal(&*found, settings);
+    mark_and_signal(found, settings);
   }
   // value was changed
   return result;
@@ -678,10 +666,10 @@ int ThreadSafeContext::update_record_from_external(const std::string& key,
     return -1;
 
   // find the key in the knowledge base
-  KnowledgeMap::iterator found = map_.find(*key_ptr);
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // if it's found, then compare the value
-  if (!settings.always_overwrite && found != map_.end())
+  if (!settings.always_overwrite && found)
   {
     // if we do not have enough quality to update the variable
     // return -2
@@ -697,21 +685,15 @@ int ThreadSafeContext::update_record_from_external(const std::string& key,
     // if we reach this point, then the record is safe to copy
     found->second.set_full(rhs);
 
-    mark_and_signal(&*found, settings);
+    mark_and_signal(found, settings);
   }
   else
   {
     // if we reach this point, then we have to create the record
-    auto ret = map_.emplace(std::piecewise_construct,
-        std::forward_as_tuple(*key_ptr), std::forward_as_tuple(rhs));
-    found = ret.first;
+    found = emplace_unsafe(*key_ptr);
+    found->second = rhs;
 
-    if (!ret.second)
-    {
-      ret.first->second = rhs;
-    }
-
-    mark_and_signal(&*found, settings);
+    mark_and_signal(found, settings);
   }
 
   // if we need to update the global clock, then update it
@@ -725,6 +707,122 @@ int ThreadSafeContext::update_record_from_external(const std::string& key,
   return result;
 }
 
+int ThreadSafeContext::update_record_from_external(const std::string& key,
+    const char*& buffer, int64_t& buffer_remaining, uint32_t quality,
+    uint64_t clock, uint64_t toi, const KnowledgeUpdateSettings& settings)
+{
+  // make sure the whole value is there before touching any variable
+  int64_t remaining = buffer_remaining;
+  const char* next = KnowledgeRecord::skip_value(buffer, remaining);
+
+  if (remaining < 0)
+  {
+    buffer_remaining = remaining;
+    return -1;
+  }
+
+  // enter the mutex
+  std::string key_actual;
+  const std::string* key_ptr;
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (settings.expand_variables)
+  {
+    key_actual = expand_statement(key);
+    key_ptr = &key_actual;
+  }
+  else
+    key_ptr = &key;
+
+  // check for null key
+  if (*key_ptr == "")
+  {
+    buffer = next;
+    buffer_remaining = remaining;
+    return -1;
+  }
+
+  // find the key in the knowledge base
+  KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
+
+  // an array delta can only patch the value it was computed from
+  bool delta = KnowledgeRecord::is_array_delta(buffer, buffer_remaining);
+
+  if (delta &&
+      (!found || !found->second.can_apply_delta(buffer, buffer_remaining)))
+  {
+    buffer = next;
+    buffer_remaining = remaining;
+    return -4;
+  }
+
+  if (!settings.always_overwrite && found)
+  {
+    int result = 0;
+
+    // same rules as update_record_from_external with a record
+    if (quality < found->second.quality)
+      result = -2;
+    else if (quality == found->second.quality && clock < found->second.clock)
+      result = -3;
+
+    if (result != 0)
+    {
+      buffer = next;
+      buffer_remaining = remaining;
+      return result;
+    }
+  }
+  else if (!found)
+  {
+    found = emplace_unsafe(*key_ptr);
+  }
+
+  KnowledgeRecord& record = found->second;
+
+  if (record.has_history())
+  {
+    // the history keeps each value, so it needs a record of its own,
+    // and a delta patches a copy of the newest value
+    KnowledgeRecord update;
+
+    if (delta)
+      update = record.get_newest();
+
+    buffer = update.read(buffer, buffer_remaining);
+
+    if (buffer_remaining < 0)
+      return -1;
+
+    update.quality = quality;
+    update.clock = clock;
+    update.set_toi(toi);
+
+    record.set_full(std::move(update));
+  }
+  else
+  {
+    buffer = record.read(buffer, buffer_remaining);
+
+    // an unknown type leaves the value as it was
+    if (buffer_remaining < 0)
+      return -1;
+
+    record.quality = quality;
+    record.write_quality = 0;
+    record.clock = clock;
+    record.set_toi(toi);
+  }
+
+  mark_and_signal(found, settings);
+
+  // if we need to update the global clock, then update it
+  if (clock >= this->clock_)
+    this->clock_ = clock + 1;
+
+  return 1;
+}
+
 /// Set if the variable value will be different. Always updates clock to
 /// highest value
 /// @return   1 if the value was changed. 0 if not changed.
@@ -765,6 +863,257 @@ int ThreadSafeContext::update_record_from_external(
   return result;
 }
 
+void ThreadSafeContext::subscribe(
+    const VariableReference& variable, ChangeSubscriber* subscriber)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (variable.is_valid() && subscriber)
+  {
+    subscribers_[variable.get_record_unsafe()].push_back(subscriber);
+  }
+}
+
+void ThreadSafeContext::unsubscribe(ChangeSubscriber* subscriber)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  for (auto i = subscribers_.begin(); i != subscribers_.end();)
+  {
+    std::vector<ChangeSubscriber*>& list = i->second;
+    list.erase(
+        std::remove(list.begin(), list.end(), subscriber), list.end());
+
+    if (list.empty())
+      i = subscribers_.erase(i);
+    else
+      ++i;
+  }
+}
+
+void ThreadSafeContext::notify_subscribers(const VariableReference& ref)
+{
+  auto found = subscribers_.find(ref.get_record_unsafe());
+
+  if (found != subscribers_.end())
+  {
+    for (ChangeSubscriber* subscriber : found->second)
+    {
+      subscriber->modified(ref);
+    }
+  }
+}
+
+void ThreadSafeContext::clear_subscriptions(void)
+{
+  if (!subscribers_.empty())
+  {
+    for (auto& entry : subscribers_)
+    {
+      for (ChangeSubscriber* subscriber : entry.second)
+      {
+        subscriber->unsubscribed();
+      }
+    }
+
+    subscribers_.clear();
+  }
+}
+
+uint64_t ThreadSafeContext::track_keys(const std::string& prefix)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  KeyLog& log = key_logs_[prefix];
+
+  // the log of a new prefix starts now
+  if (log.references++ == 0)
+  {
+    log.start = key_generation_;
+    key_log_lengths_.insert(prefix.size());
+  }
+
+  return key_generation_;
+}
+
+void ThreadSafeContext::untrack_keys(const std::string& prefix)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  std::map<std::string, KeyLog>::iterator log = key_logs_.find(prefix);
+
+  if (log != key_logs_.end() && --log->second.references == 0)
+  {
+    key_logs_.erase(log);
+
+    // other prefixes of the same length still need their logs checked
+    for (auto& other : key_logs_)
+    {
+      if (other.first.size() == prefix.size())
+        return;
+    }
+
+    key_log_lengths_.erase(prefix.size());
+  }
+}
+
+uint64_t ThreadSafeContext::get_key_generation(void) const
+{
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
+
+  return key_generation_;
+}
+
+std::weak_ptr<void> ThreadSafeContext::get_lifetime(void) const
+{
+  return lifetime_;
+}
+
+KeyChanges ThreadSafeContext::get_key_changes(
+    const std::string& prefix, uint64_t since) const
+{
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
+
+  KeyChanges result;
+  result.generation = key_generation_;
+
+  std::map<std::string, KeyLog>::const_iterator log = key_logs_.find(prefix);
+
+  if (since == 0 || log == key_logs_.end() || since < log->second.start)
+    return result;
+
+  result.complete = true;
+
+  // the first change to a key tells if it existed at since, and the last
+  // tells if it exists now
+  std::map<std::string, std::pair<bool, bool>> changed;
+
+  for (std::deque<KeyLogEntry>::const_reverse_iterator i =
+           log->second.entries.rbegin();
+       i != log->second.entries.rend() && i->generation > since; ++i)
+  {
+    auto inserted =
+        changed.emplace(i->key, std::make_pair(i->created, i->created));
+
+    if (!inserted.second)
+      inserted.first->second.first = i->created;
+  }
+
+  for (auto& key : changed)
+  {
+    if (!key.second.first)
+      result.removed.push_back(key.first);
+
+    if (key.second.second)
+      result.added.push_back(key.first);
+  }
+
+  return result;
+}
+
+void ThreadSafeContext::log_key_unsafe(const std::string& key, bool created)
+{
+  // at most this many changes are kept per prefix
+  const size_t max_entries = 4096;
+
+  bool logged = false;
+
+  for (size_t length : key_log_lengths_)
+  {
+    if (length > key.size())
+      break;
+
+    std::map<std::string, KeyLog>::iterator log =
+        key_logs_.find(key.substr(0, length));
+
+    if (log != key_logs_.end())
+    {
+      KeyLog& entries = log->second;
+
+      if (entries.entries.size() >= max_entries)
+      {
+        entries.start = entries.entries.front().generation;
+        entries.entries.pop_front();
+      }
+
+      entries.entries.push_back(
+          KeyLogEntry{key_generation_ + 1, key, created});
+      logged = true;
+    }
+  }
+
+  if (logged)
+    ++key_generation_;
+}
+
+void ThreadSafeContext::reset_key_logs_unsafe(void)
+{
+  if (!key_logs_.empty())
+  {
+    ++key_generation_;
+
+    for (auto& log : key_logs_)
+    {
+      log.second.entries.clear();
+      log.second.start = key_generation_;
+    }
+  }
+}
+
+void ThreadSafeContext::remove_waiter(ChangeWaiter& waiter)
+{
+  if (!waiter.reads.empty())
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    unsubscribe(&waiter);
+    waiter.subscribed = false;
+  }
+}
+
+bool ThreadSafeContext::wait_for_change(
+    ChangeWaiter& waiter, double max_wait_time)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (max_wait_time < 0)
+  {
+    while (!waiter.changed)
+      waiter.condition.wait(mutex_);
+  }
+  else
+  {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double>(max_wait_time));
+
+    while (!waiter.changed &&
+           waiter.condition.wait_until(mutex_, deadline) !=
+               std::cv_status::timeout)
+    {
+    }
+  }
+
+  bool changed = waiter.changed;
+  waiter.changed = false;
+
+  // erasing variables removes subscriptions
+  if (!waiter.subscribed)
+    subscribe_waiter(waiter);
+
+  return changed;
+}
+
+void ThreadSafeContext::subscribe_waiter(ChangeWaiter& waiter)
+{
+  for (const std::string& key : waiter.reads)
+  {
+    subscribe(get_ref(key, KnowledgeReferenceSettings(false)), &waiter);
+  }
+
+  waiter.subscribed = true;
+}
+
 /// Indicate that a status change has occurred. This could be a message
 /// from the transport to let the knowledge engine know that new agents
 /// are available to send knowledge to.
@@ -773,10 +1122,33 @@ void ThreadSafeContext::set_changed(void)
   changed_.MADARA_CONDITION_NOTIFY_ONE();
 }
 
+void ThreadSafeContext::enable_hash_index(bool enable)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  index_.clear();
+  use_index_ = enable;
+
+  if (enable)
+  {
+    index_.reserve(map_.size());
+
+    for (auto& entry : map_)
+    {
+      index_.emplace(&entry.first, &entry);
+    }
+  }
+  else
+  {
+    // release the buckets as well as the entries
+    KeyIndex().swap(index_);
+  }
+}
+
 // print all variables and their values
 void ThreadSafeContext::print(unsigned int level) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
   for (KnowledgeMap::const_iterator i = map_.begin(); i != map_.end(); ++i)
   {
     if (i->second.exists())
@@ -792,7 +1164,7 @@ void ThreadSafeContext::to_string(std::string& target,
     const std::string& array_delimiter, const std::string& record_delimiter,
     const std::string& key_val_delimiter) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
   std::stringstream buffer;
 
   bool first = true;
@@ -847,7 +1219,7 @@ std::string ThreadSafeContext::expand_statement(
     const std::string& statement) const
 {
   // enter the mutex
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   // vectors for holding parsed tokens and pivot_list
   size_t subcount = 0;
@@ -1031,6 +1403,30 @@ void ThreadSafeContext::define_function(const std::string& name,
   functions_[*key_ptr] = Function(expression.expression);
 }
 
+void ThreadSafeContext::define_function(const std::string& name,
+    std::shared_ptr<NativeFunction> func,
+    const KnowledgeReferenceSettings& settings)
+{
+  // enter the mutex
+  std::string key_actual;
+  const std::string* key_ptr;
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (settings.expand_variables)
+  {
+    key_actual = expand_statement(name);
+    key_ptr = &key_actual;
+  }
+  else
+    key_ptr = &name;
+
+  // check for null key
+  if (*key_ptr == "")
+    return;
+
+  functions_[*key_ptr] = Function(std::move(func));
+}
+
 Function* ThreadSafeContext::retrieve_function(
     const std::string& name, const KnowledgeReferenceSettings& settings)
 {
@@ -1054,7 +1450,8 @@ Function* ThreadSafeContext::retrieve_function(
   return &functions_[*key_ptr];
 }
 
-CompiledExpression ThreadSafeContext::compile(const std::string& expression)
+CompiledExpression ThreadSafeContext::compile(
+    const std::string& expression, bool cached)
 {
   madara_logger_ptr_log(logger_, logger::LOG_MINOR,
       "ThreadSafeContext::compile:"
@@ -1064,7 +1461,27 @@ CompiledExpression ThreadSafeContext::compile(const std::string& expression)
   MADARA_GUARD_TYPE guard(mutex_);
   CompiledExpression ce;
   ce.logic = expression;
-  ce.expression = interpreter_->interpret(*this, expression);
+  ce.context = this;
+  ce.expression = interpreter_->interpret(*this, expression, cached);
+
+  return ce;
+}
+
+CompiledExpression ThreadSafeContext::load_compiled_logic(
+    const std::string& path)
+{
+  madara_logger_ptr_log(logger_, logger::LOG_MINOR,
+      "ThreadSafeContext::load_compiled_logic:"
+      " loading %s\n",
+      path.c_str());
+
+  MADARA_GUARD_TYPE guard(mutex_);
+  expression::CompiledLogicNode* node =
+      new expression::CompiledLogicNode(*this, path);
+
+  CompiledExpression ce;
+  ce.logic = node->logic();
+  ce.expression = expression::ExpressionTree(*logger_, node);
 
   return ce;
 }
@@ -1086,6 +1503,107 @@ KnowledgeRecord ThreadSafeContext::evaluate(
     return knowledge::KnowledgeRecord(KnowledgeRecord::Integer(0));
 }
 
+size_t ThreadSafeContext::add_rule(const CompiledExpression& logic)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  rules_.emplace_back(new ReactiveRule(logic));
+  ReactiveRule* rule = rules_.back().get();
+
+  expression::DependencyVisitor dependencies;
+  dependencies.collect(rule->logic.expression.get_root());
+  rule->dynamic = dependencies.is_dynamic();
+  rule->reads.assign(
+      dependencies.reads().begin(), dependencies.reads().end());
+
+  subscribe_rule(*rule);
+
+  madara_logger_ptr_log(logger_, logger::LOG_MAJOR,
+      "ThreadSafeContext::add_rule:"
+      " rule %d reads %d variables%s\n",
+      (int)(rules_.size() - 1), (int)dependencies.reads().size(),
+      rule->dynamic ? " and is evaluated every time" : "");
+
+  return rules_.size() - 1;
+}
+
+size_t ThreadSafeContext::evaluate_rules(
+    const KnowledgeUpdateSettings& settings)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  size_t evaluated = 0;
+
+  for (auto& rule : rules_)
+  {
+    // erasing variables removes subscriptions
+    if (!rule->subscribed)
+      subscribe_rule(*rule);
+
+    if (rule->dirty || rule->dynamic)
+    {
+      rule->result = rule->logic.expression.evaluate(settings);
+
+      // changes the rule made to its own inputs are already reflected
+      rule->dirty = false;
+      ++evaluated;
+    }
+  }
+
+  return evaluated;
+}
+
+KnowledgeRecord ThreadSafeContext::get_rule_result(size_t rule) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (rule < rules_.size())
+    return rules_[rule]->result;
+
+  return KnowledgeRecord();
+}
+
+void ThreadSafeContext::clear_rules(void)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  for (auto& rule : rules_)
+  {
+    unsubscribe(rule.get());
+  }
+
+  rules_.clear();
+}
+
+void ThreadSafeContext::subscribe_rule(ReactiveRule& rule)
+{
+  for (const std::string& key : rule.reads)
+  {
+    subscribe(get_ref(key, KnowledgeReferenceSettings(false)), &rule);
+  }
+
+  rule.subscribed = true;
+}
+
+bool ThreadSafeContext::add_waiter(
+    ChangeWaiter& waiter, CompiledExpression& expression)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  expression::DependencyVisitor dependencies;
+  dependencies.collect(expression.expression.get_root());
+
+  if (dependencies.is_dynamic())
+    return false;
+
+  waiter.reads.assign(
+      dependencies.reads().begin(), dependencies.reads().end());
+
+  subscribe_waiter(waiter);
+
+  return true;
+}
+
 #endif  // _MADARA_NO_KARL_
 
 size_t ThreadSafeContext::to_vector(const std::string& subject,
@@ -1094,7 +1612,7 @@ size_t ThreadSafeContext::to_vector(const std::string& subject,
   target.clear();
 
   // enter the mutex
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (end >= start)
   {
@@ -1306,7 +1824,21 @@ void ThreadSafeContext::delete_prefix(
   std::pair<KnowledgeMap::iterator, KnowledgeMap::iterator> iters(
       get_prefix_range(prefix));
 
+  if (use_index_)
+  {
+    for (KnowledgeMap::iterator i = iters.first; i != iters.second; ++i)
+      index_.erase(&i->first);
+  }
+
+  if (!key_logs_.empty())
+  {
+    for (KnowledgeMap::iterator i = iters.first; i != iters.second; ++i)
+      log_key_unsafe(i->first, false);
+  }
+
   map_.erase(iters.first, iters.second);
+  ++erasures_;
+  clear_subscriptions();
 
   {
     // check the changed map
@@ -1404,7 +1936,7 @@ ThreadSafeContext::get_prefix_range(const std::string& prefix) const
 KnowledgeMap ThreadSafeContext::to_map(const std::string& prefix) const
 {
   // enter the mutex
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   std::pair<KnowledgeMap::const_iterator, KnowledgeMap::const_iterator> iters(
       get_prefix_range(prefix));
@@ -1416,7 +1948,7 @@ KnowledgeMap ThreadSafeContext::to_map(const std::string& prefix) const
 KnowledgeMap ThreadSafeContext::to_map_stripped(const std::string& prefix) const
 {
   // enter the mutex
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   std::pair<KnowledgeMap::const_iterator, KnowledgeMap::const_iterator> iters(
       get_prefix_range(prefix));
@@ -1444,7 +1976,11 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
         "ThreadSafeContext::copy:"
         " clearing knowledge in target context\n");
 
+    index_.clear();
     map_.clear();
+    ++erasures_;
+    clear_subscriptions();
+    reset_key_logs_unsafe();
   }
 
   if (reqs.predicates.size() != 0)
@@ -1479,6 +2015,12 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
 
             where = map_.emplace_hint(
                 where, iters.first->first, iters.first->second);
+
+            if (use_index_)
+              index_.emplace(&where->first, &*where);
+
+            if (!key_logs_.empty())
+              log_key_unsafe(where->first, true);
           }
           else
           {
@@ -1520,6 +2062,12 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
 
               where = map_.emplace_hint(
                   where, iters.first->first, iters.first->second);
+
+              if (use_index_)
+                index_.emplace(&where->first, &*where);
+
+              if (!key_logs_.empty())
+                log_key_unsafe(where->first, true);
             }
             else
             {
@@ -1545,8 +2093,11 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
 
     for (; iters.first != iters.second; ++iters.first)
     {
-      map_.insert(map_.begin(),
-          KnowledgeMap::value_type(iters.first->first, iters.first->second));
+      // existing entries are left untouched, as with map insertion
+      if (!find_unsafe(iters.first->first))
+      {
+        emplace_unsafe(iters.first->first)->second = iters.first->second;
+      }
 
       mark_modified(iters.first->first, settings);
     }
@@ -1559,7 +2110,13 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
 {
   // if we need to clean first, clear the map
   if (clean_copy)
+  {
+    index_.clear();
     map_.clear();
+    ++erasures_;
+    clear_subscriptions();
+    reset_key_logs_unsafe();
+  }
 
   // if the copy set is empty, copy everything
   if (copy_set.size() == 0)
@@ -1567,7 +2124,7 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
     for (KnowledgeMap::const_iterator i = source.map_.begin();
          i != source.map_.end(); ++i)
     {
-      map_[i->first] = (i->second);
+      emplace_unsafe(i->first)->second = i->second;
       mark_modified(i->first, settings);
     }
   }
@@ -1583,7 +2140,7 @@ void ThreadSafeContext::copy(const ThreadSafeContext& source,
       // if found, make a copy of the found entry
       if (i != source.map_.end())
       {
-        map_[i->first] = (i->second);
+        emplace_unsafe(i->first)->second = i->second;
         mark_modified(i->first, settings);
       }
     }
@@ -1665,7 +2222,7 @@ int64_t ThreadSafeContext::save_context(
         " writing records\n");
 
     // lock the context
-    MADARA_GUARD_TYPE guard(mutex_);
+    MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
     for (KnowledgeMap::const_iterator i = map_.begin(); i != map_.end(); ++i)
     {
@@ -1793,7 +2350,7 @@ int64_t ThreadSafeContext::save_as_karl(
   if (file.is_open())
   {
     // lock the context
-    MADARA_GUARD_TYPE guard(mutex_);
+    MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
     for (KnowledgeMap::const_iterator i = map_.begin(); i != map_.end(); ++i)
     {
@@ -1966,7 +2523,7 @@ int64_t ThreadSafeContext::save_as_json(
   if (file.is_open())
   {
     // lock the context
-    MADARA_GUARD_TYPE guard(mutex_);
+    MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
     buffer << "{\n";
 
@@ -13,6 +13,9 @@
 
 #include <string>
 #include <map>
+#include <set>
+#include <deque>
+#include <unordered_map>
 #include <memory>
 #include <fstream>
 #include "madara/utility/IntTypes.h"
@@ -26,6 +29,10 @@
 #include "madara/knowledge/KnowledgeUpdateSettings.h"
 #include "madara/knowledge/KnowledgeReferenceSettings.h"
 #include "madara/knowledge/CompiledExpression.h"
+#include "madara/knowledge/ChangeSubscriber.h"
+#include "madara/knowledge/ReactiveRule.h"
+#include "madara/knowledge/ChangeWaiter.h"
+#include "madara/knowledge/KeyChanges.h"
 #include "madara/knowledge/CheckpointSettings.h"
 #include "madara/knowledge/BaseStreamer.h"
 #include "madara/transport/MessageHeader.h"
@@ -44,6 +51,9 @@ namespace madara
 namespace expression
 {
 class Interpreter;
+struct ExpressionCacheStats;
+class KeyExpansionCache;
+class CompositeParallelForLoop;
 class CompositeArrayReference;
 class VariableNode;
 }
@@ -70,6 +80,7 @@ typedef std::vector<std::string> PrefixVector;
 
 /// forward declare for friendship
 class KnowledgeBaseImpl;
+class CompiledLogic;
 
 /**
  * @class ThreadSafeContext
@@ -80,8 +91,11 @@ class MADARA_EXPORT ThreadSafeContext
 {
 public:
   friend class KnowledgeBaseImpl;
+  friend class CompiledLogic;
   friend class expression::CompositeArrayReference;
   friend class expression::VariableNode;
+  friend class expression::KeyExpansionCache;
+  friend class expression::CompositeParallelForLoop;
   friend class rcw::BaseTracker;
 
   /**
@@ -831,6 +845,35 @@ public:
       const knowledge::KnowledgeRecord& new_value,
       const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings(true));
 
+  /**
+   * Atomically decodes an update from a transport buffer straight into
+   * a variable, if the update meets the same conditions as the other
+   * update_record_from_external methods. The variable's string or array
+   * storage is reused when no other record shares it, so updates to
+   * existing variables are applied without intermediate copies.
+   * Variables that keep a history decode into a new record, which is
+   * then added to the history. An array delta is patched into the
+   * variable in place, or into a copy of the newest value of a history,
+   * if that value is the one it was computed from at the clock it names.
+   * @param   key       unique identifier of the variable
+   * @param   buffer    the update, positioned at its type. Moved past
+   *                    the value, whether or not it is applied.
+   * @param   buffer_remaining  bytes left in buffer. Negative if the
+   *                    value was malformed, in which case nothing is
+   *                    changed.
+   * @param   quality   quality of the update
+   * @param   clock     clock of the update
+   * @param   toi       time of insertion to give the variable
+   * @param   settings  settings for applying the update
+   * @return   1 if the value was changed. -1 if null key or malformed
+   *          value, -2 if quality not high enough, -3 if clock is older,
+   *          -4 if an array delta does not apply to the current value
+   **/
+  int update_record_from_external(const std::string& key,
+      const char*& buffer, int64_t& buffer_remaining, uint32_t quality,
+      uint64_t clock, uint64_t toi,
+      const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings(true));
+
   /**
    * Atomically gets quality of a variable
    * @param   key       unique identifier of the
@@ -1014,6 +1057,38 @@ public:
    **/
   void wait_for_change(bool extra_release = false);
 
+#ifndef _MADARA_NO_KARL_
+  /**
+   * Subscribes a waiter to the variables an expression reads, so that
+   * wait_for_change (waiter) returns only after one of them changes,
+   * rather than after any change to the context.
+   * @param   waiter      the waiter to subscribe
+   * @param   expression  the expression the waiter evaluates
+   * @return  false if the variables the expression reads are not known
+   *          until it is evaluated, e.g., if it expands keys or calls
+   *          functions. The waiter is then not subscribed.
+   **/
+  bool add_waiter(ChangeWaiter& waiter, CompiledExpression& expression);
+#endif  // _MADARA_NO_KARL_
+
+  /**
+   * Removes the subscriptions of a waiter
+   * @param   waiter      the waiter to remove
+   **/
+  void remove_waiter(ChangeWaiter& waiter);
+
+  /**
+   * Waits for a change to a variable that a waiter is subscribed to.
+   * Changes made since the last wait return immediately. signal and
+   * set_changed do not wake the waiter. The calling thread must not hold
+   * the lock on the context.
+   * @param   waiter         a waiter subscribed with add_waiter
+   * @param   max_wait_time  the maximum time to wait in seconds, or a
+   *                         negative number to wait for a change
+   * @return  true if a change woke the waiter, false on timeout
+   **/
+  bool wait_for_change(ChangeWaiter& waiter, double max_wait_time = -1.0);
+
   /**
    * Atomically decrements the value of the variable
    * @param   key            unique identifier of the variable
@@ -1128,6 +1203,25 @@ public:
    **/
   bool delete_expression(const std::string& expression);
 
+  /**
+   * Sets the most expressions the interpreter caches for compile. When
+   * full, the least recently compiled expression is dropped. Expressions
+   * already compiled remain valid.
+   * @param   capacity       the most expressions, or 0 for no limit
+   **/
+  void set_expression_cache_capacity(size_t capacity);
+
+  /**
+   * Returns the statistics of the interpreter's expression cache
+   * @return                 capacity, size, hits, misses and evictions
+   **/
+  expression::ExpressionCacheStats get_expression_cache_stats(void) const;
+
+  /**
+   * Resets the hit, miss and eviction counts of the expression cache
+   **/
+  void reset_expression_cache_stats(void);
+
   /**
    * Atomically checks to see if a variable already exists
    * @param   key            unique identifier of the variable
@@ -1304,10 +1398,23 @@ public:
    * Compiles a KaRL expression into an expression tree
    *
    * @param expression         expression to compile
+   * @param cached             if false, the tree is not shared with other
+   *                           compilations of the same expression
    * @return                   compiled, optimized expression tree
    * @throw exceptions::KarlException  failure during compile/evaluate
    **/
-  CompiledExpression compile(const std::string& expression);
+  CompiledExpression compile(const std::string& expression, bool cached = true);
+
+  /**
+   * Loads logic that karlc generated as C++ and that was built into a
+   * shared library. The result is evaluated like a compiled expression.
+   *
+   * @param path               path to the shared library
+   * @return                   the loaded logic
+   * @throw exceptions::FileException  the library could not be loaded or
+   *                                   does not contain compiled logic
+   **/
+  CompiledExpression load_compiled_logic(const std::string& path);
 
   /**
    * Defines an external function
@@ -1378,6 +1485,17 @@ public:
       const KnowledgeReferenceSettings& settings =
           KnowledgeReferenceSettings());
 
+  /**
+   * Defines a function with native argument and return types
+   * @param  name       name of the function
+   * @param  func       function to call with this name
+   * @param  settings   settings for referring to variables
+   **/
+  void define_function(const std::string& name,
+      std::shared_ptr<NativeFunction> func,
+      const KnowledgeReferenceSettings& settings =
+          KnowledgeReferenceSettings());
+
   /**
    * Retrieves an external function
    * @param  name       name of the function to retrieve
@@ -1412,6 +1530,41 @@ public:
   knowledge::KnowledgeRecord evaluate(expression::ComponentNode* root,
       const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings());
 
+  /**
+   * Adds a reactive rule. evaluate_rules evaluates the rule again only
+   * after a variable it reads has changed. Rules that expand keys, call
+   * functions, loop or read the time are evaluated every time.
+   * @param   logic       the compiled rule
+   * @return              the index of the rule
+   **/
+  size_t add_rule(const CompiledExpression& logic);
+
+  /**
+   * Evaluates, in the order they were added, the rules whose inputs have
+   * changed since they were last evaluated. Changes a rule makes to its
+   * own inputs do not cause it to be evaluated again. Please note that
+   * updates will not be sent through any transports until you call
+   * through the KnowledgeBase.
+   * @param   settings    settings for applying the updates
+   * @return              the number of rules evaluated
+   * @throw exceptions::KarlException  failure during evaluate
+   **/
+  size_t evaluate_rules(
+      const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings());
+
+  /**
+   * Returns the result of the last evaluation of a rule
+   * @param   rule        the index of the rule
+   * @return              the result, or an empty record if the rule
+   *                      does not exist or has not been evaluated
+   **/
+  knowledge::KnowledgeRecord get_rule_result(size_t rule) const;
+
+  /**
+   * Removes all reactive rules
+   **/
+  void clear_rules(void);
+
 #endif  // _MADARA_NO_KARL_
 
   /**
@@ -1708,6 +1861,25 @@ public:
     return streamer;
   }
 
+  /**
+   * Enables or disables a hash index layered over the variable map. With
+   * the index, lookups by name (get, get_ref, exists,
+   * update_record_from_external, etc.) become hash probes instead of
+   * O(log n) string comparisons. The ordered map remains the primary
+   * storage, so prefix operations (to_map, delete_prefix, save_context)
+   * and existing VariableReferences are unaffected. Enabling the index on
+   * a populated context builds it from the current map, so this is best
+   * called right after constructing the knowledge base.
+   * @param  enable   true to maintain a hash index, false to drop it
+   **/
+  void enable_hash_index(bool enable = true);
+
+  /**
+   * Checks if the hash index is enabled
+   * @return  true if name lookups use the hash index
+   **/
+  bool has_hash_index(void) const;
+
   /**
    * NOT THREAD SAFE!
    *
@@ -1716,6 +1888,9 @@ public:
    * Reading the map is then generally safe, but writting to it will bypass
    * important mechanisms such as modification tracking. Make sure you know
    * what you're doing, and consider whether other methods fit your needs.
+   * If the hash index is enabled (@see enable_hash_index), erasing from
+   * the map directly invalidates the index; call enable_hash_index again
+   * to rebuild it.
    *
    * @return a reference to this context's KnowledgeMap
    **/
@@ -1809,8 +1984,111 @@ public:
     return invoke(key, std::forward<Callable>(callable), settings);
   }
 
+  /**
+   * Notifies a subscriber whenever a variable is modified, until it
+   * unsubscribes. Subscribers must outlive their subscriptions.
+   * @param  variable    the variable to watch
+   * @param  subscriber  the subscriber to notify
+   **/
+  void subscribe(
+      const VariableReference& variable, ChangeSubscriber* subscriber);
+
+  /**
+   * Removes all subscriptions of a subscriber
+   * @param  subscriber  the subscriber to remove
+   **/
+  void unsubscribe(ChangeSubscriber* subscriber);
+
+  /**
+   * Starts logging the variables created and erased under a prefix, so
+   * that get_key_changes can list them. Each call adds a reference to
+   * the log of the prefix, and logging continues until untrack_keys
+   * releases every reference. A bounded number of changes is kept per
+   * prefix.
+   * @param  prefix   the prefix of the variables, e.g., "agent."
+   * @return the current generation of the key log
+   **/
+  uint64_t track_keys(const std::string& prefix);
+
+  /**
+   * Releases a reference added by track_keys. The log of the prefix is
+   * dropped when no references remain.
+   * @param  prefix   a prefix passed to track_keys
+   **/
+  void untrack_keys(const std::string& prefix);
+
+  /**
+   * Returns the current generation of the key log, which increases with
+   * every logged creation or erasure. Generations start at 1, so 0 can
+   * stand for keys that have never been read.
+   * @return the current generation
+   **/
+  uint64_t get_key_generation(void) const;
+
+  /**
+   * Lists the variables created and erased under a prefix since a
+   * generation, without scanning the variables under the prefix. A
+   * caller that reads all keys under the prefix can call track_keys while
+   * holding the lock to learn the generation those keys reflect.
+   * @param  prefix   a prefix passed to track_keys
+   * @param  since    the generation the caller's keys reflect
+   * @return the changes, which are not complete if the prefix is not
+   *         tracked or the log no longer reaches back to since
+   **/
+  KeyChanges get_key_changes(const std::string& prefix, uint64_t since) const;
+
+  /**
+   * Returns a token that expires when the context is destroyed, so that
+   * objects that may outlive the context can tell if it still exists
+   * @return the lifetime of the context
+   **/
+  std::weak_ptr<void> get_lifetime(void) const;
+
 protected:
 private:
+  /**
+   * Notifies the subscribers of a modified variable. Does not lock the
+   * context.
+   * @param  ref       the modified variable
+   **/
+  void notify_subscribers(const VariableReference& ref);
+
+  /**
+   * Removes every subscription, telling the subscribers. Called when
+   * records are erased, since subscriptions are kept by record. Does not
+   * lock the context.
+   **/
+  void clear_subscriptions(void);
+
+  /**
+   * Logs the creation or erasure of a variable under each tracked prefix
+   * of its key. Does not lock the context.
+   * @param  key       the key of the variable
+   * @param  created   true if the variable was created, false if erased
+   **/
+  void log_key_unsafe(const std::string& key, bool created);
+
+  /**
+   * Empties the key logs after many variables were erased at once, so
+   * that callers read all keys again. Does not lock the context.
+   **/
+  void reset_key_logs_unsafe(void);
+
+#ifndef _MADARA_NO_KARL_
+  /**
+   * Subscribes a rule to the variables it reads. Does not lock the context.
+   * @param  rule      the rule to subscribe
+   **/
+  void subscribe_rule(ReactiveRule& rule);
+#endif  // _MADARA_NO_KARL_
+
+  /**
+   * Subscribes a waiter to the variables it reads. Does not lock the
+   * context.
+   * @param  waiter    the waiter to subscribe
+   **/
+  void subscribe_waiter(ChangeWaiter& waiter);
+
   /**
    * Changes variable to modified at current clock, and queues it to send,
    * even if it is a local that would not ordinarily be sent. Skips all
@@ -1854,11 +2132,93 @@ private:
   std::pair<KnowledgeMap::const_iterator, KnowledgeMap::const_iterator>
   get_prefix_range(const std::string& prefix) const;
 
+  /**
+   * Finds an existing entry by name. Does not lock the context.
+   * @param  key   the exact (already expanded) variable name
+   * @return the map entry, or nullptr if the variable does not exist
+   **/
+  KnowledgeMap::value_type* find_unsafe(const std::string& key);
+
+  /**
+   * Finds an existing entry by name. Does not lock the context.
+   * @param  key   the exact (already expanded) variable name
+   * @return the map entry, or nullptr if the variable does not exist
+   **/
+  const KnowledgeMap::value_type* find_unsafe(const std::string& key) const;
+
+  /**
+   * Finds an entry by name, creating an empty record if none exists.
+   * Does not lock the context.
+   * @param  key   the exact (already expanded) variable name
+   * @return the map entry
+   **/
+  KnowledgeMap::value_type* emplace_unsafe(const std::string& key);
+
+  /**
+   * Copies the value of a new entry from fallback_, if it has the entry.
+   * Does not lock the context.
+   * @param  entry  the entry that was just created
+   **/
+  void copy_fallback_unsafe(KnowledgeMap::value_type& entry);
+
+  /**
+   * Removes an entry from the hash index, if the index is enabled. Must
+   * be called before the entry is erased from the map.
+   * @param  key   the key of the entry being erased
+   **/
+  void unindex_unsafe(const std::string& key);
+
   std::pair<KnowledgeMap::iterator, KnowledgeMap::iterator> get_prefix_range(
       const std::string& prefix);
 
   /// Hash table containing variable names and values.
   madara::knowledge::KnowledgeMap map_;
+
+  /// Hashes the key text that a key pointer refers to
+  struct KeyHash
+  {
+    size_t operator()(const std::string* key) const
+    {
+      return std::hash<std::string>()(*key);
+    }
+  };
+
+  /// Compares the key text that two key pointers refer to
+  struct KeyEqual
+  {
+    bool operator()(const std::string* lhs, const std::string* rhs) const
+    {
+      return *lhs == *rhs;
+    }
+  };
+
+  /**
+   * Point-lookup index over map_. Keys point at the key strings owned by
+   * map_ nodes, which are stable until the node is erased.
+   **/
+  typedef std::unordered_map<const std::string*, KnowledgeMap::value_type*,
+      KeyHash, KeyEqual>
+      KeyIndex;
+
+  /// optional hash index for name lookups (@see enable_hash_index)
+  KeyIndex index_;
+
+  /// true if index_ is maintained
+  bool use_index_ = false;
+
+  /**
+   * If set, variables that are missing from this context are copied from
+   * the fallback when they are first referred to. Used for the private
+   * contexts of parallel loops (@see expression::CompositeParallelForLoop),
+   * which are only used by one thread at a time.
+   **/
+  const ThreadSafeContext* fallback_ = nullptr;
+
+  /**
+   * Counts erasures from map_, so holders of cached references can tell
+   * when they may dangle (@see expression::KeyExpansionCache)
+   **/
+  uint64_t erasures_ = 0;
   mutable MADARA_LOCK_TYPE mutex_;
   mutable MADARA_CONDITION_TYPE changed_;
   std::vector<std::string> expansion_splitters_;
@@ -1877,6 +2237,53 @@ private:
 
   /// Streaming provider for saving all updates
   std::unique_ptr<BaseStreamer> streamer_ = nullptr;
+
+  /// subscribers to notify when a record is modified
+  std::unordered_map<const KnowledgeRecord*, std::vector<ChangeSubscriber*>>
+      subscribers_;
+
+  /// a creation or erasure of a variable
+  struct KeyLogEntry
+  {
+    /// generation of the key log after the change
+    uint64_t generation;
+
+    /// the key of the variable
+    std::string key;
+
+    /// true if the variable was created, false if it was erased
+    bool created;
+  };
+
+  /// creations and erasures of variables under a tracked prefix
+  struct KeyLog
+  {
+    /// the log holds every change after this generation
+    uint64_t start = 0;
+
+    /// references added by track_keys
+    size_t references = 0;
+
+    /// the logged changes, oldest first
+    std::deque<KeyLogEntry> entries;
+  };
+
+  /// key logs, by tracked prefix (@see track_keys)
+  std::map<std::string, KeyLog> key_logs_;
+
+  /// lengths of the tracked prefixes, for finding the logs of a key
+  std::set<size_t> key_log_lengths_;
+
+  /// the generation of the key logs
+  uint64_t key_generation_ = 1;
+
+  /// expires when the context is destroyed (@see get_lifetime)
+  std::shared_ptr<void> lifetime_ = std::make_shared<bool>(true);
+
+#ifndef _MADARA_NO_KARL_
+  /// rules evaluated by evaluate_rules
+  std::vector<std::unique_ptr<ReactiveRule>> rules_;
+#endif  // _MADARA_NO_KARL_
 };
 }
 }
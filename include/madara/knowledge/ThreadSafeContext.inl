@@ -82,24 +82,141 @@ inline KnowledgeRecord ThreadSafeContext::get_actual(
   return KnowledgeRecord();
 }
 
+inline KnowledgeMap::value_type* ThreadSafeContext::find_unsafe(
+    const std::string& key)
+{
+  KnowledgeMap::value_type* result;
+
+  if (use_index_)
+  {
+    KeyIndex::iterator found = index_.find(&key);
+    result = found != index_.end() ? found->second : nullptr;
+  }
+  else
+  {
+    KnowledgeMap::iterator found = map_.find(key);
+    result = found != map_.end() ? &*found : nullptr;
+  }
+
+  if (!result && fallback_ && fallback_->find_unsafe(key))
+  {
+    result = emplace_unsafe(key);
+  }
+
+  return result;
+}
+
+inline const KnowledgeMap::value_type* ThreadSafeContext::find_unsafe(
+    const std::string& key) const
+{
+  const KnowledgeMap::value_type* result;
+
+  if (use_index_)
+  {
+    KeyIndex::const_iterator found = index_.find(&key);
+    result = found != index_.end() ? found->second : nullptr;
+  }
+  else
+  {
+    KnowledgeMap::const_iterator found = map_.find(key);
+    result = found != map_.end() ? &*found : nullptr;
+  }
+
+  // contexts with a fallback have a single user, so copying in what is
+  // read is safe even though this is const
+  if (!result && fallback_ && fallback_->find_unsafe(key))
+  {
+    result = const_cast<ThreadSafeContext*>(this)->emplace_unsafe(key);
+  }
+
+  return result;
+}
+
+inline KnowledgeMap::value_type* ThreadSafeContext::emplace_unsafe(
+    const std::string& key)
+{
+  if (use_index_)
+  {
+    KeyIndex::iterator found = index_.find(&key);
+    if (found != index_.end())
+    {
+      return found->second;
+    }
+
+    // emplace returns the existing node if something bypassed the index
+    std::pair<KnowledgeMap::iterator, bool> result = map_.emplace(
+        std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple());
+    index_.emplace(&result.first->first, &*result.first);
+
+    if (result.second && fallback_)
+      copy_fallback_unsafe(*result.first);
+
+    if (result.second && !key_logs_.empty())
+      log_key_unsafe(key, true);
+
+    return &*result.first;
+  }
+
+  KnowledgeMap::iterator iter = map_.lower_bound(key);
+  if (iter == map_.end() || iter->first != key)
+  {
+    iter = map_.emplace_hint(iter, std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple());
+
+    if (fallback_)
+      copy_fallback_unsafe(*iter);
+
+    if (!key_logs_.empty())
+      log_key_unsafe(key, true);
+  }
+
+  return &*iter;
+}
+
+inline void ThreadSafeContext::copy_fallback_unsafe(
+    KnowledgeMap::value_type& entry)
+{
+  const KnowledgeMap::value_type* found = fallback_->find_unsafe(entry.first);
+
+  // records share storage until one of them changes it
+  if (found)
+    entry.second = found->second;
+}
+
+inline void ThreadSafeContext::unindex_unsafe(const std::string& key)
+{
+  if (use_index_)
+  {
+    index_.erase(&key);
+  }
+}
+
+inline bool ThreadSafeContext::has_hash_index(void) const
+{
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
+
+  return use_index_;
+}
+
 inline KnowledgeRecord* ThreadSafeContext::with(
     const std::string& key, const KnowledgeReferenceSettings& settings)
 {
-  KnowledgeMap::iterator found;
+  KnowledgeMap::value_type* found;
 
   MADARA_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
     std::string cur_key = expand_statement(key);
-    found = map_.find(cur_key);
+    found = find_unsafe(cur_key);
   }
   else
   {
-    found = map_.find(key);
+    found = find_unsafe(key);
   }
 
-  if (found != map_.end())
+  if (found)
   {
     return &found->second;
   }
@@ -119,21 +236,21 @@ inline KnowledgeRecord* ThreadSafeContext::with(
 inline const KnowledgeRecord* ThreadSafeContext::with(
     const std::string& key, const KnowledgeReferenceSettings& settings) const
 {
-  KnowledgeMap::const_iterator found;
+  const KnowledgeMap::value_type* found;
 
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
     std::string cur_key = expand_statement(key);
-    found = map_.find(cur_key);
+    found = find_unsafe(cur_key);
   }
   else
   {
-    found = map_.find(key);
+    found = find_unsafe(key);
   }
 
-  if (found != map_.end())
+  if (found)
   {
     return &found->second;
   }
@@ -145,7 +262,7 @@ inline const KnowledgeRecord* ThreadSafeContext::with(
 inline const KnowledgeRecord* ThreadSafeContext::with(
     const VariableReference& variable, const KnowledgeReferenceSettings&) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   return variable.get_record_unsafe();
 }
@@ -154,7 +271,7 @@ inline const KnowledgeRecord* ThreadSafeContext::with(
 inline bool ThreadSafeContext::exists(
     const VariableReference& variable, const KnowledgeReferenceSettings&) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   auto record = variable.get_record_unsafe();
   return record && record->exists();
@@ -165,7 +282,7 @@ inline KnowledgeRecord ThreadSafeContext::retrieve_index(
     const VariableReference& variable, size_t index,
     const KnowledgeReferenceSettings&)
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   auto record = variable.get_record_unsafe();
   if (record)
@@ -474,6 +591,28 @@ inline bool ThreadSafeContext::delete_expression(const std::string& expression)
   return interpreter_->delete_expression(expression);
 }
 
+inline void ThreadSafeContext::set_expression_cache_capacity(size_t capacity)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  interpreter_->set_cache_capacity(capacity);
+}
+
+inline expression::ExpressionCacheStats
+ThreadSafeContext::get_expression_cache_stats(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  return interpreter_->get_cache_stats();
+}
+
+inline void ThreadSafeContext::reset_expression_cache_stats(void)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  interpreter_->reset_cache_stats();
+}
+
 #endif  // _MADARA_NO_KARL_
 
 inline bool ThreadSafeContext::clear(
@@ -494,8 +633,8 @@ inline bool ThreadSafeContext::clear(
     key_ptr = &key;
 
   // find the key and update found with result of find
-  KnowledgeMap::iterator record = map_.find(*key_ptr);
-  found = record != map_.end();
+  KnowledgeMap::value_type* record = find_unsafe(*key_ptr);
+  found = record != nullptr;
 
   if (found)
   {
@@ -549,7 +688,13 @@ inline bool ThreadSafeContext::delete_variable(
   local_changed_map_.erase(key_ptr->c_str());
 
   // erase the map
+  unindex_unsafe(*key_ptr);
   result = map_.erase(*key_ptr) == 1;
+  ++erasures_;
+  clear_subscriptions();
+
+  if (result && !key_logs_.empty())
+    log_key_unsafe(*key_ptr, false);
 
   return result;
 }
@@ -566,7 +711,16 @@ inline bool ThreadSafeContext::delete_variable(
   local_changed_map_.erase(var.entry_->first.c_str());
 
   // erase the map
-  return map_.erase(var.entry_->first.c_str()) == 1;
+  std::string key(var.entry_->first);
+  unindex_unsafe(key);
+  ++erasures_;
+  clear_subscriptions();
+  bool result = map_.erase(key) == 1;
+
+  if (result && !key_logs_.empty())
+    log_key_unsafe(key, false);
+
+  return result;
 }
 
 inline void ThreadSafeContext::delete_variables(KnowledgeMap::iterator begin,
@@ -576,8 +730,14 @@ inline void ThreadSafeContext::delete_variables(KnowledgeMap::iterator begin,
   {
     changed_map_.erase(cur->first.c_str());
     local_changed_map_.erase(cur->first.c_str());
+    unindex_unsafe(cur->first);
+
+    if (!key_logs_.empty())
+      log_key_unsafe(cur->first, false);
   }
   map_.erase(begin, end);
+  ++erasures_;
+  clear_subscriptions();
 }
 
 // return whether or not the key exists
@@ -587,7 +747,7 @@ inline bool ThreadSafeContext::exists(
   // enter the mutex
   std::string key_actual;
   const std::string* key_ptr;
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
@@ -601,10 +761,10 @@ inline bool ThreadSafeContext::exists(
   if (*key_ptr != "")
   {
     // find the key in the knowledge base
-    KnowledgeMap::const_iterator found = map_.find(*key_ptr);
+    const KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
     // if it's found, then return the value
-    if (found != map_.end())
+    if (found)
       return found->second.status() != knowledge::KnowledgeRecord::UNCREATED;
   }
 
@@ -676,7 +836,7 @@ inline uint64_t ThreadSafeContext::set_clock(const std::string& key,
     return 0;
 
   // create the key if it didn't exist
-  knowledge::KnowledgeRecord& record = map_[*key_ptr];
+  knowledge::KnowledgeRecord& record = emplace_unsafe(*key_ptr)->second;
 
   // check for value already set
   if (record.clock < clock)
@@ -713,7 +873,7 @@ inline uint64_t ThreadSafeContext::inc_clock(
     return 0;
 
   // create the key if it didn't exist
-  knowledge::KnowledgeRecord& record = map_[*key_ptr];
+  knowledge::KnowledgeRecord& record = emplace_unsafe(*key_ptr)->second;
 
   return record.clock += settings.clock_increment;
 }
@@ -730,7 +890,7 @@ inline uint64_t ThreadSafeContext::inc_clock(
 /// than our current clock get discarded)
 inline uint64_t ThreadSafeContext::get_clock(void) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
   return clock_;
 }
 
@@ -753,7 +913,7 @@ inline uint64_t ThreadSafeContext::get_clock(
   // enter the mutex
   std::string key_actual;
   const std::string* key_ptr;
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
 
   if (settings.expand_variables)
   {
@@ -768,10 +928,10 @@ inline uint64_t ThreadSafeContext::get_clock(
     return 0;
 
   // find the key in the knowledge base
-  KnowledgeMap::const_iterator found = map_.find(*key_ptr);
+  const KnowledgeMap::value_type* found = find_unsafe(*key_ptr);
 
   // if it's found, then compare the value
-  if (found != map_.end())
+  if (found)
   {
     return found->second.clock;
   }
@@ -818,13 +978,20 @@ inline void ThreadSafeContext::clear(bool erase)
 
   if (erase)
   {
+    index_.clear();
     map_.clear();
+    ++erasures_;
+    clear_subscriptions();
+    reset_key_logs_unsafe();
   }
   else
   {
     for (KnowledgeMap::iterator i = map_.begin(); i != map_.end(); ++i)
     {
       i->second.reset_value();
+
+      if (!subscribers_.empty())
+        notify_subscribers(VariableReference(&*i));
     }
   }
 
@@ -936,6 +1103,9 @@ inline void ThreadSafeContext::mark_and_signal(
     streamer_->enqueue(ref.get_name(), *rec_ptr);
   }
 
+  if (!subscribers_.empty())
+    notify_subscribers(ref);
+
   if (settings.signal_changes)
     changed_.MADARA_CONDITION_NOTIFY_ALL();
 }
@@ -963,7 +1133,7 @@ inline void ThreadSafeContext::mark_modified(
 
 inline std::string ThreadSafeContext::debug_modifieds(void) const
 {
-  MADARA_GUARD_TYPE guard(mutex_);
+  MADARA_SHARED_GUARD_TYPE guard(mutex_);
   std::stringstream result;
 
   result << changed_map_.size() << " modifications ready to send:\n";
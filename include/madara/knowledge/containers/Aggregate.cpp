@@ -0,0 +1,134 @@
+#ifndef _MADARA_NO_KARL_
+
+#include <sstream>
+
+#include "Aggregate.h"
+#include "madara/knowledge/ContextGuard.h"
+
+madara::knowledge::containers::Aggregate::Aggregate(
+    ThreadSafeContext& context, const std::string& name, int size)
+  : context_(&context),
+    name_(name),
+    size_(size),
+    subscribed_(false),
+    sum_(0),
+    min_(0),
+    max_(0)
+{
+}
+
+madara::knowledge::containers::Aggregate::~Aggregate()
+{
+  // the context removes all subscriptions when it is destroyed
+  if (subscribed_)
+    context_->unsubscribe(this);
+}
+
+void madara::knowledge::containers::Aggregate::subscribe(void)
+{
+  ContextGuard context_guard(*context_);
+
+  if (subscribed_)
+    return;
+
+  indices_.clear();
+  values_.clear();
+  sorted_.clear();
+
+  type sum(0);
+
+  for (int i = 0; i < size_; ++i)
+  {
+    std::stringstream buffer;
+    buffer << name_ << "." << i;
+
+    VariableReference variable =
+        context_->get_ref(buffer.str(), KnowledgeReferenceSettings(false));
+    type value = variable.get_record_unsafe()->to_integer();
+
+    indices_[variable.get_record_unsafe()] = values_.size();
+    values_.push_back(value);
+    sorted_.insert(value);
+    sum += value;
+
+    context_->subscribe(variable, this);
+  }
+
+  sum_ = sum;
+  update_extremes();
+  subscribed_ = true;
+
+  madara_logger_log(context_->get_logger(), logger::LOG_MAJOR,
+      "Aggregate::subscribe: subscribed to %d variables of %s\n", size_,
+      name_.c_str());
+}
+
+bool madara::knowledge::containers::Aggregate::is_subscribed(void) const
+{
+  return subscribed_;
+}
+
+int madara::knowledge::containers::Aggregate::size(void) const
+{
+  return size_;
+}
+
+madara::knowledge::containers::Aggregate::type
+madara::knowledge::containers::Aggregate::sum(void) const
+{
+  return sum_;
+}
+
+madara::knowledge::containers::Aggregate::type
+madara::knowledge::containers::Aggregate::min(void) const
+{
+  return min_;
+}
+
+madara::knowledge::containers::Aggregate::type
+madara::knowledge::containers::Aggregate::max(void) const
+{
+  return max_;
+}
+
+void madara::knowledge::containers::Aggregate::modified(
+    const VariableReference& variable)
+{
+  auto found = indices_.find(variable.get_record_unsafe());
+
+  if (found != indices_.end())
+  {
+    type value = variable.get_record_unsafe()->to_integer();
+    type& previous = values_[found->second];
+
+    if (value != previous)
+    {
+      sorted_.erase(sorted_.find(previous));
+      sorted_.insert(value);
+      sum_ += value - previous;
+      previous = value;
+      update_extremes();
+    }
+  }
+}
+
+void madara::knowledge::containers::Aggregate::unsubscribed(void)
+{
+  subscribed_ = false;
+}
+
+void madara::knowledge::containers::Aggregate::update_extremes(void)
+{
+  if (!sorted_.empty())
+  {
+    min_ = *sorted_.begin();
+    max_ = *sorted_.rbegin();
+  }
+  else
+  {
+    min_ = 0;
+    max_ = 0;
+  }
+}
+
+#endif  // _MADARA_NO_KARL_
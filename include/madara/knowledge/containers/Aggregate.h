@@ -0,0 +1,152 @@
+#ifndef _MADARA_CONTAINERS_AGGREGATE_H_
+#define _MADARA_CONTAINERS_AGGREGATE_H_
+
+#ifndef _MADARA_NO_KARL_
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "madara/knowledge/ChangeSubscriber.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+
+/**
+ * @file Aggregate.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the Aggregate class, which keeps the sum, minimum
+ * and maximum of a ring of variables up to date as they change
+ **/
+
+namespace madara
+{
+namespace knowledge
+{
+namespace containers
+{
+/**
+ * @class Aggregate
+ * @brief Sum, minimum and maximum of the integer values of the variables
+ *        {name}.0 to {name}.{size - 1}, e.g., the counter ring of Counter.
+ *        The context notifies the aggregate whenever one of the variables
+ *        changes, locally or from the network, so reads take constant time
+ *        and do not lock the context. The context must outlive the
+ *        aggregate or remove its subscriptions when it is destroyed.
+ */
+class MADARA_EXPORT Aggregate : public ChangeSubscriber
+{
+public:
+  /// trait that describes the value type
+  typedef knowledge::KnowledgeRecord::Integer type;
+
+  /**
+   * Constructor. The aggregate does not read the variables until it
+   * subscribes to them.
+   * @param  context   the context of the variables
+   * @param  name      the prefix of the variables
+   * @param  size      the number of variables
+   **/
+  Aggregate(ThreadSafeContext& context, const std::string& name, int size);
+
+  /**
+   * Destructor. Unsubscribes from the context.
+   **/
+  virtual ~Aggregate();
+
+  // subscriptions refer to the aggregate, so it may not be copied
+  Aggregate(const Aggregate&) = delete;
+  Aggregate& operator=(const Aggregate&) = delete;
+
+  /**
+   * Reads all variables and subscribes to them, unless the aggregate is
+   * already subscribed. Locks the context.
+   **/
+  void subscribe(void);
+
+  /**
+   * Returns true if the aggregate is notified of changes. Erasing
+   * variables from the context removes all subscriptions.
+   * @return true if the aggregates are up to date
+   **/
+  bool is_subscribed(void) const;
+
+  /**
+   * Returns the number of variables
+   * @return the number of variables in the ring
+   **/
+  int size(void) const;
+
+  /**
+   * Returns the sum of the variables
+   * @return the sum
+   **/
+  type sum(void) const;
+
+  /**
+   * Returns the smallest variable
+   * @return the minimum, or 0 if there are no variables
+   **/
+  type min(void) const;
+
+  /**
+   * Returns the largest variable
+   * @return the maximum, or 0 if there are no variables
+   **/
+  type max(void) const;
+
+  /**
+   * Updates the aggregates with the new value of a variable. Called by
+   * the context, which is locked.
+   * @param  variable   the modified variable
+   **/
+  virtual void modified(const VariableReference& variable);
+
+  /**
+   * Called by the context when it removes all subscriptions
+   **/
+  virtual void unsubscribed(void);
+
+private:
+  /**
+   * Reads the minimum and maximum from the sorted values
+   **/
+  void update_extremes(void);
+
+  /// the context of the variables
+  ThreadSafeContext* context_;
+
+  /// the prefix of the variables
+  std::string name_;
+
+  /// the number of variables
+  int size_;
+
+  /// true if the aggregate is notified of changes to the variables
+  std::atomic<bool> subscribed_;
+
+  /// the sum of the variables
+  std::atomic<type> sum_;
+
+  /// the smallest variable
+  std::atomic<type> min_;
+
+  /// the largest variable
+  std::atomic<type> max_;
+
+  /// the index of each variable, by record
+  std::unordered_map<const KnowledgeRecord*, size_t> indices_;
+
+  /// the last value read from each variable
+  std::vector<type> values_;
+
+  /// the values in order, for the minimum and maximum
+  std::multiset<type> sorted_;
+};
+}
+}
+}
+
+#endif  // _MADARA_NO_KARL_
+
+#endif  // _MADARA_CONTAINERS_AGGREGATE_H_
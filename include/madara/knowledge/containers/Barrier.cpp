@@ -1,14 +1,20 @@
 
 #ifndef _MADARA_NO_KARL_
 
+#include <algorithm>
 #include <sstream>
 
 #include "Barrier.h"
+#include "Aggregate.h"
 #include "madara/knowledge/ContextGuard.h"
 
 madara::knowledge::containers::Barrier::Barrier(
     const KnowledgeUpdateSettings& settings)
-  : BaseContainer("", settings), context_(0), id_(0), participants_(1)
+  : BaseContainer("", settings),
+    context_(0),
+    id_(0),
+    participants_(1),
+    fanout_(0)
 {
   init_noharm();
 }
@@ -18,7 +24,8 @@ madara::knowledge::containers::Barrier::Barrier(const std::string& name,
   : BaseContainer(name, settings),
     context_(&(knowledge.get_context())),
     id_(0),
-    participants_(1)
+    participants_(1),
+    fanout_(0)
 {
   init_noharm();
   build_var();
@@ -30,7 +37,8 @@ madara::knowledge::containers::Barrier::Barrier(const std::string& name,
   : BaseContainer(name, settings),
     context_(knowledge.get_context()),
     id_(0),
-    participants_(1)
+    participants_(1),
+    fanout_(0)
 {
   init_noharm();
   build_var();
@@ -43,7 +51,8 @@ madara::knowledge::containers::Barrier::Barrier(const std::string& name,
   : BaseContainer(name, settings),
     context_(&(knowledge.get_context())),
     id_(id),
-    participants_(participants)
+    participants_(participants),
+    fanout_(0)
 {
   init_noharm();
   build_var();
@@ -56,7 +65,8 @@ madara::knowledge::containers::Barrier::Barrier(const std::string& name,
   : BaseContainer(name, settings),
     context_(knowledge.get_context()),
     id_(id),
-    participants_(participants)
+    participants_(participants),
+    fanout_(0)
 {
   init_noharm();
   build_var();
@@ -69,7 +79,11 @@ madara::knowledge::containers::Barrier::Barrier(const Barrier& rhs)
     variable_(rhs.variable_),
     id_(rhs.id_),
     participants_(rhs.participants_),
-    aggregate_barrier_(rhs.aggregate_barrier_),
+    fanout_(rhs.fanout_),
+    aggregate_(rhs.aggregate_),
+    children_(rhs.children_),
+    subtree_(rhs.subtree_),
+    root_(rhs.root_),
     variable_name_(rhs.variable_name_)
 {
 }
@@ -88,7 +102,11 @@ void madara::knowledge::containers::Barrier::operator=(const Barrier& rhs)
     this->participants_ = rhs.participants_;
     this->settings_ = rhs.settings_;
     this->variable_ = rhs.variable_;
-    this->aggregate_barrier_ = rhs.aggregate_barrier_;
+    this->fanout_ = rhs.fanout_;
+    this->aggregate_ = rhs.aggregate_;
+    this->children_ = rhs.children_;
+    this->subtree_ = rhs.subtree_;
+    this->root_ = rhs.root_;
     this->variable_name_ = rhs.variable_name_;
   }
 }
@@ -100,35 +118,46 @@ void madara::knowledge::containers::Barrier::build_aggregate_barrier(void)
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
-    std::stringstream buffer;
-    if (participants_ > 0)
+    children_.clear();
+    subtree_ = VariableReference();
+    root_ = VariableReference();
+    aggregate_.reset();
+
+    if (fanout_ > 0)
     {
-      // barrier logic is that everyone else is at least to your barrier
-      buffer << name_;
-      buffer << ".0 >= ";
-      buffer << name_;
-      buffer << ".";
-      buffer << id_;
-
-      // add all other barrierer variables
-      for (size_t i = 1; i < participants_; ++i)
+      // the subtree of a participant is itself and the subtrees of its
+      // children
+      for (size_t i = id_ * fanout_ + 1;
+           i <= id_ * fanout_ + fanout_ && i < participants_; ++i)
       {
-        buffer << " && ";
-        buffer << name_;
-        buffer << ".";
-        buffer << i;
-        buffer << " >= ";
-        buffer << name_;
-        buffer << ".";
-        buffer << id_;
+        std::stringstream buffer;
+        buffer << name_ << ".min." << i;
+
+        children_.push_back(context_->get_ref(buffer.str(), no_harm));
       }
-    }
 
-    aggregate_barrier_ = context_->compile(buffer.str());
+      std::stringstream buffer;
+      buffer << name_ << ".min." << id_;
 
-    madara_logger_log(context_->get_logger(), logger::LOG_MAJOR,
-        "Barrier::build_aggregate_barrier: building barrier string of %s\n",
-        buffer.str().c_str());
+      subtree_ = context_->get_ref(buffer.str(), no_harm);
+      root_ = context_->get_ref(name_ + ".min.0", no_harm);
+
+      madara_logger_log(context_->get_logger(), logger::LOG_MAJOR,
+          "Barrier::build_aggregate_barrier: participant %d of %s has %d "
+          "children\n",
+          (int)id_, name_.c_str(), (int)children_.size());
+    }
+    else
+    {
+      // subscribed to the round variables when the barrier is first checked
+      aggregate_ =
+          std::make_shared<Aggregate>(*context_, name_, (int)participants_);
+
+      madara_logger_log(context_->get_logger(), logger::LOG_MAJOR,
+          "Barrier::build_aggregate_barrier: aggregating %d round variables "
+          "of %s\n",
+          (int)participants_, name_.c_str());
+    }
   }
   else if (name_ == "")
   {
@@ -171,6 +200,57 @@ void madara::knowledge::containers::Barrier::build_var(void)
   }
 }
 
+madara::knowledge::containers::Barrier::type
+madara::knowledge::containers::Barrier::barrier_result(void) const
+{
+  type round = context_->get(variable_, no_harm).to_integer();
+  type everyone = round;
+
+  if (fanout_ > 0)
+  {
+    if (id_ == 0)
+    {
+      // the root does not wait for its own published minimum
+      for (const VariableReference& child : children_)
+      {
+        everyone = std::min(everyone, context_->get(child).to_integer());
+      }
+    }
+    else
+    {
+      everyone = context_->get(root_).to_integer();
+    }
+  }
+  else if (aggregate_)
+  {
+    // erasing variables from the context removes the subscriptions
+    if (!aggregate_->is_subscribed())
+      aggregate_->subscribe();
+
+    everyone = aggregate_->min();
+  }
+
+  return everyone >= round ? 1 : 0;
+}
+
+madara::knowledge::containers::Barrier::type
+madara::knowledge::containers::Barrier::publish_subtree(void)
+{
+  type subtree = context_->get(variable_, no_harm).to_integer();
+
+  for (const VariableReference& child : children_)
+  {
+    subtree = std::min(subtree, context_->get(child).to_integer());
+  }
+
+  if (context_->get(subtree_).to_integer() != subtree)
+  {
+    context_->set(subtree_, subtree, settings_);
+  }
+
+  return subtree;
+}
+
 void madara::knowledge::containers::Barrier::init_noharm(void)
 {
   no_harm.always_overwrite = false;
@@ -262,6 +342,31 @@ void madara::knowledge::containers::Barrier::resize(
   }
 }
 
+void madara::knowledge::containers::Barrier::set_fanout(size_t fanout)
+{
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    fanout_ = fanout;
+
+    this->build_aggregate_barrier();
+  }
+  else
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    fanout_ = fanout;
+  }
+}
+
+size_t madara::knowledge::containers::Barrier::get_fanout(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  return fanout_;
+}
+
 madara::knowledge::containers::Barrier::type
 madara::knowledge::containers::Barrier::operator=(type value)
 {
@@ -312,6 +417,9 @@ void madara::knowledge::containers::Barrier::next(void)
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
     context_->inc(variable_, settings_);
+
+    if (fanout_ > 0)
+      publish_subtree();
   }
 }
 
@@ -327,6 +435,9 @@ bool madara::knowledge::containers::Barrier::is_done(void)
     madara_logger_log(context_->get_logger(), logger::LOG_MAJOR,
         "Barrier::is_done: checking barrier result for done\n");
 
+    if (fanout_ > 0)
+      publish_subtree();
+
     result = barrier_result() == 1;
 
     if (!result)
@@ -337,7 +448,12 @@ bool madara::knowledge::containers::Barrier::is_done(void)
 
       context_->mark_modified(variable_);
 
-      context_->print(logger::LOG_DETAILED);
+      if (fanout_ > 0)
+        context_->mark_modified(subtree_);
+
+      // printing walks the whole context, so skip it unless it is logged
+      if (context_->get_logger().get_level() >= logger::LOG_DETAILED)
+        context_->print(logger::LOG_DETAILED);
     }
     else
     {
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include "madara/LockType.h"
 #include "madara/knowledge/KnowledgeBase.h"
 #include "madara/knowledge/ThreadSafeContext.h"
@@ -26,9 +27,18 @@ namespace knowledge
 {
 namespace containers
 {
+class Aggregate;
+
 /**
  * @class Barrier
- * @brief This class stores an integer within a variable context
+ * @brief This class stores an integer within a variable context. Each
+ *        participant in the barrier ring has a round variable, and a round
+ *        is done when every participant has reached it. By default, the
+ *        barrier keeps the minimum round of all participants up to date
+ *        as their variables arrive, so is_done takes constant time. With
+ *        a fan-out (see set_fanout), participants form a tree instead, and
+ *        each one publishes the minimum round of its subtree, so a
+ *        participant only reads its children and the root.
  */
 class MADARA_EXPORT Barrier : public BaseContainer
 {
@@ -236,6 +246,24 @@ public:
    **/
   void resize(size_t id = 0, size_t participants = 1);
 
+  /**
+   * Arranges the participants in a tree, where the children of participant
+   * i are participants i * fanout + 1 to i * fanout + fanout. Each
+   * participant publishes the minimum round of its subtree in
+   * {name}.min.{id} during next and is_done, and a round is done when the
+   * minimum of the root, participant 0, has reached it. All participants
+   * must use the same fan-out.
+   * @param fanout    the number of children of each participant, or 0 for
+   *                  every participant to read every round variable
+   **/
+  void set_fanout(size_t fanout);
+
+  /**
+   * Returns the number of children of each participant in the tree
+   * @return the fan-out, or 0 if the participants do not form a tree
+   **/
+  size_t get_fanout(void) const;
+
   /**
    * Returns the type of the container along with name and any other
    * useful information. The provided information should be useful
@@ -306,13 +334,17 @@ private:
   void build_aggregate_barrier(void);
 
   /**
-   * Checks if current barrier is successful
+   * Checks if current barrier is successful. The context must be locked.
    * @return  0 if unsuccessful, otherwise it is successful
    **/
-  inline type barrier_result(void) const
-  {
-    return context_->evaluate(aggregate_barrier_, no_harm).to_integer();
-  }
+  type barrier_result(void) const;
+
+  /**
+   * Publishes the minimum round of the subtree of this participant, if it
+   * changed. The context must be locked.
+   * @return  the minimum round of the subtree
+   **/
+  type publish_subtree(void);
 
   /**
    * Builds the variable that is actually incremented
@@ -345,9 +377,29 @@ private:
   size_t participants_;
 
   /**
-   * Expression for aggregating barrier in one atomic operation
+   * the number of children of each participant in the tree, or 0
+   **/
+  size_t fanout_;
+
+  /**
+   * Minimum round of all participants, if the participants are not a tree
+   **/
+  std::shared_ptr<Aggregate> aggregate_;
+
+  /**
+   * Minimum rounds of the subtrees of the children of this participant
+   **/
+  std::vector<VariableReference> children_;
+
+  /**
+   * Minimum round of the subtree of this participant
+   **/
+  VariableReference subtree_;
+
+  /**
+   * Minimum round of the subtree of the root, i.e., of all participants
    **/
-  CompiledExpression aggregate_barrier_;
+  VariableReference root_;
 
   /**
    * Settings we'll use for all evaluations
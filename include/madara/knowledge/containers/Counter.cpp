@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "Counter.h"
+#include "Aggregate.h"
 #include "madara/knowledge/ContextGuard.h"
 
 madara::knowledge::containers::Counter::Counter(
@@ -71,7 +72,7 @@ madara::knowledge::containers::Counter::Counter(const Counter& rhs)
     variable_(rhs.variable_),
     id_(rhs.id_),
     counters_(rhs.counters_),
-    aggregate_count_(rhs.aggregate_count_)
+    aggregate_(rhs.aggregate_)
 {
 }
 
@@ -89,7 +90,7 @@ void madara::knowledge::containers::Counter::operator=(const Counter& rhs)
     this->counters_ = rhs.counters_;
     this->settings_ = rhs.settings_;
     this->variable_ = rhs.variable_;
-    this->aggregate_count_ = rhs.aggregate_count_;
+    this->aggregate_ = rhs.aggregate_;
   }
 }
 
@@ -100,24 +101,8 @@ void madara::knowledge::containers::Counter::build_aggregate_count(void)
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
-    std::stringstream buffer;
-    if (counters_ > 0)
-    {
-      // add the first counter variable
-      buffer << name_;
-      buffer << ".0";
-
-      // add all other counter variables
-      for (int i = 1; i < counters_; ++i)
-      {
-        buffer << "+";
-        buffer << name_;
-        buffer << ".";
-        buffer << i;
-      }
-    }
-
-    aggregate_count_ = context_->compile(buffer.str());
+    // subscribed to the counter variables when the counter is first read
+    aggregate_ = std::make_shared<Aggregate>(*context_, name_, counters_);
   }
   else if (name_ == "")
   {
@@ -186,7 +171,7 @@ std::string madara::knowledge::containers::Counter::get_debug_info(void)
 
     result << this->name_;
     result << " = " << context_->get(variable_).to_string();
-    result << " (total: " << get_count() << ")";
+    result << " (total: " << get_sum() << ")";
   }
 
   return result.str();
@@ -282,9 +267,7 @@ bool madara::knowledge::containers::Counter::operator==(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() == value;
+    return get_sum() == value;
   }
 
   return false;
@@ -294,9 +277,7 @@ bool madara::knowledge::containers::Counter::operator!=(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() != value;
+    return get_sum() != value;
   }
 
   return true;
@@ -307,9 +288,7 @@ bool madara::knowledge::containers::Counter::operator==(
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() == value.get_count();
+    return get_sum() == value.get_sum();
   }
 
   return false;
@@ -320,9 +299,7 @@ bool madara::knowledge::containers::Counter::operator!=(
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() != value.get_count();
+    return get_sum() != value.get_sum();
   }
 
   return true;
@@ -332,9 +309,7 @@ bool madara::knowledge::containers::Counter::operator<(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() < value;
+    return get_sum() < value;
   }
 
   return false;
@@ -344,9 +319,7 @@ bool madara::knowledge::containers::Counter::operator<=(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() <= value;
+    return get_sum() <= value;
   }
 
   return false;
@@ -356,9 +329,7 @@ bool madara::knowledge::containers::Counter::operator>(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() > value;
+    return get_sum() > value;
   }
 
   return false;
@@ -368,9 +339,7 @@ bool madara::knowledge::containers::Counter::operator>=(type value) const
 {
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    return get_count() >= value;
+    return get_sum() >= value;
   }
 
   return false;
@@ -389,9 +358,7 @@ madara::knowledge::containers::Counter::to_record(void) const
 
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    result = get_count_record();
+    result.set_value(get_sum());
   }
 
   return result;
@@ -400,16 +367,7 @@ madara::knowledge::containers::Counter::to_record(void) const
 madara::knowledge::KnowledgeRecord::Integer
 madara::knowledge::containers::Counter::to_integer(void) const
 {
-  madara::knowledge::KnowledgeRecord::Integer result(0);
-
-  if (context_)
-  {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    result = get_count();
-  }
-
-  return result;
+  return get_sum();
 }
 
 void madara::knowledge::containers::Counter::operator+=(type value)
@@ -462,30 +420,74 @@ void madara::knowledge::containers::Counter::operator--(void)
 
 double madara::knowledge::containers::Counter::to_double(void) const
 {
-  double result(0.0);
+  return (double)get_sum();
+}
+
+std::string madara::knowledge::containers::Counter::to_string(void) const
+{
+  std::string result;
 
   if (context_)
   {
-    ContextGuard context_guard(*context_);
-    MADARA_GUARD_TYPE guard(mutex_);
-    result = get_count_double();
+    result = KnowledgeRecord(get_sum()).to_string();
   }
 
   return result;
 }
 
-std::string madara::knowledge::containers::Counter::to_string(void) const
+std::shared_ptr<madara::knowledge::containers::Aggregate>
+madara::knowledge::containers::Counter::get_aggregate(void) const
 {
-  std::string result;
+  std::shared_ptr<Aggregate> aggregate;
 
-  if (context_)
   {
-    ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
-    result = get_count_string();
+    aggregate = aggregate_;
   }
 
-  return result;
+  // erasing variables from the context removes the subscriptions
+  if (aggregate && !aggregate->is_subscribed())
+  {
+    aggregate->subscribe();
+  }
+
+  return aggregate;
+}
+
+madara::knowledge::containers::Counter::type
+madara::knowledge::containers::Counter::get_sum(void) const
+{
+  std::shared_ptr<Aggregate> aggregate = get_aggregate();
+
+  return aggregate ? aggregate->sum() : 0;
+}
+
+madara::knowledge::containers::Counter::type
+madara::knowledge::containers::Counter::get_min(void) const
+{
+  std::shared_ptr<Aggregate> aggregate = get_aggregate();
+
+  return aggregate ? aggregate->min() : 0;
+}
+
+madara::knowledge::containers::Counter::type
+madara::knowledge::containers::Counter::get_max(void) const
+{
+  std::shared_ptr<Aggregate> aggregate = get_aggregate();
+
+  return aggregate ? aggregate->max() : 0;
+}
+
+double madara::knowledge::containers::Counter::get_average(void) const
+{
+  std::shared_ptr<Aggregate> aggregate = get_aggregate();
+
+  if (aggregate && aggregate->size() > 0)
+  {
+    return (double)aggregate->sum() / aggregate->size();
+  }
+
+  return 0.0;
 }
 
 void madara::knowledge::containers::Counter::set_quality(
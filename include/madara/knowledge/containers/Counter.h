@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include "madara/LockType.h"
 #include "madara/knowledge/KnowledgeBase.h"
 #include "madara/knowledge/ThreadSafeContext.h"
@@ -26,9 +27,15 @@ namespace knowledge
 {
 namespace containers
 {
+class Aggregate;
+
 /**
  * @class Counter
- * @brief This class stores an integer within a variable context
+ * @brief This class stores an integer within a variable context. Each
+ *        counter in the counter ring has its own variable, and reads
+ *        return the aggregate of all of them. The aggregates are kept up
+ *        to date as the variables change, locally or from the network, so
+ *        reads do not depend on the number of counters.
  */
 class MADARA_EXPORT Counter : public BaseContainer
 {
@@ -255,6 +262,30 @@ public:
    **/
   std::string to_string(void) const;
 
+  /**
+   * Returns the sum of all counters in the counter ring (same as *)
+   * @return the sum of the counters
+   **/
+  type get_sum(void) const;
+
+  /**
+   * Returns the smallest counter in the counter ring
+   * @return the minimum of the counters
+   **/
+  type get_min(void) const;
+
+  /**
+   * Returns the largest counter in the counter ring
+   * @return the maximum of the counters
+   **/
+  type get_max(void) const;
+
+  /**
+   * Returns the average of the counters in the counter ring
+   * @return the sum of the counters divided by the number of counters
+   **/
+  double get_average(void) const;
+
   /**
    * Sets the quality of writing to the counter variables
    *
@@ -337,7 +368,7 @@ private:
   virtual std::string get_debug_info_(void);
 
   /**
-   * Builds the aggregate counter logic
+   * Builds the aggregates of the counter variables
    **/
   void build_aggregate_count(void);
 
@@ -352,40 +383,11 @@ private:
   void init_noharm(void);
 
   /**
-   * Counts all counter variables
-   * @return  total count
-   **/
-  inline type get_count(void) const
-  {
-    return context_->evaluate(aggregate_count_, no_harm).to_integer();
-  }
-
-  /**
-   * Counts all counter variables
-   * @return  total count
-   **/
-  inline std::string get_count_string(void) const
-  {
-    return context_->evaluate(aggregate_count_, no_harm).to_string();
-  }
-
-  /**
-   * Counts all counter variables
-   * @return  total count
-   **/
-  inline double get_count_double(void) const
-  {
-    return context_->evaluate(aggregate_count_, no_harm).to_double();
-  }
-
-  /**
-   * Counts all counter variables
-   * @return  total count
+   * Returns the aggregates, subscribing them to the counter variables if
+   * they are not already
+   * @return  the aggregates, or null if the counter has no variables
    **/
-  inline knowledge::KnowledgeRecord get_count_record(void) const
-  {
-    return context_->evaluate(aggregate_count_, no_harm);
-  }
+  std::shared_ptr<Aggregate> get_aggregate(void) const;
 
   /**
    * Variable context that we are modifying
@@ -408,9 +410,9 @@ private:
   int counters_;
 
   /**
-   * Expression for aggregating count in one atomic operation
+   * Aggregates of all counter variables, shared by copies
    **/
-  CompiledExpression aggregate_count_;
+  std::shared_ptr<Aggregate> aggregate_;
 
   /**
    * Settings we'll use for all evaluations
@@ -5,7 +5,10 @@
 
 madara::knowledge::containers::FlexMap::FlexMap(
     const KnowledgeUpdateSettings& settings, const std::string& delimiter)
-  : BaseContainer("", settings), context_(0), delimiter_(delimiter)
+  : BaseContainer("", settings),
+    context_(0),
+    delimiter_(delimiter),
+    key_generation_(0)
 {
 }
 
@@ -14,7 +17,8 @@ madara::knowledge::containers::FlexMap::FlexMap(const std::string& name,
     const std::string& delimiter)
   : BaseContainer(name, settings),
     context_(&(knowledge.get_context())),
-    delimiter_(delimiter)
+    delimiter_(delimiter),
+    key_generation_(0)
 {
 }
 
@@ -23,7 +27,8 @@ madara::knowledge::containers::FlexMap::FlexMap(const std::string& name,
     const std::string& delimiter)
   : BaseContainer(name, settings),
     context_(knowledge.get_context()),
-    delimiter_(delimiter)
+    delimiter_(delimiter),
+    key_generation_(0)
 {
 }
 
@@ -31,11 +36,16 @@ madara::knowledge::containers::FlexMap::FlexMap(const FlexMap& rhs)
   : BaseContainer(rhs),
     context_(rhs.context_),
     variable_(rhs.variable_),
-    delimiter_(rhs.delimiter_)
+    delimiter_(rhs.delimiter_),
+    key_cache_(rhs.key_cache_),
+    key_generation_(rhs.key_generation_)
 {
 }
 
-madara::knowledge::containers::FlexMap::~FlexMap() {}
+madara::knowledge::containers::FlexMap::~FlexMap()
+{
+  untrack_keys();
+}
 
 /**
  * Checks if the value in the record is not false (0)
@@ -145,12 +155,18 @@ void madara::knowledge::containers::FlexMap::operator=(const FlexMap& rhs)
 {
   if (this != &rhs)
   {
+    // like copies, the map holds no reference until it reads all keys
+    untrack_keys();
+
     MADARA_GUARD_TYPE guard(mutex_), guard2(rhs.mutex_);
 
     this->context_ = rhs.context_;
     this->name_ = rhs.name_;
     this->settings_ = rhs.settings_;
     this->variable_ = rhs.variable_;
+    this->delimiter_ = rhs.delimiter_;
+    this->key_cache_ = rhs.key_cache_;
+    this->key_generation_ = rhs.key_generation_;
   }
 }
 
@@ -488,19 +504,14 @@ size_t madara::knowledge::containers::FlexMap::size(
 
   if (!first_level_keys_only)
   {
-    // get all children
-    KnowledgeBase knowledge;
-    knowledge.facade_for(*context_);
-    Map map(name_, knowledge, settings_, delimiter_);
+    sync_key_cache();
 
-    result = map.size();
+    result = key_cache_.size();
   }
   else
   {
-    // use the context's specialized mapping feature
     std::vector<std::string> next_keys;
-    std::map<std::string, madara::knowledge::KnowledgeRecord> all_record_vars;
-    context_->to_map(name_, delimiter_, "", next_keys, all_record_vars, true);
+    keys(next_keys, true);
 
     result = next_keys.size();
   }
@@ -575,12 +586,14 @@ void madara::knowledge::containers::FlexMap::set_name(
 {
   if (context_ != &(knowledge.get_context()) || name_ != var_name)
   {
+    untrack_keys();
     context_ = &(knowledge.get_context());
 
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
     name_ = var_name;
+    key_generation_ = 0;
 
     if (context_->exists(var_name, settings_))
     {
@@ -601,12 +614,14 @@ void madara::knowledge::containers::FlexMap::set_name(
 {
   if (context_ != knowledge.get_context() || name_ != var_name)
   {
+    untrack_keys();
     context_ = knowledge.get_context();
 
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
     name_ = var_name;
+    key_generation_ = 0;
 
     if (context_->exists(var_name, settings_))
     {
@@ -636,7 +651,9 @@ void madara::knowledge::containers::FlexMap::update_variable(void) const
 void madara::knowledge::containers::FlexMap::set_delimiter(
     const std::string& delimiter)
 {
+  untrack_keys();
   delimiter_ = delimiter;
+  key_generation_ = 0;
 }
 
 std::string madara::knowledge::containers::FlexMap::get_delimiter(void)
@@ -700,24 +717,94 @@ void madara::knowledge::containers::FlexMap::keys(
   ContextGuard context_guard(*context_);
   MADARA_GUARD_TYPE guard(mutex_);
 
+  sync_key_cache();
+
+  curkeys.clear();
+
   if (!first_level_keys_only)
   {
-    // use the Map container, which already has clear implemented
-    KnowledgeBase knowledge;
-    knowledge.facade_for(*context_);
-    Map map(name_, knowledge, settings_, delimiter_);
+    curkeys.assign(key_cache_.begin(), key_cache_.end());
+  }
+  else
+  {
+    // keys are sorted, so keys with the same first level are adjacent
+    for (std::set<std::string>::const_iterator i = key_cache_.begin();
+         i != key_cache_.end(); ++i)
+    {
+      std::string current_key(i->substr(0, i->find(delimiter_)));
+
+      if (!current_key.empty() &&
+          (curkeys.empty() || curkeys.back() != current_key))
+      {
+        curkeys.push_back(current_key);
+      }
+    }
+  }
+}
+
+void madara::knowledge::containers::FlexMap::sync_key_cache(void) const
+{
+  std::string common = name_ + delimiter_;
+
+  KeyChanges changes = context_->get_key_changes(common, key_generation_);
+
+  if (changes.complete)
+  {
+    // erased and recreated keys are in both lists, so remove first
+    for (size_t i = 0; i < changes.removed.size(); ++i)
+      key_cache_.erase(changes.removed[i].substr(common.size()));
+
+    for (size_t i = 0; i < changes.added.size(); ++i)
+      key_cache_.insert(changes.added[i].substr(common.size()));
 
-    map.keys(curkeys);
+    key_generation_ = changes.generation;
   }
   else
   {
-    // use the context's specialized mapping feature
-    std::vector<std::string> next_keys;
-    std::map<std::string, madara::knowledge::KnowledgeRecord> all_record_vars;
-    context_->to_map(name_, delimiter_, "", curkeys, all_record_vars, true);
+    // the context is locked, so the keys read here are those of the
+    // generation returned by track_keys
+    key_generation_ = track_keys(common);
+
+    std::map<std::string, knowledge::KnowledgeRecord> contents;
+    context_->to_map(common, contents);
+
+    key_cache_.clear();
+
+    for (std::map<std::string, knowledge::KnowledgeRecord>::iterator i =
+             contents.begin();
+         i != contents.end(); ++i)
+    {
+      key_cache_.insert(key_cache_.end(), i->first.substr(common.size()));
+    }
   }
 }
 
+uint64_t madara::knowledge::containers::FlexMap::track_keys(
+    const std::string& prefix) const
+{
+  // each map holds one reference to the log of its keys
+  if (tracked_context_.expired() || tracked_keys_ != prefix)
+  {
+    untrack_keys();
+
+    tracked_keys_ = prefix;
+    tracked_context_ = context_->get_lifetime();
+    return context_->track_keys(prefix);
+  }
+
+  return context_->get_key_generation();
+}
+
+void madara::knowledge::containers::FlexMap::untrack_keys(void) const
+{
+  // the context may have been destroyed before the map
+  if (!tracked_context_.expired())
+    context_->untrack_keys(tracked_keys_);
+
+  tracked_context_.reset();
+  tracked_keys_.clear();
+}
+
 int madara::knowledge::containers::FlexMap::read_file(
     const std::string& filename)
 {
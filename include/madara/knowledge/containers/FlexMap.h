@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include "madara/LockType.h"
 #include "madara/knowledge/KnowledgeBase.h"
@@ -234,8 +235,9 @@ public:
   size_t size(bool first_level_keys_only = true) const;
 
   /**
-   * Returns the keys within the map. This can be an O(n)
-   * operation that checks for any key that has name{delimiter}key.
+   * Returns the keys within the map. The keys are cached, and only the
+   * keys created and erased since the last call are applied, using the
+   * key log of the context (@see ThreadSafeContext::track_keys).
    * @param curkeys the results of the operation
    * @param first_level_keys_only  if true, only generate first level
    *                               keys
@@ -666,6 +668,26 @@ private:
   /// Updates the variable reference if necessary
   void update_variable(void) const;
 
+  /**
+   * Applies the keys created and erased since the last call to the
+   * key cache, or reads all keys if the key log no longer reaches back
+   * to the last call. The context and the map must be locked.
+   **/
+  void sync_key_cache(void) const;
+
+  /**
+   * Holds a reference to the key log of a prefix, releasing the one held
+   * for a previous prefix. The context must be locked.
+   * @param  prefix   the prefix of the keys in the map
+   * @return the current generation of the key log
+   **/
+  uint64_t track_keys(const std::string& prefix) const;
+
+  /**
+   * Releases the reference to a key log held by the map, if any
+   **/
+  void untrack_keys(void) const;
+
   /// internal map of variable references
   typedef std::map<std::string, VariableReference> InternalFlexMap;
 
@@ -683,6 +705,29 @@ private:
    * Delimiter for the prefix to subvars
    **/
   std::string delimiter_;
+
+  /**
+   * Keys under name{delimiter}, without the prefix
+   **/
+  mutable std::set<std::string> key_cache_;
+
+  /**
+   * Generation of the context's key log at the last sync of the key
+   * cache, or 0 if the keys must be read again
+   **/
+  mutable uint64_t key_generation_;
+
+  /**
+   * Prefix of the key log the map holds a reference to. Copies do not
+   * share the reference.
+   **/
+  mutable std::string tracked_keys_;
+
+  /**
+   * Lifetime of the context of the key log, which expires if the context
+   * is destroyed before the map
+   **/
+  mutable std::weak_ptr<void> tracked_context_;
 };
 }
 }
@@ -277,6 +277,79 @@ public:
   int set(
       const std::vector<type>& value, const KnowledgeUpdateSettings& settings);
 
+  /**
+   * Sets a range of elements, locking the context once and signalling
+   * the changes once. The vector grows if the range ends past its end.
+   *
+   * @param first           index of the first element to set
+   * @param values          values of the elements
+   * @return                0 if successful, -1 if key is null, and
+   *                        -2 if quality isn't high enough
+   **/
+  int set_range(size_t first, const std::vector<type>& values);
+
+  /**
+   * Sets a range of elements from a pointer to values, and the number
+   * of values. @see set_range
+   *
+   * @param values          pointer to the values
+   * @param count           number of values
+   * @param first           index of the first element to set
+   * @return                0 if successful, -1 if key is null, and
+   *                        -2 if quality isn't high enough
+   **/
+  int copy_from(const type* values, size_t count, size_t first = 0);
+
+  /**
+   * Sets a range of elements from a pointer to values, and the number
+   * of values. @see set_range
+   *
+   * @param values          pointer to the values
+   * @param count           number of values
+   * @param first           index of the first element to set
+   * @param settings        settings for applying the update
+   * @return                0 if successful, -1 if key is null, and
+   *                        -2 if quality isn't high enough
+   **/
+  int copy_from(const type* values, size_t count, size_t first,
+      const KnowledgeUpdateSettings& settings);
+
+  /**
+   * Replaces the elements with a range of values. The vector is
+   * resized to the number of values, and the variables of elements past
+   * them are deleted. @see set_range
+   *
+   * @param first           pointer to the first value
+   * @param last            pointer past the last value
+   * @return                0 if successful, -1 if key is null, and
+   *                        -2 if quality isn't high enough
+   **/
+  int assign(const type* first, const type* last);
+
+  /**
+   * Sets a range of elements to a value, locking the context once and
+   * signalling the changes once
+   *
+   * @param value           value to set the elements to
+   * @param first           index of the first element to set
+   * @param last            index past the last element to set. Elements
+   *                        past the end of the vector are not set.
+   * @return                0 if successful, -1 if key is null, and
+   *                        -2 if quality isn't high enough
+   **/
+  int fill(
+      const type& value, size_t first = 0, size_t last = (size_t)-1);
+
+  /**
+   * Copies a range of elements, locking the context once
+   *
+   * @param target          buffer for at least count elements
+   * @param count           maximum number of elements to copy
+   * @param first           index of the first element to copy
+   * @return                the number of elements copied
+   **/
+  size_t copy_to(type* target, size_t count, size_t first = 0) const;
+
   /**
    * Sets the quality of writing to a certain variable from this entity
    *
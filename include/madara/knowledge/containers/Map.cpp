@@ -5,7 +5,10 @@
 
 madara::knowledge::containers::Map::Map(
     const KnowledgeUpdateSettings& settings, const std::string& delimiter)
-  : BaseContainer("", settings), context_(0), delimiter_(delimiter)
+  : BaseContainer("", settings),
+    context_(0),
+    delimiter_(delimiter),
+    key_generation_(0)
 {
 }
 
@@ -14,23 +17,10 @@ madara::knowledge::containers::Map::Map(const std::string& name,
     const std::string& delimiter)
   : BaseContainer(name, settings),
     context_(&(knowledge.get_context())),
-    delimiter_(delimiter)
+    delimiter_(delimiter),
+    key_generation_(0)
 {
-  std::map<std::string, knowledge::KnowledgeRecord> contents;
-  std::string common = name + delimiter_;
-  context_->to_map(common, contents);
-
-  KnowledgeUpdateSettings keep_local(true);
-  if (contents.size() > 0)
-  {
-    for (std::map<std::string, knowledge::KnowledgeRecord>::iterator i =
-             contents.begin();
-         i != contents.end(); ++i)
-    {
-      map_[i->first.substr(common.size())] =
-          knowledge.get_ref(i->first, keep_local);
-    }
-  }
+  sync_keys();
 }
 
 madara::knowledge::containers::Map::Map(const std::string& name,
@@ -38,34 +28,25 @@ madara::knowledge::containers::Map::Map(const std::string& name,
     const std::string& delimiter)
   : BaseContainer(name, settings),
     context_(knowledge.get_context()),
-    delimiter_(delimiter)
+    delimiter_(delimiter),
+    key_generation_(0)
 {
-  std::map<std::string, knowledge::KnowledgeRecord> contents;
-  std::string common = name + delimiter_;
-  context_->to_map(common, contents);
-
-  KnowledgeUpdateSettings keep_local(true);
-  if (contents.size() > 0)
-  {
-    for (std::map<std::string, knowledge::KnowledgeRecord>::iterator i =
-             contents.begin();
-         i != contents.end(); ++i)
-    {
-      map_[i->first.substr(common.size())] =
-          knowledge.get_ref(i->first, keep_local);
-    }
-  }
+  sync_keys();
 }
 
 madara::knowledge::containers::Map::Map(const Map& rhs)
   : BaseContainer(rhs),
     context_(rhs.context_),
     map_(rhs.map_),
-    delimiter_(rhs.delimiter_)
+    delimiter_(rhs.delimiter_),
+    key_generation_(rhs.key_generation_)
 {
 }
 
-madara::knowledge::containers::Map::~Map() {}
+madara::knowledge::containers::Map::~Map()
+{
+  untrack_keys();
+}
 
 void madara::knowledge::containers::Map::modify(void)
 {
@@ -150,12 +131,17 @@ void madara::knowledge::containers::Map::operator=(const Map& rhs)
 {
   if (this != &rhs)
   {
+    // like copies, the map holds no reference until it reads all keys
+    untrack_keys();
+
     MADARA_GUARD_TYPE guard(mutex_), guard2(rhs.mutex_);
 
     this->context_ = rhs.context_;
     this->name_ = rhs.name_;
     this->settings_ = rhs.settings_;
     this->map_ = rhs.map_;
+    this->delimiter_ = rhs.delimiter_;
+    this->key_generation_ = rhs.key_generation_;
   }
 }
 
@@ -212,22 +198,52 @@ std::vector<std::string> madara::knowledge::containers::Map::sync_keys(void)
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
-    clear(false);
-
-    std::map<std::string, knowledge::KnowledgeRecord> contents;
     std::string common = name_ + delimiter_;
-    context_->to_map(common, contents);
     KnowledgeUpdateSettings keep_local(true);
 
-    for (std::map<std::string, knowledge::KnowledgeRecord>::iterator i =
-             contents.begin();
-         i != contents.end(); ++i)
+    KeyChanges changes =
+        context_->get_key_changes(common, key_generation_);
+
+    if (changes.complete)
     {
-      std::string key = i->first.substr(common.size());
+      // erased and recreated keys are in both lists, so remove first
+      for (size_t i = 0; i < changes.removed.size(); ++i)
+        map_.erase(changes.removed[i].substr(common.size()));
 
-      if (map_.find(key) == map_.end())
+      for (size_t i = 0; i < changes.added.size(); ++i)
       {
-        additions.push_back(key);
+        std::string key = changes.added[i].substr(common.size());
+
+        if (map_.find(key) == map_.end())
+        {
+          additions.push_back(key);
+          map_[key] = context_->get_ref(changes.added[i], keep_local);
+        }
+      }
+
+      key_generation_ = changes.generation;
+    }
+    else
+    {
+      // the context is locked, so the keys read here are those of the
+      // generation returned by track_keys
+      key_generation_ = track_keys(common);
+
+      std::map<std::string, knowledge::KnowledgeRecord> contents;
+      context_->to_map(common, contents);
+
+      InternalMap previous;
+      previous.swap(map_);
+
+      for (std::map<std::string, knowledge::KnowledgeRecord>::iterator i =
+               contents.begin();
+           i != contents.end(); ++i)
+      {
+        std::string key = i->first.substr(common.size());
+
+        if (previous.find(key) == previous.end())
+          additions.push_back(key);
+
         map_[key] = context_->get_ref(i->first, keep_local);
       }
     }
@@ -366,12 +382,14 @@ void madara::knowledge::containers::Map::clear(bool clear_knowledge)
       this->erase(keys[i]);
 
     map_.clear();
+    key_generation_ = 0;
   }
 
   else if (context_)
   {
     MADARA_GUARD_TYPE guard(mutex_);
     map_.clear();
+    key_generation_ = 0;
   }
 }
 
@@ -386,6 +404,7 @@ void madara::knowledge::containers::Map::reset(void)
       context_->clear(entry.first);
 
     map_.clear();
+    key_generation_ = 0;
   }
 }
 
@@ -413,6 +432,7 @@ void madara::knowledge::containers::Map::set_name(
 {
   if (context_ != &(knowledge.get_context()) || name_ != var_name)
   {
+    untrack_keys();
     context_ = &(knowledge.get_context());
 
     ContextGuard context_guard(*context_);
@@ -432,6 +452,7 @@ void madara::knowledge::containers::Map::set_name(
 {
   if (context_ != knowledge.get_context() || name_ != var_name)
   {
+    untrack_keys();
     context_ = knowledge.get_context();
 
     ContextGuard context_guard(*context_);
@@ -449,6 +470,7 @@ void madara::knowledge::containers::Map::set_name(
 void madara::knowledge::containers::Map::set_delimiter(
     const std::string& delimiter, bool sync)
 {
+  untrack_keys();
   delimiter_ = delimiter;
 
   if (context_)
@@ -460,6 +482,32 @@ void madara::knowledge::containers::Map::set_delimiter(
   }
 }
 
+uint64_t madara::knowledge::containers::Map::track_keys(
+    const std::string& prefix)
+{
+  // each map holds one reference to the log of its keys
+  if (tracked_context_.expired() || tracked_keys_ != prefix)
+  {
+    untrack_keys();
+
+    tracked_keys_ = prefix;
+    tracked_context_ = context_->get_lifetime();
+    return context_->track_keys(prefix);
+  }
+
+  return context_->get_key_generation();
+}
+
+void madara::knowledge::containers::Map::untrack_keys(void)
+{
+  // the context may have been destroyed before the map
+  if (!tracked_context_.expired())
+    context_->untrack_keys(tracked_keys_);
+
+  tracked_context_.reset();
+  tracked_keys_.clear();
+}
+
 std::string madara::knowledge::containers::Map::get_delimiter(void)
 {
   return delimiter_;
@@ -128,6 +128,9 @@ public:
   /**
    * Syncs the keys from the knowledge base. This can be useful
    * if you expect other knowledge bases to add variables to the map.
+   * Only the keys created and erased since the last sync are applied,
+   * using the key log of the context (@see ThreadSafeContext::track_keys),
+   * unless the log no longer reaches back to the last sync.
    * @return a vector of the keys that were added during the sync
    **/
   std::vector<std::string> sync_keys(void);
@@ -567,6 +570,19 @@ private:
    **/
   virtual std::string get_debug_info_(void);
 
+  /**
+   * Holds a reference to the key log of a prefix, releasing the one held
+   * for a previous prefix. The context must be locked.
+   * @param  prefix   the prefix of the keys in the map
+   * @return the current generation of the key log
+   **/
+  uint64_t track_keys(const std::string& prefix);
+
+  /**
+   * Releases the reference to a key log held by the map, if any
+   **/
+  void untrack_keys(void);
+
   /// internal map of variable references
   typedef std::map<std::string, VariableReference> InternalMap;
 
@@ -584,6 +600,24 @@ private:
    * Delimiter for the prefix to subvars
    **/
   std::string delimiter_;
+
+  /**
+   * Generation of the context's key log at the last sync, or 0 if the
+   * keys must be read again
+   **/
+  uint64_t key_generation_;
+
+  /**
+   * Prefix of the key log the map holds a reference to. Copies do not
+   * share the reference.
+   **/
+  std::string tracked_keys_;
+
+  /**
+   * Lifetime of the context of the key log, which expires if the context
+   * is destroyed before the map
+   **/
+  std::weak_ptr<void> tracked_context_;
 };
 }
 }
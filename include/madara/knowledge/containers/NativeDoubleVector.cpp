@@ -2,6 +2,55 @@
 #include "madara/knowledge/ContextGuard.h"
 #include "madara/logger/GlobalLogger.h"
 
+#include <algorithm>
+
+namespace
+{
+/**
+ * Checks the write quality of the record, then calls a function to
+ * change its elements in place. The record is made a double array
+ * of at least size elements first, keeping its values. The context
+ * must be locked.
+ * @param  record    the record of the vector
+ * @param  settings  settings for applying the update
+ * @param  size      the minimum number of elements
+ * @param  func      called with the elements, as a std::vector
+ * @return 0 if successful, and -2 if quality isn't high enough
+ **/
+template<typename Func>
+int write_in_place(madara::knowledge::KnowledgeRecord& record,
+    const madara::knowledge::KnowledgeUpdateSettings& settings, size_t size,
+    Func func)
+{
+  if (!settings.always_overwrite && record.write_quality < record.quality)
+    return -2;
+
+  record.quality = record.write_quality;
+
+  if (record.type() == madara::knowledge::KnowledgeRecord::DOUBLE_ARRAY &&
+      !record.has_history())
+  {
+    // copies of the record keep the previous elements
+    func(record.resize_doubles(std::max(size, (size_t)record.size())));
+  }
+  else
+  {
+    std::vector<double> elements;
+
+    if (record.exists())
+      elements = record.to_doubles();
+
+    if (elements.size() < size)
+      elements.resize(size);
+
+    func(elements);
+    record.set_value(std::move(elements));
+  }
+
+  return 0;
+}
+}
+
 madara::knowledge::containers::NativeDoubleVector::NativeDoubleVector(
     const KnowledgeUpdateSettings& settings)
   : BaseContainer("", settings), context_(0)
@@ -476,6 +525,124 @@ int madara::knowledge::containers::NativeDoubleVector::set(const double* values,
   return result;
 }
 
+int madara::knowledge::containers::NativeDoubleVector::set_range(
+    size_t first, const std::vector<type>& values)
+{
+  return copy_from(values.data(), values.size(), first, settings_);
+}
+
+int madara::knowledge::containers::NativeDoubleVector::copy_from(
+    const type* values, size_t count, size_t first)
+{
+  return copy_from(values, count, first, settings_);
+}
+
+int madara::knowledge::containers::NativeDoubleVector::copy_from(
+    const type* values, size_t count, size_t first,
+    const KnowledgeUpdateSettings& settings)
+{
+  int result = -1;
+
+  if (context_ && vector_.is_valid())
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "NativeDoubleVector::copy_from: %s: setting %d elements from [%d]\n",
+        this->name_.c_str(), (int)count, (int)first);
+
+    result = write_in_place(*vector_.get_record_unsafe(), settings,
+        first + count, [values, count, first](std::vector<type>& elements) {
+          std::copy(values, values + count, elements.begin() + first);
+        });
+
+    if (result == 0)
+      context_->mark_modified(vector_, settings);
+  }
+
+  return result;
+}
+
+int madara::knowledge::containers::NativeDoubleVector::assign(
+    const type* first, const type* last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    result =
+        context_->set(vector_, first, (uint32_t)(last - first), settings_);
+  }
+
+  return result;
+}
+
+int madara::knowledge::containers::NativeDoubleVector::fill(
+    type value, size_t first, size_t last)
+{
+  int result = -1;
+
+  if (context_ && vector_.is_valid())
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "NativeDoubleVector::fill: %s: setting elements [%d, %d)\n",
+        this->name_.c_str(), (int)first, (int)last);
+
+    result = write_in_place(*vector_.get_record_unsafe(), settings_, 0,
+        [value, first, last](std::vector<type>& elements) {
+          std::fill(elements.begin() + std::min(first, elements.size()),
+              elements.begin() + std::min(last, elements.size()), value);
+        });
+
+    if (result == 0)
+      context_->mark_modified(vector_, settings_);
+  }
+
+  return result;
+}
+
+size_t madara::knowledge::containers::NativeDoubleVector::copy_to(
+    type* target, size_t count, size_t first) const
+{
+  size_t result = 0;
+
+  if (context_ && vector_.is_valid())
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    const KnowledgeRecord& record = *vector_.get_record_unsafe();
+    const std::vector<type>* elements = record.peek_doubles();
+
+    // other types are converted, as with operator[]
+    std::vector<type> converted;
+
+    if (!elements)
+    {
+      converted = record.to_doubles();
+      elements = &converted;
+    }
+
+    // begin () + first is not an iterator when first is past the end
+    if (first < elements->size())
+    {
+      result = std::min(count, elements->size() - first);
+
+      std::copy(elements->begin() + first,
+          elements->begin() + first + result, target);
+    }
+  }
+
+  return result;
+}
+
 void madara::knowledge::containers::NativeDoubleVector::set_quality(
     size_t /*index*/, uint32_t quality,
     const KnowledgeReferenceSettings& settings)
@@ -1,6 +1,8 @@
 #include "StringVector.h"
 #include "madara/knowledge/ContextGuard.h"
 
+#include <algorithm>
+
 madara::knowledge::containers::StringVector::StringVector(
     const KnowledgeUpdateSettings& settings, const std::string& delimiter)
   : BaseContainer("", settings), context_(0), delimiter_(delimiter)
@@ -477,11 +479,7 @@ void madara::knowledge::containers::StringVector::copy_to(
     MADARA_GUARD_TYPE guard(mutex_);
 
     target.resize(vector_.size());
-
-    for (size_t i = 0; i < vector_.size(); ++i)
-    {
-      target[i] = (*this)[i];
-    }
+    copy_to(target.data(), target.size());
   }
 }
 
@@ -562,6 +560,31 @@ int madara::knowledge::containers::StringVector::set(
 
 int madara::knowledge::containers::StringVector::set(
     const std::vector<type>& value)
+{
+  return copy_from(value.data(), value.size(), 0, settings_);
+}
+
+int madara::knowledge::containers::StringVector::set(
+    const std::vector<type>& value, const KnowledgeUpdateSettings& settings)
+{
+  return copy_from(value.data(), value.size(), 0, settings);
+}
+
+int madara::knowledge::containers::StringVector::set_range(
+    size_t first, const std::vector<type>& values)
+{
+  return copy_from(values.data(), values.size(), first, settings_);
+}
+
+int madara::knowledge::containers::StringVector::copy_from(
+    const type* values, size_t count, size_t first)
+{
+  return copy_from(values, count, first, settings_);
+}
+
+int madara::knowledge::containers::StringVector::copy_from(
+    const type* values, size_t count, size_t first,
+    const KnowledgeUpdateSettings& settings)
 {
   int result = -1;
 
@@ -570,22 +593,45 @@ int madara::knowledge::containers::StringVector::set(
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
 
-    if (vector_.size() < value.size())
-      resize((int)value.size(), false);
+    if (vector_.size() < first + count)
+      resize((int)(first + count), false);
+
+    // waiting threads are signalled once, after the last element
+    KnowledgeUpdateSettings quiet(settings);
+    quiet.signal_changes = false;
+
+    result = 0;
 
-    for (size_t i = 0; i < value.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
-      context_->set(vector_[i], value[i], settings_);
+      if (context_->set_unsafe(vector_[first + i], values[i],
+              i + 1 == count ? settings : quiet) != 0)
+        result = -2;
     }
+  }
 
-    result = 0;
+  return result;
+}
+
+int madara::knowledge::containers::StringVector::assign(
+    const type* first, const type* last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    resize((int)(last - first));
+    result = copy_from(first, last - first, 0, settings_);
   }
 
   return result;
 }
 
-int madara::knowledge::containers::StringVector::set(
-    const std::vector<type>& value, const KnowledgeUpdateSettings& settings)
+int madara::knowledge::containers::StringVector::fill(
+    const type& value, size_t first, size_t last)
 {
   int result = -1;
 
@@ -593,15 +639,42 @@ int madara::knowledge::containers::StringVector::set(
   {
     ContextGuard context_guard(*context_);
     MADARA_GUARD_TYPE guard(mutex_);
-    if (vector_.size() < value.size())
-      resize((int)value.size(), false);
 
-    for (size_t i = 0; i < value.size(); ++i)
+    // waiting threads are signalled once, after the last element
+    KnowledgeUpdateSettings quiet(settings_);
+    quiet.signal_changes = false;
+
+    result = 0;
+    last = std::min(last, vector_.size());
+
+    for (size_t i = first; i < last; ++i)
     {
-      context_->set(vector_[i], value[i], settings);
+      if (context_->set_unsafe(
+              vector_[i], value, i + 1 == last ? settings_ : quiet) != 0)
+        result = -2;
     }
+  }
 
-    result = 0;
+  return result;
+}
+
+size_t madara::knowledge::containers::StringVector::copy_to(
+    type* target, size_t count, size_t first) const
+{
+  size_t result = 0;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (first < vector_.size())
+      result = std::min(count, vector_.size() - first);
+
+    for (size_t i = 0; i < result; ++i)
+    {
+      target[i] = vector_[first + i].get_record_unsafe()->to_string();
+    }
   }
 
   return result;
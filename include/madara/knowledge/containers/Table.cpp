@@ -0,0 +1,596 @@
+#include <sstream>
+
+#include "Table.h"
+#include "madara/knowledge/ContextGuard.h"
+#include "madara/logger/GlobalLogger.h"
+
+madara::knowledge::containers::Table::Table(
+    const KnowledgeUpdateSettings& settings)
+  : BaseContainer("", settings)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::constructor: new object\n");
+
+  context_ = 0;
+}
+
+madara::knowledge::containers::Table::Table(const std::string& name,
+    KnowledgeBase& knowledge, const KnowledgeUpdateSettings& settings)
+  : BaseContainer(name, settings)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::constructor called for %s\n", name.c_str());
+
+  context_ = &(knowledge.get_context());
+}
+
+madara::knowledge::containers::Table::Table(const std::string& name,
+    Variables& knowledge, const KnowledgeUpdateSettings& settings)
+  : BaseContainer(name, settings)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::constructor called for %s\n", name.c_str());
+
+  context_ = knowledge.get_context();
+}
+
+madara::knowledge::containers::Table::Table(const Table& rhs)
+  : BaseContainer(rhs), columns_(rhs.columns_), dirty_(rhs.dirty_)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::copy constructor called on %s\n", rhs.name_.c_str());
+}
+
+madara::knowledge::containers::Table::~Table()
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::destructor called on %s\n", this->name_.c_str());
+}
+
+void madara::knowledge::containers::Table::operator=(const Table& rhs)
+{
+  if (this != &rhs)
+  {
+    MADARA_GUARD_TYPE guard(mutex_), guard2(rhs.mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::assignment: %s: copying from %s.\n", this->name_.c_str(),
+        rhs.name_.c_str());
+
+    this->context_ = rhs.context_;
+    this->name_ = rhs.name_;
+    this->settings_ = rhs.settings_;
+    this->columns_ = rhs.columns_;
+    this->dirty_ = rhs.dirty_;
+  }
+}
+
+size_t madara::knowledge::containers::Table::add_column(
+    const std::string& column, uint32_t type)
+{
+  int existing = find_column(column);
+
+  if (existing >= 0)
+    return (size_t)existing;
+
+  if (type != KnowledgeRecord::INTEGER_ARRAY)
+    type = KnowledgeRecord::DOUBLE_ARRAY;
+
+  Column added;
+  added.name = column;
+  added.type = type;
+
+  if (context_ && name_ != "")
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::add_column: %s: adding column %s\n", this->name_.c_str(),
+        column.c_str());
+
+    // a new column starts with the rows of the table
+    attach_column(added, columns_.size() > 0
+                             ? columns_[0].variable.get_record_unsafe()->size()
+                             : 0);
+
+    columns_.push_back(added);
+  }
+  else
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+    columns_.push_back(added);
+  }
+
+  return columns_.size() - 1;
+}
+
+int madara::knowledge::containers::Table::find_column(
+    const std::string& column) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  for (size_t i = 0; i < columns_.size(); ++i)
+  {
+    if (columns_[i].name == column)
+      return (int)i;
+  }
+
+  return -1;
+}
+
+size_t madara::knowledge::containers::Table::columns(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  return columns_.size();
+}
+
+std::string madara::knowledge::containers::Table::get_column_name(
+    size_t column) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (column < columns_.size())
+    return name_ + "." + columns_[column].name;
+
+  return "";
+}
+
+uint32_t madara::knowledge::containers::Table::get_column_type(
+    size_t column) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (column < columns_.size())
+    return columns_[column].type;
+
+  return 0;
+}
+
+size_t madara::knowledge::containers::Table::rows(void) const
+{
+  size_t result = 0;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (columns_.size() > 0 && columns_[0].variable.is_valid())
+      result = columns_[0].variable.get_record_unsafe()->size();
+  }
+
+  return result;
+}
+
+void madara::knowledge::containers::Table::resize(size_t rows)
+{
+  if (context_ && name_ != "")
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::resize: %s: resizing to %d rows\n", this->name_.c_str(),
+        (int)rows);
+
+    KnowledgeUpdateSettings quiet(settings_);
+    quiet.signal_changes = false;
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      KnowledgeRecord& record = *columns_[i].variable.get_record_unsafe();
+
+      if (prepare_write(record, columns_[i].type))
+      {
+        if (columns_[i].type == KnowledgeRecord::INTEGER_ARRAY)
+          record.resize_integers(rows);
+        else
+          record.resize_doubles(rows);
+
+        // waiting threads are signalled once, after the last column
+        context_->mark_modified(columns_[i].variable,
+            i + 1 == columns_.size() ? settings_ : quiet);
+      }
+    }
+
+    size_t previous = dirty_.size();
+    dirty_.resize(rows, false);
+
+    if (rows > previous)
+      mark_dirty(previous, rows);
+  }
+}
+
+madara::knowledge::containers::Table::Integer
+madara::knowledge::containers::Table::get_integer(
+    size_t row, size_t column) const
+{
+  Integer result = 0;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column < columns_.size() && columns_[column].variable.is_valid())
+    {
+      const KnowledgeRecord& record =
+          *columns_[column].variable.get_record_unsafe();
+
+      if (row < record.size())
+        result = record.retrieve_index(row).to_integer();
+    }
+  }
+
+  return result;
+}
+
+double madara::knowledge::containers::Table::get_double(
+    size_t row, size_t column) const
+{
+  double result = 0;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column < columns_.size() && columns_[column].variable.is_valid())
+    {
+      const KnowledgeRecord& record =
+          *columns_[column].variable.get_record_unsafe();
+
+      if (row < record.size())
+        result = record.retrieve_index(row).to_double();
+    }
+  }
+
+  return result;
+}
+
+madara::knowledge::KnowledgeVector
+madara::knowledge::containers::Table::get_row(size_t row) const
+{
+  KnowledgeVector result;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    result.resize(columns_.size());
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      if (!columns_[i].variable.is_valid())
+        continue;
+
+      const KnowledgeRecord& record =
+          *columns_[i].variable.get_record_unsafe();
+
+      if (row < record.size())
+        result[i] = record.retrieve_index(row);
+    }
+  }
+
+  return result;
+}
+
+int madara::knowledge::containers::Table::set(
+    size_t row, size_t column, Integer value)
+{
+  if (get_column_type(column) == KnowledgeRecord::DOUBLE_ARRAY)
+    return set(row, column, (double)value);
+
+  return write_integers(
+      column, [value](Integer* data, size_t) { *data = value; }, row,
+      row + 1);
+}
+
+int madara::knowledge::containers::Table::set(
+    size_t row, size_t column, double value)
+{
+  if (get_column_type(column) == KnowledgeRecord::INTEGER_ARRAY)
+    return set(row, column, (Integer)value);
+
+  return write_doubles(
+      column, [value](double* data, size_t) { *data = value; }, row,
+      row + 1);
+}
+
+int madara::knowledge::containers::Table::set_row(
+    size_t row, const std::vector<double>& values)
+{
+  int result = -1;
+
+  if (context_ && name_ != "")
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::set_row: %s: setting row %d\n", this->name_.c_str(),
+        (int)row);
+
+    if (values.size() != columns_.size() || row >= rows())
+      return -1;
+
+    KnowledgeUpdateSettings quiet(settings_);
+    quiet.signal_changes = false;
+
+    result = 0;
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      KnowledgeRecord& record = *columns_[i].variable.get_record_unsafe();
+
+      if (row >= record.size())
+      {
+        result = -1;
+      }
+      else if (!prepare_write(record, columns_[i].type))
+      {
+        result = -2;
+      }
+      else
+      {
+        if (columns_[i].type == KnowledgeRecord::INTEGER_ARRAY)
+          record.resize_integers(record.size())[row] = (Integer)values[i];
+        else
+          record.resize_doubles(record.size())[row] = values[i];
+
+        // waiting threads are signalled once, after the last column
+        context_->mark_modified(columns_[i].variable,
+            i + 1 == columns_.size() ? settings_ : quiet);
+      }
+    }
+
+    mark_dirty(row, row + 1);
+  }
+
+  return result;
+}
+
+bool madara::knowledge::containers::Table::is_dirty(size_t row) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  return row < dirty_.size() && dirty_[row];
+}
+
+std::vector<madara::knowledge::containers::Table::RowRange>
+madara::knowledge::containers::Table::get_dirty_ranges(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  std::vector<RowRange> result;
+
+  for (size_t i = 0; i < dirty_.size(); ++i)
+  {
+    if (dirty_[i])
+    {
+      if (result.size() > 0 && result.back().second == i)
+        ++result.back().second;
+      else
+        result.push_back(RowRange(i, i + 1));
+    }
+  }
+
+  return result;
+}
+
+void madara::knowledge::containers::Table::clear_dirty(void)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  dirty_.assign(dirty_.size(), false);
+}
+
+void madara::knowledge::containers::Table::modify(void)
+{
+  if (context_ && name_ != "")
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::modify: %s: marking %d columns\n", this->name_.c_str(),
+        (int)columns_.size());
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      context_->mark_modified(columns_[i].variable);
+    }
+  }
+}
+
+void madara::knowledge::containers::Table::set_name(
+    const std::string& var_name, KnowledgeBase& knowledge)
+{
+  if (context_ != &(knowledge.get_context()) || name_ != var_name)
+  {
+    context_ = &(knowledge.get_context());
+
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::set_name: setting name to %s\n", var_name.c_str());
+
+    name_ = var_name;
+    update_columns();
+  }
+}
+
+void madara::knowledge::containers::Table::set_name(
+    const std::string& var_name, Variables& knowledge)
+{
+  if (context_ != knowledge.get_context() || name_ != var_name)
+  {
+    context_ = knowledge.get_context();
+
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+        "Table::set_name: setting name to %s\n", var_name.c_str());
+
+    name_ = var_name;
+    update_columns();
+  }
+}
+
+std::string madara::knowledge::containers::Table::get_debug_info(void)
+{
+  std::stringstream result;
+
+  result << "Table: ";
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    result << this->name_;
+    result << " [" << rows() << " x " << columns_.size() << "]";
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      result << (i == 0 ? " = {" : ", ") << columns_[i].name << ": ";
+
+      if (columns_[i].variable.is_valid())
+        result << columns_[i].variable.get_record_unsafe()->to_string();
+    }
+
+    if (columns_.size() > 0)
+      result << "}";
+  }
+
+  return result.str();
+}
+
+madara::knowledge::containers::BaseContainer*
+madara::knowledge::containers::Table::clone(void) const
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_MAJOR,
+      "Table::clone: cloning %s\n", this->name_.c_str());
+
+  return new Table(*this);
+}
+
+bool madara::knowledge::containers::Table::is_true(void) const
+{
+  bool result(false);
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    result = columns_.size() > 0;
+
+    for (size_t i = 0; result && i < columns_.size(); ++i)
+    {
+      result = columns_[i].variable.is_valid() &&
+               columns_[i].variable.get_record_unsafe()->is_true();
+    }
+  }
+
+  return result;
+}
+
+bool madara::knowledge::containers::Table::is_false(void) const
+{
+  return !is_true();
+}
+
+bool madara::knowledge::containers::Table::is_true_(void) const
+{
+  return is_true();
+}
+
+bool madara::knowledge::containers::Table::is_false_(void) const
+{
+  return is_false();
+}
+
+void madara::knowledge::containers::Table::modify_(void)
+{
+  modify();
+}
+
+std::string madara::knowledge::containers::Table::get_debug_info_(void)
+{
+  return get_debug_info();
+}
+
+void madara::knowledge::containers::Table::update_columns(void)
+{
+  for (size_t i = 0; i < columns_.size(); ++i)
+  {
+    if (name_ == "")
+    {
+      columns_[i].variable = VariableReference();
+    }
+    else
+    {
+      // new columns start with the rows of the first column
+      attach_column(columns_[i],
+          i > 0 ? columns_[0].variable.get_record_unsafe()->size() : 0);
+    }
+  }
+}
+
+void madara::knowledge::containers::Table::attach_column(
+    Column& column, size_t rows)
+{
+  column.variable = context_->get_ref(name_ + "." + column.name, settings_);
+
+  KnowledgeRecord& record = *column.variable.get_record_unsafe();
+
+  if (record.type() == KnowledgeRecord::INTEGER_ARRAY ||
+      record.type() == KnowledgeRecord::DOUBLE_ARRAY)
+  {
+    // keep the rows of an existing column
+    if (record.type() != column.type)
+      prepare_write(record, column.type);
+  }
+  else if (column.type == KnowledgeRecord::INTEGER_ARRAY)
+  {
+    record.set_value(std::vector<Integer>(rows));
+  }
+  else
+  {
+    record.set_value(std::vector<double>(rows));
+  }
+}
+
+bool madara::knowledge::containers::Table::prepare_write(
+    KnowledgeRecord& record, uint32_t type) const
+{
+  // check if we have the appropriate write quality
+  if (!settings_.always_overwrite && record.write_quality < record.quality)
+    return false;
+
+  if (record.type() != type)
+  {
+    if (type == KnowledgeRecord::INTEGER_ARRAY)
+      record.set_value(record.to_integers());
+    else
+      record.set_value(record.to_doubles());
+  }
+
+  record.quality = record.write_quality;
+
+  return true;
+}
+
+void madara::knowledge::containers::Table::mark_dirty(
+    size_t first, size_t last)
+{
+  if (dirty_.size() < last)
+    dirty_.resize(last, false);
+
+  for (size_t i = first; i < last; ++i)
+  {
+    dirty_[i] = true;
+  }
+}
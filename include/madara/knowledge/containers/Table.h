@@ -0,0 +1,417 @@
+
+#ifndef _MADARA_KNOWLEDGE_CONTAINERS_TABLE_H_
+#define _MADARA_KNOWLEDGE_CONTAINERS_TABLE_H_
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "madara/LockType.h"
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/ThreadSafeContext.h"
+#include "madara/knowledge/KnowledgeUpdateSettings.h"
+#include "BaseContainer.h"
+
+/**
+ * @file Table.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a C++ object that manages interactions for a
+ * table of integers and doubles, stored by column
+ **/
+
+namespace madara
+{
+namespace knowledge
+{
+namespace containers
+{
+/**
+ * @class Table
+ * @brief This class stores a table of rows, e.g., one per agent, and
+ *        named columns, e.g., one per field. Each column is a single
+ *        integer or double array variable, {name}.{column}, so a table
+ *        of N rows and M columns needs M variables instead of N x M.
+ *        Writes through the table mark rows as dirty until clear_dirty
+ *        is called. Transports send the whole column when it changes,
+ *        or only the ranges of rows that changed if
+ *        TransportSettings::array_delta_interval is set. Columns are
+ *        plain arrays, so rcw::Transaction can also track them, e.g.,
+ *        with a Tracked<std::vector<double>> for get_column_name(i).
+ */
+class MADARA_EXPORT Table : public BaseContainer
+{
+public:
+  /// trait that describes the integer column type
+  typedef KnowledgeRecord::Integer Integer;
+
+  /// a range of rows, from first up to, but not including, second
+  typedef std::pair<size_t, size_t> RowRange;
+
+  /**
+   * Default constructor
+   * @param  settings   settings for evaluating the table
+   **/
+  Table(const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings());
+
+  /**
+   * Constructor
+   * @param  name       name of the table in the knowledge base
+   * @param  knowledge  the knowledge base that will contain the table
+   * @param  settings   settings for evaluating the table
+   **/
+  Table(const std::string& name, KnowledgeBase& knowledge,
+      const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings());
+
+  /**
+   * Constructor
+   * @param  name       name of the table in the knowledge base
+   * @param  knowledge  the knowledge base that will contain the table
+   * @param  settings   settings for evaluating the table
+   **/
+  Table(const std::string& name, Variables& knowledge,
+      const KnowledgeUpdateSettings& settings = KnowledgeUpdateSettings());
+
+  /**
+   * Copy constructor
+   **/
+  Table(const Table& rhs);
+
+  /**
+   * Destructor
+   **/
+  virtual ~Table();
+
+  /**
+   * Assignment operator
+   * @param  rhs    value to copy
+   **/
+  void operator=(const Table& rhs);
+
+  /**
+   * Adds a column to the table, or returns the index of the column if
+   * it has already been added. The column starts with the rows of the
+   * table, unless the variable already holds an array of the type.
+   * @param  column    the name of the column
+   * @param  type      KnowledgeRecord::INTEGER_ARRAY or DOUBLE_ARRAY
+   * @return the index of the column
+   **/
+  size_t add_column(const std::string& column,
+      uint32_t type = KnowledgeRecord::DOUBLE_ARRAY);
+
+  /**
+   * Finds a column by name
+   * @param  column    the name of the column
+   * @return the index of the column, or -1 if it has not been added
+   **/
+  int find_column(const std::string& column) const;
+
+  /**
+   * Returns the number of columns
+   * @return the number of columns added to the table
+   **/
+  size_t columns(void) const;
+
+  /**
+   * Returns the name of the variable that holds a column
+   * @param  column    the index of the column
+   * @return {name}.{column}, or an empty string if there is no column
+   **/
+  std::string get_column_name(size_t column) const;
+
+  /**
+   * Returns the type of a column
+   * @param  column    the index of the column
+   * @return KnowledgeRecord::INTEGER_ARRAY or DOUBLE_ARRAY, or 0 if
+   *         there is no column
+   **/
+  uint32_t get_column_type(size_t column) const;
+
+  /**
+   * Returns the number of rows, which is the size of the first column
+   * @return the number of rows
+   **/
+  size_t rows(void) const;
+
+  /**
+   * Resizes all columns. Added rows are zero and dirty.
+   * @param   rows   the number of rows
+   **/
+  void resize(size_t rows);
+
+  /**
+   * Retrieves an element as an integer
+   * @param  row       the row of the element
+   * @param  column    the index of the column
+   * @return the element, or 0 if it does not exist
+   **/
+  Integer get_integer(size_t row, size_t column) const;
+
+  /**
+   * Retrieves an element as a double
+   * @param  row       the row of the element
+   * @param  column    the index of the column
+   * @return the element, or 0 if it does not exist
+   **/
+  double get_double(size_t row, size_t column) const;
+
+  /**
+   * Retrieves a row, with one record per column
+   * @param  row       the row to retrieve
+   * @return the elements of the row. Modifications to this will
+   *         not be reflected in the context.
+   **/
+  KnowledgeVector get_row(size_t row) const;
+
+  /**
+   * Sets an element. The value is converted to the type of the column.
+   * @param  row       the row of the element
+   * @param  column    the index of the column
+   * @param  value     the new value
+   * @return 0 if successful, -1 if the element does not exist, and
+   *         -2 if quality isn't high enough
+   **/
+  int set(size_t row, size_t column, Integer value);
+
+  /**
+   * Sets an element. The value is converted to the type of the column.
+   * @param  row       the row of the element
+   * @param  column    the index of the column
+   * @param  value     the new value
+   * @return 0 if successful, -1 if the element does not exist, and
+   *         -2 if quality isn't high enough
+   **/
+  int set(size_t row, size_t column, double value);
+
+  /**
+   * Sets all columns of a row, locking the context and signalling
+   * changes once. Values are converted to the types of the columns.
+   * @param  row       the row to set
+   * @param  values    one value per column
+   * @return 0 if successful, -1 if the row does not exist or the number
+   *         of values is wrong, and -2 if quality isn't high enough
+   **/
+  int set_row(size_t row, const std::vector<double>& values);
+
+  /**
+   * Calls a function with the elements of an integer column, while
+   * the context is locked. The elements are contiguous, so loops over
+   * them can be vectorized by the compiler. A double column is
+   * converted to a temporary array first.
+   * @param  column    the index of the column
+   * @param  func      called as func (const Integer* data, size_t size)
+   **/
+  template<typename Func>
+  void read_integers(size_t column, Func func) const;
+
+  /**
+   * Calls a function with the elements of a double column, while the
+   * context is locked. @see read_integers.
+   * @param  column    the index of the column
+   * @param  func      called as func (const double* data, size_t size)
+   **/
+  template<typename Func>
+  void read_doubles(size_t column, Func func) const;
+
+  /**
+   * Calls a function to change a range of rows of an integer column
+   * in place, while the context is locked, then marks the rows dirty
+   * and the column modified.
+   * @param  column    the index of an integer column
+   * @param  func      called as func (Integer* data, size_t size), with
+   *                   data pointing at the first row of the range
+   * @param  first     the first row to change
+   * @param  last      one past the last row to change. Rows past the
+   *                   end of the table are not changed.
+   * @return 0 if successful, -1 if the column does not exist, is not
+   *         an integer column or has none of the rows, and -2 if
+   *         quality isn't high enough
+   **/
+  template<typename Func>
+  int write_integers(size_t column, Func func, size_t first = 0,
+      size_t last = (size_t)-1);
+
+  /**
+   * Calls a function to change a range of rows of a double column in
+   * place. @see write_integers.
+   * @param  column    the index of a double column
+   * @param  func      called as func (double* data, size_t size)
+   * @param  first     the first row to change
+   * @param  last      one past the last row to change
+   * @return 0 if successful, -1 if the column does not exist, is not
+   *         a double column or has none of the rows, and -2 if quality
+   *         isn't high enough
+   **/
+  template<typename Func>
+  int write_doubles(size_t column, Func func, size_t first = 0,
+      size_t last = (size_t)-1);
+
+  /**
+   * Checks if a row was written through this table since the last
+   * call to clear_dirty
+   * @param  row       the row to check
+   * @return true if the row is dirty
+   **/
+  bool is_dirty(size_t row) const;
+
+  /**
+   * Returns the dirty rows, merged into ranges
+   * @return the ranges of dirty rows, in order
+   **/
+  std::vector<RowRange> get_dirty_ranges(void) const;
+
+  /**
+   * Marks all rows as clean
+   **/
+  void clear_dirty(void);
+
+  /**
+   * Mark all columns as modified. The table retains the same values
+   * but will resend them as if they had been modified.
+   **/
+  void modify(void);
+
+  /**
+   * Sets the variable name that this refers to. Columns are kept, and
+   * refer to variables with the new name.
+   * @param var_name  the name of the table in the knowledge base
+   * @param knowledge  the knowledge base the table is housed in
+   **/
+  void set_name(const std::string& var_name, KnowledgeBase& knowledge);
+
+  /**
+   * Sets the variable name that this refers to. Columns are kept, and
+   * refer to variables with the new name.
+   * @param var_name  the name of the table in the knowledge base
+   * @param knowledge  the knowledge base the table is housed in
+   **/
+  void set_name(const std::string& var_name, Variables& knowledge);
+
+  /**
+   * Returns the type of the container along with name and any other
+   * useful information. The provided information should be useful
+   * for developers wishing to debug container operations, especially
+   * as it pertains to pending network operations (i.e., when used
+   * in conjunction with modify)
+   *
+   * @return info in format {container}: {name}{ = value, if appropriate}
+   **/
+  std::string get_debug_info(void);
+
+  /**
+   * Clones this container
+   * @return  a deep copy of the container that must be managed
+   *          by the user (i.e., you have to delete the return value)
+   **/
+  virtual BaseContainer* clone(void) const;
+
+  /**
+   * Determines if all values in the table are true
+   * @return true if all values are true
+   **/
+  bool is_true(void) const;
+
+  /**
+   * Determines if the value of the table is false
+   * @return true if at least one value is false
+   **/
+  bool is_false(void) const;
+
+private:
+  /**
+   * A column of the table
+   **/
+  struct Column
+  {
+    /// the name of the column, without the table prefix
+    std::string name;
+
+    /// KnowledgeRecord::INTEGER_ARRAY or DOUBLE_ARRAY
+    uint32_t type;
+
+    /// the variable that holds the column
+    VariableReference variable;
+  };
+
+  /**
+   * Polymorphic is true method which can be used to determine if
+   * all values in the container are true
+   **/
+  virtual bool is_true_(void) const;
+
+  /**
+   * Polymorphic is false method which can be used to determine if
+   * at least one value in the container is false
+   **/
+  virtual bool is_false_(void) const;
+
+  /**
+   * Polymorphic modify method used by collection containers. This
+   * method calls the modify method for this class. We separate the
+   * faster version (modify) from this version (modify_) to allow
+   * users the opportunity to have a fastery version that does not
+   * use polymorphic functions (generally virtual functions are half
+   * as efficient as normal function calls)
+   **/
+  virtual void modify_(void);
+
+  /**
+   * Returns the type of the container along with name and any other
+   * useful information. The provided information should be useful
+   * for developers wishing to debug container operations, especially
+   * as it pertains to pending network operations (i.e., when used
+   * in conjunction with modify)
+   *
+   * @return info in format {container}: {name}{ = value, if appropriate}
+   **/
+  virtual std::string get_debug_info_(void);
+
+  /**
+   * Refers the columns to the variables of the current name, creating
+   * the arrays of new columns. Columns have no variables while the name
+   * is empty. The context and the table must be locked.
+   **/
+  void update_columns(void);
+
+  /**
+   * Refers a column to its variable under the current name, and creates
+   * its array if the variable holds none. The context and the table
+   * must be locked.
+   * @param  column    the column
+   * @param  rows      the rows of the array of a new column
+   **/
+  void attach_column(Column& column, size_t rows);
+
+  /**
+   * Checks the quality of a column before it is written, then takes
+   * the write quality, and converts it to the type of the column if a
+   * remote agent changed it. The context must be locked.
+   * @param  record    the record of the column
+   * @param  type      the type of the column
+   * @return true if the column may be written
+   **/
+  bool prepare_write(KnowledgeRecord& record, uint32_t type) const;
+
+  /**
+   * Marks rows as dirty. The table must be locked.
+   * @param  first     the first dirty row
+   * @param  last      one past the last dirty row
+   **/
+  void mark_dirty(size_t first, size_t last);
+
+  /**
+   * The columns of the table
+   **/
+  std::vector<Column> columns_;
+
+  /**
+   * Rows written since the last call to clear_dirty
+   **/
+  std::vector<bool> dirty_;
+};
+}
+}
+}
+
+#include "Table.inl"
+
+#endif  // _MADARA_KNOWLEDGE_CONTAINERS_TABLE_H_
@@ -0,0 +1,170 @@
+
+#ifndef _MADARA_KNOWLEDGE_CONTAINERS_TABLE_INL_
+#define _MADARA_KNOWLEDGE_CONTAINERS_TABLE_INL_
+
+#include <algorithm>
+
+#include "Table.h"
+#include "madara/knowledge/ContextGuard.h"
+
+/**
+ * @file Table.inl
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains inline functions of the Table class
+ **/
+
+namespace madara
+{
+namespace knowledge
+{
+namespace containers
+{
+template<typename Func>
+inline void Table::read_integers(size_t column, Func func) const
+{
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column < columns_.size() && columns_[column].variable.is_valid())
+    {
+      const KnowledgeRecord& record =
+          *columns_[column].variable.get_record_unsafe();
+      const std::vector<Integer>* values = record.peek_integers();
+
+      if (values)
+      {
+        func(values->data(), values->size());
+      }
+      else
+      {
+        std::vector<Integer> converted(record.to_integers());
+        func((const Integer*)converted.data(), converted.size());
+      }
+    }
+  }
+}
+
+template<typename Func>
+inline void Table::read_doubles(size_t column, Func func) const
+{
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column < columns_.size() && columns_[column].variable.is_valid())
+    {
+      const KnowledgeRecord& record =
+          *columns_[column].variable.get_record_unsafe();
+      const std::vector<double>* values = record.peek_doubles();
+
+      if (values)
+      {
+        func(values->data(), values->size());
+      }
+      else
+      {
+        std::vector<double> converted(record.to_doubles());
+        func((const double*)converted.data(), converted.size());
+      }
+    }
+  }
+}
+
+template<typename Func>
+inline int Table::write_integers(
+    size_t column, Func func, size_t first, size_t last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column >= columns_.size() || !columns_[column].variable.is_valid() ||
+        columns_[column].type != KnowledgeRecord::INTEGER_ARRAY)
+      return -1;
+
+    const VariableReference& variable = columns_[column].variable;
+    KnowledgeRecord& record = *variable.get_record_unsafe();
+
+    if (!prepare_write(record, columns_[column].type))
+    {
+      result = -2;
+    }
+    else
+    {
+      // the record holds an array of the column type only after
+      // prepare_write, so its rows are known here
+      last = std::min(last, (size_t)record.size());
+
+      if (first < last)
+      {
+        // writes in place unless another record shares the array
+        std::vector<Integer>& values = record.resize_integers(record.size());
+
+        func(values.data() + first, last - first);
+        mark_dirty(first, last);
+
+        context_->mark_modified(variable, settings_);
+        result = 0;
+      }
+    }
+  }
+
+  return result;
+}
+
+template<typename Func>
+inline int Table::write_doubles(
+    size_t column, Func func, size_t first, size_t last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (column >= columns_.size() || !columns_[column].variable.is_valid() ||
+        columns_[column].type != KnowledgeRecord::DOUBLE_ARRAY)
+      return -1;
+
+    const VariableReference& variable = columns_[column].variable;
+    KnowledgeRecord& record = *variable.get_record_unsafe();
+
+    if (!prepare_write(record, columns_[column].type))
+    {
+      result = -2;
+    }
+    else
+    {
+      // the record holds an array of the column type only after
+      // prepare_write, so its rows are known here
+      last = std::min(last, (size_t)record.size());
+
+      if (first < last)
+      {
+        // writes in place unless another record shares the array
+        std::vector<double>& values = record.resize_doubles(record.size());
+
+        func(values.data() + first, last - first);
+        mark_dirty(first, last);
+
+        context_->mark_modified(variable, settings_);
+        result = 0;
+      }
+    }
+  }
+
+  return result;
+}
+}
+}
+}
+
+#endif  // _MADARA_KNOWLEDGE_CONTAINERS_TABLE_INL_
@@ -1,6 +1,8 @@
 #include "Vector.h"
 #include "madara/knowledge/ContextGuard.h"
 
+#include <algorithm>
+
 madara::knowledge::containers::Vector::Vector(
     const KnowledgeUpdateSettings& settings, const std::string& delimiter)
   : BaseContainer("", settings), context_(0), delimiter_(delimiter)
@@ -825,6 +827,116 @@ int madara::knowledge::containers::Vector::set(size_t index,
   return result;
 }
 
+int madara::knowledge::containers::Vector::set_range(
+    size_t first, const std::vector<KnowledgeRecord>& values)
+{
+  return copy_from(values.data(), values.size(), first, settings_);
+}
+
+int madara::knowledge::containers::Vector::copy_from(
+    const KnowledgeRecord* values, size_t count, size_t first)
+{
+  return copy_from(values, count, first, settings_);
+}
+
+int madara::knowledge::containers::Vector::copy_from(
+    const KnowledgeRecord* values, size_t count, size_t first,
+    const KnowledgeUpdateSettings& settings)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (vector_.size() < first + count)
+      resize((int)(first + count), false);
+
+    // waiting threads are signalled once, after the last element
+    KnowledgeUpdateSettings quiet(settings);
+    quiet.signal_changes = false;
+
+    result = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (context_->set_unsafe(vector_[first + i], values[i],
+              i + 1 == count ? settings : quiet) != 0)
+        result = -2;
+    }
+  }
+
+  return result;
+}
+
+int madara::knowledge::containers::Vector::assign(
+    const KnowledgeRecord* first, const KnowledgeRecord* last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    resize((int)(last - first));
+    result = copy_from(first, last - first, 0, settings_);
+  }
+
+  return result;
+}
+
+int madara::knowledge::containers::Vector::fill(
+    const KnowledgeRecord& value, size_t first, size_t last)
+{
+  int result = -1;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    // waiting threads are signalled once, after the last element
+    KnowledgeUpdateSettings quiet(settings_);
+    quiet.signal_changes = false;
+
+    result = 0;
+    last = std::min(last, vector_.size());
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (context_->set_unsafe(
+              vector_[i], value, i + 1 == last ? settings_ : quiet) != 0)
+        result = -2;
+    }
+  }
+
+  return result;
+}
+
+size_t madara::knowledge::containers::Vector::copy_to(
+    KnowledgeRecord* target, size_t count, size_t first) const
+{
+  size_t result = 0;
+
+  if (context_)
+  {
+    ContextGuard context_guard(*context_);
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    if (first < vector_.size())
+      result = std::min(count, vector_.size() - first);
+
+    for (size_t i = 0; i < result; ++i)
+    {
+      target[i].deep_copy(*vector_[first + i].get_record_unsafe());
+    }
+  }
+
+  return result;
+}
+
 void madara::knowledge::containers::Vector::set_quality(
     size_t index, uint32_t quality, const KnowledgeReferenceSettings& settings)
 {
@@ -0,0 +1,81 @@
+#include "ArrayDeltas.h"
+
+madara::transport::ArrayDeltas::ArrayDeltas() {}
+
+madara::transport::ArrayDeltas::ArrayDeltas(const ArrayDeltas& rhs)
+{
+  MADARA_GUARD_TYPE guard(rhs.mutex_);
+  sent_ = rhs.sent_;
+}
+
+void madara::transport::ArrayDeltas::operator=(const ArrayDeltas& rhs)
+{
+  if (this != &rhs)
+  {
+    std::unordered_map<std::string, SentArray> sent;
+
+    {
+      MADARA_GUARD_TYPE guard(rhs.mutex_);
+      sent = rhs.sent_;
+    }
+
+    MADARA_GUARD_TYPE guard(mutex_);
+    sent_.swap(sent);
+  }
+}
+
+char* madara::transport::ArrayDeltas::write(char* buffer,
+    const std::string& key, const knowledge::KnowledgeRecord& record,
+    uint64_t clock, int64_t& buffer_remaining, uint32_t snapshot_interval,
+    uint32_t min_elements)
+{
+  if (snapshot_interval == 0 || record.has_history() ||
+      !record.is_array_type() || record.size() < min_elements)
+  {
+    return record.write(buffer, buffer_remaining);
+  }
+
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  SentArray& sent = sent_[key];
+
+  bool snapshot = !sent.value.exists() || sent.deltas + 1 >= snapshot_interval;
+
+  if (!snapshot)
+  {
+    int64_t delta_size = record.get_delta_encoded_size(sent.value);
+
+    // a resized array, or one that mostly changed, is sent in full
+    snapshot = delta_size < 0 || delta_size >= record.get_encoded_size();
+  }
+
+  if (snapshot)
+  {
+    buffer = record.write(buffer, buffer_remaining);
+    sent.deltas = 0;
+  }
+  else
+  {
+    buffer = record.write_delta(buffer, sent.value, sent.clock,
+        buffer_remaining);
+    ++sent.deltas;
+  }
+
+  // keep a copy of its own, since the record may be changed in place
+  sent.value.deep_copy(record);
+  sent.clock = clock;
+
+  return buffer;
+}
+
+size_t madara::transport::ArrayDeltas::size(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  return sent_.size();
+}
+
+void madara::transport::ArrayDeltas::clear(void)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  sent_.clear();
+}
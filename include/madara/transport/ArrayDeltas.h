@@ -0,0 +1,110 @@
+#ifndef _MADARA_ARRAY_DELTAS_H_
+#define _MADARA_ARRAY_DELTAS_H_
+
+/**
+ * @file ArrayDeltas.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the ArrayDeltas class, which remembers the arrays
+ * a transport has sent so that later sends only carry what changed
+ **/
+
+#include <string>
+#include <unordered_map>
+
+#include "madara/LockType.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/utility/StdInt.h"
+#include "madara/MadaraExport.h"
+
+namespace madara
+{
+namespace transport
+{
+/**
+ * @class ArrayDeltas
+ * @brief Sends large integer and double arrays as the ranges of elements
+ *        that changed since the last time the array was sent, when
+ *        TransportSettings::array_delta_interval is set. Receivers patch
+ *        a delta into their variable only if it holds the previously
+ *        sent value at the clock of the message that carried it. All
+ *        others drop deltas until the next full snapshot, which is sent
+ *        every array_delta_interval sends of an array.
+ **/
+class MADARA_EXPORT ArrayDeltas
+{
+public:
+  /**
+   * Default constructor
+   **/
+  ArrayDeltas();
+
+  /**
+   * Copy constructor
+   * @param  rhs   the value to be copied into this class
+   **/
+  ArrayDeltas(const ArrayDeltas& rhs);
+
+  /**
+   * Assignment operator
+   * @param  rhs   the value to be copied into this class
+   **/
+  void operator=(const ArrayDeltas& rhs);
+
+  /**
+   * Writes the value of a variable to a buffer, as a delta from the
+   * last value sent if that is possible and smaller
+   * @param     buffer     the buffer to write to
+   * @param     key        the name of the variable
+   * @param     record     the value of the variable
+   * @param     clock      the clock of the message being written
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @param     snapshot_interval  sends of an array between full values.
+   *                              0 always sends full values.
+   * @param     min_elements  smallest array that is sent as deltas
+   * @return    current buffer position for next write
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  char* write(char* buffer, const std::string& key,
+      const knowledge::KnowledgeRecord& record, uint64_t clock,
+      int64_t& buffer_remaining, uint32_t snapshot_interval,
+      uint32_t min_elements);
+
+  /**
+   * Returns the number of arrays whose last sent value is remembered
+   * @return  number of arrays
+   **/
+  size_t size(void) const;
+
+  /**
+   * Forgets all sent arrays. Each is sent in full the next time.
+   **/
+  void clear(void);
+
+private:
+  /**
+   * The last value of an array that was sent
+   **/
+  struct SentArray
+  {
+    /// the value that was sent
+    knowledge::KnowledgeRecord value;
+
+    /// clock of the message that carried the value
+    uint64_t clock = 0;
+
+    /// sends since the last full value
+    uint32_t deltas = 0;
+  };
+
+  /// arrays that have been sent
+  std::unordered_map<std::string, SentArray> sent_;
+
+  /// protects the arrays from concurrent sends
+  mutable MADARA_LOCK_TYPE mutex_;
+};
+}
+}
+
+#endif  // _MADARA_ARRAY_DELTAS_H_
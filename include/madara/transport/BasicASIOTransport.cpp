@@ -9,8 +9,14 @@
 #include "madara/transport/Fragmentation.h"
 
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 #include "madara/utility/IntTypes.h"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 namespace madara
 {
 namespace transport
@@ -37,6 +43,8 @@ BasicASIOTransport::~BasicASIOTransport()
 
 void BasicASIOTransport::close(void)
 {
+  this->close_send_queue();
+
   this->invalidate_transport();
 
   read_threads_.terminate();
@@ -242,6 +250,12 @@ int BasicASIOTransport::setup_read_threads()
       hertz = 0.0;
     }
 
+    if (settings_.event_driven_reads)
+    {
+      // read threads block on their sockets, so never pace them
+      hertz = 0.0;
+    }
+
     madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
         "BasicASIOTransport::setup:"
         " starting %d threads at %f hertz\n",
@@ -263,5 +277,113 @@ int BasicASIOTransport::setup_read_threads()
 
   return 0;
 }
+
+size_t BasicASIOTransport::send_datagrams(
+    const std::vector<OutgoingDatagram>& datagrams, std::vector<long>& results)
+{
+  size_t failures = 0;
+  size_t count = datagrams.size();
+
+  results.assign(count, -1);
+
+  // a datagram is abandoned after this many failed attempts
+  int max_attempts = settings_.resend_attempts < 0
+                         ? -1
+                         : settings_.resend_attempts + 1;
+  int attempts = 0;
+
+#ifdef __linux__
+  // the kernel accepts at most UIO_MAXIOV (1024) messages per call
+  static const size_t max_batch = 1024;
+
+  std::vector<struct mmsghdr> messages(std::min(count, max_batch));
+  std::vector<struct iovec> iovecs(messages.size());
+
+  size_t next = 0;
+
+  while (next < count)
+  {
+    size_t batch = std::min(count - next, max_batch);
+
+    for (size_t i = 0; i < batch; ++i)
+    {
+      const OutgoingDatagram& datagram = datagrams[next + i];
+      const udp::endpoint& target = addresses_[datagram.addr_index];
+
+      iovecs[i].iov_base = (void*)datagram.buf;
+      iovecs[i].iov_len = datagram.size;
+
+      std::memset(&messages[i], 0, sizeof(messages[i]));
+      messages[i].msg_hdr.msg_iov = &iovecs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+      messages[i].msg_hdr.msg_name = (void*)target.data();
+      messages[i].msg_hdr.msg_namelen = (socklen_t)target.size();
+    }
+
+    int sent = ::sendmmsg(socket_.native_handle(), messages.data(),
+        (unsigned int)batch, 0);
+
+    if (sent > 0)
+    {
+      for (int i = 0; i < sent; ++i)
+      {
+        results[next + i] = (long)messages[i].msg_len;
+      }
+
+      next += (size_t)sent;
+      attempts = 0;
+    }
+    else
+    {
+      // the datagram at next failed. Retry it or move past it.
+      ++failures;
+      ++attempts;
+
+      madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+          "BasicASIOTransport::send_datagrams:"
+          " Error sending packet to %s:%d: %s\n",
+          addresses_[datagrams[next].addr_index].address().to_string().c_str(),
+          (int)addresses_[datagrams[next].addr_index].port(),
+          strerror(errno));
+
+      if (max_attempts >= 0 && attempts >= max_attempts)
+      {
+        ++next;
+        attempts = 0;
+      }
+    }
+  }
+#else
+  for (size_t i = 0; i < count; ++i)
+  {
+    const OutgoingDatagram& datagram = datagrams[i];
+    const udp::endpoint& target = addresses_[datagram.addr_index];
+
+    for (attempts = 0; max_attempts < 0 || attempts < max_attempts;
+         ++attempts)
+    {
+      boost::system::error_code err;
+      size_t sent = socket_.send_to(
+          asio::buffer(datagram.buf, datagram.size), target, 0, err);
+
+      if (!err)
+      {
+        results[i] = (long)sent;
+        break;
+      }
+
+      ++failures;
+
+      madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+          "BasicASIOTransport::send_datagrams:"
+          " Error sending packet to %s:%d: %s\n",
+          target.address().to_string().c_str(), (int)target.port(),
+          err.message().c_str());
+    }
+  }
+#endif
+
+  return failures;
+}
 }
 }
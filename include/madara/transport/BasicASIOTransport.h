@@ -2,6 +2,7 @@
 #define _MADARA_BASIC_ASIO_TRANSPORT_H_
 
 #include <string>
+#include <vector>
 
 #include "madara/MadaraExport.h"
 #include "madara/utility/ScopedArray.h"
@@ -37,6 +38,33 @@ public:
   static const double default_read_hertz;
 
 protected:
+  /**
+   * A datagram to be sent by send_datagrams
+   **/
+  struct OutgoingDatagram
+  {
+    /// the bytes to send
+    const char* buf;
+
+    /// number of bytes to send
+    size_t size;
+
+    /// index of the destination in addresses_
+    size_t addr_index;
+  };
+
+  /**
+   * Sends a list of datagrams with as few system calls as possible. On
+   * Linux, this uses sendmmsg for all datagrams at once. Datagrams that
+   * fail are retried up to settings.resend_attempts times.
+   * @param  datagrams   the datagrams to send
+   * @param  results     filled with bytes sent for each datagram, or -1
+   *                     if it could not be sent
+   * @return  number of attempts that failed, for debug counters
+   **/
+  size_t send_datagrams(const std::vector<OutgoingDatagram>& datagrams,
+      std::vector<long>& results);
+
   virtual int setup_socket(udp::socket& socket);
   virtual int setup_read_socket();
   virtual int setup_write_socket();
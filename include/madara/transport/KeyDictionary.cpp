@@ -0,0 +1,333 @@
+#include <random>
+#include <sstream>
+#include <string.h>
+
+#include "KeyDictionary.h"
+#include "madara/exceptions/MemoryException.h"
+#include "madara/utility/Utility.h"
+
+namespace
+{
+/**
+ * Picks a session that a restarted sender is unlikely to pick again
+ **/
+uint64_t new_session(void)
+{
+  std::random_device device;
+  uint64_t session = ((uint64_t)device() << 32) ^ device();
+
+  return session ^ (uint64_t)madara::utility::get_time();
+}
+}
+
+madara::transport::KeyDictionary::KeyDictionary() : session_(new_session())
+{
+}
+
+madara::transport::KeyDictionary::KeyDictionary(const KeyDictionary& rhs)
+{
+  MADARA_GUARD_TYPE guard(rhs.mutex_);
+  session_ = rhs.session_;
+  sent_ = rhs.sent_;
+  received_ = rhs.received_;
+}
+
+void madara::transport::KeyDictionary::operator=(const KeyDictionary& rhs)
+{
+  if (this != &rhs)
+  {
+    uint64_t session;
+    std::unordered_map<std::string, SentKey> sent;
+    std::map<std::string, ReceivedKeys> received;
+
+    {
+      MADARA_GUARD_TYPE guard(rhs.mutex_);
+      session = rhs.session_;
+      sent = rhs.sent_;
+      received = rhs.received_;
+    }
+
+    MADARA_GUARD_TYPE guard(mutex_);
+    session_ = session;
+    sent_.swap(sent);
+    pending_.clear();
+    received_.swap(received);
+  }
+}
+
+char* madara::transport::KeyDictionary::write_varint(
+    char* buffer, uint64_t value, int64_t& buffer_remaining)
+{
+  do
+  {
+    if (buffer_remaining < 1)
+    {
+      std::stringstream message;
+      message << "KeyDictionary::write_varint: ";
+      message << "varint encoding cannot fit in ";
+      message << buffer_remaining << " byte buffer\n";
+
+      throw exceptions::MemoryException(message.str());
+    }
+
+    unsigned char byte = (unsigned char)(value & 0x7f);
+    value >>= 7;
+
+    if (value != 0)
+      byte |= 0x80;
+
+    *buffer = (char)byte;
+    ++buffer;
+    --buffer_remaining;
+  } while (value != 0);
+
+  return buffer;
+}
+
+const char* madara::transport::KeyDictionary::read_varint(
+    const char* buffer, uint64_t& value, int64_t& buffer_remaining)
+{
+  value = 0;
+
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (buffer_remaining < 1)
+    {
+      buffer_remaining = -1;
+      return buffer;
+    }
+
+    unsigned char byte = (unsigned char)*buffer;
+    ++buffer;
+    --buffer_remaining;
+
+    value |= (uint64_t)(byte & 0x7f) << shift;
+
+    if ((byte & 0x80) == 0)
+      return buffer;
+  }
+
+  // more than 64 bits of value is not something we wrote
+  buffer_remaining = -1;
+  return buffer;
+}
+
+char* madara::transport::KeyDictionary::write_session(
+    char* buffer, int64_t& buffer_remaining)
+{
+  uint64_t session;
+
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    // keys of a message that was never confirmed were not sent
+    pending_.clear();
+    session = session_;
+  }
+
+  return write_varint(buffer, session, buffer_remaining);
+}
+
+char* madara::transport::KeyDictionary::write(char* buffer,
+    const std::string& key, int64_t& buffer_remaining, uint32_t max_keys,
+    uint32_t definition_interval)
+{
+  uint64_t tag = LITERAL;
+  uint64_t id = 0;
+
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    auto found = sent_.find(key);
+
+    if (found == sent_.end() && sent_.size() < max_keys)
+    {
+      SentKey entry = {(uint32_t)sent_.size(), 0};
+      found = sent_.emplace(key, entry).first;
+    }
+
+    if (found != sent_.end())
+    {
+      SentKey& entry = found->second;
+
+      id = entry.id;
+      tag = (definition_interval > 0 ? entry.sends % definition_interval
+                                     : entry.sends) == 0
+                ? DEFINITION
+                : REFERENCE;
+
+      pending_.push_back(&entry);
+    }
+  }
+
+  if (tag == REFERENCE)
+  {
+    return write_varint(buffer, (id << 2) | REFERENCE, buffer_remaining);
+  }
+
+  if (tag == DEFINITION)
+  {
+    buffer = write_varint(buffer, (id << 2) | DEFINITION, buffer_remaining);
+    buffer = write_varint(buffer, key.size(), buffer_remaining);
+  }
+  else
+  {
+    buffer = write_varint(
+        buffer, ((uint64_t)key.size() << 2) | LITERAL, buffer_remaining);
+  }
+
+  if (buffer_remaining < (int64_t)key.size())
+  {
+    std::stringstream message;
+    message << "KeyDictionary::write: ";
+    message << key.size() << " byte key cannot fit in ";
+    message << buffer_remaining << " byte buffer\n";
+
+    throw exceptions::MemoryException(message.str());
+  }
+
+  memcpy(buffer, key.c_str(), key.size());
+  buffer += key.size();
+  buffer_remaining -= key.size();
+
+  return buffer;
+}
+
+void madara::transport::KeyDictionary::confirm_sends(bool sent)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  if (sent)
+  {
+    for (SentKey* entry : pending_)
+      ++entry->sends;
+  }
+
+  pending_.clear();
+}
+
+const char* madara::transport::KeyDictionary::read_session(
+    const char* buffer, const std::string& peer, int64_t& buffer_remaining)
+{
+  uint64_t session = 0;
+  buffer = read_varint(buffer, session, buffer_remaining);
+
+  if (buffer_remaining >= 0)
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    auto inserted = received_.emplace(peer, ReceivedKeys{session, {}});
+
+    // the peer restarted, and its ids may now name other keys
+    if (inserted.first->second.session != session)
+    {
+      inserted.first->second.session = session;
+      inserted.first->second.names.clear();
+    }
+  }
+
+  return buffer;
+}
+
+const char* madara::transport::KeyDictionary::read(const char* buffer,
+    const std::string& peer, std::string& key, int64_t& buffer_remaining)
+{
+  uint64_t value = 0;
+  buffer = read_varint(buffer, value, buffer_remaining);
+
+  if (buffer_remaining < 0)
+    return buffer;
+
+  uint64_t tag = value & 3;
+  uint64_t id = value >> 2;
+  uint64_t length = id;
+
+  if (tag == REFERENCE)
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    auto found = received_.find(peer);
+
+    if (found != received_.end() && id < found->second.names.size())
+      key = found->second.names[id];
+    else
+      key.clear();
+
+    return buffer;
+  }
+
+  if (tag == DEFINITION)
+  {
+    buffer = read_varint(buffer, length, buffer_remaining);
+
+    if (buffer_remaining < 0 || id >= MAX_KEY_ID)
+    {
+      buffer_remaining = -1;
+      return buffer;
+    }
+  }
+  else if (tag != LITERAL)
+  {
+    buffer_remaining = -1;
+    return buffer;
+  }
+
+  if (buffer_remaining < (int64_t)length)
+  {
+    buffer_remaining = -1;
+    return buffer;
+  }
+
+  key.assign(buffer, length);
+  buffer += length;
+  buffer_remaining -= length;
+
+  if (tag == DEFINITION)
+  {
+    MADARA_GUARD_TYPE guard(mutex_);
+
+    std::vector<std::string>& keys = received_[peer].names;
+
+    if (id >= keys.size())
+      keys.resize(id + 1);
+
+    keys[id] = key;
+  }
+
+  return buffer;
+}
+
+size_t madara::transport::KeyDictionary::sent_keys(void) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  return sent_.size();
+}
+
+size_t madara::transport::KeyDictionary::received_keys(
+    const std::string& peer) const
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+
+  size_t result = 0;
+  auto found = received_.find(peer);
+
+  if (found != received_.end())
+  {
+    for (const auto& key : found->second.names)
+    {
+      if (!key.empty())
+        ++result;
+    }
+  }
+
+  return result;
+}
+
+void madara::transport::KeyDictionary::clear(void)
+{
+  MADARA_GUARD_TYPE guard(mutex_);
+  session_ = new_session();
+  sent_.clear();
+  pending_.clear();
+  received_.clear();
+}
@@ -0,0 +1,226 @@
+#ifndef _MADARA_KEY_DICTIONARY_H_
+#define _MADARA_KEY_DICTIONARY_H_
+
+/**
+ * @file KeyDictionary.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the KeyDictionary class, which interns variable
+ * names as small integer ids for the compact wire format of transports
+ **/
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "madara/LockType.h"
+#include "madara/utility/StdInt.h"
+#include "madara/MadaraExport.h"
+
+namespace madara
+{
+namespace transport
+{
+/**
+ * @class KeyDictionary
+ * @brief Interns variable names as varint ids in messages sent with
+ *        TransportSettings::intern_keys. Senders define an id in-line
+ *        with the name the first time a key is sent, and again every
+ *        few sends so that late joiners learn it. Receivers learn ids
+ *        per peer from those definitions.
+ *
+ *        Each message starts with a varint session, which is random
+ *        for every dictionary and changes when it is cleared. A sender
+ *        that restarts hands out ids in a new order, so receivers
+ *        forget a peer's ids when its session changes. Each key in a
+ *        message is then encoded as a varint whose low two bits are a
+ *        tag:
+ *
+ *        LITERAL:    [len << 2 | 0] [len characters]<br />
+ *        REFERENCE:  [id << 2 | 1]<br />
+ *        DEFINITION: [id << 2 | 2] [len] [len characters]
+ **/
+class MADARA_EXPORT KeyDictionary
+{
+public:
+  /**
+   * Encodings of a key in a message with interned keys
+   **/
+  enum Tags
+  {
+    LITERAL = 0,
+    REFERENCE = 1,
+    DEFINITION = 2
+  };
+
+  /**
+   * Largest id a receiver accepts, to bound the memory a peer can use
+   **/
+  static const uint32_t MAX_KEY_ID = 1 << 20;
+
+  /**
+   * Default constructor
+   **/
+  KeyDictionary();
+
+  /**
+   * Copy constructor
+   * @param  rhs   the value to be copied into this class
+   **/
+  KeyDictionary(const KeyDictionary& rhs);
+
+  /**
+   * Assignment operator
+   * @param  rhs   the value to be copied into this class
+   **/
+  void operator=(const KeyDictionary& rhs);
+
+  /**
+   * Writes the session of the dictionary to a buffer. This starts a
+   * message, and must come before its keys.
+   * @param     buffer     the buffer to write to
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @return    current buffer position for next write
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  char* write_session(char* buffer, int64_t& buffer_remaining);
+
+  /**
+   * Writes a key to a buffer, interning it if there is room. A key is
+   * not counted as sent until confirm_sends is called for the message.
+   * @param     buffer     the buffer to write to
+   * @param     key        the name of the variable
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @param     max_keys   most keys to intern. Others are sent in full.
+   * @param     definition_interval  sends of a key between definitions
+   *                              of its id. 0 defines only once.
+   * @return    current buffer position for next write
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  char* write(char* buffer, const std::string& key, int64_t& buffer_remaining,
+      uint32_t max_keys, uint32_t definition_interval);
+
+  /**
+   * Counts the keys written since write_session as sent, if the
+   * message was sent. Keys of a message that was not sent are defined
+   * again in the next message.
+   * @param     sent       true if the message was sent
+   **/
+  void confirm_sends(bool sent);
+
+  /**
+   * Reads the session that starts a message from a peer. If the session
+   * changed, the ids learned from the peer are forgotten.
+   * @param     buffer     the buffer to read from
+   * @param     peer       the sender of the message
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer. Negative if it is malformed.
+   * @return    current buffer position for next read
+   **/
+  const char* read_session(
+      const char* buffer, const std::string& peer, int64_t& buffer_remaining);
+
+  /**
+   * Reads a key from a buffer, learning any id it defines
+   * @param     buffer     the buffer to read from
+   * @param     peer       the sender of the message, whose ids are used
+   * @param     key        the name of the variable. Empty if the key
+   *                       referred to an id that has not been defined.
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer. Negative if the key is malformed.
+   * @return    current buffer position for next read
+   **/
+  const char* read(const char* buffer, const std::string& peer,
+      std::string& key, int64_t& buffer_remaining);
+
+  /**
+   * Returns the number of keys interned for sending
+   * @return  number of interned keys
+   **/
+  size_t sent_keys(void) const;
+
+  /**
+   * Returns the number of keys learned from a peer
+   * @param     peer       the sender of messages
+   * @return  number of keys with known ids
+   **/
+  size_t received_keys(const std::string& peer) const;
+
+  /**
+   * Forgets all sent and received ids, and starts a new session. Peers
+   * will be sent definitions again before references.
+   **/
+  void clear(void);
+
+  /**
+   * Writes an unsigned integer in as few bytes as it needs, 7 bits
+   * to a byte, least significant group first
+   * @param     buffer     the buffer to write to
+   * @param     value      the value to write
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer, updated by the write
+   * @return    current buffer position for next write
+   * @throw exceptions::MemoryException  not enough buffer to encode
+   **/
+  static char* write_varint(
+      char* buffer, uint64_t value, int64_t& buffer_remaining);
+
+  /**
+   * Reads an unsigned integer written by write_varint
+   * @param     buffer     the buffer to read from
+   * @param     value      the value that was read
+   * @param     buffer_remaining  the count of bytes remaining in the
+   *                              buffer. Negative if the value is
+   *                              truncated or too long.
+   * @return    current buffer position for next read
+   **/
+  static const char* read_varint(
+      const char* buffer, uint64_t& value, int64_t& buffer_remaining);
+
+private:
+  /**
+   * An interned key, from the sender's point of view
+   **/
+  struct SentKey
+  {
+    /// the id of the key
+    uint32_t id;
+
+    /// number of times the key has been sent
+    uint32_t sends;
+  };
+
+  /**
+   * Keys learned from a peer
+   **/
+  struct ReceivedKeys
+  {
+    /// the session of the peer's dictionary
+    uint64_t session;
+
+    /// names of the keys, indexed by id
+    std::vector<std::string> names;
+  };
+
+  /// the session sent at the start of each message
+  uint64_t session_;
+
+  /// keys interned for sending
+  std::unordered_map<std::string, SentKey> sent_;
+
+  /// keys written since write_session, counted by confirm_sends
+  std::vector<SentKey*> pending_;
+
+  /// keys learned from each peer
+  std::map<std::string, ReceivedKeys> received_;
+
+  /// protects the dictionaries from concurrent send and read threads
+  mutable MADARA_LOCK_TYPE mutex_;
+};
+}
+}
+
+#endif  // _MADARA_KEY_DICTIONARY_H_
@@ -5,6 +5,7 @@
 
 #include "madara/exceptions/MemoryException.h"
 #include "MessageHeader.h"
+#include "ReducedMessageHeader.h"
 #include "madara/utility/Utility.h"
 
 madara::transport::MessageHeader::MessageHeader()
@@ -407,6 +408,19 @@ std::string madara::transport::MessageHeader::to_string(void)
   return buffer.str();
 }
 
+void madara::transport::MessageHeader::set_interned_keys(bool interned)
+{
+  memcpy(madara_id, interned ? MADARA_INTERNED_IDENTIFIER : MADARA_IDENTIFIER,
+      7);
+  madara_id[7] = 0;
+}
+
+bool madara::transport::MessageHeader::has_interned_keys(void) const
+{
+  return strncmp(madara_id, MADARA_INTERNED_IDENTIFIER, 7) == 0 ||
+         strncmp(madara_id, REDUCED_MADARA_INTERNED_ID, 7) == 0;
+}
+
 uint64_t madara::transport::MessageHeader::get_size(const char* buffer)
 {
   return (madara::utility::endian_swap(*(uint64_t*)buffer));
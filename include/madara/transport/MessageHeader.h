@@ -20,6 +20,7 @@ namespace transport
 {
 #define MADARA_IDENTIFIER_LENGTH 8
 #define MADARA_IDENTIFIER "KaRL1.5"
+#define MADARA_INTERNED_IDENTIFIER "KaRL1.6"
 #define MADARA_DOMAIN_MAX_LENGTH 32
 #define PAIR_COUNT_TYPE uint32_t
 #define KNOWLEDGE_QUALITY_TYPE uint32_t
@@ -122,13 +123,27 @@ public:
    **/
   static uint64_t get_size(const char* buffer);
 
+  /**
+   * Marks the message as naming variables by interned key ids from a
+   * KeyDictionary, rather than by full name (the default)
+   * @param     interned   true if updates use interned keys
+   **/
+  virtual void set_interned_keys(bool interned);
+
+  /**
+   * Checks if the message names variables by interned key ids
+   * @return    true if updates must be read with a KeyDictionary
+   **/
+  bool has_interned_keys(void) const;
+
   /**
    * Tests the buffer for a normal message identifier
-   * @return   true if identifier indicates reduced message header
+   * @return   true if identifier indicates normal message header
    **/
   static inline bool message_header_test(const char* buffer)
   {
-    return strncmp(&(buffer[8]), MADARA_IDENTIFIER, 7) == 0;
+    return strncmp(&(buffer[8]), MADARA_IDENTIFIER, 7) == 0 ||
+           strncmp(&(buffer[8]), MADARA_INTERNED_IDENTIFIER, 7) == 0;
   }
 
   /**
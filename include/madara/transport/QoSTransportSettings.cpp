@@ -238,6 +238,13 @@ void madara::transport::QoSTransportSettings::add_send_filter(
   send_filters_.add(types, functor);
 }
 
+void madara::transport::QoSTransportSettings::add_send_filter(uint32_t types,
+    void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+        TransportContext&))
+{
+  send_filters_.add(types, function);
+}
+
 void madara::transport::QoSTransportSettings::add_send_filter(void (*function)(
     knowledge::KnowledgeMap&, const TransportContext&, knowledge::Variables&))
 {
@@ -275,6 +282,13 @@ void madara::transport::QoSTransportSettings::add_receive_filter(
   receive_filters_.add(types, functor);
 }
 
+void madara::transport::QoSTransportSettings::add_receive_filter(uint32_t types,
+    void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+        TransportContext&))
+{
+  receive_filters_.add(types, function);
+}
+
 void madara::transport::QoSTransportSettings::add_receive_filter(
     void (*function)(knowledge::KnowledgeMap&, const TransportContext&,
         knowledge::Variables&))
@@ -295,6 +309,14 @@ void madara::transport::QoSTransportSettings::add_rebroadcast_filter(
   rebroadcast_filters_.add(types, functor);
 }
 
+void madara::transport::QoSTransportSettings::add_rebroadcast_filter(
+    uint32_t types,
+    void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+        TransportContext&))
+{
+  rebroadcast_filters_.add(types, function);
+}
+
 void madara::transport::QoSTransportSettings::add_rebroadcast_filter(
     void (*function)(knowledge::KnowledgeMap&, const TransportContext&,
         knowledge::Variables&))
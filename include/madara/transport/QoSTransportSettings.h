@@ -97,6 +97,18 @@ public:
    **/
   void add_send_filter(uint32_t types, filters::RecordFilter* filter);
 
+  /**
+   * Adds a filter that will be applied to certain types before sending,
+   * changing the record in place. Unlike other record filters, it is
+   * called without packing FunctionArguments and Variables.
+   * @param   types      the types to add the filter to
+   * @param   function   the function that will take the knowledge record,
+   *                     the name of the variable and the transport context
+   **/
+  void add_send_filter(uint32_t types,
+      void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+          TransportContext&));
+
   /**
    * Adds an aggregate update filter that will be applied before sending,
    * after individual record filters.
@@ -138,6 +150,18 @@ public:
    **/
   void add_receive_filter(uint32_t types, filters::RecordFilter* filter);
 
+  /**
+   * Adds a filter that will be applied to certain types after receiving,
+   * changing the record in place. Unlike other record filters, it is
+   * called without packing FunctionArguments and Variables.
+   * @param   types      the types to add the filter to
+   * @param   function   the function that will take the knowledge record,
+   *                     the name of the variable and the transport context
+   **/
+  void add_receive_filter(uint32_t types,
+      void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+          TransportContext&));
+
   /**
    * Adds an aggregate update filter that will be applied after receiving,
    * after individual record filters.
@@ -174,6 +198,18 @@ public:
    **/
   void add_rebroadcast_filter(uint32_t types, filters::RecordFilter* filter);
 
+  /**
+   * Adds a filter that will be applied to certain types before
+   * rebroadcasting, changing the record in place. Unlike other record
+   * filters, it is called without packing FunctionArguments and Variables.
+   * @param   types      the types to add the filter to
+   * @param   function   the function that will take the knowledge record,
+   *                     the name of the variable and the transport context
+   **/
+  void add_rebroadcast_filter(uint32_t types,
+      void (*function)(knowledge::KnowledgeRecord&, const std::string&,
+          TransportContext&));
+
   /**
    * Adds an aggregate update filter that will be applied before
    * rebroadcasting, after individual record filters.
@@ -16,6 +16,13 @@ madara::transport::ReducedMessageHeader::ReducedMessageHeader()
 
 madara::transport::ReducedMessageHeader::~ReducedMessageHeader() {}
 
+void madara::transport::ReducedMessageHeader::set_interned_keys(bool interned)
+{
+  memcpy(
+      madara_id, interned ? REDUCED_MADARA_INTERNED_ID : REDUCED_MADARA_ID, 7);
+  madara_id[7] = 0;
+}
+
 uint32_t madara::transport::ReducedMessageHeader::encoded_size(void) const
 {
   return sizeof(uint64_t) * 3  // size, clock, timestamp
@@ -19,6 +19,7 @@ namespace madara
 namespace transport
 {
 #define REDUCED_MADARA_ID "karl1.5"
+#define REDUCED_MADARA_INTERNED_ID "karl1.6"
 
 /**
  * @class ReducedMessageHeader
@@ -92,13 +93,21 @@ public:
    **/
   virtual bool equals(const MessageHeader& other);
 
+  /**
+   * Marks the message as naming variables by interned key ids from a
+   * KeyDictionary, rather than by full name (the default)
+   * @param     interned   true if updates use interned keys
+   **/
+  virtual void set_interned_keys(bool interned);
+
   /**
    * Tests the buffer for a reduced message identifier
    * @return   true if identifier indicates reduced message header
    **/
   static inline bool reduced_message_header_test(const char* buffer)
   {
-    return strncmp(&(buffer[8]), REDUCED_MADARA_ID, 7) == 0;
+    return strncmp(&(buffer[8]), REDUCED_MADARA_ID, 7) == 0 ||
+           strncmp(&(buffer[8]), REDUCED_MADARA_INTERNED_ID, 7) == 0;
   }
 };
 }
@@ -27,7 +27,10 @@ Base::Base(const std::string& id, TransportSettings& new_settings,
   packet_scheduler_.attach(&settings_);
 }
 
-Base::~Base() {}
+Base::~Base()
+{
+  close_send_queue();
+}
 
 int Base::setup(void)
 {
@@ -98,14 +101,234 @@ int Base::setup(void)
         settings_.write_domain.c_str(), buffer.str().c_str());
   }
 
+  // the caller of queue_data holds the context lock while it waits for
+  // room, and the send thread needs the lock for send filters and the
+  // debug_to_kb counters, so blocking there would deadlock
+  if (settings_.async_send &&
+      settings_.send_queue_policy == SEND_QUEUE_BLOCK &&
+      (settings_.get_number_of_send_filtered_types() > 0 ||
+          settings_.get_number_of_send_aggregate_filters() > 0 ||
+          settings_.debug_to_kb_prefix != ""))
+  {
+    madara_logger_log(context_.get_logger(), logger::LOG_WARNING,
+        "transport::Base::setup"
+        " SEND_QUEUE_BLOCK cannot be used with send filters or"
+        " debug_to_kb_prefix. Using SEND_QUEUE_COALESCE instead\n");
+
+    settings_.send_queue_policy = SEND_QUEUE_COALESCE;
+  }
+
+  if (settings_.async_send && !send_thread_.joinable())
+  {
+    madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+        "transport::Base::setup"
+        " starting send thread with queue size %d and policy %d\n",
+        (int)settings_.send_queue_size, (int)settings_.send_queue_policy);
+
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      send_closing_ = false;
+    }
+
+    send_thread_ = std::thread(&Base::run_send_queue, this);
+  }
+
   return validate_transport();
 }
 
 void Base::close(void)
 {
+  close_send_queue();
+
   invalidate_transport();
 }
 
+uint64_t Base::queue_data(const knowledge::VariableReferenceMap& updates)
+{
+  SendBatch batch;
+  batch.clock = context_.get_clock();
+
+  for (const auto& entry : updates)
+  {
+    const auto* record = entry.second.get_record_unsafe();
+
+    if (record)
+    {
+      batch.records.emplace_hint(batch.records.end(), entry.first, *record);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(send_mutex_);
+
+  if (send_closing_ || !send_thread_.joinable())
+  {
+    madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+        "transport::Base::queue_data:"
+        " send queue is closed. Dropping %d updates\n",
+        (int)batch.records.size());
+
+    return 0;
+  }
+
+  batch.ticket = ++sends_queued_;
+
+  size_t capacity =
+      settings_.send_queue_size > 0 ? settings_.send_queue_size : 1;
+
+  if (send_queue_.size() >= capacity)
+  {
+    if (settings_.send_queue_policy == SEND_QUEUE_BLOCK)
+    {
+      madara_logger_log(context_.get_logger(), logger::LOG_MINOR,
+          "transport::Base::queue_data:"
+          " send queue is full. Waiting for the send thread\n");
+
+      send_done_.wait(lock, [this, capacity] {
+        return send_closing_ || send_queue_.size() < capacity;
+      });
+
+      if (send_closing_)
+      {
+        return 0;
+      }
+    }
+    else if (settings_.send_queue_policy == SEND_QUEUE_DROP_OLDEST)
+    {
+      madara_logger_log(context_.get_logger(), logger::LOG_MINOR,
+          "transport::Base::queue_data:"
+          " send queue is full. Dropping oldest batch of %d updates\n",
+          (int)send_queue_.front().records.size());
+
+      send_queue_.pop_front();
+      ++sends_dropped_;
+    }
+    else
+    {
+      madara_logger_log(context_.get_logger(), logger::LOG_MINOR,
+          "transport::Base::queue_data:"
+          " send queue is full. Coalescing %d updates into newest batch\n",
+          (int)batch.records.size());
+
+      SendBatch& newest = send_queue_.back();
+
+      for (auto& entry : batch.records)
+      {
+        newest.records[entry.first] = std::move(entry.second);
+      }
+
+      newest.clock = batch.clock;
+      newest.ticket = batch.ticket;
+
+      return batch.ticket;
+    }
+  }
+
+  send_queue_.push_back(std::move(batch));
+  send_ready_.notify_one();
+
+  return sends_queued_;
+}
+
+uint64_t Base::sends_completed(void) const
+{
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  return sends_completed_;
+}
+
+uint64_t Base::sends_dropped(void) const
+{
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  return sends_dropped_;
+}
+
+size_t Base::pending_sends(void) const
+{
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  return send_queue_.size();
+}
+
+bool Base::flush_sends(double max_wait)
+{
+  std::unique_lock<std::mutex> lock(send_mutex_);
+
+  uint64_t target = sends_queued_;
+  auto flushed = [this, target] {
+    return sends_completed_ >= target || send_closing_;
+  };
+
+  if (max_wait < 0)
+  {
+    send_done_.wait(lock, flushed);
+    return true;
+  }
+
+  return send_done_.wait_for(
+      lock, std::chrono::duration<double>(max_wait), flushed);
+}
+
+void Base::close_send_queue(void)
+{
+  if (!send_thread_.joinable() ||
+      send_thread_.get_id() == std::this_thread::get_id())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_closing_ = true;
+  }
+
+  send_ready_.notify_all();
+  send_done_.notify_all();
+
+  send_thread_.join();
+
+  madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+      "transport::Base::close_send_queue:"
+      " send thread has exited after %d sends (%d dropped)\n",
+      (int)sends_completed_, (int)sends_dropped_);
+}
+
+void Base::run_send_queue(void)
+{
+  std::unique_lock<std::mutex> lock(send_mutex_);
+
+  for (;;)
+  {
+    send_ready_.wait(
+        lock, [this] { return send_closing_ || !send_queue_.empty(); });
+
+    // when closing, whatever is still queued is sent before exiting
+    if (send_queue_.empty())
+    {
+      break;
+    }
+
+    SendBatch batch(std::move(send_queue_.front()));
+    send_queue_.pop_front();
+    send_done_.notify_all();
+
+    lock.unlock();
+
+    knowledge::VariableReferenceMap updates;
+
+    for (auto& entry : batch.records)
+    {
+      updates.emplace_hint(updates.end(), entry.first.c_str(),
+          knowledge::VariableReference(&entry));
+    }
+
+    send_clock_ = batch.clock;
+    send_data(updates);
+
+    lock.lock();
+
+    sends_completed_ = batch.ticket;
+    send_done_.notify_all();
+  }
+}
+
 int process_received_update(const char* buffer, uint32_t bytes_read,
     const std::string& id, knowledge::ThreadSafeContext& context,
     const QoSTransportSettings& settings, BandwidthMonitor& send_monitor,
@@ -438,6 +661,25 @@ int process_received_update(const char* buffer, uint32_t bytes_read,
   record.clock = header->clock;
   std::string key;
 
+  // interned keys are learned per peer. Reduced headers carry no
+  // originator, so the sending host stands in for it.
+  bool interned_keys = header->has_interned_keys();
+  std::string peer;
+
+  if (interned_keys)
+  {
+    peer = is_reduced ? remote_host : header->originator;
+    update = settings.key_dictionary.read_session(
+        update, peer, buffer_remaining);
+  }
+
+  const auto read_key = [&](const char* buffer) {
+    return interned_keys ? settings.key_dictionary.read(
+                               buffer, peer, key, buffer_remaining)
+                         : knowledge::KnowledgeRecord::read_key(
+                               buffer, key, buffer_remaining);
+  };
+
   bool dropped = false;
 
   if (send_monitor.is_bandwidth_violated(settings.get_send_bandwidth_limit()))
@@ -491,48 +733,139 @@ int process_received_update(const char* buffer, uint32_t bytes_read,
     }
   };
 
-  // iterate over the updates
-  for (uint32_t i = 0; i < header->updates; ++i)
+  // Without receive filters, and with nothing to rebroadcast, no one needs
+  // an owned copy of an update, so decode each one straight into its
+  // variable in the context and skip the updates map entirely
+  bool direct_apply = settings.get_number_of_receive_filtered_types() == 0 &&
+                      settings.get_number_of_receive_aggregate_filters() == 0 &&
+                      (dropped || header->ttl == 0);
+
+  if (direct_apply)
   {
-    // read converts everything into host format from the update stream
-    update = record.read(update, key, buffer_remaining);
+    knowledge::ContextGuard guard(context);
+
+    madara_logger_log(context.get_logger(), logger::LOG_MINOR,
+        "%s:"
+        " No receive filters. Applying updates directly to context.\n",
+        print_prefix);
+
+    uint64_t now = utility::get_time();
 
-    if (buffer_remaining < 0)
+    for (uint32_t i = 0; i < header->updates; ++i)
     {
-      madara_logger_log(context.get_logger(), logger::LOG_EMERGENCY,
-          "%s:"
-          " unable to process message. Buffer remaining is negative."
-          " Server is likely being targeted by custom KaRL tools.\n",
-          print_prefix);
+      update = read_key(update);
 
-      // we do not delete the header as this will be cleaned up later
-      break;
+      int result = -1;
+
+      if (buffer_remaining >= 0)
+      {
+        result = context.update_record_from_external(key, update,
+            buffer_remaining, header->quality, header->clock, now,
+            knowledge::KnowledgeUpdateSettings::GLOBAL_AS_LOCAL_NO_EXPAND);
+      }
+
+      if (buffer_remaining < 0)
+      {
+        madara_logger_log(context.get_logger(), logger::LOG_EMERGENCY,
+            "%s:"
+            " unable to process message. Buffer remaining is negative."
+            " Server is likely being targeted by custom KaRL tools.\n",
+            print_prefix);
+
+        break;
+      }
+
+      ++actual_updates;
+
+      madara_logger_log(context.get_logger(), logger::LOG_MAJOR,
+          "%s:"
+          " update %s was %s\n",
+          print_prefix, key.c_str(), result == 1 ? "accepted" : "rejected");
     }
-    else
+  }
+  else
+  {
+    // iterate over the updates
+    for (uint32_t i = 0; i < header->updates; ++i)
     {
-      madara_logger_log(context.get_logger(), logger::LOG_MINOR,
-          "%s:"
-          " Applying receive filter to %s (clk %i, qual %i) = %s\n",
-          print_prefix, key.c_str(), record.clock, record.quality,
-          record.to_string().c_str());
+      // read converts everything into host format from the update stream
+      update = read_key(update);
 
-      record = settings.filter_receive(record, key, transport_context);
+      bool delta_dropped = false;
 
-      if (record.exists())
+      if (knowledge::KnowledgeRecord::is_array_delta(update, buffer_remaining))
       {
-        madara_logger_log(context.get_logger(), logger::LOG_MINOR,
+        // an array delta patches a copy of the value it was computed from
+        record = context.get(key, knowledge::KnowledgeReferenceSettings(false));
+        delta_dropped = !record.can_apply_delta(update, buffer_remaining);
+
+        if (delta_dropped)
+        {
+          update =
+              knowledge::KnowledgeRecord::skip_value(update, buffer_remaining);
+        }
+      }
+
+      if (!delta_dropped)
+      {
+        update = record.read(update, buffer_remaining);
+      }
+
+      record.quality = header->quality;
+      record.clock = header->clock;
+
+      if (buffer_remaining < 0)
+      {
+        madara_logger_log(context.get_logger(), logger::LOG_EMERGENCY,
             "%s:"
-            " Filter results for %s were %s\n",
-            print_prefix, key.c_str(), record.to_string().c_str());
+            " unable to process message. Buffer remaining is negative."
+            " Server is likely being targeted by custom KaRL tools.\n",
+            print_prefix);
 
-        add_record(key, record);
+        // we do not delete the header as this will be cleaned up later
+        break;
+      }
+      else if (interned_keys && key.empty())
+      {
+        madara_logger_log(context.get_logger(), logger::LOG_MAJOR,
+            "%s:"
+            " dropping update with a key id %s has not defined yet\n",
+            print_prefix, peer.c_str());
+      }
+      else if (delta_dropped)
+      {
+        madara_logger_log(context.get_logger(), logger::LOG_MAJOR,
+            "%s:"
+            " dropping array delta for %s, which does not hold the value"
+            " it patches. Waiting for the next full value.\n",
+            print_prefix, key.c_str());
       }
       else
       {
         madara_logger_log(context.get_logger(), logger::LOG_MINOR,
             "%s:"
-            " Filter resulted in dropping %s\n",
-            print_prefix, key.c_str());
+            " Applying receive filter to %s (clk %i, qual %i) = %s\n",
+            print_prefix, key.c_str(), record.clock, record.quality,
+            record.to_string().c_str());
+
+        record = settings.filter_receive(record, key, transport_context);
+
+        if (record.exists())
+        {
+          madara_logger_log(context.get_logger(), logger::LOG_MINOR,
+              "%s:"
+              " Filter results for %s were %s\n",
+              print_prefix, key.c_str(), record.to_string().c_str());
+
+          add_record(key, record);
+        }
+        else
+        {
+          madara_logger_log(context.get_logger(), logger::LOG_MINOR,
+              "%s:"
+              " Filter resulted in dropping %s\n",
+              print_prefix, key.c_str());
+        }
       }
     }
   }
@@ -756,6 +1089,9 @@ int prep_rebroadcast(knowledge::ThreadSafeContext& context, char* buffer,
     // the number of updates will be the size of the records map
     header->updates = uint32_t(records.size());
 
+    // rebroadcasts always name variables in full
+    header->set_interned_keys(false);
+
     // set the update to the end of the header
     char* update = header->write(buffer, buffer_remaining);
 
@@ -1055,8 +1391,11 @@ long Base::prep_send(const knowledge::VariableReferenceMap& orig_updates,
     header = new MessageHeader();
   }
 
-  // get the clock
-  header->clock = context_.get_clock();
+  // get the clock, as of queue_data if this is the send thread
+  if (send_thread_.get_id() == std::this_thread::get_id())
+    header->clock = send_clock_;
+  else
+    header->clock = context_.get_clock();
 
   if (!reduced)
   {
@@ -1076,6 +1415,8 @@ long Base::prep_send(const knowledge::VariableReferenceMap& orig_updates,
     header->type = MULTIASSIGN;
   }
 
+  header->set_interned_keys(settings_.intern_keys);
+
   // set the time-to-live
   header->ttl = settings_.get_rebroadcast_ttl();
 
@@ -1090,7 +1431,14 @@ long Base::prep_send(const knowledge::VariableReferenceMap& orig_updates,
   // set the update to the end of the header
   char* update = header->write(buffer, buffer_remaining);
   uint64_t* message_size = (uint64_t*)buffer;
-  uint32_t* message_updates = (uint32_t*)(buffer + 116);
+
+  if (settings_.intern_keys)
+  {
+    update = settings_.key_dictionary.write_session(update, buffer_remaining);
+  }
+
+  // the reduced header has its update count right after the size and id
+  uint32_t* message_updates = (uint32_t*)(buffer + (reduced ? 16 : 116));
 
   // Message header format
   // [size|id|domain|originator|type|updates|quality|clock|list of updates]
@@ -1131,7 +1479,21 @@ long Base::prep_send(const knowledge::VariableReferenceMap& orig_updates,
         return;
       }
 
-      update = rec.write(update, key, buffer_remaining);
+      if (settings_.intern_keys)
+      {
+        update = settings_.key_dictionary.write(update, key, buffer_remaining,
+            settings_.max_interned_keys, settings_.key_definition_interval);
+      }
+      else
+      {
+        update = knowledge::KnowledgeRecord::write_key(
+            update, key, buffer_remaining);
+      }
+
+      // large arrays may be sent as only what changed since the last send
+      update = settings_.array_deltas.write(update, key, rec, header->clock,
+          buffer_remaining, settings_.array_delta_interval,
+          settings_.min_array_delta_size);
 
       if (buffer_remaining > 0)
       {
@@ -17,6 +17,10 @@
 #include <sstream>
 #include <vector>
 #include <ostream>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #include "madara/utility/ThreadSafeVector.h"
 #include "madara/MadaraExport.h"
@@ -111,11 +115,63 @@ public:
    **/
   virtual long send_data(const knowledge::VariableReferenceMap&) = 0;
 
+  /**
+   * Copies a list of updates into the asynchronous send queue, to be
+   * passed to send_data by the send thread of this transport. The
+   * caller must hold the context lock, as with send_data. If the queue
+   * is full, settings.send_queue_policy decides what happens.
+   * @param  updates   the updates to copy
+   * @return  ticket for the queued updates, which have been sent
+   *          (or dropped) once sends_completed () reaches it. 0 if
+   *          the transport is not sending asynchronously.
+   **/
+  uint64_t queue_data(const knowledge::VariableReferenceMap& updates);
+
+  /**
+   * Checks if this transport sends through an asynchronous send queue
+   * @return  true if send_modifieds should call queue_data
+   **/
+  bool is_async_send(void) const;
+
+  /**
+   * Returns the last ticket that the send thread has finished
+   * @return  a completion counter to compare with queue_data tickets
+   **/
+  uint64_t sends_completed(void) const;
+
+  /**
+   * Returns the number of batches dropped from the send queue by the
+   * SEND_QUEUE_DROP_OLDEST policy
+   * @return  the number of dropped batches
+   **/
+  uint64_t sends_dropped(void) const;
+
+  /**
+   * Returns the number of batches in the send queue
+   * @return  the number of batches waiting for the send thread
+   **/
+  size_t pending_sends(void) const;
+
+  /**
+   * Waits for everything queued so far to be sent. Do not call this
+   * while holding the context lock, since send filters may need it.
+   * @param  max_wait   maximum seconds to wait. Negative waits forever.
+   * @return  true if the queue was flushed, false on timeout
+   **/
+  bool flush_sends(double max_wait = -1.0);
+
   /**
    * Invalidates a transport to indicate it is shutting down
    **/
   void invalidate_transport(void);
 
+  /**
+   * Sends anything left in the asynchronous send queue and joins the
+   * send thread. Transports should call this at the start of close,
+   * before invalidating the transport.
+   **/
+  void close_send_queue(void);
+
   /**
    * Closes this transport
    **/
@@ -154,6 +210,57 @@ protected:
 
   /// Latest TOI the previous send operation included
   uint64_t last_toi_sent_ = 0;
+
+private:
+  /**
+   * Records copied by queue_data for a later send_data call
+   **/
+  struct SendBatch
+  {
+    /// copies of the modified records
+    knowledge::KnowledgeMap records;
+
+    /// the context clock when the records were copied
+    uint64_t clock = 0;
+
+    /// ticket of the newest queue_data call merged into this batch
+    uint64_t ticket = 0;
+  };
+
+  /**
+   * Main loop of the send thread
+   **/
+  void run_send_queue(void);
+
+  /// batches waiting to be sent
+  std::deque<SendBatch> send_queue_;
+
+  /// protects the send queue and its counters
+  mutable std::mutex send_mutex_;
+
+  /// signaled when a batch is queued or the queue is closing
+  std::condition_variable send_ready_;
+
+  /// signaled when a batch leaves the queue or finishes sending
+  std::condition_variable send_done_;
+
+  /// thread that drains send_queue_ through send_data
+  std::thread send_thread_;
+
+  /// true when the send thread has been asked to exit
+  bool send_closing_ = false;
+
+  /// last ticket handed out by queue_data
+  uint64_t sends_queued_ = 0;
+
+  /// last ticket finished by the send thread
+  uint64_t sends_completed_ = 0;
+
+  /// batches discarded by SEND_QUEUE_DROP_OLDEST
+  uint64_t sends_dropped_ = 0;
+
+  /// clock of the batch the send thread is sending
+  uint64_t send_clock_ = 0;
 };
 
 /**
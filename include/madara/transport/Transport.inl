@@ -43,4 +43,9 @@ inline madara::transport::TransportSettings& madara::transport::Base::settings(
   return settings_;
 }
 
+inline bool madara::transport::Base::is_async_send(void) const
+{
+  return settings_.async_send;
+}
+
 #endif
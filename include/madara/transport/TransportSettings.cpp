@@ -70,14 +70,25 @@ madara::transport::TransportSettings::TransportSettings(
     delay_launch(settings.delay_launch),
     never_exit(settings.never_exit),
     send_reduced_message_header(settings.send_reduced_message_header),
+    intern_keys(settings.intern_keys),
+    max_interned_keys(settings.max_interned_keys),
+    key_definition_interval(settings.key_definition_interval),
+    array_delta_interval(settings.array_delta_interval),
+    min_array_delta_size(settings.min_array_delta_size),
     slack_time(settings.slack_time),
     read_thread_hertz(settings.read_thread_hertz),
+    event_driven_reads(settings.event_driven_reads),
+    read_batch_size(settings.read_batch_size),
     max_send_hertz(settings.max_send_hertz),
+    batched_sends(settings.batched_sends),
     hosts(),
     no_sending(settings.no_sending),
     no_receiving(settings.no_receiving),
     send_history(settings.send_history),
     debug_to_kb_prefix(settings.debug_to_kb_prefix),
+    async_send(settings.async_send),
+    send_queue_size(settings.send_queue_size),
+    send_queue_policy(settings.send_queue_policy),
     read_domains_(settings.read_domains_)
 {
   hosts.resize(settings.hosts.size());
@@ -105,9 +116,17 @@ void madara::transport::TransportSettings::operator=(
   never_exit = settings.never_exit;
 
   send_reduced_message_header = settings.send_reduced_message_header;
+  intern_keys = settings.intern_keys;
+  max_interned_keys = settings.max_interned_keys;
+  key_definition_interval = settings.key_definition_interval;
+  array_delta_interval = settings.array_delta_interval;
+  min_array_delta_size = settings.min_array_delta_size;
   slack_time = settings.slack_time;
   read_thread_hertz = settings.read_thread_hertz;
+  event_driven_reads = settings.event_driven_reads;
+  read_batch_size = settings.read_batch_size;
   max_send_hertz = settings.max_send_hertz;
+  batched_sends = settings.batched_sends;
 
   hosts.resize(settings.hosts.size());
   for (unsigned int i = 0; i < settings.hosts.size(); ++i)
@@ -119,6 +138,10 @@ void madara::transport::TransportSettings::operator=(
   send_history = settings.send_history;
 
   debug_to_kb_prefix = settings.debug_to_kb_prefix;
+
+  async_send = settings.async_send;
+  send_queue_size = settings.send_queue_size;
+  send_queue_policy = settings.send_queue_policy;
 }
 
 madara::transport::TransportSettings::~TransportSettings()
@@ -161,9 +184,23 @@ void madara::transport::TransportSettings::load(
 
   send_reduced_message_header =
       knowledge.get(prefix + ".send_reduced_message_header").is_true();
+  intern_keys = knowledge.get(prefix + ".intern_keys").is_true();
+  max_interned_keys =
+      (uint32_t)knowledge.get(prefix + ".max_interned_keys").to_integer();
+  key_definition_interval =
+      (uint32_t)knowledge.get(prefix + ".key_definition_interval").to_integer();
+  array_delta_interval =
+      (uint32_t)knowledge.get(prefix + ".array_delta_interval").to_integer();
+  min_array_delta_size =
+      (uint32_t)knowledge.get(prefix + ".min_array_delta_size").to_integer();
   slack_time = knowledge.get(prefix + ".slack_time").to_double();
   read_thread_hertz = knowledge.get(prefix + ".read_thread_hertz").to_double();
+  event_driven_reads =
+      knowledge.get(prefix + ".event_driven_reads").is_true();
+  read_batch_size =
+      (uint32_t)knowledge.get(prefix + ".read_batch_size").to_integer();
   max_send_hertz = knowledge.get(prefix + ".max_send_hertz").to_double();
+  batched_sends = knowledge.get(prefix + ".batched_sends").is_true();
 
   containers::StringVector kb_hosts(prefix + ".hosts", knowledge);
 
@@ -185,6 +222,11 @@ void madara::transport::TransportSettings::load(
   no_receiving = knowledge.get(prefix + ".no_receiving").is_true();
   debug_to_kb_prefix =
       knowledge.get(prefix + ".debug_to_kb_prefix").to_string();
+  async_send = knowledge.get(prefix + ".async_send").is_true();
+  send_queue_size =
+      (uint32_t)knowledge.get(prefix + ".send_queue_size").to_integer();
+  send_queue_policy =
+      (uint32_t)knowledge.get(prefix + ".send_queue_policy").to_integer();
 }
 
 void madara::transport::TransportSettings::load_text(
@@ -214,9 +256,23 @@ void madara::transport::TransportSettings::load_text(
 
   send_reduced_message_header =
       knowledge.get(prefix + ".send_reduced_message_header").is_true();
+  intern_keys = knowledge.get(prefix + ".intern_keys").is_true();
+  max_interned_keys =
+      (uint32_t)knowledge.get(prefix + ".max_interned_keys").to_integer();
+  key_definition_interval =
+      (uint32_t)knowledge.get(prefix + ".key_definition_interval").to_integer();
+  array_delta_interval =
+      (uint32_t)knowledge.get(prefix + ".array_delta_interval").to_integer();
+  min_array_delta_size =
+      (uint32_t)knowledge.get(prefix + ".min_array_delta_size").to_integer();
   slack_time = knowledge.get(prefix + ".slack_time").to_double();
   read_thread_hertz = knowledge.get(prefix + ".read_thread_hertz").to_double();
+  event_driven_reads =
+      knowledge.get(prefix + ".event_driven_reads").is_true();
+  read_batch_size =
+      (uint32_t)knowledge.get(prefix + ".read_batch_size").to_integer();
   max_send_hertz = knowledge.get(prefix + ".max_send_hertz").to_double();
+  batched_sends = knowledge.get(prefix + ".batched_sends").is_true();
 
   containers::StringVector kb_hosts(prefix + ".hosts", knowledge);
 
@@ -238,6 +294,11 @@ void madara::transport::TransportSettings::load_text(
   no_receiving = knowledge.get(prefix + ".no_receiving").is_true();
   debug_to_kb_prefix =
       knowledge.get(prefix + ".debug_to_kb_prefix").to_string();
+  async_send = knowledge.get(prefix + ".async_send").is_true();
+  send_queue_size =
+      (uint32_t)knowledge.get(prefix + ".send_queue_size").to_integer();
+  send_queue_policy =
+      (uint32_t)knowledge.get(prefix + ".send_queue_policy").to_integer();
 }
 
 void madara::transport::TransportSettings::save(
@@ -269,9 +330,20 @@ void madara::transport::TransportSettings::save(
 
   knowledge.set(prefix + ".send_reduced_message_header",
       Integer(send_reduced_message_header));
+  knowledge.set(prefix + ".intern_keys", Integer(intern_keys));
+  knowledge.set(prefix + ".max_interned_keys", Integer(max_interned_keys));
+  knowledge.set(
+      prefix + ".key_definition_interval", Integer(key_definition_interval));
+  knowledge.set(
+      prefix + ".array_delta_interval", Integer(array_delta_interval));
+  knowledge.set(
+      prefix + ".min_array_delta_size", Integer(min_array_delta_size));
   knowledge.set(prefix + ".slack_time", slack_time);
   knowledge.set(prefix + ".read_thread_hertz", read_thread_hertz);
+  knowledge.set(prefix + ".event_driven_reads", Integer(event_driven_reads));
+  knowledge.set(prefix + ".read_batch_size", Integer(read_batch_size));
   knowledge.set(prefix + ".max_send_hertz", max_send_hertz);
+  knowledge.set(prefix + ".batched_sends", Integer(batched_sends));
 
   for (size_t i = 0; i < hosts.size(); ++i)
     kb_hosts.set(i, hosts[i]);
@@ -279,6 +351,9 @@ void madara::transport::TransportSettings::save(
   knowledge.set(prefix + ".no_sending", Integer(no_sending));
   knowledge.set(prefix + ".no_receiving", Integer(no_receiving));
   knowledge.set(prefix + ".debug_to_kb_prefix", debug_to_kb_prefix);
+  knowledge.set(prefix + ".async_send", Integer(async_send));
+  knowledge.set(prefix + ".send_queue_size", Integer(send_queue_size));
+  knowledge.set(prefix + ".send_queue_policy", Integer(send_queue_policy));
 
   knowledge::containers::Map kb_read_domains(
       prefix + ".read_domains", knowledge);
@@ -321,9 +396,20 @@ void madara::transport::TransportSettings::save_text(
 
   knowledge.set(prefix + ".send_reduced_message_header",
       Integer(send_reduced_message_header));
+  knowledge.set(prefix + ".intern_keys", Integer(intern_keys));
+  knowledge.set(prefix + ".max_interned_keys", Integer(max_interned_keys));
+  knowledge.set(
+      prefix + ".key_definition_interval", Integer(key_definition_interval));
+  knowledge.set(
+      prefix + ".array_delta_interval", Integer(array_delta_interval));
+  knowledge.set(
+      prefix + ".min_array_delta_size", Integer(min_array_delta_size));
   knowledge.set(prefix + ".slack_time", slack_time);
   knowledge.set(prefix + ".read_thread_hertz", read_thread_hertz);
+  knowledge.set(prefix + ".event_driven_reads", Integer(event_driven_reads));
+  knowledge.set(prefix + ".read_batch_size", Integer(read_batch_size));
   knowledge.set(prefix + ".max_send_hertz", max_send_hertz);
+  knowledge.set(prefix + ".batched_sends", Integer(batched_sends));
 
   for (size_t i = 0; i < hosts.size(); ++i)
     kb_hosts.set(i, hosts[i]);
@@ -331,6 +417,9 @@ void madara::transport::TransportSettings::save_text(
   knowledge.set(prefix + ".no_sending", Integer(no_sending));
   knowledge.set(prefix + ".no_receiving", Integer(no_receiving));
   knowledge.set(prefix + ".debug_to_kb_prefix", debug_to_kb_prefix);
+  knowledge.set(prefix + ".async_send", Integer(async_send));
+  knowledge.set(prefix + ".send_queue_size", Integer(send_queue_size));
+  knowledge.set(prefix + ".send_queue_policy", Integer(send_queue_policy));
 
   knowledge::containers::Map kb_read_domains(
       prefix + ".read_domains", knowledge);
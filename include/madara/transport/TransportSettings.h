@@ -26,6 +26,8 @@
 #include "madara/expression/Interpreter.h"
 #include "madara/MadaraExport.h"
 #include "madara/transport/Fragmentation.h"
+#include "madara/transport/ArrayDeltas.h"
+#include "madara/transport/KeyDictionary.h"
 
 namespace madara
 {
@@ -54,6 +56,23 @@ enum Reliabilities
   RELIABLE = 1
 };
 
+/**
+ * What an asynchronous send queue does with a new batch of updates
+ * when it is already full. See TransportSettings::send_queue_policy.
+ **/
+enum SendQueuePolicies
+{
+  /// merge the new updates into the newest queued batch, by key
+  SEND_QUEUE_COALESCE = 0,
+  /// discard the oldest queued batch to make room
+  SEND_QUEUE_DROP_OLDEST = 1,
+  /// wait until the send thread makes room. The wait happens while
+  /// the knowledge base is locked, so transports with send filters or
+  /// a debug_to_kb_prefix, which need the lock on the send thread, use
+  /// SEND_QUEUE_COALESCE instead
+  SEND_QUEUE_BLOCK = 2
+};
+
 enum Messages
 {
   ASSIGN = 0,
@@ -262,6 +281,40 @@ public:
   /// Map of fragments received by originator
   mutable OriginatorFragmentMap fragment_map;
 
+  /**
+   * If true, updates name variables by small ids interned in
+   * key_dictionary instead of by full name. Works with either message
+   * header. Every receiver must run a MADARA version that understands
+   * interned keys, since older versions drop these messages.
+   **/
+  bool intern_keys = false;
+
+  /// Most keys interned when intern_keys is on. Others are sent by name.
+  uint32_t max_interned_keys = 4096;
+
+  /**
+   * Sends of an interned key between repeated definitions of its id,
+   * which let peers that joined late, or lost a message, learn the key
+   **/
+  uint32_t key_definition_interval = 100;
+
+  /// Keys interned for sending, and learned from peers, by the transport
+  mutable KeyDictionary key_dictionary;
+
+  /**
+   * Sends of a large integer or double array between full values of it.
+   * The sends in between carry only the ranges of elements that changed.
+   * 0 always sends arrays in full. Like intern_keys, every receiver must
+   * run a MADARA version that understands array deltas.
+   **/
+  uint32_t array_delta_interval = 0;
+
+  /// Smallest array, in elements, sent as deltas
+  uint32_t min_array_delta_size = 256;
+
+  /// Arrays last sent by the transport, for array_delta_interval
+  mutable ArrayDeltas array_deltas;
+
   /// Time to sleep between sends and rebroadcasts
   double slack_time = 0;
 
@@ -271,6 +324,17 @@ public:
    **/
   double read_thread_hertz = 0.0;
 
+  /**
+   * If true, read threads sleep until their socket is readable instead
+   * of polling it at read_thread_hertz. Each wakeup drains up to
+   * read_batch_size datagrams and applies them under a single lock of
+   * the knowledge base. Only supported by UDP-based transports.
+   **/
+  bool event_driven_reads = false;
+
+  /// Maximum datagrams an event-driven read thread handles per wakeup
+  uint32_t read_batch_size = 32;
+
   /**
    * Maximum rate of sending messages. This is not a bandwidth limit.
    * This specifically limits the number of times the transport can
@@ -280,6 +344,14 @@ public:
    **/
   double max_send_hertz = 0.0;
 
+  /**
+   * If true, UDP-based transports gather every fragment of a message
+   * for every destination and hand them to the operating system in as
+   * few calls as possible (sendmmsg on Linux). Ignored when slack_time
+   * or max_send_hertz require pauses between individual sends.
+   **/
+  bool batched_sends = false;
+
   /**
    * Host information for transports that require it. The format of these
    * is transport specific, but for UDP, you might have "localhost:1234"
@@ -310,6 +382,21 @@ public:
    **/
   std::string debug_to_kb_prefix = "";
 
+  /**
+   * if true, send_modifieds only copies the modified records into a
+   * bounded queue, and a dedicated thread per transport applies send
+   * filters and performs the network send. This keeps network latency
+   * out of the critical section of the knowledge base.
+   **/
+  bool async_send = false;
+
+  /// Maximum number of batches waiting in the asynchronous send queue
+  uint32_t send_queue_size = 16;
+
+  /// What to do when the asynchronous send queue is full.
+  /// See madara::transport::SendQueuePolicies for options
+  uint32_t send_queue_policy = SEND_QUEUE_COALESCE;
+
 private:
   /**
    * Any acceptable read domain is added here
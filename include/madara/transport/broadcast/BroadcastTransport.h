@@ -41,6 +41,14 @@ class MADARA_EXPORT BroadcastTransport : public UdpTransport
 public:
   using UdpTransport::UdpTransport;
 
+  /**
+   * Destructor
+   **/
+  virtual ~BroadcastTransport()
+  {
+    close();
+  }
+
 protected:
   bool pre_send_buffer(size_t addr_index) override
   {
@@ -27,6 +27,11 @@ MulticastTransport::MulticastTransport(const std::string& id,
     setup();
 }
 
+MulticastTransport::~MulticastTransport()
+{
+  close();
+}
+
 int MulticastTransport::setup_read_thread(double hertz, const std::string& name)
 {
   read_threads_.run(hertz, name, new MulticastTransportReadThread(*this));
@@ -58,6 +58,11 @@ public:
       madara::knowledge::ThreadSafeContext& context, TransportSettings& config,
       bool launch_transport);
 
+  /**
+   * Destructor
+   **/
+  virtual ~MulticastTransport();
+
 protected:
   int setup_read_socket() override;
   int setup_write_socket() override;
@@ -35,6 +35,8 @@ madara::transport::NddsTransport::~NddsTransport()
 void madara::transport::NddsTransport::close(void)
 {
   DDS_ReturnCode_t rc;
+  this->close_send_queue();
+
   this->invalidate_transport();
 
   if (subscriber_)
@@ -313,6 +315,8 @@ long madara::transport::NddsTransport::send_data(
   DDS_InstanceHandle_t handle = update_writer_->register_instance(data);
   rc = update_writer_->write(data, handle);
 
+  settings_.key_dictionary.confirm_sends(rc == DDS_RETCODE_OK);
+
   Ndds_Knowledge_Update_finalize(&data);
 
   return rc;
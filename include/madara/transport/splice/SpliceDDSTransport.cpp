@@ -55,6 +55,8 @@ madara::transport::SpliceDDSTransport::~SpliceDDSTransport()
 
 void madara::transport::SpliceDDSTransport::close(void)
 {
+  this->close_send_queue();
+
   this->invalidate_transport();
 
   read_threads_.terminate();
@@ -434,6 +436,8 @@ long madara::transport::SpliceDDSTransport::send_data(
     handle = update_writer_->register_instance(data);
     dds_result = update_writer_->write(data, handle);
     result = (long)dds_result;
+
+    settings_.key_dictionary.confirm_sends(dds_result == DDS::RETCODE_OK);
     // update_writer_->unregister_instance (data, handle);
   }
 
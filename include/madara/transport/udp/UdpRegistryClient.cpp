@@ -23,6 +23,11 @@ UdpRegistryClient::UdpRegistryClient(const std::string& id,
     setup();
 }
 
+UdpRegistryClient::~UdpRegistryClient()
+{
+  close();
+}
+
 int UdpRegistryClient::setup(void)
 {
   // call base setup method to initialize certain common variables
@@ -49,6 +49,11 @@ public:
       madara::knowledge::ThreadSafeContext& context, TransportSettings& config,
       bool launch_transport);
 
+  /**
+   * Destructor
+   **/
+  virtual ~UdpRegistryClient();
+
   /**
    * Sends register messages to all servers
    **/
@@ -19,6 +19,11 @@ madara::transport::UdpRegistryServer::UdpRegistryServer(const std::string& id,
     setup();
 }
 
+madara::transport::UdpRegistryServer::~UdpRegistryServer()
+{
+  close();
+}
+
 int madara::transport::UdpRegistryServer::setup(void)
 {
   // call base setup method to initialize certain common variables
@@ -42,6 +42,11 @@ public:
       madara::knowledge::ThreadSafeContext& context, TransportSettings& config,
       bool launch_transport);
 
+  /**
+   * Destructor
+   **/
+  virtual ~UdpRegistryServer();
+
   /**
    * Sends a list of knowledge updates to listeners
    * @param   updates listing of all updates that must be sent
@@ -34,6 +34,11 @@ UdpTransport::UdpTransport(const std::string& id,
   }
 }
 
+UdpTransport::~UdpTransport()
+{
+  close();
+}
+
 int UdpTransport::reliability(void) const
 {
   return BEST_EFFORT;
@@ -169,12 +174,122 @@ long UdpTransport::send_buffer(
   return (long)bytes_sent;
 }
 
+long UdpTransport::send_message_batched(const char* buf, size_t packet_size)
+{
+  static const char print_prefix[] = "UdpTransport::send_message_batched";
+
+  uint64_t bytes_sent = 0;
+  FragmentMap map;
+  std::vector<OutgoingDatagram> datagrams;
+  std::vector<long> results;
+
+  if (packet_size > settings_.max_fragment_size)
+  {
+    madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+        "%s:"
+        " fragmenting %" PRIu64 " byte packet (%" PRIu32
+        " bytes is max fragment size)\n",
+        print_prefix, packet_size, settings_.max_fragment_size);
+
+    frag(buf, settings_.max_fragment_size, map);
+  }
+
+  // fragments go out in order, each to every destination
+  datagrams.reserve((map.size() > 0 ? map.size() : 1) * addresses_.size());
+
+  auto add_datagram = [&](const char* datagram, size_t size) {
+    for (size_t i = 0; i < addresses_.size(); ++i)
+    {
+      if (pre_send_buffer(i))
+      {
+        datagrams.push_back(OutgoingDatagram{datagram, size, i});
+      }
+    }
+  };
+
+  if (map.size() > 0)
+  {
+    for (FragmentMap::iterator i = map.begin(); i != map.end(); ++i)
+    {
+      add_datagram(i->second, (size_t)MessageHeader::get_size(i->second));
+    }
+  }
+  else
+  {
+    add_datagram(buf, packet_size);
+  }
+
+  size_t failures = send_datagrams(datagrams, results);
+
+  madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+      "%s:"
+      " Sent %d datagrams with %d failed attempts\n",
+      print_prefix, (int)datagrams.size(), (int)failures);
+
+  size_t successes = 0;
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    if (results[i] >= 0)
+    {
+      bytes_sent += results[i];
+      ++successes;
+    }
+  }
+
+  if (settings_.debug_to_kb_prefix != "")
+  {
+    // like send_buffer, count every attempt as a sent packet
+    sent_packets +=
+        (knowledge::KnowledgeRecord::Integer)(successes + failures);
+    failed_sends += (knowledge::KnowledgeRecord::Integer)failures;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      long actual_sent = results[i];
+
+      if (actual_sent > 0)
+      {
+        sent_data += actual_sent;
+        if (sent_data_max < actual_sent)
+        {
+          sent_data_max = actual_sent;
+        }
+        if (sent_data_min > actual_sent || sent_data_min == 0)
+        {
+          sent_data_min = actual_sent;
+        }
+      }
+    }
+  }
+
+  delete_fragments(map);
+
+  if (bytes_sent > 0)
+  {
+    send_monitor_.add((uint32_t)bytes_sent);
+  }
+
+  madara_logger_log(context_.get_logger(), logger::LOG_MAJOR,
+      "%s:"
+      " Send bandwidth = %" PRIu64 " B/s\n",
+      print_prefix, send_monitor_.get_bytes_per_second());
+
+  return (long)bytes_sent;
+}
+
 long UdpTransport::send_message(const char* buf, size_t packet_size)
 {
   static const char print_prefix[] = "UdpTransport::send_message";
 
   uint64_t bytes_sent = 0;
 
+  if (settings_.batched_sends && settings_.slack_time <= 0 &&
+      settings_.max_send_hertz <= 0)
+  {
+    return send_message_batched(buf, packet_size);
+  }
+
   if (packet_size > settings_.max_fragment_size)
   {
     FragmentMap map;
@@ -269,6 +384,8 @@ long UdpTransport::send_data(
     {
       result = send_message(buffer_.get_ptr(), result);
     }
+
+    settings_.key_dictionary.confirm_sends(result > 0);
   }
 
   return result;
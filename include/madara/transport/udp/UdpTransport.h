@@ -42,6 +42,12 @@ public:
       madara::knowledge::ThreadSafeContext& context, TransportSettings& config,
       bool launch_transport);
 
+  /**
+   * Destructor. Closes the transport before the members the send and
+   * read threads use are destroyed.
+   **/
+  virtual ~UdpTransport();
+
   /**
    * Accesses reliability setting
    * @return  whether we are using reliable dissemination or not
@@ -83,6 +89,15 @@ protected:
   int setup_read_thread(double hertz, const std::string& name) override;
 
   long send_message(const char* buf, size_t size);
+
+  /**
+   * Version of send_message used when settings.batched_sends is true.
+   * Sends all fragments to all destinations through send_datagrams.
+   * @param  buf     the message to send
+   * @param  size    size of the message
+   * @return  total bytes sent
+   **/
+  long send_message_batched(const char* buf, size_t size);
   long send_buffer(const udp::endpoint& target, const char* buf, size_t size);
   virtual bool pre_send_buffer(size_t addr_index)
   {
@@ -2,8 +2,15 @@
 
 #include "madara/utility/Utility.h"
 #include "madara/transport/ReducedMessageHeader.h"
+#include "madara/knowledge/ContextGuard.h"
 
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
 
 namespace madara
 {
@@ -132,6 +139,12 @@ void UdpTransportReadThread::run(void)
     return;
   }
 
+  if (settings_.event_driven_reads)
+  {
+    run_batch();
+    return;
+  }
+
   // allocate a buffer to send
   char* buffer = buffer_.get_ptr();
   static const char print_prefix[] = "UdpTransportReadThread::run";
@@ -186,6 +199,26 @@ void UdpTransportReadThread::run(void)
     return;
   }
 
+  MessageHeader* header = 0;
+  knowledge::KnowledgeMap rebroadcast_records;
+
+  process_datagram(print_prefix, buffer, bytes_read, remote, header,
+      rebroadcast_records);
+
+  finish_datagram(print_prefix, header, rebroadcast_records);
+
+  madara_logger_log(this->context_->get_logger(), logger::LOG_MAJOR,
+      "%s:"
+      " finished iteration.\n",
+      print_prefix);
+}
+
+void UdpTransportReadThread::process_datagram(const char* print_prefix,
+    const char* buffer, size_t bytes_read, const udp::endpoint& remote,
+    MessageHeader*& header, knowledge::KnowledgeMap& rebroadcast_records)
+{
+  const QoSTransportSettings& settings_ = transport_.settings_;
+
   if (settings_.debug_to_kb_prefix != "")
   {
     received_data_ += bytes_read;
@@ -217,15 +250,11 @@ void UdpTransportReadThread::run(void)
         print_prefix, (long long)bytes_read);
   }
 
-  MessageHeader* header = 0;
-
   std::stringstream remote_host;
   remote_host << remote.address().to_string();
   remote_host << ":";
   remote_host << remote.port();
 
-  knowledge::KnowledgeMap rebroadcast_records;
-
   process_received_update(buffer, (uint32_t)bytes_read, transport_.id_,
       *context_, settings_, transport_.send_monitor_,
       transport_.receive_monitor_, rebroadcast_records,
@@ -233,6 +262,12 @@ void UdpTransportReadThread::run(void)
       on_data_received_,
 #endif  // _MADARA_NO_KARL_
       print_prefix, remote_host.str().c_str(), header);
+}
+
+void UdpTransportReadThread::finish_datagram(const char* print_prefix,
+    MessageHeader* header, const knowledge::KnowledgeMap& rebroadcast_records)
+{
+  const QoSTransportSettings& settings_ = transport_.settings_;
 
   if (header)
   {
@@ -248,11 +283,156 @@ void UdpTransportReadThread::run(void)
     // delete header
     delete header;
   }
+}
 
-  madara_logger_log(this->context_->get_logger(), logger::LOG_MAJOR,
-      "%s:"
-      " finished iteration.\n",
-      print_prefix);
+bool UdpTransportReadThread::wait_for_datagrams(int timeout_ms)
+{
+#ifdef _WIN32
+  WSAPOLLFD handle;
+  handle.fd = transport_.socket_.native_handle();
+  handle.events = POLLRDNORM;
+  handle.revents = 0;
+
+  return WSAPoll(&handle, 1, timeout_ms) > 0;
+#else
+  struct pollfd handle;
+  handle.fd = transport_.socket_.native_handle();
+  handle.events = POLLIN;
+  handle.revents = 0;
+
+  return ::poll(&handle, 1, timeout_ms) > 0;
+#endif
+}
+
+size_t UdpTransportReadThread::receive_batch(void)
+{
+  size_t count = 0;
+  size_t slots = batch_sizes_.size();
+
+#ifdef __linux__
+  // one system call for every datagram already queued on the socket
+  for (size_t i = 0; i < slots; ++i)
+  {
+    batch_iovecs_[i].iov_base = &batch_buffer_[i * batch_slot_size_];
+    batch_iovecs_[i].iov_len = batch_slot_size_;
+
+    std::memset(&batch_messages_[i], 0, sizeof(batch_messages_[i]));
+    batch_messages_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+    batch_messages_[i].msg_hdr.msg_iovlen = 1;
+    batch_messages_[i].msg_hdr.msg_name = batch_remotes_[i].data();
+    batch_messages_[i].msg_hdr.msg_namelen =
+        (socklen_t)batch_remotes_[i].capacity();
+  }
+
+  int result = ::recvmmsg(transport_.socket_.native_handle(),
+      batch_messages_.data(), (unsigned int)slots, MSG_DONTWAIT, nullptr);
+
+  if (result > 0)
+  {
+    count = (size_t)result;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      batch_sizes_[i] = batch_messages_[i].msg_len;
+      batch_remotes_[i].resize(batch_messages_[i].msg_hdr.msg_namelen);
+    }
+  }
+#else
+  for (; count < slots; ++count)
+  {
+    boost::system::error_code err;
+    batch_sizes_[count] = transport_.socket_.receive_from(
+        asio::buffer(&batch_buffer_[count * batch_slot_size_],
+            batch_slot_size_),
+        batch_remotes_[count], udp::socket::message_flags{}, err);
+
+    if (err || batch_sizes_[count] == 0)
+    {
+      break;
+    }
+  }
+#endif
+
+  return count;
+}
+
+void UdpTransportReadThread::run_batch(void)
+{
+  const QoSTransportSettings& settings_ = transport_.settings_;
+  static const char print_prefix[] = "UdpTransportReadThread::run_batch";
+
+  if (batch_sizes_.size() == 0)
+  {
+    size_t slots = settings_.read_batch_size > 0 ? settings_.read_batch_size : 1;
+
+    // a datagram can never be larger than this, so there is no point in
+    // giving every slot the full queue_length
+    batch_slot_size_ = std::min<size_t>(settings_.queue_length, 65536);
+
+    batch_buffer_.resize(slots * batch_slot_size_);
+    batch_sizes_.resize(slots);
+    batch_remotes_.resize(slots);
+    batch_headers_.resize(slots);
+    batch_rebroadcasts_.resize(slots);
+
+#ifdef __linux__
+    batch_messages_.resize(slots);
+    batch_iovecs_.resize(slots);
+#endif
+
+    madara_logger_log(this->context_->get_logger(), logger::LOG_MAJOR,
+        "%s:"
+        " handling up to %d datagrams of %d bytes per wakeup\n",
+        print_prefix, (int)slots, (int)batch_slot_size_);
+  }
+
+  // wake up periodically so the thread can notice termination requests
+  if (!wait_for_datagrams(100))
+  {
+    return;
+  }
+
+  size_t count = receive_batch();
+
+  if (count == 0)
+  {
+    madara_logger_log(this->context_->get_logger(), logger::LOG_MINOR,
+        "%s: no bytes to read. Proceeding to next wait\n", print_prefix);
+
+    if (settings_.debug_to_kb_prefix != "")
+    {
+      ++failed_receives_;
+    }
+
+    return;
+  }
+
+  madara_logger_log(this->context_->get_logger(), logger::LOG_MINOR,
+      "%s: received %d datagrams. Applying as one batch\n", print_prefix,
+      (int)count);
+
+  {
+    knowledge::ContextGuard guard(*context_);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      batch_headers_[i] = 0;
+      batch_rebroadcasts_[i].clear();
+
+      if (batch_sizes_[i] > 0)
+      {
+        process_datagram(print_prefix, &batch_buffer_[i * batch_slot_size_],
+            batch_sizes_[i], batch_remotes_[i], batch_headers_[i],
+            batch_rebroadcasts_[i]);
+      }
+    }
+  }
+
+  // rebroadcasts go out after the context is unlocked
+  for (size_t i = 0; i < count; ++i)
+  {
+    finish_datagram(print_prefix, batch_headers_[i], batch_rebroadcasts_[i]);
+  }
 }
 }
 }
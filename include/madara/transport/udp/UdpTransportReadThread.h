@@ -2,6 +2,11 @@
 #define _MADARA_UDP_TRANSPORT_READ_THREAD_H_
 
 #include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
 
 #include "madara/utility/ScopedArray.h"
 #include "madara/knowledge/ThreadSafeContext.h"
@@ -59,6 +64,52 @@ public:
       const knowledge::KnowledgeMap& records);
 
 protected:
+  /**
+   * Updates debug counters and applies one received datagram to the
+   * context
+   * @param  print_prefix     prefix to include before every log message
+   * @param  buffer           the datagram
+   * @param  bytes_read       size of the datagram
+   * @param  remote           the sender of the datagram
+   * @param  header           will contain the message header (or null),
+   *                          to be passed to finish_datagram
+   * @param  rebroadcast_records  filled with records to rebroadcast
+   **/
+  void process_datagram(const char* print_prefix, const char* buffer,
+      size_t bytes_read, const udp::endpoint& remote, MessageHeader*& header,
+      knowledge::KnowledgeMap& rebroadcast_records);
+
+  /**
+   * Rebroadcasts if required and deletes the header of a processed
+   * datagram. Does not need the context lock.
+   * @param  print_prefix     prefix to include before every log message
+   * @param  header           header from process_datagram
+   * @param  rebroadcast_records  records from process_datagram
+   **/
+  void finish_datagram(const char* print_prefix, MessageHeader* header,
+      const knowledge::KnowledgeMap& rebroadcast_records);
+
+  /**
+   * Event-driven version of run. Blocks until the socket is readable,
+   * then drains up to settings.read_batch_size datagrams and applies
+   * them under one context lock.
+   **/
+  void run_batch(void);
+
+  /**
+   * Waits for the socket to become readable
+   * @param  timeout_ms   maximum milliseconds to wait
+   * @return  true if there is data to read
+   **/
+  bool wait_for_datagrams(int timeout_ms);
+
+  /**
+   * Reads every queued datagram that fits into the batch slots, using
+   * recvmmsg where available
+   * @return  the number of datagrams read
+   **/
+  size_t receive_batch(void);
+
   UdpTransport& transport_;
 
   knowledge::ThreadSafeContext* context_ = nullptr;
@@ -85,6 +136,32 @@ protected:
 
   /// min data received
   knowledge::containers::Integer received_data_min_;
+
+  /// receive buffers for event-driven reads, one slot per datagram
+  std::vector<char> batch_buffer_;
+
+  /// size of each slot in batch_buffer_
+  size_t batch_slot_size_ = 0;
+
+  /// bytes received into each slot
+  std::vector<size_t> batch_sizes_;
+
+  /// sender of each slot
+  std::vector<udp::endpoint> batch_remotes_;
+
+  /// headers of the processed datagrams in a batch
+  std::vector<MessageHeader*> batch_headers_;
+
+  /// records to rebroadcast for each datagram in a batch
+  std::vector<knowledge::KnowledgeMap> batch_rebroadcasts_;
+
+#ifdef __linux__
+  /// recvmmsg message headers, one per slot
+  std::vector<struct mmsghdr> batch_messages_;
+
+  /// recvmmsg buffer descriptors, one per slot
+  std::vector<struct iovec> batch_iovecs_;
+#endif
 };
 }
 }
@@ -53,6 +53,8 @@ madara::transport::ZMQTransport::~ZMQTransport()
 
 void madara::transport::ZMQTransport::close(void)
 {
+  this->close_send_queue();
+
   this->invalidate_transport();
 
   if (write_socket_ != 0)
@@ -271,6 +273,8 @@ long madara::transport::ZMQTransport::send_data(
       result = (long)zmq_send(
           write_socket_, (void*)buffer_.get_ptr(), (size_t)result, 0);
 
+      settings_.key_dictionary.confirm_sends(result > 0);
+
       if (result > 0)
       {
         if (settings_.debug_to_kb_prefix != "")
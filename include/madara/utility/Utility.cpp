@@ -6,6 +6,13 @@
 #include <sstream>
 #include <fstream>
 #include <thread>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "madara/logger/GlobalLogger.h"
 #include "madara/utility/Utility.h"
@@ -387,6 +394,67 @@ char* get_var(const std::string& source, size_t cur, size_t& end)
   return getenv(source.substr(cur, source.size() - cur).c_str());
 }
 
+void endian_swap_64(void* target, const void* source, size_t count)
+{
+  if (endian_is_little())
+  {
+    byte_swap_64(target, source, count);
+  }
+  else if (count > 0)
+  {
+    memcpy(target, source, count * sizeof(uint64_t));
+  }
+}
+
+void byte_swap_64(void* target, const void* source, size_t count)
+{
+  char* dest = (char*)target;
+  const char* src = (const char*)source;
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  // reverses the bytes within each 64 bit lane
+  const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14,
+      13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9,
+      8);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    __m256i values = _mm256_loadu_si256((const __m256i*)(src + i * 8));
+    values = _mm256_shuffle_epi8(values, reverse);
+    _mm256_storeu_si256((__m256i*)(dest + i * 8), values);
+  }
+#endif  // __AVX2__
+
+#if defined(__SSE2__)
+  for (; i + 2 <= count; i += 2)
+  {
+    __m128i values = _mm_loadu_si128((const __m128i*)(src + i * 8));
+
+    // swap the bytes of each 16 bit word, then reverse the words
+    values = _mm_or_si128(_mm_slli_epi16(values, 8), _mm_srli_epi16(values, 8));
+    values = _mm_shufflelo_epi16(values, _MM_SHUFFLE(0, 1, 2, 3));
+    values = _mm_shufflehi_epi16(values, _MM_SHUFFLE(0, 1, 2, 3));
+
+    _mm_storeu_si128((__m128i*)(dest + i * 8), values);
+  }
+#endif  // __SSE2__
+
+  for (; i < count; ++i)
+  {
+    uint64_t value;
+    memcpy(&value, src + i * 8, sizeof(value));
+
+    value = ((value << 8) & 0xFF00FF00FF00FF00ULL) |
+            ((value >> 8) & 0x00FF00FF00FF00FFULL);
+    value = ((value << 16) & 0xFFFF0000FFFF0000ULL) |
+            ((value >> 16) & 0x0000FFFF0000FFFFULL);
+    value = (value << 32) | (value >> 32);
+
+    memcpy(dest + i * 8, &value, sizeof(value));
+  }
+}
+
 std::string clean_dir_name(const std::string& source)
 {
 // define the characters we'll want to replace
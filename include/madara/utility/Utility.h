@@ -337,6 +337,28 @@ int16_t endian_swap(int16_t value);
  **/
 double endian_swap(double value);
 
+/**
+ * Copies 64 bit values, such as integer or double arrays, converting
+ * each between host and network form as endian_swap would. Hosts that
+ * need no conversion copy the values in bulk.
+ * @param     target     where to write the converted values
+ * @param     source     the values to convert. May be unaligned, but must
+ *                       not overlap target.
+ * @param     count      the number of 64 bit values
+ **/
+MADARA_EXPORT void endian_swap_64(
+    void* target, const void* source, size_t count);
+
+/**
+ * Copies 64 bit values, reversing the order of the bytes of each. Uses
+ * AVX2 or SSE2 instructions when the build enables them.
+ * @param     target     where to write the reversed values
+ * @param     source     the values to reverse. May be unaligned, but must
+ *                       not overlap target.
+ * @param     count      the number of 64 bit values
+ **/
+MADARA_EXPORT void byte_swap_64(void* target, const void* source, size_t count);
+
 /**
  * Reads a file into a provided void pointer. The void pointer will point
  * to an allocated buffer that the user will need to delete.
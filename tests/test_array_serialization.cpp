@@ -0,0 +1,242 @@
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <string.h>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/Timer.h"
+
+#include "test.h"
+
+namespace knowledge = madara::knowledge;
+namespace logger = madara::logger;
+namespace utility = madara::utility;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+typedef std::chrono::steady_clock Clock;
+
+// times each serialization is repeated
+uint32_t num_iterations = 20;
+
+// where save_context and load_context are timed
+std::string filename = "/tmp/madara_test_array_serialization.kb";
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-i" || arg1 == "--iterations")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_iterations;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-f" || arg1 == "--file")
+    {
+      if (i + 1 < argc)
+      {
+        filename = argv[i + 1];
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Tests the byte order conversion of integer and double arrays\n"
+          "  and reports how long arrays take to serialize.\n\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-i|--iterations num]    times to repeat each serialization\n"
+          " [-f|--file file]         file to save and load contexts with\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
+
+/**
+ * Converts values one at a time, as arrays were serialized before
+ **/
+void scalar_swap(char* target, const char* source, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint64_t cur;
+    memcpy(&cur, source + i * sizeof(cur), sizeof(cur));
+    cur = utility::endian_swap(cur);
+    memcpy(target + i * sizeof(cur), &cur, sizeof(cur));
+  }
+}
+
+void test_swap(void)
+{
+  log("Testing bulk conversion against endian_swap\n");
+
+  std::vector<char> source(17 * 8 + 1), target(17 * 8 + 1),
+      expected(17 * 8 + 1);
+
+  for (size_t i = 0; i < source.size(); ++i)
+  {
+    source[i] = (char)(i * 7 + 3);
+  }
+
+  // every count that leaves a remainder for each vector width, read from
+  // and written to unaligned addresses
+  for (size_t count = 0; count <= 17; ++count)
+  {
+    scalar_swap(expected.data() + 1, source.data() + 1, count);
+    utility::endian_swap_64(target.data() + 1, source.data() + 1, count);
+
+    TEST_EQ(memcmp(target.data() + 1, expected.data() + 1, count * 8), 0);
+  }
+
+  uint64_t value = 0x0102030405060708ULL, swapped = 0;
+  utility::byte_swap_64(&swapped, &value, 1);
+
+  TEST_EQ(swapped, 0x0807060504030201ULL);
+
+  // swapping twice restores the values
+  utility::byte_swap_64(target.data(), source.data(), 17);
+  utility::byte_swap_64(expected.data(), target.data(), 17);
+
+  TEST_EQ(memcmp(expected.data(), source.data(), 17 * 8), 0);
+}
+
+/**
+ * Writes and reads an array, reporting the time each takes
+ **/
+template<typename T>
+void test_array(const char* name, size_t size)
+{
+  std::vector<T> values(size);
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    values[i] = (T)(i * 3) + (T)1;
+  }
+
+  knowledge::KnowledgeRecord record(values), result;
+
+  std::vector<char> buffer(record.get_encoded_size() + 16);
+  std::vector<char> reference(size * sizeof(T));
+
+  utility::Timer<Clock> write_timer, read_timer, scalar_timer;
+
+  write_timer.start();
+  for (uint32_t i = 0; i < num_iterations; ++i)
+  {
+    int64_t remaining = (int64_t)buffer.size();
+    record.write(buffer.data(), remaining);
+  }
+  write_timer.stop();
+
+  read_timer.start();
+  for (uint32_t i = 0; i < num_iterations; ++i)
+  {
+    int64_t remaining = (int64_t)buffer.size();
+    result.read(buffer.data(), remaining);
+  }
+  read_timer.stop();
+
+  scalar_timer.start();
+  for (uint32_t i = 0; i < num_iterations; ++i)
+  {
+    scalar_swap(reference.data(), (const char*)values.data(), size);
+  }
+  scalar_timer.stop();
+
+  TEST_EQ(result.type(), record.type());
+  TEST_EQ(result.size(), (uint32_t)size);
+  TEST_EQ(result.to_doubles() == record.to_doubles(), true);
+
+  log("  %s[%d]: write %d ns, read %d ns, per-element loop %d ns\n", name,
+      (int)size, (int)(write_timer.duration_ns() / num_iterations),
+      (int)(read_timer.duration_ns() / num_iterations),
+      (int)(scalar_timer.duration_ns() / num_iterations));
+}
+
+void test_context(size_t size)
+{
+  knowledge::KnowledgeBase kb, loaded;
+
+  kb.set("integers", std::vector<Integer>(size, 12345));
+  kb.set("doubles", std::vector<double>(size, 1.25));
+
+  knowledge::CheckpointSettings settings;
+  settings.filename = filename;
+  settings.buffer_size = size * 2 * sizeof(double) + 100000;
+
+  utility::Timer<Clock> save_timer, load_timer;
+
+  save_timer.start();
+  kb.save_context(settings);
+  save_timer.stop();
+
+  load_timer.start();
+  loaded.load_context(settings);
+  load_timer.stop();
+
+  TEST_EQ(loaded.get("integers").size(), (uint32_t)size);
+  TEST_EQ(loaded.get("doubles").retrieve_index(size - 1).to_double(), 1.25);
+
+  log("  save_context: %d us, load_context: %d us for 2 x %d elements\n",
+      (int)(save_timer.duration_ns() / 1000),
+      (int)(load_timer.duration_ns() / 1000), (int)size);
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  test_swap();
+
+  log("Testing array serialization\n");
+
+  for (size_t size : {1000, 100000, 1000000})
+  {
+    test_array<Integer>("integers", size);
+    test_array<double>("doubles", size);
+  }
+
+  log("Testing checkpoints of arrays\n");
+
+  test_context(1000000);
+
+  if (madara_tests_fail_count > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_tests_fail_count
+              << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_tests_fail_count;
+}
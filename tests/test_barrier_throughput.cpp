@@ -0,0 +1,318 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <memory>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/containers/Barrier.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/Timer.h"
+
+namespace logger = madara::logger;
+namespace knowledge = madara::knowledge;
+namespace containers = knowledge::containers;
+
+typedef std::chrono::steady_clock Clock;
+
+// default settings
+uint32_t num_participants = 256;
+uint32_t num_rounds = 10;
+uint32_t fanout = 8;
+
+int madara_fails(0);
+
+void handle_arguments(int argc, char* argv[]);
+
+// how participants check the barrier
+enum BarrierMode
+{
+  EXPRESSION,
+  AGGREGATE,
+  TREE
+};
+
+// the measurements of a run
+struct Result
+{
+  // time spent checking the barrier
+  uint64_t check_ns;
+
+  // number of barrier checks
+  uint64_t checks;
+
+  // number of passes over all participants until everyone was done
+  uint64_t passes;
+};
+
+typedef std::vector<std::unique_ptr<knowledge::KnowledgeBase>> Participants;
+
+/**
+ * Simulates a broadcast transport by copying the modified variables of a
+ * participant into the knowledge bases of all other participants
+ **/
+void deliver(Participants& participants, size_t sender)
+{
+  knowledge::ThreadSafeContext& context = participants[sender]->get_context();
+  knowledge::VariableReferences modifieds = context.save_modifieds();
+
+  for (const knowledge::VariableReference& ref : modifieds)
+  {
+    knowledge::KnowledgeRecord record = context.get(ref);
+
+    for (size_t i = 0; i < participants.size(); ++i)
+    {
+      if (i != sender)
+      {
+        participants[i]->get_context().update_record_from_external(
+            ref.get_name(), record);
+      }
+    }
+  }
+
+  context.reset_modified();
+}
+
+/**
+ * Builds the logic the barrier evaluated before it kept the minimum
+ * round, which compares every round variable to the participant's
+ **/
+std::string barrier_logic(size_t id, size_t participants)
+{
+  std::stringstream buffer;
+
+  for (size_t i = 0; i < participants; ++i)
+  {
+    if (i > 0)
+      buffer << " && ";
+
+    buffer << "barrier." << i << " >= barrier." << id;
+  }
+
+  return buffer.str();
+}
+
+Result run_test(size_t size, BarrierMode mode)
+{
+  Participants participants;
+  std::vector<std::unique_ptr<containers::Barrier>> barriers;
+  std::vector<knowledge::CompiledExpression> logic;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    participants.emplace_back(new knowledge::KnowledgeBase());
+    barriers.emplace_back(new containers::Barrier(
+        "barrier", *participants[i], (int)i, (int)size));
+
+    if (mode == TREE)
+      barriers[i]->set_fanout(fanout);
+    else if (mode == EXPRESSION)
+      logic.push_back(participants[i]->compile(barrier_logic(i, size)));
+
+    deliver(participants, i);
+  }
+
+  // barriers read the round variables on their first check, which should
+  // not count toward the time of a check
+  if (mode != EXPRESSION)
+  {
+    for (size_t i = 0; i < size; ++i)
+      barriers[i]->is_done();
+  }
+
+  Result result = {0, 0, 0};
+  madara::utility::Timer<Clock> timer;
+
+  for (uint32_t round = 0; round < num_rounds; ++round)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      barriers[i]->next();
+      deliver(participants, i);
+
+      // the first participant must wait for everyone else
+      if (i == 0 && size > 1 && mode != EXPRESSION && barriers[0]->is_done())
+      {
+        std::cerr << "FAIL: participant 0 passed round " << round + 1
+                  << " alone.\n";
+        ++madara_fails;
+      }
+    }
+
+    bool all_done = false;
+
+    while (!all_done)
+    {
+      all_done = true;
+      ++result.passes;
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        bool done;
+
+        timer.start();
+
+        if (mode == EXPRESSION)
+          done = participants[i]->evaluate(logic[i]).is_true();
+        else
+          done = barriers[i]->is_done();
+
+        timer.stop();
+
+        result.check_ns += timer.duration_ns();
+        ++result.checks;
+
+        if (!done)
+          all_done = false;
+
+        deliver(participants, i);
+      }
+    }
+  }
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  handle_arguments(argc, argv);
+
+#ifndef _MADARA_NO_KARL_
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing barriers with simulated participants for MADARA v%s\n"
+      "  rounds per run: %d, tree fan-out: %d\n\n",
+      madara::utility::get_version().c_str(), num_rounds, fanout);
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      " participants       ns per check (passes per round)\n"
+      "                   expression      aggregate           tree\n"
+      "==============================================================\n");
+
+  for (uint32_t size = 2; size <= num_participants; size *= 2)
+  {
+    std::stringstream buffer;
+    std::locale loc("C");
+    buffer.imbue(loc);
+
+    buffer << " " << std::setw(12) << size;
+
+    for (BarrierMode mode : {EXPRESSION, AGGREGATE, TREE})
+    {
+      Result result = run_test(size, mode);
+
+      std::stringstream cell;
+      cell.imbue(loc);
+      cell << result.check_ns / (result.checks ? result.checks : 1) << " ("
+           << result.passes / num_rounds << ")";
+
+      buffer << " " << std::setw(14) << cell.str();
+    }
+
+    buffer << "\n";
+
+    madara_logger_ptr_log(
+        logger::global_logger.get(), logger::LOG_ALWAYS, buffer.str().c_str());
+
+    // make sure the largest participant count is always measured
+    if (size < num_participants && size * 2 > num_participants)
+      size = num_participants / 2;
+  }
+#else
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "This test is disabled due to karl feature being disabled.\n");
+#endif
+
+  if (madara_fails > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_fails << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_fails;
+}
+
+void handle_arguments(int argc, char* argv[])
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-f" || arg1 == "--logfile")
+    {
+      if (i + 1 < argc)
+      {
+        logger::global_logger->add_file(argv[i + 1]);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-k" || arg1 == "--fanout")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> fanout;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--participants")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_participants;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-r" || arg1 == "--rounds")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_rounds;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Simulates barrier rounds between participants with their own\n"
+          "  knowledge bases, copying each participant's updates to all\n"
+          "  others. Compares the logic the barrier used to evaluate, which\n"
+          "  reads every round variable, with the minimum the barrier now\n"
+          "  keeps, and with participants arranged in a tree.\n\n"
+          " [-f|--logfile file]      log to a file\n"
+          " [-k|--fanout num]        children per participant in the tree "
+          "(default: 8)\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--participants num]  maximum number of participants "
+          "(default: 256)\n"
+          " [-r|--rounds num]        barrier rounds per run (default: 10)\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
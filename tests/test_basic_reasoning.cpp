@@ -4,6 +4,7 @@
 #include <iostream>
 #include <assert.h>
 #include <math.h>
+#include <stdlib.h>
 
 #include "madara/knowledge/KnowledgeBase.h"
 #include "madara/logger/GlobalLogger.h"
@@ -73,6 +74,18 @@ madara::knowledge::KnowledgeRecord set_var1_to_arg2(
   return variables.get(".var1");
 }
 
+double distance(double x, double y)
+{
+  return sqrt(x * x + y * y);
+}
+
+int64_t native_total = 0;
+
+void add_to_total(int64_t value)
+{
+  native_total += value;
+}
+
 madara::knowledge::KnowledgeRecord check_vector(
     madara::knowledge::FunctionArguments&,
     madara::knowledge::Variables& variables)
@@ -169,6 +182,12 @@ void test_functions(madara::knowledge::KnowledgeBase& knowledge);
 void test_for_loops(madara::knowledge::KnowledgeBase& knowledge);
 void test_simplification_operators(madara::knowledge::KnowledgeBase& knowledge);
 void test_to_string(void);
+void test_bytecode(void);
+void test_expression_cache(void);
+void test_key_expansion(void);
+void test_parallel_for_loop(void);
+void test_reactive_rules(void);
+void test_expression_profile(void);
 
 #endif  // _MADARA_NO_KARL_
 
@@ -208,6 +227,12 @@ int main(int argc, char* argv[])
   test_to_string();
   test_get_matches(knowledge);
   test_record_math();
+  test_bytecode();
+  test_expression_cache();
+  test_key_expansion();
+  test_parallel_for_loop();
+  test_reactive_rules();
+  test_expression_profile();
 
   knowledge.print();
 
@@ -1126,6 +1151,279 @@ void test_implies(madara::knowledge::KnowledgeBase& knowledge)
          knowledge.get(".var3").to_integer() == 1);
 }
 
+/// Tests that bytecode evaluates as the expression tree does
+void test_bytecode(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing bytecode against the expression tree\n");
+
+  const char* expressions[] = {"++.x; .y = .x * 3 + 2 - .z / 2 % 3",
+      ".y = .x + .d + .s; .z = .s + .x", ".x = .d * 2; .y = -.x; .z = !.x",
+      ".y = (.x < 3) + (.x <= 3) * 2 + (.x > 3) * 4 + (.x >= 3) * 8",
+      ".y = (.x == .d) + (.x != .s) * 2 + (.s == \"hello\") * 4",
+      ".y = .x && .d && .s; .z = .x && .missing && ++.w",
+      ".y = .missing || .none; .z = .missing || .x || ++.w",
+      ".y = (.x = 4 ; .z = 2); .w = ((.x = 5) && (.z = 7))",
+      ".y = (.x ; .d ; .s); .z = (.s && .d)", "--.x; --.x => ++.y",
+      ".x => .y = 9; .missing => .z = 9; .w = (.x => 0)",
+      ".arr[1] = .x + 1; .y = .arr[1] * .arr[0]",
+      ".i = 1; var{.i} = .x + 1; .y = var{.i} * 2",
+      "++.count; .a1 = .count + 1; .a2 = .a1 + 1; .a3 = .a2 + .a1",
+      ".y = #size (.arr) + .x; .z = .s + #to_string (.x)", ".k = 3 * 4 + .x",
+      ".y = .d / 0.5 - .x * .d; .z = .x / .d"};
+
+  for (const char* logic : expressions)
+  {
+    madara::knowledge::KnowledgeBase tree, bytecode;
+
+    for (madara::knowledge::KnowledgeBase* kb : {&tree, &bytecode})
+    {
+      kb->set(".x", madara::knowledge::KnowledgeRecord::Integer(3));
+      kb->set(".z", madara::knowledge::KnowledgeRecord::Integer(7));
+      kb->set(".d", 2.5);
+      kb->set(".s", "hello");
+      kb->set(".arr", std::vector<madara::knowledge::KnowledgeRecord::Integer>(
+                          {1, 2, 3}));
+    }
+
+    madara::knowledge::CompiledExpression tree_ce = tree.compile(logic);
+    madara::knowledge::CompiledExpression bytecode_ce =
+        bytecode.compile(logic);
+
+    bytecode_ce.compile_bytecode();
+    assert(bytecode_ce.has_bytecode() && !tree_ce.has_bytecode());
+
+    // evaluate twice, so variables changed in the first pass are read
+    for (int i = 0; i < 2; ++i)
+    {
+      madara::knowledge::KnowledgeRecord tree_result = tree.evaluate(tree_ce);
+      madara::knowledge::KnowledgeRecord bytecode_result =
+          bytecode.evaluate(bytecode_ce);
+
+      if (tree_result.type() != bytecode_result.type() ||
+          tree_result.to_string() != bytecode_result.to_string())
+      {
+        madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+            "  FAIL: %s returned %s with the tree and %s with bytecode\n",
+            logic, tree_result.to_string().c_str(),
+            bytecode_result.to_string().c_str());
+      }
+
+      assert(tree_result.type() == bytecode_result.type());
+      assert(tree_result.to_string() == bytecode_result.to_string());
+    }
+
+    madara::knowledge::KnowledgeMap tree_map = tree.to_map("");
+    madara::knowledge::KnowledgeMap bytecode_map = bytecode.to_map("");
+
+    assert(tree_map.size() == bytecode_map.size());
+
+    for (auto i = tree_map.begin(), j = bytecode_map.begin();
+         i != tree_map.end(); ++i, ++j)
+    {
+      assert(i->first == j->first);
+      assert(i->second.type() == j->second.type());
+      assert(i->second.to_string() == j->second.to_string());
+    }
+  }
+}
+
+void test_expression_cache(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing the bounded expression cache\n");
+
+  madara::knowledge::KnowledgeBase kb;
+  madara::expression::ExpressionCacheStats stats;
+
+  kb.set_expression_cache_capacity(2);
+  kb.reset_expression_cache_stats();
+
+  madara::knowledge::CompiledExpression first = kb.compile(".x = 1");
+  kb.compile(".x = 2");
+  kb.compile(".x = 1");
+
+  stats = kb.get_expression_cache_stats();
+  assert(stats.capacity == 2 && stats.size == 2);
+  assert(stats.hits == 1 && stats.misses == 2 && stats.evictions == 0);
+
+  // .x = 2 is the least recently used and is dropped
+  kb.compile(".x = 3");
+
+  stats = kb.get_expression_cache_stats();
+  assert(stats.size == 2 && stats.misses == 3 && stats.evictions == 1);
+
+  kb.compile(".x = 1");
+  kb.compile(".x = 2");
+
+  stats = kb.get_expression_cache_stats();
+  assert(stats.hits == 2 && stats.misses == 4 && stats.evictions == 2);
+
+  // trees handed out stay valid after they are evicted
+  kb.compile(".x = 4");
+  kb.compile(".x = 5");
+  assert(kb.evaluate(first).to_integer() == 1);
+  assert(kb.get(".x").to_integer() == 1);
+
+  // generated strings stay within capacity
+  for (int i = 0; i < 100; ++i)
+  {
+    kb.evaluate(".y = " + std::to_string(i));
+  }
+
+  stats = kb.get_expression_cache_stats();
+  assert(stats.size == 2 && kb.get(".y").to_integer() == 99);
+
+  assert(kb.get_context().delete_expression(".y = 99"));
+  assert(!kb.get_context().delete_expression(".y = 0"));
+  assert(kb.get_expression_cache_stats().size == 1);
+
+  // shrinking the cache evicts, and 0 removes the limit
+  kb.set_expression_cache_capacity(0);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    kb.compile(".z = " + std::to_string(i));
+  }
+
+  assert(kb.get_expression_cache_stats().size == 101);
+
+  kb.set_expression_cache_capacity(10);
+  stats = kb.get_expression_cache_stats();
+  assert(stats.size == 10 && stats.capacity == 10);
+
+  kb.reset_expression_cache_stats();
+  stats = kb.get_expression_cache_stats();
+  assert(stats.hits == 0 && stats.misses == 0 && stats.evictions == 0);
+  assert(stats.size == 10);
+}
+
+void test_key_expansion(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing cached key expansion\n");
+
+  madara::knowledge::KnowledgeBase kb;
+
+  // the same expansions are written and then read
+  kb.evaluate(".i[0->100) (agent{.i}.pos = .i * 2)");
+  kb.evaluate(".sum = 0; .i[0->100) (.sum = .sum + agent{.i}.pos)");
+  assert(kb.get("agent50.pos").to_integer() == 100);
+  assert(kb.get(".sum").to_integer() == 9900);
+
+  // reading a missing variable does not create it
+  kb.set(".i", madara::knowledge::KnowledgeRecord::Integer(500));
+  kb.evaluate(".x = agent{.i}.pos");
+  assert(!kb.exists("agent500.pos"));
+
+  kb.evaluate("++agent{.i}.count; ++agent{.i}.count; --agent{.i}.count");
+  assert(kb.get("agent500.count").to_integer() == 1);
+
+  kb.evaluate(".j = 1; arr{.j}[2] = 7; ++arr{.j}[2]; .y = arr{.j}[2]");
+  assert(kb.get(".y").to_integer() == 8);
+  assert(kb.get("arr1").retrieve_index(2).to_integer() == 8);
+
+  // erased variables are not read through stale references
+  kb.set(".i", madara::knowledge::KnowledgeRecord::Integer(5));
+  assert(kb.evaluate("agent{.i}.pos").to_integer() == 10);
+  kb.get_context().delete_variable("agent5.pos");
+  assert(!kb.evaluate("agent{.i}.pos").exists());
+  assert(!kb.exists("agent5.pos"));
+  kb.evaluate("agent{.i}.pos = 3");
+  assert(kb.get("agent5.pos").to_integer() == 3);
+
+  kb.clear(true);
+  kb.evaluate(".i = 5; agent{.i}.pos = 4; .z = agent{.i}.pos");
+  assert(kb.get("agent5.pos").to_integer() == 4);
+  assert(kb.get(".z").to_integer() == 4);
+
+  // other values expand without the cache
+  kb.evaluate(".name = 'bob'; agent{.name}.pos = 1; .w = agent{.name}.pos");
+  assert(kb.get("agentbob.pos").to_integer() == 1);
+  assert(kb.get(".w").to_integer() == 1);
+}
+
+madara::knowledge::KnowledgeRecord parallel_twice(
+    madara::knowledge::FunctionArguments& args, madara::knowledge::Variables&)
+{
+  return madara::knowledge::KnowledgeRecord(args[0].to_integer() * 2);
+}
+
+void test_parallel_for_loop(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing parallel for loops\n");
+
+  typedef madara::knowledge::KnowledgeRecord::Integer Integer;
+
+  // use threads even on a single core
+#ifdef _WIN32
+  _putenv_s("MADARA_PARALLEL_THREADS", "4");
+#else
+  setenv("MADARA_PARALLEL_THREADS", "4", 0);
+#endif
+
+  madara::knowledge::KnowledgeBase kb;
+
+  kb.evaluate(".i[0->1000) (agent{.i}.x = .i)");
+  kb.set(".bias", Integer(5));
+  kb.get_context().reset_modified();
+
+  // each iteration reads and writes its own agent, plus a shared local
+  madara::knowledge::KnowledgeRecord result = kb.evaluate(
+      ".i[0->1000).parallel (agent{.i}.score = agent{.i}.x * 2 + .bias)");
+  assert(result.to_integer() == 1000);
+  assert(kb.get(".i").to_integer() == 1000);
+
+  bool correct = true;
+  for (Integer i = 0; i < 1000; ++i)
+  {
+    std::string name = "agent" + std::to_string(i) + ".score";
+    correct = correct && kb.get(name).to_integer() == i * 2 + 5;
+  }
+  assert(correct);
+
+  // the changed globals are marked once, as a sequential loop would
+  assert(kb.get_context().get_modifieds().size() == 1000);
+
+  // the same results as the sequential loop, with steps and bounds
+  kb.evaluate(".j[0-3>30] (seq{.j} = .j * .j)");
+  result = kb.evaluate(".j[0-3>30].parallel (par{.j} = .j * .j)");
+  assert(result.to_integer() == 11);
+  assert(kb.get(".j").to_integer() == 33);
+  assert(kb.get("par30").to_integer() == 900);
+  assert(kb.to_map("par").size() == kb.to_map("seq").size());
+
+  // locals written by the body stay private
+  kb.evaluate(".tmp = 7; .i[0->100).parallel (.tmp = .i; out{.i} = .tmp)");
+  assert(kb.get(".tmp").to_integer() == 7);
+  assert(kb.get("out42").to_integer() == 42);
+
+  // the last iteration to write a global wins
+  kb.evaluate(".i[0->100).parallel (last = .i)");
+  assert(kb.get("last").to_integer() == 99);
+
+  // C++ functions can be called from the body
+  kb.define_function("twice", parallel_twice);
+  kb.evaluate(".i[0->50).parallel (doubled{.i} = twice (.i))");
+  assert(kb.get("doubled49").to_integer() == 98);
+
+  // loops that call KaRL functions, or are not over integers, still work
+  kb.define_function("triple_i", ".i * 3");
+  kb.evaluate(".i[0->50).parallel (tripled{.i} = triple_i ())");
+  assert(kb.get("tripled49").to_integer() == 147);
+
+  kb.set(".end", 2.5);
+  result = kb.evaluate(".i[0->.end).parallel (halves{.i} = 1)");
+  assert(result.to_integer() == 3);
+
+  // nested parallel loops run the inner loop in the outer loop's threads
+  kb.evaluate(".i[0->8).parallel "
+              "(.k[0->8).parallel (grid{.i}.{.k} = .i * .k))");
+  assert(kb.get("grid7.6").to_integer() == 42);
+  assert(kb.to_map("grid").size() == 64);
+}
+
 /// Tests the math ops (+, -, *, /)
 void test_mathops(madara::knowledge::KnowledgeBase& knowledge)
 {
@@ -1429,6 +1727,54 @@ void test_functions(madara::knowledge::KnowledgeBase& knowledge)
   knowledge.define_function("function1", return_named_1);
   result = knowledge.evaluate(".var2 = function1()");
   assert(result.to_integer() == 1);
+
+  // test functions with native argument and return types
+  knowledge.print("Testing native typed functions...\n");
+  knowledge.define_function<double(double, double)>("distance", distance);
+  result = knowledge.evaluate("distance (3, 4)");
+  assert(result.is_double_type() && result.to_double() == 5.0);
+
+  // missing arguments are empty, and extra arguments are ignored
+  assert(knowledge.evaluate("distance (3)").to_double() == 3.0);
+  assert(knowledge.evaluate("distance (3, 4, 12)").to_double() == 5.0);
+
+  knowledge.define_function<std::string(const std::string&, int)>(
+      "repeat", [](const std::string& text, int count) {
+        std::string repeated;
+        for (int i = 0; i < count; ++i)
+          repeated += text;
+        return repeated;
+      });
+  result = knowledge.evaluate("repeat ('ab', 3)");
+  assert(result == "ababab");
+
+  knowledge.set("samples", std::vector<double>{1.5, 2.5, 3});
+  knowledge.define_function<double(const std::vector<double>&)>(
+      "total", [](const std::vector<double>& values) {
+        double sum = 0;
+        for (double value : values)
+          sum += value;
+        return sum;
+      });
+  assert(knowledge.evaluate("total (samples)").to_double() == 7.0);
+
+  // functions without results return an empty record
+  knowledge.define_function<void(int64_t)>("add_to_total", add_to_total);
+  result = knowledge.evaluate(".i[0->10) (add_to_total (.i))");
+  assert(native_total == 45);
+
+  // reusing the argument storage of a node across calls
+  madara::knowledge::CompiledExpression compiled =
+      knowledge.compile("distance (.x, .y)");
+  knowledge.set(".x", 6.0);
+  knowledge.set(".y", 8.0);
+  assert(knowledge.evaluate(compiled).to_double() == 10.0);
+  knowledge.set(".y", 0.0);
+  assert(knowledge.evaluate(compiled).to_double() == 6.0);
+
+  // redefining a native function as an extern function
+  knowledge.define_function("distance", return_2);
+  assert(knowledge.evaluate(compiled).to_integer() == 2);
 }
 
 /// Test the ability to use for loops
@@ -1512,6 +1858,144 @@ void test_simplification_operators(madara::knowledge::KnowledgeBase& knowledge)
   assert(result.to_integer() == 200 && knowledge.get(".i").to_integer() == 5);
 }
 
+void test_reactive_rules(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing reactive rules\n");
+
+  madara::knowledge::KnowledgeBase kb;
+
+  kb.set("speed", madara::knowledge::KnowledgeRecord::Integer(3));
+  kb.set("time", madara::knowledge::KnowledgeRecord::Integer(4));
+  kb.set("limit", madara::knowledge::KnowledgeRecord::Integer(10));
+
+  size_t distance = kb.add_rule("distance = speed * time");
+  size_t too_far = kb.add_rule("too_far = distance > limit");
+  size_t alarm = kb.add_rule("alarms += too_far");
+
+  // every rule is evaluated the first time
+  assert(kb.evaluate_rules() == 3);
+  assert(kb.get("distance").to_integer() == 12);
+  assert(kb.get("too_far").to_integer() == 1);
+  assert(kb.get("alarms").to_integer() == 1);
+  assert(kb.get_rule_result(distance).to_integer() == 12);
+
+  // nothing changed, so nothing is evaluated, including the rule that
+  // changed its own input
+  assert(kb.evaluate_rules() == 0);
+  assert(kb.get("alarms").to_integer() == 1);
+
+  // a change is propagated to the rules that read it, in order
+  kb.set("limit", madara::knowledge::KnowledgeRecord::Integer(20));
+  assert(kb.evaluate_rules() == 2);
+  assert(kb.get("too_far").to_integer() == 0);
+  assert(kb.get_rule_result(too_far).to_integer() == 0);
+  assert(kb.get("alarms").to_integer() == 1);
+
+  kb.set("time", madara::knowledge::KnowledgeRecord::Integer(10));
+  assert(kb.evaluate_rules() == 3);
+  assert(kb.get("distance").to_integer() == 30);
+  assert(kb.get_rule_result(alarm).to_integer() == 2);
+
+  // variables that are only assigned are not inputs
+  kb.set("distance", madara::knowledge::KnowledgeRecord::Integer(0));
+  assert(kb.evaluate_rules() == 2);
+  assert(kb.get("distance").to_integer() == 0);
+  assert(kb.get("too_far").to_integer() == 0);
+
+  // rules that expand keys are evaluated every time
+  kb.set(".id", madara::knowledge::KnowledgeRecord::Integer(2));
+  kb.set("agent2.x", madara::knowledge::KnowledgeRecord::Integer(5));
+  size_t expanded = kb.add_rule("agent{.id}.y = agent{.id}.x * 2");
+  assert(kb.evaluate_rules() == 1);
+  assert(kb.get("agent2.y").to_integer() == 10);
+  assert(kb.evaluate_rules() == 1);
+  assert(kb.get_rule_result(expanded).to_integer() == 10);
+
+  // array indices and compound assignments are read
+  kb.clear_rules();
+  kb.set_index("samples", 2, 7.5);
+  kb.set("bias", 0.0);
+  kb.add_rule("total = samples[2] + bias");
+  kb.add_rule("count *= factor");
+  kb.set("count", madara::knowledge::KnowledgeRecord::Integer(1));
+  kb.set("factor", madara::knowledge::KnowledgeRecord::Integer(3));
+  assert(kb.evaluate_rules() == 2);
+  assert(kb.get("count").to_integer() == 3);
+  assert(kb.evaluate_rules() == 0);
+  kb.set_index("samples", 2, 1.5);
+  assert(kb.evaluate_rules() == 1);
+  assert(kb.get("total").to_double() == 1.5);
+  kb.set("factor", madara::knowledge::KnowledgeRecord::Integer(2));
+  assert(kb.evaluate_rules() == 1);
+  assert(kb.get("count").to_integer() == 6);
+
+  // erasing variables evaluates the rules again and keeps them subscribed
+  kb.set("unrelated", madara::knowledge::KnowledgeRecord::Integer(1));
+  kb.get_context().delete_variable("unrelated");
+  assert(kb.evaluate_rules() == 2);
+  assert(kb.get("count").to_integer() == 12);
+  assert(kb.evaluate_rules() == 0);
+  kb.set("factor", madara::knowledge::KnowledgeRecord::Integer(5));
+  assert(kb.evaluate_rules() == 1);
+  assert(kb.get("count").to_integer() == 60);
+
+  kb.clear_rules();
+  assert(kb.evaluate_rules() == 0);
+}
+
+/// Tests that profiles count the evaluations of each part of the logic
+void test_expression_profile(void)
+{
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing expression profiles\n");
+
+  madara::knowledge::KnowledgeBase kb;
+  madara::knowledge::CompiledExpression ce =
+      kb.compile(".sum = 0; .i [0->10) (.sum += .i); .x = .sum * 2");
+
+  assert(!ce.get_profile());
+
+  std::shared_ptr<madara::expression::ExpressionProfile> profile =
+      ce.enable_profiling();
+
+  assert(profile && ce.get_profile() == profile);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    assert(kb.evaluate(ce).to_integer() == 90);
+  }
+
+  std::string annotated = profile->annotate();
+  std::string folded = profile->folded();
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "  Profile:\n%s  Folded:\n%s", annotated.c_str(), folded.c_str());
+
+  assert(profile->calls() == 3);
+
+  // expressions compiled from the same logic share a tree, but the
+  // profile has one of its own
+  madara::knowledge::CompiledExpression other =
+      kb.compile(".sum = 0; .i [0->10) (.sum += .i); .x = .sum * 2");
+  assert(!other.get_profile() && kb.evaluate(other).to_integer() == 90);
+  assert(profile->annotate() == annotated);
+
+  assert(annotated.find(".sum += .i") != std::string::npos);
+  assert(annotated.find(".x = .sum * 2") != std::string::npos);
+  assert(annotated.find("\n        30") != std::string::npos);
+  assert(folded.size() > 0 && folded[folded.size() - 1] == '\n');
+
+  profile->reset();
+  assert(profile->calls() == 0 && profile->total_ns() == 0);
+
+  // the profile outlives the tree, and the tree evaluates without it
+  ce.disable_profiling();
+  assert(!ce.get_profile());
+  assert(kb.evaluate(ce).to_integer() == 90);
+  assert(profile->calls() == 0);
+}
+
 #endif  // _MADARA_NO_KARL_
 
 int parse_args(int argc, char* argv[])
@@ -0,0 +1,306 @@
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/expression/CppVisitor.h"
+#include "madara/exceptions/FileException.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/Timer.h"
+
+#include "test.h"
+
+namespace knowledge = madara::knowledge;
+namespace expression = madara::expression;
+namespace logger = madara::logger;
+namespace utility = madara::utility;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+typedef std::chrono::steady_clock Clock;
+
+// builds a generated source file into a shared library
+std::string compiler =
+    "g++ -std=c++11 -O2 -shared -fPIC -I$(MADARA_ROOT)/include "
+    "-L$(MADARA_ROOT)/lib";
+
+// where generated sources and libraries are written
+std::string directory = "/tmp";
+
+// evaluations that are timed
+uint32_t num_iterations = 100000;
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-c" || arg1 == "--compiler")
+    {
+      if (i + 1 < argc)
+      {
+        compiler = argv[i + 1];
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-d" || arg1 == "--directory")
+    {
+      if (i + 1 < argc)
+      {
+        directory = argv[i + 1];
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--iterations")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_iterations;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Tests generating C++ from KaRL logic, building it into a\n"
+          "  shared library and loading it into a knowledge base.\n\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-c|--compiler command]  command that builds a shared library\n"
+          " [-d|--directory dir]     directory for generated files\n"
+          " [-n|--iterations num]    evaluations to time\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
+
+/**
+ * Sets the variables the logic is evaluated against
+ **/
+void prepare(knowledge::KnowledgeBase& kb)
+{
+  kb.set(".x", Integer(3));
+  kb.set(".z", Integer(7));
+  kb.set(".d", 2.5);
+  kb.set(".s", "hello");
+}
+
+/**
+ * Checks if two knowledge bases hold the same variables
+ **/
+bool same(knowledge::KnowledgeBase& lhs, knowledge::KnowledgeBase& rhs)
+{
+  knowledge::KnowledgeMap lhs_map = lhs.to_map("");
+  knowledge::KnowledgeMap rhs_map = rhs.to_map("");
+
+  if (lhs_map.size() != rhs_map.size())
+    return false;
+
+  for (auto i = lhs_map.begin(), j = rhs_map.begin(); i != lhs_map.end();
+       ++i, ++j)
+  {
+    if (i->first != j->first || i->second.type() != j->second.type() ||
+        i->second.to_string() != j->second.to_string())
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Generates the C++ for logic, returning whether it was supported
+ **/
+bool generate(const std::string& logic, std::string& source)
+{
+  knowledge::KnowledgeBase kb;
+  knowledge::CompiledExpression ce = kb.compile(logic);
+
+  expression::CppVisitor visitor;
+  bool result = visitor.generate(ce.get_root());
+  source = visitor.source(logic);
+
+  return result;
+}
+
+void test_generation(void)
+{
+  log("Testing which logic can be generated as C++\n");
+
+  std::string source;
+
+  TEST_EQ(generate("++.x; .y = .x * 3 + 2 - .z / 2 % 3", source), true);
+  TEST_EQ(generate(".y = .x && .d || !.s; .z = -.x", source), true);
+  TEST_EQ(generate(".x => .y = 9; (.x , .d) ; (.z ;> .s)", source), true);
+  TEST_EQ(generate(".s = 'say \"hi\" \\ bye'", source), true);
+  TEST_EQ(source.find("say \\\"hi\\\" \\\\ bye") != std::string::npos, true);
+
+  TEST_EQ(generate("#print ('hello')", source), false);
+  TEST_EQ(generate(".arr[1] = 2", source), false);
+  TEST_EQ(generate(".i = 1; var{.i} = 1", source), false);
+  TEST_EQ(generate(".x += 2", source), false);
+  TEST_EQ(generate(".i[0->3) (.x = .i)", source), false);
+}
+
+/**
+ * Checks if the program that the compiler command runs can be found
+ **/
+bool has_compiler(void)
+{
+  std::string command = utility::expand_envs(compiler);
+  std::string program = command.substr(0, command.find(' '));
+
+  return system(("command -v " + program + " > /dev/null 2>&1").c_str()) == 0;
+}
+
+/**
+ * Generates and builds logic into a shared library, returning its path or
+ * an empty string if it could not be built
+ **/
+std::string build(const std::string& name, const std::string& logic)
+{
+  std::string source;
+
+  if (!generate(logic, source))
+    return "";
+
+  std::string source_file = directory + "/" + name + ".cpp";
+  std::string library_file = directory + "/lib" + name + ".so";
+
+  utility::write_file(source_file, (void*)source.c_str(), source.size());
+
+  std::string command = utility::expand_envs(compiler) + " " + source_file +
+                        " -o " + library_file + " -lMADARA";
+
+  log("  %s\n", command.c_str());
+
+  if (system(command.c_str()) != 0)
+    return "";
+
+  return library_file;
+}
+
+void test_loading(void)
+{
+  log("Testing generated logic against the expression tree\n");
+
+  std::string logic = "++.count;"
+                      ".y = .x * 3 + 2 - .z / 2 % 3;"
+                      ".w = (.x < 5) + (.x >= 3) * 2 + (.s == \"hello\") * 4;"
+                      ".a = .x && .d && ++.b; .o = .missing || --.c;"
+                      ".x > 10 => .x = 0;"
+                      ".m = (.x , .d) + (.x ; .d) + (.z ;> .d);"
+                      ".t = .s + .x + 1.5;"
+                      ".n = !.missing; .q = 'say \"hi\" \\ bye';"
+                      ".x = .x + 1";
+
+  if (!has_compiler())
+  {
+    log("  No compiler found. Skipping load tests.\n");
+    return;
+  }
+
+  // generated logic that a compiler cannot build is a bug
+  std::string library = build("madara_test_compiled_logic", logic);
+
+  TEST_NE(library, "");
+
+  if (library == "")
+    return;
+
+  knowledge::KnowledgeBase tree, loaded;
+  prepare(tree);
+  prepare(loaded);
+
+  knowledge::CompiledExpression tree_ce = tree.compile(logic);
+  knowledge::CompiledExpression loaded_ce =
+      loaded.load_compiled_logic(library);
+
+  for (int i = 0; i < 20; ++i)
+  {
+    knowledge::KnowledgeRecord tree_result = tree.evaluate(tree_ce);
+    knowledge::KnowledgeRecord loaded_result = loaded.evaluate(loaded_ce);
+
+    TEST_EQ(loaded_result.to_string(), tree_result.to_string());
+  }
+
+  TEST_EQ(same(tree, loaded), true);
+  TEST_EQ(loaded.get(".count").to_integer(), (Integer)20);
+
+  log("Testing the speed of generated logic\n");
+
+  utility::Timer<Clock> tree_timer, loaded_timer;
+
+  tree_timer.start();
+  for (uint32_t i = 0; i < num_iterations; ++i)
+    tree.evaluate(tree_ce);
+  tree_timer.stop();
+
+  loaded_timer.start();
+  for (uint32_t i = 0; i < num_iterations; ++i)
+    loaded.evaluate(loaded_ce);
+  loaded_timer.stop();
+
+  TEST_EQ(same(tree, loaded), true);
+
+  log("  tree: %d ns, generated: %d ns per evaluation\n",
+      (int)(tree_timer.duration_ns() / num_iterations),
+      (int)(loaded_timer.duration_ns() / num_iterations));
+
+  log("Testing that missing libraries are reported\n");
+
+  bool thrown = false;
+
+  try
+  {
+    loaded.load_compiled_logic(directory + "/madara_no_such_logic.so");
+  }
+  catch (madara::exceptions::FileException&)
+  {
+    thrown = true;
+  }
+
+  TEST_EQ(thrown, true);
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  test_generation();
+  test_loading();
+
+  if (madara_tests_fail_count > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_tests_fail_count
+              << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_tests_fail_count;
+}
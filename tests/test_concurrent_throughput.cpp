@@ -0,0 +1,286 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/Timer.h"
+
+namespace logger = madara::logger;
+namespace knowledge = madara::knowledge;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+typedef std::chrono::steady_clock Clock;
+
+// default settings
+uint32_t num_iterations = 100000;
+uint32_t max_threads = 0;
+uint32_t num_keys = 1000;
+uint32_t read_percent = 90;
+bool hash_index = false;
+
+void handle_arguments(int argc, char* argv[]);
+
+// how workers address variables
+enum AccessMode
+{
+  BY_NAME,
+  BY_REFERENCE
+};
+
+/**
+ * Each worker walks the key set with its own stride and performs a mix of
+ * reads and writes, according to read_percent.
+ **/
+void worker(knowledge::KnowledgeBase& kb,
+    const std::vector<std::string>& keys,
+    std::vector<knowledge::VariableReference>& refs, uint32_t id,
+    AccessMode mode, std::atomic<bool>& start)
+{
+  while (!start.load())
+    std::this_thread::yield();
+
+  uint32_t cur = id * 7919;
+  Integer sum = 0;
+
+  for (uint32_t i = 0; i < num_iterations; ++i)
+  {
+    cur = (cur + 104729) % num_keys;
+
+    if ((i % 100) < read_percent)
+    {
+      if (mode == BY_NAME)
+        sum += kb.get(keys[cur]).to_integer();
+      else
+        sum += kb.get(refs[cur]).to_integer();
+    }
+    else
+    {
+      if (mode == BY_NAME)
+        kb.set(keys[cur], (Integer)i);
+      else
+        kb.set(refs[cur], (Integer)i);
+    }
+  }
+
+  // keep the compiler from discarding the reads
+  if (sum == -1)
+    std::cerr << sum;
+}
+
+uint64_t run_test(knowledge::KnowledgeBase& kb,
+    const std::vector<std::string>& keys,
+    std::vector<knowledge::VariableReference>& refs, uint32_t threads,
+    AccessMode mode)
+{
+  std::atomic<bool> start(false);
+  std::vector<std::thread> workers;
+
+  for (uint32_t i = 0; i < threads; ++i)
+  {
+    workers.emplace_back(worker, std::ref(kb), std::cref(keys), std::ref(refs),
+        i, mode, std::ref(start));
+  }
+
+  madara::utility::Timer<Clock> timer;
+  timer.start();
+  start = true;
+
+  for (auto& thread : workers)
+    thread.join();
+
+  timer.stop();
+
+  return timer.duration_ns();
+}
+
+int main(int argc, char* argv[])
+{
+  handle_arguments(argc, argv);
+
+  if (max_threads == 0)
+  {
+    max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0)
+      max_threads = 4;
+  }
+
+  if (num_keys == 0 || num_iterations == 0 || read_percent > 100)
+  {
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+        "\nERROR: keys (%d) and iterations (%d) must be positive and read "
+        "percent (%d) must be <= 100\n",
+        num_keys, num_iterations, read_percent);
+
+    return -1;
+  }
+
+  knowledge::KnowledgeBase kb;
+  std::vector<std::string> keys;
+
+  if (hash_index)
+    kb.enable_hash_index();
+
+  std::vector<knowledge::VariableReference> refs;
+
+  keys.reserve(num_keys);
+  refs.reserve(num_keys);
+
+  for (uint32_t i = 0; i < num_keys; ++i)
+  {
+    std::stringstream buffer;
+    buffer << "agent." << i << ".value";
+    keys.push_back(buffer.str());
+    refs.push_back(kb.get_ref(keys.back()));
+    kb.set(refs.back(), (Integer)i);
+  }
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing concurrent get/set throughput for MADARA v%s\n"
+      "  lock: %s, index: %s, keys: %d, iterations/thread: %d, "
+      "reads: %d%%\n\n",
+      madara::utility::get_version().c_str(),
+#ifdef _MADARA_SHARED_LOCK_
+      "recursive shared",
+#elif defined _MADARA_NULL_LOCK_
+      "null",
+#else
+      "recursive",
+#endif
+      hash_index ? "hash" : "ordered", num_keys, num_iterations, read_percent);
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      " threads   by name (ops/s)   by ref (ops/s)\n"
+      "=========================================================\n");
+
+  for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    uint64_t total_ops = (uint64_t)num_iterations * threads;
+
+    uint64_t by_name = run_test(kb, keys, refs, threads, BY_NAME);
+    uint64_t by_ref = run_test(kb, keys, refs, threads, BY_REFERENCE);
+
+    if (by_name == 0)
+      by_name = 1;
+    if (by_ref == 0)
+      by_ref = 1;
+
+    std::stringstream buffer;
+    std::locale loc("C");
+    buffer.imbue(loc);
+
+    buffer << " " << std::setw(7) << threads;
+    buffer << " " << std::setw(17) << (total_ops * 1000000000) / by_name;
+    buffer << " " << std::setw(16) << (total_ops * 1000000000) / by_ref;
+    buffer << "\n";
+
+    madara_logger_ptr_log(
+        logger::global_logger.get(), logger::LOG_ALWAYS, buffer.str().c_str());
+
+    // make sure the largest thread count is always measured
+    if (threads < max_threads && threads * 2 > max_threads)
+      threads = max_threads / 2;
+  }
+
+  return 0;
+}
+
+void handle_arguments(int argc, char* argv[])
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-f" || arg1 == "--logfile")
+    {
+      if (i + 1 < argc)
+      {
+        logger::global_logger->add_file(argv[i + 1]);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-k" || arg1 == "--keys")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_keys;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-x" || arg1 == "--hash-index")
+    {
+      hash_index = true;
+    }
+    else if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--iterations")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_iterations;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-r" || arg1 == "--reads")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> read_percent;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-t" || arg1 == "--threads")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> max_threads;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Measures get/set throughput on one knowledge base as the number\n"
+          "  of application threads grows. Build with the shared_lock\n"
+          "  feature to compare against the default recursive lock, or pass\n"
+          "  -x to compare hashed against ordered key lookups.\n\n"
+          " [-f|--logfile file]      log to a file\n"
+          " [-k|--keys num]          number of variables to spread access over\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--iterations num]    operations per thread per run\n"
+          " [-r|--reads percent]     percentage of operations that are reads\n"
+          " [-t|--threads num]       maximum number of threads (default: "
+          "hardware concurrency)\n"
+          " [-x|--hash-index]        look up keys through the hash index\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
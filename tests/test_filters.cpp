@@ -447,6 +447,97 @@ void test_variable_map_filter(void)
   }
 }
 
+/**
+ * In-place filter that doubles integers and removes negative ones
+ **/
+void double_integers(knowledge::KnowledgeRecord& record, const std::string&,
+    transport::TransportContext&)
+{
+  if (record.to_integer() < 0)
+    record = knowledge::KnowledgeRecord();
+  else
+    record.set_value(record.to_integer() * 2);
+}
+
+/**
+ * In-place filter that tags the record with the name of the variable
+ **/
+void name_strings(knowledge::KnowledgeRecord& record, const std::string& name,
+    transport::TransportContext&)
+{
+  record.set_value(record.to_string() + ":" + name);
+}
+
+/**
+ * Returns the name argument that a filter was called with
+ **/
+knowledge::KnowledgeRecord return_name(
+    knowledge::FunctionArguments& args, knowledge::Variables&)
+{
+  return args[1];
+}
+
+void check(const std::string& label, bool condition)
+{
+  std::cerr << "  " << label << " (";
+
+  if (condition)
+    std::cerr << "SUCCESS)\n";
+  else
+  {
+    std::cerr << "FAILURE)\n";
+    ++madara_fails;
+  }
+}
+
+void test_in_place_filters(void)
+{
+  std::cerr << "Testing in-place record filters\n";
+
+  knowledge::KnowledgeRecordFilters filters;
+  transport::TransportContext context;
+
+  // chains mix in-place and argument filters and keep their order
+  filters.add(KnowledgeRecord::INTEGER, double_integers);
+  filters.add(KnowledgeRecord::INTEGER, decrement_primitives);
+  filters.add(KnowledgeRecord::INTEGER, double_integers);
+
+  check("(5 * 2 - 1) * 2 == 18",
+      filters.filter(KnowledgeRecord(KnowledgeRecord::Integer(5)), "x",
+          context) == KnowledgeRecord::Integer(18));
+
+  filters.add(KnowledgeRecord::DOUBLE, double_integers);
+
+  check("default record removes the variable",
+      !filters.filter(KnowledgeRecord(-5.0), "x", context).exists());
+
+  filters.add(KnowledgeRecord::STRING, name_strings);
+
+  check("in-place filter is passed the name",
+      filters.filter(KnowledgeRecord("value"), "x", context) == "value:x");
+
+  // reused arguments must not carry a name to an unnamed record
+  filters.clear(KnowledgeRecord::STRING);
+  filters.add(KnowledgeRecord::STRING, return_name);
+
+  check("first name is passed",
+      filters.filter(KnowledgeRecord("value"), "first", context) == "first");
+  check("second name is passed",
+      filters.filter(KnowledgeRecord("value"), "second", context) ==
+          "second");
+  check("unnamed record is passed no name",
+      !filters.filter(KnowledgeRecord("value"), "", context).exists());
+
+  // reused arguments must not keep a reference to filtered arrays
+  filters.add(KnowledgeRecord::INTEGER_ARRAY, return_name);
+
+  KnowledgeRecord array(std::vector<KnowledgeRecord::Integer>(100, 1));
+  filters.filter(array, "array", context);
+
+  check("filtered array is released",
+      array.share_integers().use_count() == 2);
+}
+
 int main(int, char**)
 {
   test_dynamic_predicate_filter();
@@ -456,6 +547,7 @@ int main(int, char**)
   test_print_filter_compile();
   test_variable_map_filter();
   test_fragments_to_files_filter();
+  test_in_place_filters();
 
   madara::knowledge::KnowledgeRecordFilters filters;
 
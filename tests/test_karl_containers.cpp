@@ -3,6 +3,7 @@
 #include "madara/knowledge/containers/IntegerVector.h"
 #include "madara/knowledge/containers/DoubleVector.h"
 #include "madara/knowledge/containers/NativeDoubleVector.h"
+#include "madara/knowledge/containers/NativeIntegerVector.h"
 #include "madara/knowledge/containers/StringVector.h"
 #include "madara/knowledge/containers/Map.h"
 #include "madara/knowledge/containers/FlexMap.h"
@@ -21,7 +22,11 @@
 #include "madara/knowledge/containers/NativeCircularBufferConsumer.h"
 #include "madara/knowledge/containers/CircularBufferConsumer.h"
 #include "madara/knowledge/containers/CircularBufferConsumerT.h"
+#include "madara/knowledge/containers/Counter.h"
+#include "madara/knowledge/containers/Table.h"
 #include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/rcw/Transaction.h"
+#include "madara/knowledge/rcw/Tracked.h"
 #include <iostream>
 
 namespace knowledge = madara::knowledge;
@@ -4294,6 +4299,521 @@ void test_circular_consumert_any(void)
   }
 }
 
+void test_counter(void)
+{
+  std::cerr << "************* COUNTER: AGGREGATES*************\n";
+  knowledge::KnowledgeBase knowledge;
+  containers::Counter first("ring", knowledge, 0, 3);
+  containers::Counter second("ring", knowledge, 1, 3);
+  containers::Counter third("ring", knowledge, 2, 3);
+
+  first += 5;
+  ++second;
+  ++second;
+  third -= 3;
+
+  std::cerr << "  Checking local updates... ";
+  if (*first == 4 && *third == 4 && first.get_min() == -3 &&
+      first.get_max() == 5 && second.get_average() * 3 == 4.0)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << *first << ", min=" << first.get_min()
+              << ", max=" << first.get_max()
+              << ", average=" << first.get_average() << "\n";
+    ++madara_fails;
+  }
+
+  knowledge.set("ring.1", knowledge::KnowledgeRecord::Integer(10));
+  knowledge.evaluate("ring.2 = -1");
+
+  std::cerr << "  Checking updates made outside the counter... ";
+  if (*first == 14 && first.to_string() == "14" && first.get_min() == -1 &&
+      first.get_max() == 10 && first.to_double() == 14.0)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << *first << ", min=" << first.get_min()
+              << ", max=" << first.get_max() << "\n";
+    ++madara_fails;
+  }
+
+  third.resize(2, 2);
+
+  std::cerr << "  Checking resized counter... ";
+  if (*third == 15 && third.get_min() == 5 && *first == 14)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << *third << ", min=" << third.get_min()
+              << "\n";
+    ++madara_fails;
+  }
+
+  knowledge.clear();
+
+  std::cerr << "  Checking counter after resetting the knowledge base... ";
+  if (*first == 0 && first.get_min() == 0 && first.get_max() == 0)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << *first << "\n";
+    ++madara_fails;
+  }
+
+  knowledge.clear(true);
+  knowledge.set("ring.2", knowledge::KnowledgeRecord::Integer(7));
+
+  std::cerr << "  Checking counter after clearing the knowledge base... ";
+  if (*first == 7 && first.get_min() == 0 && first.get_max() == 7)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << *first << ", min=" << first.get_min()
+              << ", max=" << first.get_max() << "\n";
+    ++madara_fails;
+  }
+}
+
+
+void test_table(void)
+{
+  std::cerr << "************* TABLE: COLUMNS OF AGENT STATE*************\n";
+  knowledge::KnowledgeBase knowledge;
+  containers::Table agents("agents", knowledge);
+
+  size_t x = agents.add_column("x");
+  size_t id =
+      agents.add_column("id", knowledge::KnowledgeRecord::INTEGER_ARRAY);
+  agents.resize(4);
+  agents.clear_dirty();
+
+  agents.set(1, x, 1.5);
+  agents.set(1, id, knowledge::KnowledgeRecord::Integer(11));
+  agents.set_row(3, {3.5, 33});
+
+  std::cerr << "  Checking columns are single array variables... ";
+  if (agents.rows() == 4 && agents.columns() == 2 &&
+      agents.find_column("id") == 1 &&
+      agents.get_column_name(x) == "agents.x" &&
+      knowledge.get("agents.x").type() ==
+          knowledge::KnowledgeRecord::DOUBLE_ARRAY &&
+      knowledge.get("agents.id").to_integers() ==
+          std::vector<knowledge::KnowledgeRecord::Integer>({0, 11, 0, 33}) &&
+      agents.get_double(3, x) == 3.5 && agents.get_integer(1, id) == 11 &&
+      agents.get_row(3)[1].to_integer() == 33)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << agents.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  std::vector<containers::Table::RowRange> dirty = agents.get_dirty_ranges();
+
+  std::cerr << "  Checking dirty rows... ";
+  if (dirty.size() == 2 && dirty[0] == containers::Table::RowRange(1, 2) &&
+      dirty[1] == containers::Table::RowRange(3, 4) && !agents.is_dirty(2) &&
+      agents.set(4, x, 1.0) == -1)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << dirty.size() << " dirty ranges\n";
+    ++madara_fails;
+  }
+
+  agents.clear_dirty();
+  agents.write_doubles(
+      x,
+      [](double* data, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+          data[i] += 10;
+      },
+      2, 4);
+
+  double sum = 0;
+  agents.read_doubles(x, [&sum](const double* data, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      sum += data[i];
+  });
+
+  std::cerr << "  Checking column iteration... ";
+  if (sum == 1.5 + 10 + 13.5 &&
+      agents.get_dirty_ranges() ==
+          std::vector<containers::Table::RowRange>(
+              {containers::Table::RowRange(2, 4)}) &&
+      agents.write_integers(x, [](knowledge::KnowledgeRecord::Integer*,
+                                   size_t) {}) == -1)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. sum=" << sum << "\n";
+    ++madara_fails;
+  }
+
+  // remote agents replace whole columns, possibly with other types
+  knowledge.set("agents.id",
+      std::vector<double>({5.0, 6.0, 7.0, 8.0, 9.0}));
+  containers::Table copy("agents", knowledge);
+  copy.add_column("x");
+  copy.add_column("id", knowledge::KnowledgeRecord::INTEGER_ARRAY);
+
+  std::cerr << "  Checking remote updates and existing columns... ";
+  if (agents.get_integer(4, id) == 9 && copy.get_double(2, 0) == 10 &&
+      knowledge.get("agents.id").type() ==
+          knowledge::KnowledgeRecord::INTEGER_ARRAY &&
+      copy.get_integer(4, 1) == 9)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << copy.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  knowledge::rcw::Transaction transaction(knowledge);
+  knowledge::rcw::Tracked<std::vector<double>> column;
+  transaction.add(agents.get_column_name(x).c_str(), column);
+  transaction.pull();
+  column.set(0, 42.0);
+  transaction.push();
+
+  std::cerr << "  Checking columns tracked by transactions... ";
+  if (agents.get_double(0, x) == 42 && agents.get_double(3, x) == 13.5)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << agents.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  // columns added before the name exist once the table is named
+  containers::Table late;
+  size_t late_x = late.add_column("x");
+  late.set_name("late", knowledge);
+  int empty_set = late.set(0, late_x, 5.0);
+  late.resize(2);
+
+  std::cerr << "  Checking columns added before the table is named... ";
+  if (empty_set == -1 && late.set(1, late_x, 5.0) == 0 &&
+      knowledge.get("late.x").to_doubles() == std::vector<double>({0, 5}))
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << late.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  containers::Table unnamed("", knowledge);
+  size_t unnamed_x = unnamed.add_column("x");
+  size_t unnamed_rows = 0;
+  unnamed.read_doubles(
+      unnamed_x, [&unnamed_rows](const double*, size_t size) {
+        unnamed_rows = size;
+      });
+
+  std::cerr << "  Checking columns of a table without a name... ";
+  if (unnamed.set(0, unnamed_x, 1.0) == -1 &&
+      unnamed.set_row(0, {1.0}) == -1 && unnamed.rows() == 0 &&
+      unnamed.get_double(0, unnamed_x) == 0 &&
+      unnamed.get_integer(0, unnamed_x) == 0 &&
+      unnamed.get_row(0).size() == 1 && !unnamed.is_true() &&
+      unnamed_rows == 0 && unnamed.get_debug_info() != "")
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << unnamed.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  // writing a row of a column with history keeps the other rows
+  containers::Table history("history", knowledge);
+  size_t history_x = history.add_column("x");
+  size_t history_id =
+      history.add_column("id", knowledge::KnowledgeRecord::INTEGER_ARRAY);
+  history.resize(4);
+  history.write_doubles(history_x, [](double* data, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      data[i] = (double)i + 1;
+  });
+  knowledge.set_history_capacity("history.x", 5);
+  knowledge.set_history_capacity("history.id", 5);
+  history.set(2, history_x, 42.0);
+  history.set_row(1, {7.0, 7});
+
+  std::cerr << "  Checking columns with history... ";
+  if (knowledge.get("history.x").to_doubles() ==
+          std::vector<double>({1, 7, 42, 4}) &&
+      knowledge.get("history.id").to_integers() ==
+          std::vector<knowledge::KnowledgeRecord::Integer>({0, 7, 0, 0}) &&
+      history.get_integer(1, history_id) == 7 && history.rows() == 4)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << history.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+}
+
+void test_key_changes(void)
+{
+  std::cerr << "************* KEY CHANGES: SYNCING MAP KEYS*************\n";
+  knowledge::KnowledgeBase knowledge;
+  knowledge::ThreadSafeContext& context = knowledge.get_context();
+
+  knowledge.set("agent.0.x", 1.0);
+  knowledge.set("agent.1.x", 2.0);
+
+  uint64_t start = context.track_keys("agent.");
+
+  knowledge.set("agent.2.x", 3.0);
+  knowledge.set("agent.0.x", 4.0);
+  knowledge.set("other.x", 5.0);
+  context.delete_variable("agent.1.x");
+  knowledge.set("agent.3.x", 6.0);
+  context.delete_variable("agent.3.x");
+  context.delete_variable("agent.0.x");
+  knowledge.set("agent.0.x", 7.0);
+
+  knowledge::KeyChanges changes = context.get_key_changes("agent.", start);
+  knowledge::KeyChanges untracked = context.get_key_changes("other.", start);
+
+  std::cerr << "  Checking keys added and removed since a generation... ";
+  if (changes.complete && !untracked.complete &&
+      changes.generation == context.get_key_generation() &&
+      changes.added ==
+          std::vector<std::string>({"agent.0.x", "agent.2.x"}) &&
+      changes.removed ==
+          std::vector<std::string>({"agent.0.x", "agent.1.x"}) &&
+      context.get_key_changes("agent.", changes.generation).added.empty() &&
+      !context.get_key_changes("agent.", 0).complete)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << changes.added.size() << " added, "
+              << changes.removed.size() << " removed\n";
+    ++madara_fails;
+  }
+
+  containers::Map map("agent", knowledge);
+  containers::FlexMap flex("agent", knowledge);
+  std::vector<std::string> flex_keys;
+  flex.keys(flex_keys);
+
+  knowledge.set("agent.4.x", 8.0);
+  knowledge.set("agent.4.y", 9.0);
+  context.delete_variable("agent.2.x");
+
+  std::vector<std::string> added = map.sync_keys();
+  std::vector<std::string> map_keys;
+  map.keys(map_keys);
+  std::vector<std::string> flex_all;
+  flex.keys(flex_keys);
+  flex.keys(flex_all, false);
+
+  std::cerr << "  Checking Map and FlexMap apply key changes... ";
+  if (added == std::vector<std::string>({"4.x", "4.y"}) &&
+      map_keys == std::vector<std::string>({"0.x", "4.x", "4.y"}) &&
+      flex_keys == std::vector<std::string>({"0", "4"}) &&
+      flex_all == map_keys && flex.size() == 2 && flex.size(false) == 3)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << map.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  // clearing the context empties the logs, so maps read all keys again
+  knowledge.clear(true);
+  knowledge.set("agent.5.x", 10.0);
+
+  added = map.sync_keys();
+  map.keys(map_keys);
+  flex.keys(flex_keys);
+
+  std::cerr << "  Checking Map and FlexMap after clearing the context... ";
+  if (added == std::vector<std::string>({"5.x"}) &&
+      map_keys == std::vector<std::string>({"5.x"}) &&
+      flex_keys == std::vector<std::string>({"5"}))
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << map.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  // the log is dropped when the last of its references is released
+  context.untrack_keys("agent.");
+  uint64_t generation = context.get_key_generation();
+
+  {
+    containers::Map temporary("agent", knowledge);
+  }
+
+  bool kept = context.get_key_changes("agent.", generation).complete;
+
+  map.set_name("other", knowledge);
+  bool flex_kept = context.get_key_changes("agent.", generation).complete;
+  bool moved = context.get_key_changes("other.", generation).complete;
+
+  flex.set_delimiter("/");
+  bool released = !context.get_key_changes("agent.", generation).complete;
+
+  std::cerr << "  Checking maps release the key logs they no longer use... ";
+  if (kept && flex_kept && moved && released)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << kept << flex_kept << moved << released << "\n";
+    ++madara_fails;
+  }
+}
+
+void test_vector_ranges(void)
+{
+  std::cerr << "************* VECTORS: RANGE OPERATIONS*************\n";
+  knowledge::KnowledgeBase knowledge;
+
+  containers::IntegerVector integers("integers", knowledge, 4);
+  std::vector<knowledge::KnowledgeRecord::Integer> values({1, 2, 3});
+  integers.set_range(2, values);
+  integers.fill(9, 0, 2);
+
+  knowledge::KnowledgeRecord::Integer buffer[8];
+  size_t copied = integers.copy_to(buffer, 8, 1);
+
+  std::cerr << "  Checking IntegerVector ranges... ";
+  if (integers.size() == 5 && copied == 4 && buffer[0] == 9 &&
+      buffer[1] == 1 && buffer[3] == 3 &&
+      knowledge.get("integers.4").to_integer() == 3 &&
+      knowledge.get("integers.size").to_integer() == 5)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << integers.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  double doubles_in[] = {1.5, 2.5};
+  containers::DoubleVector doubles("doubles", knowledge, 5);
+  doubles.fill(0.5);
+  doubles.assign(doubles_in, doubles_in + 2);
+
+  std::vector<std::string> strings_in({"a", "b", "c"});
+  containers::StringVector strings("strings", knowledge);
+  strings.copy_from(strings_in.data(), strings_in.size());
+  strings.fill("z", 1);
+  std::vector<std::string> strings_out;
+  strings.copy_to(strings_out);
+
+  std::cerr << "  Checking DoubleVector and StringVector ranges... ";
+  if (doubles.size() == 2 && doubles[1] == 2.5 &&
+      !knowledge.exists("doubles.4") &&
+      strings_out == std::vector<std::string>({"a", "z", "z"}))
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << doubles.get_debug_info() << ", "
+              << strings.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  containers::Vector records("records", knowledge, 2);
+  records.fill(knowledge::KnowledgeRecord(std::string("x")));
+  records.set_range(1, {knowledge::KnowledgeRecord(3.5)});
+  knowledge::KnowledgeRecord records_out[2];
+  records.copy_to(records_out, 2);
+
+  std::cerr << "  Checking Vector ranges... ";
+  if (records.size() == 2 && records_out[0].to_string() == "x" &&
+      records_out[1].to_double() == 3.5)
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << records.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+
+  containers::NativeDoubleVector native("native", knowledge, 3);
+  double native_in[] = {1.0, 2.0, 3.0, 4.0};
+  native.copy_from(native_in, 4, 1);
+  native.fill(7.0, 0, 1);
+
+  // other copies of the record keep the elements they had
+  knowledge::KnowledgeRecord before = knowledge.get("native");
+  native.set_range(4, {8.0});
+
+  double native_out[5];
+  size_t native_copied = native.copy_to(native_out, 5);
+
+  containers::NativeIntegerVector native_ints("native_ints", knowledge, 2);
+  knowledge::KnowledgeRecord::Integer ints_in[] = {4, 5, 6};
+  native_ints.assign(ints_in, ints_in + 3);
+  native_ints.fill(1, 2);
+
+  // copies that start past the end copy nothing
+  knowledge::KnowledgeRecord::Integer ints_out[1];
+  size_t past_end = native.copy_to(native_out, 1, 10) +
+                    native_ints.copy_to(ints_out, 1, 10);
+
+  std::cerr << "  Checking native vector ranges... ";
+  if (native.size() == 5 && native_copied == 5 && past_end == 0 &&
+      native_out[0] == 7 && native_out[1] == 1 && native_out[4] == 8 &&
+      before.retrieve_index(4).to_double() == 4 &&
+      knowledge.get("native").type() ==
+          knowledge::KnowledgeRecord::DOUBLE_ARRAY &&
+      native_ints.to_integers() ==
+          std::vector<knowledge::KnowledgeRecord::Integer>({4, 5, 1}))
+  {
+    std::cerr << "SUCCESS\n";
+  }
+  else
+  {
+    std::cerr << "FAIL. " << native.get_debug_info() << ", "
+              << native_ints.get_debug_info() << "\n";
+    ++madara_fails;
+  }
+}
+
 int main(int, char**)
 {
   test_vector();
@@ -4324,6 +4844,10 @@ int main(int, char**)
   test_circular_consumer_any();
   test_circular_consumert_any();
   test_native_circular_consumer();  // TODO needs to be fixed
+  test_counter();
+  test_table();
+  test_key_changes();
+  test_vector_ranges();
 
   if (madara_fails > 0)
   {
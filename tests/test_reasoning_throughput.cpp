@@ -9,6 +9,7 @@
 #include "madara/knowledge/CompiledExpression.h"
 #include "madara/knowledge/KnowledgeBase.h"
 #include "madara/knowledge/KnowledgeUpdateSettings.h"
+#include "madara/knowledge/containers/Counter.h"
 #include "madara/knowledge/containers/Integer.h"
 #include "madara/knowledge/containers/IntegerStaged.h"
 #include "madara/logger/GlobalLogger.h"
@@ -57,6 +58,10 @@ uint64_t test_staged_container_assignment(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 uint64_t test_staged_container_increment(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_counter_sum(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_counter_aggregate(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 
 uint64_t test_compiled_sr(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
@@ -77,8 +82,29 @@ uint64_t test_compiled_sfi(
 uint64_t test_compiled_lfi(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 
+uint64_t test_bytecode_sr(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_lr(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_si(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_li(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_sa(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_la(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_sfi(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_bytecode_lfi(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+
 uint64_t test_extern_call(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_extern_args_call(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_native_args_call(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 
 uint64_t test_looped_sr(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
@@ -88,6 +114,14 @@ uint64_t test_optimal_loop(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 uint64_t test_looped_li(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_looped_array_add(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_vector_array_add(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_looped_dot(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
+uint64_t test_vector_dot(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 uint64_t test_normal_set(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations);
 uint64_t test_var_ref_set(
@@ -116,12 +150,21 @@ long increment(bool check, long value);
 // inlining, which is precisely what I am trying to avoid.
 long increment(long value);
 
+// number of counters in the counter ring of the counter tests
+const int counter_participants = 1000;
+
 // default iterations
 uint32_t num_iterations = 100000;
 uint32_t num_runs = 10;
 bool conditional = true;
 uint32_t step = 1;
 
+// true if compiled tests should lower their expressions into bytecode
+bool use_bytecode = false;
+
+// compiled tests whose bytecode ended with different values than the tree
+int bytecode_mismatches = 0;
+
 // still trying to stop this darn thing from optimizing the increments
 class Incrementer
 {
@@ -227,6 +270,119 @@ madara::knowledge::KnowledgeRecord no_op(
   return madara::knowledge::KnowledgeRecord(0);
 }
 
+madara::knowledge::KnowledgeRecord add_args(
+    madara::knowledge::FunctionArguments& args, madara::knowledge::Variables&)
+{
+  return madara::knowledge::KnowledgeRecord(
+      args[0].to_integer() + args[1].to_integer());
+}
+
+Integer add_native(Integer lhs, Integer rhs)
+{
+  return lhs + rhs;
+}
+
+#ifndef _MADARA_NO_KARL_
+/**
+ * Compiles logic, lowering it into bytecode if use_bytecode is set
+ **/
+madara::knowledge::CompiledExpression compile(
+    madara::knowledge::KnowledgeBase& knowledge, const std::string& logic)
+{
+  madara::knowledge::CompiledExpression ce = knowledge.compile(logic);
+
+  if (use_bytecode)
+    ce.compile_bytecode();
+
+  return ce;
+}
+#endif  // _MADARA_NO_KARL_
+
+/**
+ * Times a compiled test with bytecode, after checking that it leaves the
+ * knowledge base as the tree does
+ **/
+uint64_t test_bytecode(uint64_t (*test)(madara::knowledge::KnowledgeBase&,
+                           uint32_t),
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  test(knowledge, iterations);
+  madara::knowledge::KnowledgeMap tree = knowledge.to_map("");
+
+  use_bytecode = true;
+  uint64_t measured = test(knowledge, iterations);
+  use_bytecode = false;
+
+  madara::knowledge::KnowledgeMap bytecode = knowledge.to_map("");
+
+  bool same = tree.size() == bytecode.size();
+
+  for (auto i = tree.begin(), j = bytecode.begin();
+       same && i != tree.end(); ++i, ++j)
+  {
+    same = i->first == j->first && i->second.type() == j->second.type() &&
+           i->second.to_string() == j->second.to_string();
+  }
+
+  if (!same)
+  {
+    madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+        "ERROR: bytecode results differ from the expression tree\n");
+
+    ++bytecode_mismatches;
+  }
+
+  return measured;
+}
+
+uint64_t test_bytecode_sr(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_sr, knowledge, iterations);
+}
+
+uint64_t test_bytecode_lr(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_lr, knowledge, iterations);
+}
+
+uint64_t test_bytecode_si(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_si, knowledge, iterations);
+}
+
+uint64_t test_bytecode_li(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_li, knowledge, iterations);
+}
+
+uint64_t test_bytecode_sa(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_sa, knowledge, iterations);
+}
+
+uint64_t test_bytecode_la(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_la, knowledge, iterations);
+}
+
+uint64_t test_bytecode_sfi(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_sfi, knowledge, iterations);
+}
+
+uint64_t test_bytecode_lfi(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_bytecode(test_compiled_lfi, knowledge, iterations);
+}
+
 std::string to_legible_hertz(uint64_t hertz)
 {
   std::stringstream buffer;
@@ -300,7 +456,7 @@ int main(int argc, char* argv[])
     exit(-1);
   }
 
-  const int num_test_types = 36;
+  const int num_test_types = 52;
 
   // make everything all pretty and for-loopy
   uint64_t results[num_test_types];
@@ -318,12 +474,26 @@ int main(int argc, char* argv[])
       "KaRL: Compiled Single Assign      ",
       "KaRL: Compiled Multiple Assign    ",
       "KaRL: Extern Function Call        ",
+      "KaRL: Extern Call With Args       ",
+      "KaRL: Native Call With Args       ",
       "KaRL: Compiled Extern Inc Func    ",
       "KaRL: Compiled Extern Multi Calls ",
+      "KaRL VM: Simple Increments        ",
+      "KaRL VM: Multiple Inc             ",
+      "KaRL VM: Simple Tern Inc          ",
+      "KaRL VM: Multiple Tern Inc        ",
+      "KaRL VM: Single Assign            ",
+      "KaRL VM: Multiple Assign          ",
+      "KaRL VM: Extern Inc Func          ",
+      "KaRL VM: Extern Multi Calls       ",
       "KaRL: Looped Simple Increments    ",
       "KaRL: Optimized Loop              ",
       "KaRL: Looped Simple Ternary Inc   ",
       "KaRL: Looped Multiple Ternary Inc ",
+      "KaRL: Looped Array Add            ",
+      "KaRL: Vector Array Add (#vadd)    ",
+      "KaRL: Looped Dot Product          ",
+      "KaRL: Vector Dot Product (#vdot)  ",
       "KaRL: Get Variable Reference      ",
       "KaRL: Get Expanded Reference      ",
       "KaRL: Normal Set Operation        ",
@@ -333,6 +503,8 @@ int main(int argc, char* argv[])
       "KaRL container: Increments        ",
       "KaRL staged container: Assignment ",
       "KaRL staged container: Increments ",
+      "KaRL: 1k Counter Sum Expression   ",
+      "KaRL container: 1k Counter Reads  ",
       "C++: Optimized Assignments        ",
       "C++: Optimized Increments         ",
       "C++: Optimized Ternary Increments ",
@@ -358,12 +530,26 @@ int main(int argc, char* argv[])
     CompiledSA,
     CompiledLA,
     ExternCall,
+    ExternArgsCall,
+    NativeArgsCall,
     CompiledSFI,
     CompiledLFI,
+    BytecodeSR,
+    BytecodeLR,
+    BytecodeSI,
+    BytecodeLI,
+    BytecodeSA,
+    BytecodeLA,
+    BytecodeSFI,
+    BytecodeLFI,
     LoopedSR,
     OptimalLoop,
     LoopedSI,
     LoopedLI,
+    LoopedArrayAdd,
+    VectorArrayAdd,
+    LoopedDot,
+    VectorDot,
     GetVariableReference,
     GetExpandedReference,
     NormalSet,
@@ -373,6 +559,8 @@ int main(int argc, char* argv[])
     ContainerIncrement,
     StagedContainerAssignment,
     StagedContainerIncrement,
+    CounterSum,
+    CounterAggregate,
     OptimizedAssignment,
     OptimizedReinforcement,
     OptimizedInference,
@@ -402,14 +590,30 @@ int main(int argc, char* argv[])
   test_functions[CompiledLA] = test_compiled_la;
 
   test_functions[ExternCall] = test_extern_call;
+  test_functions[ExternArgsCall] = test_extern_args_call;
+  test_functions[NativeArgsCall] = test_native_args_call;
   test_functions[CompiledSFI] = test_compiled_sfi;
   test_functions[CompiledLFI] = test_compiled_lfi;
 
+  test_functions[BytecodeSR] = test_bytecode_sr;
+  test_functions[BytecodeLR] = test_bytecode_lr;
+  test_functions[BytecodeSI] = test_bytecode_si;
+  test_functions[BytecodeLI] = test_bytecode_li;
+  test_functions[BytecodeSA] = test_bytecode_sa;
+  test_functions[BytecodeLA] = test_bytecode_la;
+  test_functions[BytecodeSFI] = test_bytecode_sfi;
+  test_functions[BytecodeLFI] = test_bytecode_lfi;
+
   test_functions[LoopedSR] = test_looped_sr;
   test_functions[OptimalLoop] = test_optimal_loop;
   test_functions[LoopedSI] = test_looped_si;
   test_functions[LoopedLI] = test_looped_li;
 
+  test_functions[LoopedArrayAdd] = test_looped_array_add;
+  test_functions[VectorArrayAdd] = test_vector_array_add;
+  test_functions[LoopedDot] = test_looped_dot;
+  test_functions[VectorDot] = test_vector_dot;
+
   test_functions[GetExpandedReference] = test_get_expand_ref;
   test_functions[GetVariableReference] = test_get_ref;
   test_functions[NormalSet] = test_normal_set;
@@ -420,6 +624,8 @@ int main(int argc, char* argv[])
   test_functions[ContainerIncrement] = test_container_increment;
   test_functions[StagedContainerAssignment] = test_staged_container_assignment;
   test_functions[StagedContainerIncrement] = test_staged_container_increment;
+  test_functions[CounterSum] = test_counter_sum;
+  test_functions[CounterAggregate] = test_counter_aggregate;
 
   test_functions[OptimizedAssignment] = test_optimal_assignment;
   test_functions[OptimizedReinforcement] = test_optimal_reinforcement;
@@ -436,6 +642,9 @@ int main(int argc, char* argv[])
 #ifndef _MADARA_NO_KARL_
   knowledge.define_function("inc", increment_var1);
   knowledge.define_function("no_op", no_op);
+  knowledge.define_function("add_args", add_args);
+  knowledge.define_function<Integer(Integer, Integer)>(
+      "add_native", add_native);
   knowledge.define_function("inc_var_ref", increment_var1_through_variables);
 #endif
 
@@ -555,7 +764,7 @@ int main(int argc, char* argv[])
       "========================================================================"
       "=\n\n");
 
-  return 0;
+  return bytecode_mismatches;
 }
 
 long increment(bool check, long value)
@@ -724,6 +933,96 @@ uint64_t test_staged_container_increment(
   return measured;
 }
 
+/// Tests reading a counter by summing all of its variables, which is how
+/// Counter was read before it kept aggregates
+uint64_t test_counter_sum(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  knowledge.clear();
+
+#ifndef _MADARA_NO_KARL_
+  // keep track of time
+  uint64_t measured(0);
+  madara::utility::Timer<Clock> timer;
+
+  std::stringstream buffer;
+  buffer << "counter.0";
+
+  for (int i = 1; i < counter_participants; ++i)
+  {
+    std::stringstream name;
+    name << "counter." << i;
+
+    knowledge.set(name.str(), i);
+    buffer << "+" << name.str();
+  }
+
+  madara::knowledge::CompiledExpression ce = knowledge.compile(buffer.str());
+  madara::knowledge::EvalSettings settings(false, false, false);
+  Integer total(0);
+
+  timer.start();
+
+  for (uint32_t i = 0; i < iterations; ++i)
+  {
+    total += knowledge.evaluate(ce, settings).to_integer();
+  }
+
+  timer.stop();
+  measured = timer.duration_ns();
+
+  print(measured, madara::knowledge::KnowledgeRecord(total / iterations),
+      iterations, "Counter sum expression: ");
+
+  return measured;
+#else
+  return 0;
+#endif
+}
+
+/// Tests reading the aggregate of a counter
+uint64_t test_counter_aggregate(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  knowledge.clear();
+
+#ifndef _MADARA_NO_KARL_
+  // keep track of time
+  uint64_t measured(0);
+  madara::utility::Timer<Clock> timer;
+
+  madara::knowledge::containers::Counter counter("counter", knowledge, 0,
+      counter_participants, 0,
+      madara::knowledge::EvalSettings(false, false, false));
+
+  for (int i = 1; i < counter_participants; ++i)
+  {
+    std::stringstream buffer;
+    buffer << "counter." << i;
+    knowledge.set(buffer.str(), i);
+  }
+
+  Integer total(0);
+
+  timer.start();
+
+  for (uint32_t i = 0; i < iterations; ++i)
+  {
+    total += *counter;
+  }
+
+  timer.stop();
+  measured = timer.duration_ns();
+
+  print(measured, madara::knowledge::KnowledgeRecord(total / iterations),
+      iterations, "Counter aggregate: ");
+
+  return measured;
+#else
+  return 0;
+#endif
+}
+
 uint64_t test_compiled_sr(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
 {
@@ -731,7 +1030,7 @@ uint64_t test_compiled_sr(
 #ifndef _MADARA_NO_KARL_
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile("++.var1");
+  ce = compile(knowledge, "++.var1");
 
   // keep track of time
   uint64_t measured(0);
@@ -764,7 +1063,7 @@ uint64_t test_compiled_sa(
 #ifndef _MADARA_NO_KARL_
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile(".var1=1");
+  ce = compile(knowledge, ".var1=1");
 
   // keep track of time
   uint64_t measured(0);
@@ -798,7 +1097,7 @@ uint64_t test_compiled_sfi(
 #ifndef _MADARA_NO_KARL_
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile("inc ()");
+  ce = compile(knowledge, "inc ()");
 
   // keep track of time
   uint64_t measured(0);
@@ -858,6 +1157,53 @@ uint64_t test_extern_call(
 #endif
 }
 
+/// Calls a function that adds its arguments
+uint64_t test_function_args_call(madara::knowledge::KnowledgeBase& knowledge,
+    uint32_t iterations, const std::string& logic, const char* message)
+{
+  knowledge.clear();
+#ifndef _MADARA_NO_KARL_
+  madara::knowledge::CompiledExpression ce;
+
+  ce = knowledge.compile(logic);
+
+  // keep track of time
+  uint64_t measured(0);
+  madara::utility::Timer<Clock> timer;
+
+  timer.start();
+
+  for (uint32_t i = 0; i < iterations; ++i)
+  {
+    knowledge.evaluate(
+        ce, madara::knowledge::EvalSettings(false, false, false));
+  }
+
+  timer.stop();
+  measured = timer.duration_ns();
+
+  print(measured, knowledge.get(".var1"), iterations, message);
+
+  return measured;
+#else
+  return 0;
+#endif
+}
+
+uint64_t test_extern_args_call(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_function_args_call(knowledge, iterations,
+      ".var1 = add_args (.var1, 1)", "Extern call with args: ");
+}
+
+uint64_t test_native_args_call(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_function_args_call(knowledge, iterations,
+      ".var1 = add_native (.var1, 1)", "Native call with args: ");
+}
+
 /// Tests looped long inferences (++.var1)
 uint64_t test_looped_sr(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
@@ -963,7 +1309,7 @@ uint64_t test_compiled_lr(
 
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile(buffer.str());
+  ce = compile(knowledge, buffer.str());
 
   timer.start();
 
@@ -1010,7 +1356,7 @@ uint64_t test_compiled_la(
 
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile(buffer.str());
+  ce = compile(knowledge, buffer.str());
 
   timer.start();
 
@@ -1055,7 +1401,7 @@ uint64_t test_compiled_lfi(
 
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile(buffer.str());
+  ce = compile(knowledge, buffer.str());
 
   timer.start();
 
@@ -1388,7 +1734,7 @@ uint64_t test_compiled_si(
 
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile("1 => ++.var1");
+  ce = compile(knowledge, "1 => ++.var1");
 
   timer.start();
 
@@ -1511,7 +1857,7 @@ uint64_t test_compiled_li(
 
   madara::knowledge::CompiledExpression ce;
 
-  ce = knowledge.compile(buffer.str());
+  ce = compile(knowledge, buffer.str());
 
   timer.start();
 
@@ -1573,6 +1919,90 @@ uint64_t test_looped_li(
 #endif
 }
 
+/**
+ * Times array logic over arrays of up to 1000 elements, evaluated until
+ * iterations elements have been processed
+ **/
+uint64_t test_array_logic(madara::knowledge::KnowledgeBase& knowledge,
+    uint32_t iterations, const std::string& logic, const std::string& type)
+{
+  knowledge.clear();
+
+#ifndef _MADARA_NO_KARL_
+  // keep track of time
+  uint64_t measured(0);
+  madara::utility::Timer<Clock> timer;
+
+  unsigned size = iterations > 1000 ? 1000 : iterations;
+  unsigned actual_iterations = iterations > 1000 ? iterations / 1000 : 1;
+
+  std::vector<double> a(size), b(size);
+
+  for (unsigned i = 0; i < size; ++i)
+  {
+    a[i] = i * 0.5;
+    b[i] = size - i;
+  }
+
+  knowledge.set("a", a);
+  knowledge.set("b", b);
+  knowledge.set(".size", size);
+
+  madara::knowledge::CompiledExpression ce;
+
+  ce = knowledge.compile(logic);
+
+  timer.start();
+
+  for (uint32_t i = 0; i < actual_iterations; ++i)
+    knowledge.evaluate(
+        ce, madara::knowledge::EvalSettings(false, false, false));
+
+  timer.stop();
+  measured = timer.duration_ns();
+
+  print(measured, knowledge.get(".result"), iterations, type);
+
+  return measured;
+#else
+  return 0;
+#endif
+}
+
+/// Tests adding arrays one element at a time
+uint64_t test_looped_array_add(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_array_logic(knowledge, iterations,
+      ".i[0->.size) (c[.i] = a[.i] + b[.i]); .result = #size (c)",
+      "Looped Array Add: ");
+}
+
+/// Tests adding arrays with #vadd
+uint64_t test_vector_array_add(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_array_logic(knowledge, iterations,
+      ".result = #vadd (c, a, b)", "Vector Array Add: ");
+}
+
+/// Tests the dot product of arrays one element at a time
+uint64_t test_looped_dot(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_array_logic(knowledge, iterations,
+      ".result = 0; .i[0->.size) (.result += a[.i] * b[.i])",
+      "Looped Dot Product: ");
+}
+
+/// Tests the dot product of arrays with #vdot
+uint64_t test_vector_dot(
+    madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
+{
+  return test_array_logic(knowledge, iterations,
+      ".result = #vdot (a, b)", "Vector Dot Product: ");
+}
+
 /// Tests logicals operators (&&, ||)
 uint64_t test_optimal_inference(
     madara::knowledge::KnowledgeBase& knowledge, uint32_t iterations)
@@ -18,6 +18,7 @@ int parse_args(int argc, char* argv[]);
 
 // test functions
 void test_system_calls(madara::knowledge::KnowledgeBase& knowledge);
+void test_vector_system_calls(madara::knowledge::KnowledgeBase& knowledge);
 
 int main(int argc, char* argv[])
 {
@@ -29,6 +30,7 @@ int main(int argc, char* argv[])
   madara::knowledge::KnowledgeBase knowledge;
 
   test_system_calls(knowledge);
+  test_vector_system_calls(knowledge);
 
   knowledge.print();
 
@@ -193,6 +195,115 @@ void test_system_calls(madara::knowledge::KnowledgeBase& knowledge)
 #endif
 }
 
+/**
+ * Checks that an array in the knowledge base holds the expected elements
+ **/
+template<typename T>
+void check_array(madara::knowledge::KnowledgeBase& knowledge,
+    const std::string& name, uint32_t type, const std::vector<T>& expected)
+{
+  KnowledgeRecord record = knowledge.get(name);
+  std::vector<double> actual = record.to_doubles();
+  bool same = record.type() == type && actual.size() == expected.size();
+
+  for (size_t i = 0; same && i < actual.size(); ++i)
+  {
+    same = actual[i] == (double)expected[i];
+  }
+
+  if (!same)
+  {
+    std::cerr << "FAIL: " << name << " is [" << record.to_string(", ")
+              << "] of type " << record.type() << ".\n";
+    ++madara_fails;
+  }
+}
+
+/// Tests the system calls that do arithmetic over whole arrays
+void test_vector_system_calls(madara::knowledge::KnowledgeBase& knowledge)
+{
+#ifndef _MADARA_NO_KARL_
+  typedef KnowledgeRecord::Integer Integer;
+
+  std::cerr << "Testing vector system calls...\n";
+
+  knowledge.set("vints", std::vector<Integer>{1, 2, 3, 4, 5});
+  knowledge.set("vreals", std::vector<double>{0.5, 1.5, 2.5, 3.5, 4.5, 5.5});
+
+  knowledge.evaluate("vsum_ints = #vsum (vints);"
+                     "vsum_reals = #vsum (vreals);"
+                     "vmin_ints = #vmin (vints);"
+                     "vmax_reals = #vmax (vreals);"
+                     "vdot = #vdot (vints, vints);"
+                     "vwritten = #vadd (vsums, vints, vreals);"
+                     "#vmul (vsquares, vints, vints);"
+                     "#vscale (vhalves, vints, 0.5);"
+                     "#vclamp (vclamped, vreals, 1, 4);"
+                     "#vadd (vshifted, vints, 10);"
+                     "vcopy = vints;"
+                     "#vadd (vcopy, vcopy, 1)");
+
+  if (knowledge.get("vsum_ints").type() != KnowledgeRecord::INTEGER ||
+      knowledge.get("vsum_ints").to_integer() != 15 ||
+      knowledge.get("vsum_reals").to_double() != 18.0 ||
+      knowledge.get("vmin_ints").to_integer() != 1 ||
+      knowledge.get("vmax_reals").to_double() != 5.5 ||
+      knowledge.evaluate("#vmax (vempty)").exists() ||
+      knowledge.get("vdot").to_integer() != 55 ||
+      knowledge.get("vwritten").to_integer() != 5)
+  {
+    std::cerr << "FAIL: vector reductions returned the wrong values.\n";
+    ++madara_fails;
+  }
+
+  check_array(knowledge, "vsums", KnowledgeRecord::DOUBLE_ARRAY,
+      std::vector<double>{1.5, 3.5, 5.5, 7.5, 9.5});
+  check_array(knowledge, "vsquares", KnowledgeRecord::INTEGER_ARRAY,
+      std::vector<Integer>{1, 4, 9, 16, 25});
+  check_array(knowledge, "vhalves", KnowledgeRecord::DOUBLE_ARRAY,
+      std::vector<double>{0.5, 1, 1.5, 2, 2.5});
+  check_array(knowledge, "vclamped", KnowledgeRecord::DOUBLE_ARRAY,
+      std::vector<double>{1, 1.5, 2.5, 3.5, 4, 4});
+  check_array(knowledge, "vshifted", KnowledgeRecord::INTEGER_ARRAY,
+      std::vector<Integer>{11, 12, 13, 14, 15});
+
+  // writing a copy must not change the array it was copied from
+  check_array(knowledge, "vcopy", KnowledgeRecord::INTEGER_ARRAY,
+      std::vector<Integer>{2, 3, 4, 5, 6});
+  check_array(knowledge, "vints", KnowledgeRecord::INTEGER_ARRAY,
+      std::vector<Integer>{1, 2, 3, 4, 5});
+
+  // an array that is not shared is written in place
+  const std::vector<double>* before =
+      knowledge.get_context().get_record("vsums")->peek_doubles();
+
+  knowledge.evaluate("#vadd (vsums, vsums, vsums)");
+
+  if (knowledge.get_context().get_record("vsums")->peek_doubles() != before)
+  {
+    std::cerr << "FAIL: #vadd did not write vsums in place.\n";
+    ++madara_fails;
+  }
+
+  check_array(knowledge, "vsums", KnowledgeRecord::DOUBLE_ARRAY,
+      std::vector<double>{3, 7, 11, 15, 19});
+
+  // the first argument of calls that write must be a variable
+  try
+  {
+    knowledge.evaluate("#vadd (1, vints, vints)");
+
+    std::cerr << "FAIL: #vadd accepted a target that is not a variable.\n";
+    ++madara_fails;
+  }
+  catch (madara::exceptions::KarlException&)
+  {
+  }
+#else
+  std::cout << "This test is disabled due to karl feature being disabled.\n";
+#endif
+}
+
 int parse_args(int argc, char* argv[])
 {
   for (int i = 1; i < argc; ++i)
@@ -0,0 +1,241 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/Timer.h"
+
+namespace logger = madara::logger;
+namespace knowledge = madara::knowledge;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+typedef std::chrono::steady_clock Clock;
+
+// default settings
+uint32_t num_waiters = 50;
+uint32_t num_updates = 10000;
+
+std::atomic<int> madara_fails(0);
+
+void handle_arguments(int argc, char* argv[]);
+
+// how waiters are woken
+enum WakeMode
+{
+  ANY_CHANGE,
+  PER_VARIABLE
+};
+
+/**
+ * Each waiter blocks until its own ready flag is set. Reading the time
+ * keeps the context from knowing which variables an expression reads, so
+ * it falls back to waking on any change.
+ **/
+void waiter(knowledge::KnowledgeBase& kb, uint32_t id, WakeMode mode,
+    std::atomic<uint32_t>& started, std::atomic<uint32_t>& finished)
+{
+  std::stringstream buffer;
+
+  if (mode == ANY_CHANGE)
+    buffer << "#get_time () > 0 && ";
+
+  buffer << "ready." << id << " == 1";
+
+  knowledge::CompiledExpression expression = kb.compile(buffer.str());
+
+  knowledge::WaitSettings settings;
+  settings.poll_frequency = 0;
+  settings.max_wait_time = 60;
+
+  ++started;
+
+  if (!kb.wait(expression, settings).is_true())
+  {
+    std::cerr << "FAIL: waiter " << id << " timed out.\n";
+    ++madara_fails;
+  }
+
+  ++finished;
+}
+
+uint64_t run_test(uint32_t waiters, WakeMode mode)
+{
+  knowledge::KnowledgeBase kb;
+  std::atomic<uint32_t> started(0), finished(0);
+  std::vector<std::thread> threads;
+
+  for (uint32_t i = 0; i < waiters; ++i)
+  {
+    threads.emplace_back(
+        waiter, std::ref(kb), i, mode, std::ref(started), std::ref(finished));
+  }
+
+  // give the waiters time to block
+  while (started.load() < waiters)
+    std::this_thread::yield();
+
+  madara::utility::sleep(0.1);
+
+  madara::utility::Timer<Clock> timer;
+  timer.start();
+
+  // updates that no waiter is waiting for
+  for (uint32_t i = 0; i < num_updates; ++i)
+    kb.set("noise", (Integer)i);
+
+  for (uint32_t i = 0; i < waiters; ++i)
+  {
+    std::stringstream buffer;
+    buffer << "ready." << i;
+    kb.set(buffer.str(), (Integer)1);
+  }
+
+  // waiters on any change may miss a wakeup between evaluations
+  while (finished.load() < waiters)
+  {
+    kb.get_context().signal();
+    std::this_thread::yield();
+  }
+
+  timer.stop();
+
+  for (auto& thread : threads)
+    thread.join();
+
+  return timer.duration_ns();
+}
+
+int main(int argc, char* argv[])
+{
+  handle_arguments(argc, argv);
+
+#ifndef _MADARA_NO_KARL_
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Testing update throughput with blocked waiters for MADARA v%s\n"
+      "  updates per run: %d\n\n",
+      madara::utility::get_version().c_str(), num_updates);
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      " waiters   any change (updates/s)   per variable (updates/s)\n"
+      "=============================================================\n");
+
+  for (uint32_t waiters = 1; waiters <= num_waiters; waiters *= 2)
+  {
+    uint64_t total_updates = (uint64_t)num_updates + waiters;
+
+    uint64_t any_change = run_test(waiters, ANY_CHANGE);
+    uint64_t per_variable = run_test(waiters, PER_VARIABLE);
+
+    if (any_change == 0)
+      any_change = 1;
+    if (per_variable == 0)
+      per_variable = 1;
+
+    std::stringstream buffer;
+    std::locale loc("C");
+    buffer.imbue(loc);
+
+    buffer << " " << std::setw(7) << waiters;
+    buffer << " " << std::setw(24)
+           << (total_updates * 1000000000) / any_change;
+    buffer << " " << std::setw(26)
+           << (total_updates * 1000000000) / per_variable;
+    buffer << "\n";
+
+    madara_logger_ptr_log(
+        logger::global_logger.get(), logger::LOG_ALWAYS, buffer.str().c_str());
+
+    // make sure the largest waiter count is always measured
+    if (waiters < num_waiters && waiters * 2 > num_waiters)
+      waiters = num_waiters / 2;
+  }
+#else
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "This test is disabled due to karl feature being disabled.\n");
+#endif
+
+  if (madara_fails > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_fails << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_fails;
+}
+
+void handle_arguments(int argc, char* argv[])
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-f" || arg1 == "--logfile")
+    {
+      if (i + 1 < argc)
+      {
+        logger::global_logger->add_file(argv[i + 1]);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--updates")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_updates;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-w" || arg1 == "--waiters")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_waiters;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Measures how fast one thread can update a knowledge base while\n"
+          "  other threads are blocked in wait. Waiters on expressions that\n"
+          "  read known variables are woken only when those variables\n"
+          "  change. Waiters on any change wake for every update.\n\n"
+          " [-f|--logfile file]      log to a file\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--updates num]       unrelated updates per run\n"
+          " [-w|--waiters num]       maximum number of waiting threads "
+          "(default: 50)\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
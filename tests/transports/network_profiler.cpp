@@ -145,10 +145,22 @@ void handle_arguments(int argc, char** argv)
 
       ++i;
     }
+    else if (arg1 == "--intern-keys")
+    {
+      settings.intern_keys = true;
+    }
     else if (arg1 == "-r" || arg1 == "--reduced")
     {
       settings.send_reduced_message_header = true;
     }
+    else if (arg1 == "--batched-sends")
+    {
+      settings.batched_sends = true;
+    }
+    else if (arg1 == "--event-reads")
+    {
+      settings.event_driven_reads = true;
+    }
     else if (arg1 == "-s" || arg1 == "--size")
     {
       if (i + 1 < argc)
@@ -209,12 +221,17 @@ void handle_arguments(int argc, char** argv)
           " [-a|--no-latency]        do not test for latency (throughput "
           "only)\n"
           " [-b|--broadcast ip:port] the broadcast ip to send and listen to\n"
+          " [--batched-sends]        gather fragments and destinations into\n"
+          "                          as few send calls as possible\n"
           " [-d|--domain domain]     the knowledge domain to send and listen "
           "to\n"
           " [-e|--threads threads]   number of read threads\n"
+          " [--event-reads]          read threads wait on the socket instead\n"
+          "                          of polling at the read thread hertz\n"
           " [-f|--logfile file]      log to a file\n"
           " [-i|--id id]             the id of this agent (should be "
           "non-negative)\n"
+          " [--intern-keys]          send variable names as small ids\n"
           " [-l|--level level]       the logger level (0+, higher is higher "
           "detail)\n"
           " [-m|--multicast ip:port] the multicast ip to send and listen to\n"
@@ -313,6 +330,9 @@ int main(int argc, char** argv)
       num_vars = 1;
     }
 
+    // keep track of bytes sent to report the cost of each update
+    settings.debug_to_kb(".profiler");
+
     // setup a knowledge base
     knowledge::KnowledgeBase kb(host, settings);
     unsigned char* data = new unsigned char[data_size];
@@ -341,6 +361,7 @@ int main(int argc, char** argv)
     // use epoch enforcer"
 
     utility::EpochEnforcer<utility::Clock> enforcer(1 / send_hertz, test_time);
+    uint64_t sends = 0;
 
     while (!enforcer.is_done())
     {
@@ -351,6 +372,7 @@ int main(int argc, char** argv)
 
       kb.mark_modified(num_vars_ref);
       kb.send_modifieds();
+      ++sends;
 
       if (send_hertz > 0.0)
       {
@@ -364,6 +386,15 @@ int main(int argc, char** argv)
 
     delete[] data;
 
+    uint64_t sent_data = (uint64_t)kb.get(".profiler.sent_data").to_integer();
+
+    if (sends > 0 && sent_data > 0)
+    {
+      std::cerr << "Sent " << sent_data << " B in " << sends << " sends ("
+                << sent_data / (sends * (num_vars + 1))
+                << " B per update)\n";
+    }
+
     std::cerr << "Publisher is done. Check results on subscriber.\n";
   }  // end publisher
   else
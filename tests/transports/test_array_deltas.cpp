@@ -0,0 +1,311 @@
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/transport/Transport.h"
+
+#include "../test.h"
+
+namespace knowledge = madara::knowledge;
+namespace transport = madara::transport;
+namespace logger = madara::logger;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+
+// number of elements in the shared map
+size_t map_size = 10000;
+
+// sends of the map between full snapshots
+uint32_t interval = 5;
+
+/**
+ * Transport that keeps the last message it was asked to send, so the
+ * test can feed it to process_received_update
+ **/
+class CaptureTransport : public transport::Base
+{
+public:
+  CaptureTransport(knowledge::ThreadSafeContext& context,
+      transport::TransportSettings& settings)
+    : transport::Base("sender", settings, context)
+  {
+    setup();
+  }
+
+  long send_data(const knowledge::VariableReferenceMap& updates) override
+  {
+    long result = prep_send(updates, "CaptureTransport::send_data");
+
+    if (result > 0)
+    {
+      message.assign(buffer_.get_ptr(), (size_t)result);
+    }
+
+    return result;
+  }
+
+  std::string message;
+};
+
+knowledge::KnowledgeRecord pass_through(
+    knowledge::FunctionArguments& args, knowledge::Variables&)
+{
+  return args.size() > 0 ? args[0] : knowledge::KnowledgeRecord();
+}
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-s" || arg1 == "--size")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> map_size;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Tests sending large arrays as deltas and reports the bytes\n"
+          "  sent for a full array and for a change to one element.\n\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-s|--size size]         elements in the array\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
+
+/**
+ * Passes a message to a knowledge base as if it had been received
+ **/
+void receive(knowledge::KnowledgeBase& receiver, const std::string& message,
+    const transport::QoSTransportSettings& settings)
+{
+  transport::BandwidthMonitor send_monitor, receive_monitor;
+  knowledge::KnowledgeMap rebroadcast_records;
+#ifndef _MADARA_NO_KARL_
+  knowledge::CompiledExpression on_data_received;
+#endif  // _MADARA_NO_KARL_
+
+  std::vector<char> buffer(message.begin(), message.end());
+
+  transport::MessageHeader* header = 0;
+  transport::process_received_update(buffer.data(), (uint32_t)buffer.size(),
+      "receiver", receiver.get_context(), settings, send_monitor,
+      receive_monitor, rebroadcast_records,
+#ifndef _MADARA_NO_KARL_
+      on_data_received,
+#endif  // _MADARA_NO_KARL_
+      "test_array_deltas", "127.0.0.1:40000", header);
+
+  delete header;
+}
+
+/**
+ * Checks if a receiver holds the same elements as the sender
+ **/
+bool same(knowledge::KnowledgeBase& receiver, knowledge::KnowledgeBase& sender,
+    const std::string& key)
+{
+  knowledge::KnowledgeRecord lhs = receiver.get(key);
+  knowledge::KnowledgeRecord rhs = sender.get(key);
+
+  return lhs.type() == rhs.type() && lhs.to_doubles() == rhs.to_doubles();
+}
+
+transport::QoSTransportSettings receiver_settings(bool filtered)
+{
+  transport::QoSTransportSettings settings;
+  settings.add_read_domain(settings.write_domain);
+
+  if (filtered)
+  {
+    settings.add_receive_filter(
+        knowledge::KnowledgeRecord::ALL_TYPES, pass_through);
+  }
+
+  return settings;
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  const knowledge::EvalSettings& delay = knowledge::EvalSettings::DELAY;
+
+  knowledge::KnowledgeBase sender;
+  transport::TransportSettings sender_settings;
+  sender_settings.array_delta_interval = interval;
+  sender_settings.queue_length = (uint32_t)(map_size * 8 + 100000);
+  CaptureTransport* capture =
+      new CaptureTransport(sender.get_context(), sender_settings);
+  sender.attach_transport(capture);
+
+  knowledge::KnowledgeBase receiver, filtered_receiver, history_receiver;
+  transport::QoSTransportSettings settings = receiver_settings(false);
+  transport::QoSTransportSettings filtered = receiver_settings(true);
+
+  // the first send of the map is always in full
+  sender.set("map", std::vector<double>(map_size, 0.5), delay);
+  sender.set("counts", std::vector<Integer>(1000, 3), delay);
+  sender.set("small", std::vector<Integer>(10, 1), delay);
+  sender.send_modifieds();
+
+  std::string full = capture->message;
+
+  receive(receiver, full, settings);
+  receive(filtered_receiver, full, filtered);
+  receive(history_receiver, full, settings);
+
+  // deltas patch the newest value of a history, without receive filters
+  history_receiver.set_history_capacity("map", interval);
+
+  TEST_EQ(receiver.get("map").size(), (uint32_t)map_size);
+  TEST_EQ(filtered_receiver.get("map").size(), (uint32_t)map_size);
+
+  log("Testing that changes to one element send only that element\n");
+
+  knowledge::KnowledgeRecord held = receiver.get("map");
+
+  sender.set_index("map", map_size / 2, 7.25, delay);
+  sender.set_index("counts", 0, (Integer)4, delay);
+  sender.set_index("counts", 999, (Integer)5, delay);
+  sender.set_index("small", 0, (Integer)2, delay);
+  sender.send_modifieds();
+
+  std::string delta = capture->message;
+
+  log("  %d B for the full arrays, %d B for the changes\n", (int)full.size(),
+      (int)delta.size());
+
+  TEST_LT(delta.size() * 100, full.size());
+
+  receive(receiver, delta, settings);
+  receive(filtered_receiver, delta, filtered);
+  receive(history_receiver, delta, settings);
+
+  for (auto kb : {&receiver, &filtered_receiver, &history_receiver})
+  {
+    TEST_EQ(same(*kb, sender, "map"), true);
+    TEST_EQ(same(*kb, sender, "counts"), true);
+    TEST_EQ(same(*kb, sender, "small"), true);
+  }
+
+  // records that were handed out keep the value they had
+  TEST_EQ(held.retrieve_index(map_size / 2).to_double(), 0.5);
+
+  log("Testing that deltas are dropped by receivers without the base\n");
+
+  knowledge::KnowledgeBase late_receiver;
+  receive(late_receiver, delta, settings);
+
+  TEST_EQ(late_receiver.exists("map"), false);
+  TEST_EQ(same(late_receiver, sender, "small"), true);
+
+  log("Testing that deltas are dropped by receivers holding another value "
+      "of the same size at the same clock\n");
+
+  std::vector<Integer> elements(100, 1);
+  knowledge::KnowledgeRecord base(elements);
+  elements[3] = 2;
+  knowledge::KnowledgeRecord next(elements);
+  elements[3] = 1;
+  elements[50] = 9;
+  knowledge::KnowledgeRecord other(elements);
+  base.clock = other.clock = 5;
+
+  std::vector<char> buffer(4096);
+  int64_t remaining = (int64_t)buffer.size();
+  next.write_delta(buffer.data(), base, 5, remaining);
+  remaining = (int64_t)buffer.size() - remaining;
+
+  TEST_EQ(base.can_apply_delta(buffer.data(), remaining), true);
+  TEST_EQ(other.can_apply_delta(buffer.data(), remaining), false);
+
+  base.read(buffer.data(), remaining);
+  TEST_EQ(base.to_integers() == next.to_integers(), true);
+
+  // a local change means the receiver no longer holds the base
+  receiver.set_index("map", 0, 99.0);
+
+  for (uint32_t i = 0; i + 2 < interval; ++i)
+  {
+    sender.set_index("map", i, 1.0 + i, delay);
+    sender.send_modifieds();
+
+    receive(receiver, capture->message, settings);
+    receive(late_receiver, capture->message, settings);
+    receive(filtered_receiver, capture->message, filtered);
+    receive(history_receiver, capture->message, settings);
+
+    TEST_EQ(same(filtered_receiver, sender, "map"), true);
+    TEST_EQ(same(history_receiver, sender, "map"), true);
+  }
+
+  // every delta was added to the history
+  TEST_EQ(history_receiver.get_history_size("map"), (size_t)interval);
+
+  TEST_EQ(same(receiver, sender, "map"), false);
+  TEST_EQ(late_receiver.exists("map"), false);
+
+  log("Testing that every receiver catches up at the next snapshot\n");
+
+  sender.set_index("map", 1, 2.5, delay);
+  sender.send_modifieds();
+
+  TEST_GT(capture->message.size(), map_size * 8);
+
+  receive(receiver, capture->message, settings);
+  receive(late_receiver, capture->message, settings);
+  receive(filtered_receiver, capture->message, filtered);
+
+  for (auto kb : {&receiver, &late_receiver, &filtered_receiver})
+  {
+    TEST_EQ(same(*kb, sender, "map"), true);
+  }
+
+  log("Testing that resized arrays are sent in full\n");
+
+  sender.set("map", std::vector<double>(map_size + 1, 1.5), delay);
+  sender.send_modifieds();
+
+  receive(receiver, capture->message, settings);
+  TEST_EQ(same(receiver, sender, "map"), true);
+
+  if (madara_tests_fail_count > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_tests_fail_count
+              << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_tests_fail_count;
+}
@@ -0,0 +1,290 @@
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <atomic>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/transport/Transport.h"
+#include "madara/utility/Timer.h"
+
+#include "../test.h"
+
+namespace knowledge = madara::knowledge;
+namespace transport = madara::transport;
+namespace logger = madara::logger;
+namespace utility = madara::utility;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+typedef std::chrono::steady_clock Clock;
+
+// simulated network latency per send_data call
+double send_latency = 0.01;
+
+// number of send_modifieds calls per test
+int num_sends = 50;
+
+/**
+ * Transport that only records what it was asked to send, after a delay
+ * that stands in for a blocking socket send
+ **/
+class SlowTransport : public transport::Base
+{
+public:
+  SlowTransport(knowledge::ThreadSafeContext& context,
+      transport::TransportSettings& settings)
+    : transport::Base("slow", settings, context)
+  {
+    setup();
+  }
+
+  ~SlowTransport()
+  {
+    close();
+  }
+
+  long send_data(const knowledge::VariableReferenceMap& updates) override
+  {
+    utility::sleep(send_latency);
+
+    ++sends;
+    records += (int)updates.size();
+
+    auto found = updates.find("value");
+    if (found != updates.end())
+    {
+      last_value = found->second.get_record_unsafe()->to_integer();
+    }
+
+    return (long)updates.size();
+  }
+
+  std::atomic<int> sends{0};
+  std::atomic<int> records{0};
+  std::atomic<Integer> last_value{-1};
+};
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--sends")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_sends;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Tests the asynchronous send queue of transports and compares\n"
+          "  caller latency of send_modifieds with synchronous sending.\n\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--sends num]         number of sends per test\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
+
+/**
+ * Sets a variable num_sends times and returns the average caller latency
+ * of each set in nanoseconds
+ **/
+uint64_t run_sets(knowledge::KnowledgeBase& kb)
+{
+  madara::utility::Timer<Clock> timer;
+  timer.start();
+
+  for (int i = 0; i < num_sends; ++i)
+  {
+    kb.set("value", (Integer)i, knowledge::EvalSettings::SEND);
+  }
+
+  timer.stop();
+
+  return timer.duration_ns() / num_sends;
+}
+
+void test_sync(uint64_t& latency)
+{
+  log("Testing synchronous sends\n");
+
+  knowledge::KnowledgeBase kb;
+  transport::TransportSettings settings;
+  SlowTransport* slow = new SlowTransport(kb.get_context(), settings);
+  kb.attach_transport(slow);
+
+  TEST_EQ(slow->is_async_send(), false);
+
+  latency = run_sets(kb);
+
+  TEST_EQ(slow->sends.load(), num_sends);
+  TEST_EQ(slow->last_value.load(), (Integer)num_sends - 1);
+  TEST_EQ(kb.flush_sends(1.0), true);
+}
+
+void test_coalesce(uint64_t& latency)
+{
+  log("Testing asynchronous sends with SEND_QUEUE_COALESCE\n");
+
+  knowledge::KnowledgeBase kb;
+  transport::TransportSettings settings;
+  settings.async_send = true;
+  settings.send_queue_size = 4;
+  settings.send_queue_policy = transport::SEND_QUEUE_COALESCE;
+
+  SlowTransport* slow = new SlowTransport(kb.get_context(), settings);
+  kb.attach_transport(slow);
+
+  TEST_EQ(slow->is_async_send(), true);
+
+  latency = run_sets(kb);
+
+  TEST_EQ(kb.flush_sends(), true);
+  TEST_EQ(slow->pending_sends(), (size_t)0);
+  TEST_EQ(slow->sends_completed(), (uint64_t)num_sends);
+  TEST_EQ(slow->sends_dropped(), (uint64_t)0);
+
+  // coalescing may merge batches, but never loses the latest value
+  TEST_LE(slow->sends.load(), num_sends);
+  TEST_EQ(slow->last_value.load(), (Integer)num_sends - 1);
+}
+
+void test_drop_oldest(void)
+{
+  log("Testing asynchronous sends with SEND_QUEUE_DROP_OLDEST\n");
+
+  knowledge::KnowledgeBase kb;
+  transport::TransportSettings settings;
+  settings.async_send = true;
+  settings.send_queue_size = 2;
+  settings.send_queue_policy = transport::SEND_QUEUE_DROP_OLDEST;
+
+  SlowTransport* slow = new SlowTransport(kb.get_context(), settings);
+  kb.attach_transport(slow);
+
+  run_sets(kb);
+
+  TEST_EQ(kb.flush_sends(), true);
+  TEST_EQ(slow->pending_sends(), (size_t)0);
+  TEST_EQ(
+      (uint64_t)slow->sends.load() + slow->sends_dropped(), (uint64_t)num_sends);
+  TEST_EQ(slow->last_value.load(), (Integer)num_sends - 1);
+}
+
+void test_block(void)
+{
+  log("Testing asynchronous sends with SEND_QUEUE_BLOCK\n");
+
+  knowledge::KnowledgeBase kb;
+  transport::TransportSettings settings;
+  settings.async_send = true;
+  settings.send_queue_size = 2;
+  settings.send_queue_policy = transport::SEND_QUEUE_BLOCK;
+
+  SlowTransport* slow = new SlowTransport(kb.get_context(), settings);
+  kb.attach_transport(slow);
+
+  run_sets(kb);
+
+  TEST_EQ(kb.flush_sends(), true);
+  TEST_EQ(slow->sends.load(), num_sends);
+  TEST_EQ(slow->sends_dropped(), (uint64_t)0);
+  TEST_EQ(slow->last_value.load(), (Integer)num_sends - 1);
+
+  // the send thread may need the context lock, so blocking is refused
+  settings.debug_to_kb_prefix = "slow_debug";
+  SlowTransport debugged(kb.get_context(), settings);
+
+  TEST_EQ(debugged.settings().send_queue_policy,
+      (uint32_t)transport::SEND_QUEUE_COALESCE);
+}
+
+void test_close_drains(void)
+{
+  log("Testing that closing a transport sends what is queued\n");
+
+  knowledge::KnowledgeBase kb;
+  transport::TransportSettings settings;
+  settings.async_send = true;
+  settings.send_queue_size = 1000;
+
+  SlowTransport slow(kb.get_context(), settings);
+
+  knowledge::KnowledgeMap map;
+  map["value"] = knowledge::KnowledgeRecord(Integer(42));
+
+  knowledge::VariableReferenceMap updates;
+  updates.emplace("value", knowledge::VariableReference(&*map.begin()));
+
+  uint64_t ticket = 0;
+  for (int i = 0; i < 5; ++i)
+  {
+    ticket = slow.queue_data(updates);
+  }
+
+  TEST_EQ(ticket, (uint64_t)5);
+
+  slow.close();
+
+  TEST_EQ(slow.sends.load(), 5);
+  TEST_EQ(slow.sends_completed(), ticket);
+  TEST_EQ(slow.last_value.load(), (Integer)42);
+
+  // nothing is accepted after close
+  TEST_EQ(slow.queue_data(updates), (uint64_t)0);
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  uint64_t sync_latency = 0, async_latency = 0;
+
+  test_sync(sync_latency);
+  test_coalesce(async_latency);
+  test_drop_oldest();
+  test_block();
+  test_close_drains();
+
+  log("Average caller latency of set with %f s network latency:\n"
+      "  synchronous:  %" PRIu64 " ns\n"
+      "  asynchronous: %" PRIu64 " ns\n",
+      send_latency, sync_latency, async_latency);
+
+  TEST_LT(async_latency, sync_latency);
+
+  if (madara_tests_fail_count > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_tests_fail_count
+              << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_tests_fail_count;
+}
@@ -0,0 +1,427 @@
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/transport/Transport.h"
+
+#include "../test.h"
+
+namespace knowledge = madara::knowledge;
+namespace transport = madara::transport;
+namespace logger = madara::logger;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+
+// every heap allocation made by the process
+std::atomic<uint64_t> allocations(0);
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+
+  void* result = std::malloc(size > 0 ? size : 1);
+
+  if (!result)
+    throw std::bad_alloc();
+
+  return result;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+// number of times each message is received per measurement
+int num_iterations = 1000;
+
+// number of agents whose variables are in each message
+int num_agents = 10;
+
+/**
+ * Transport that keeps the last message it was asked to send, so the
+ * test can feed it to process_received_update
+ **/
+class CaptureTransport : public transport::Base
+{
+public:
+  CaptureTransport(knowledge::ThreadSafeContext& context,
+      transport::TransportSettings& settings)
+    : transport::Base("sender", settings, context)
+  {
+    setup();
+  }
+
+  long send_data(const knowledge::VariableReferenceMap& updates) override
+  {
+    long result = prep_send(updates, "CaptureTransport::send_data");
+
+    if (result > 0)
+    {
+      message.assign(buffer_.get_ptr(), (size_t)result);
+    }
+
+    settings_.key_dictionary.confirm_sends(result > 0);
+
+    return result;
+  }
+
+  std::string message;
+};
+
+knowledge::KnowledgeRecord pass_through(
+    knowledge::FunctionArguments& args, knowledge::Variables&)
+{
+  return args.size() > 0 ? args[0] : knowledge::KnowledgeRecord();
+}
+
+void pass_through_in_place(knowledge::KnowledgeRecord&, const std::string&,
+    transport::TransportContext&)
+{
+}
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-a" || arg1 == "--agents")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_agents;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--iterations")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_iterations;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Counts heap allocations made while receiving updates, with\n"
+          "  and without receive filters.\n\n"
+          " [-a|--agents num]        agents whose variables are sent\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--iterations num]    times each message is received\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
+
+/**
+ * Sets five variables of each agent, of every common type, and returns
+ * the message the sender puts on the wire for them
+ **/
+std::string build_message(knowledge::KnowledgeBase& sender,
+    CaptureTransport& capture, Integer seed)
+{
+  const knowledge::EvalSettings& delay = knowledge::EvalSettings::DELAY;
+
+  for (int i = 0; i < num_agents; ++i)
+  {
+    std::stringstream prefix;
+    prefix << "agent." << i << ".";
+
+    std::vector<double> position = {1.0 * i, 2.0 * seed, 3.0};
+    std::vector<Integer> readings(64, seed + i);
+
+    sender.set(prefix.str() + "state", seed + i, delay);
+    sender.set(prefix.str() + "battery", 0.5 * seed, delay);
+    sender.set(prefix.str() + "position", position, delay);
+    sender.set(prefix.str() + "readings", readings, delay);
+    sender.set(prefix.str() + "name",
+        prefix.str() + "name is too long for a small string buffer", delay);
+  }
+
+  sender.send_modifieds();
+
+  return capture.message;
+}
+
+/**
+ * Receives message num_iterations times and returns the allocations made
+ **/
+uint64_t receive(knowledge::KnowledgeBase& receiver,
+    const std::string& message, const transport::QoSTransportSettings& settings)
+{
+  transport::BandwidthMonitor send_monitor, receive_monitor;
+  knowledge::KnowledgeMap rebroadcast_records;
+#ifndef _MADARA_NO_KARL_
+  knowledge::CompiledExpression on_data_received;
+#endif  // _MADARA_NO_KARL_
+
+  std::vector<char> buffer(message.size());
+  uint64_t before = 0;
+
+  // the first pass creates the variables and is not counted
+  for (int i = 0; i <= num_iterations; ++i)
+  {
+    if (i == 1)
+    {
+      before = allocations.load();
+    }
+
+    memcpy(buffer.data(), message.data(), message.size());
+
+    transport::MessageHeader* header = 0;
+    transport::process_received_update(buffer.data(), (uint32_t)buffer.size(),
+        "receiver", receiver.get_context(), settings, send_monitor,
+        receive_monitor, rebroadcast_records,
+#ifndef _MADARA_NO_KARL_
+        on_data_received,
+#endif  // _MADARA_NO_KARL_
+        "test_receive_allocations", "127.0.0.1:40000", header);
+
+    delete header;
+  }
+
+  return allocations.load() - before;
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  if (num_iterations < 1 || num_agents < 1)
+  {
+    num_iterations = 1000;
+    num_agents = 10;
+  }
+
+  knowledge::KnowledgeBase sender;
+  transport::TransportSettings sender_settings;
+  CaptureTransport* capture =
+      new CaptureTransport(sender.get_context(), sender_settings);
+  sender.attach_transport(capture);
+
+  std::string message = build_message(sender, *capture, 7);
+  uint64_t updates = (uint64_t)num_iterations * num_agents * 5;
+
+  TEST_GT(message.size(), (size_t)0);
+
+  log("Receiving %d updates per message, %d times\n", num_agents * 5,
+      num_iterations);
+
+  transport::QoSTransportSettings filtered_settings;
+  filtered_settings.add_read_domain(filtered_settings.write_domain);
+  filtered_settings.add_receive_filter(
+      knowledge::KnowledgeRecord::ALL_TYPES, pass_through);
+
+  knowledge::KnowledgeBase filtered_receiver;
+  uint64_t filtered = receive(filtered_receiver, message, filtered_settings);
+
+  transport::QoSTransportSettings direct_settings;
+  direct_settings.add_read_domain(direct_settings.write_domain);
+  knowledge::KnowledgeBase direct_receiver;
+  uint64_t direct = receive(direct_receiver, message, direct_settings);
+
+  transport::QoSTransportSettings in_place_settings;
+  in_place_settings.add_read_domain(in_place_settings.write_domain);
+  in_place_settings.add_receive_filter(
+      knowledge::KnowledgeRecord::ALL_TYPES, pass_through_in_place);
+
+  knowledge::KnowledgeBase in_place_receiver;
+  uint64_t in_place = receive(in_place_receiver, message, in_place_settings);
+
+  log("Allocations per update:\n"
+      "  with receive filter:    %.2f\n"
+      "  with in-place filter:   %.2f\n"
+      "  without receive filter: %.2f\n",
+      (double)filtered / updates, (double)in_place / updates,
+      (double)direct / updates);
+
+  // both paths must produce the same knowledge
+  for (int i = 0; i < num_agents; ++i)
+  {
+    std::stringstream prefix;
+    prefix << "agent." << i << ".";
+
+    for (const char* name :
+        {"state", "battery", "position", "readings", "name"})
+    {
+      std::string key = prefix.str() + name;
+
+      TEST_EQ(
+          direct_receiver.get(key).to_string(), sender.get(key).to_string());
+      TEST_EQ(filtered_receiver.get(key).to_string(),
+          sender.get(key).to_string());
+      TEST_EQ(in_place_receiver.get(key).to_string(),
+          sender.get(key).to_string());
+    }
+  }
+
+  // in-place filters are called without packing arguments
+  TEST_LT(in_place, filtered);
+
+  // decoding in place must leave no allocations behind per update
+  TEST_LT(direct, filtered);
+  TEST_LT(direct, updates);
+
+  log("Testing that received values are not written into shared storage\n");
+
+  knowledge::KnowledgeRecord shared = direct_receiver.get("agent.0.readings");
+  std::string next = build_message(sender, *capture, 11);
+  receive(direct_receiver, next, direct_settings);
+
+  TEST_EQ(shared.retrieve_index(0).to_integer(), (Integer)7);
+  TEST_EQ(
+      direct_receiver.get("agent.0.readings").retrieve_index(0).to_integer(),
+      (Integer)11);
+
+  log("Testing that variables with history keep each received value\n");
+
+  direct_receiver.set_history_capacity("agent.0.state", 5);
+  std::string last = build_message(sender, *capture, 13);
+  receive(direct_receiver, last, direct_settings);
+
+  TEST_EQ(direct_receiver.get("agent.0.state").to_integer(), (Integer)13);
+  TEST_GT(direct_receiver.get_history_size("agent.0.state"), (size_t)1);
+
+  for (bool reduced : {false, true})
+  {
+    log("Testing interned keys with %s message headers\n",
+        reduced ? "reduced" : "full");
+
+    knowledge::KnowledgeBase interned_sender;
+    transport::TransportSettings interned_settings;
+    interned_settings.intern_keys = true;
+    interned_settings.send_reduced_message_header = reduced;
+    CaptureTransport* interned_capture = new CaptureTransport(
+        interned_sender.get_context(), interned_settings);
+    interned_sender.attach_transport(interned_capture);
+
+    std::string defining = build_message(interned_sender, *interned_capture, 7);
+    std::string referring =
+        build_message(interned_sender, *interned_capture, 17);
+
+    log("  message sizes: %d B with names, %d B defining ids, "
+        "%d B referring to ids\n",
+        (int)message.size(), (int)defining.size(), (int)referring.size());
+
+    TEST_LT(referring.size(), defining.size());
+    TEST_LT(referring.size(), message.size());
+
+    // receivers learn ids into their settings, so each starts fresh
+    transport::QoSTransportSettings late_settings;
+    late_settings.add_read_domain(late_settings.write_domain);
+
+    // ids that have not been defined yet cannot be applied
+    knowledge::KnowledgeBase late_receiver;
+    receive(late_receiver, referring, late_settings);
+    TEST_EQ(late_receiver.exists("agent.0.state"), false);
+
+    transport::QoSTransportSettings interned_direct_settings;
+    interned_direct_settings.add_read_domain(
+        interned_direct_settings.write_domain);
+
+    knowledge::KnowledgeBase interned_receiver;
+    receive(interned_receiver, defining, interned_direct_settings);
+    receive(interned_receiver, referring, interned_direct_settings);
+
+    transport::QoSTransportSettings interned_filtered_settings;
+    interned_filtered_settings.add_read_domain(
+        interned_filtered_settings.write_domain);
+    interned_filtered_settings.add_receive_filter(
+        knowledge::KnowledgeRecord::ALL_TYPES, pass_through);
+
+    knowledge::KnowledgeBase interned_filtered;
+    receive(interned_filtered, defining, interned_filtered_settings);
+    receive(interned_filtered, referring, interned_filtered_settings);
+
+    for (int i = 0; i < num_agents; ++i)
+    {
+      std::stringstream prefix;
+      prefix << "agent." << i << ".";
+
+      for (const char* name :
+          {"state", "battery", "position", "readings", "name"})
+      {
+        std::string key = prefix.str() + name;
+
+        TEST_EQ(interned_receiver.get(key).to_string(),
+            interned_sender.get(key).to_string());
+        TEST_EQ(interned_filtered.get(key).to_string(),
+            interned_sender.get(key).to_string());
+      }
+    }
+  }
+
+  log("Testing that interned ids are forgotten when a sender restarts\n");
+
+  transport::KeyDictionary writer, reader;
+  std::vector<char> buffer(64);
+  std::string key;
+
+  const auto send = [&](const std::string& name, bool sent) {
+    int64_t remaining = (int64_t)buffer.size();
+    char* end = writer.write_session(buffer.data(), remaining);
+    end = writer.write(end, name, remaining, 10, 0);
+    writer.confirm_sends(sent);
+    return std::string(buffer.data(), end - buffer.data());
+  };
+
+  const auto read = [&](const std::string& message) {
+    int64_t remaining = (int64_t)message.size();
+    const char* update =
+        reader.read_session(message.data(), "writer", remaining);
+    reader.read(update, "writer", key, remaining);
+    return key;
+  };
+
+  // a message that was not sent does not count as defining the key
+  send("agent.0.state", false);
+  TEST_EQ(read(send("agent.0.state", true)), "agent.0.state");
+  TEST_EQ(read(send("agent.0.state", true)), "agent.0.state");
+
+  // the restarted writer's definition of id 0 as another key is lost
+  writer.clear();
+  send("agent.0.battery", true);
+  TEST_EQ(read(send("agent.0.battery", true)), "");
+  TEST_EQ(reader.received_keys("writer"), (size_t)0);
+
+  if (madara_tests_fail_count > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << madara_tests_fail_count
+              << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return madara_tests_fail_count;
+}
@@ -0,0 +1,262 @@
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/logger/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+#include "madara/utility/EpochEnforcer.h"
+
+namespace logger = madara::logger;
+namespace knowledge = madara::knowledge;
+namespace transport = madara::transport;
+namespace utility = madara::utility;
+
+typedef knowledge::KnowledgeRecord::Integer Integer;
+
+// default settings
+uint32_t num_updates = 2000;
+double send_hertz = 1000.0;
+double polled_hertz = 100.0;
+uint32_t batch_size = 32;
+int base_port = 43130;
+
+// receive statistics, filled in by the receive filter
+std::atomic<uint64_t> received(0);
+std::atomic<uint64_t> total_latency(0);
+std::atomic<uint64_t> max_latency(0);
+
+void handle_arguments(int argc, char** argv);
+
+/**
+ * Aggregate receive filter that measures how long each stamp took to go
+ * from the sending knowledge base into the receiving one
+ **/
+void measure_latency(
+    knowledge::KnowledgeMap& records, const transport::TransportContext&,
+    knowledge::Variables&)
+{
+  auto found = records.find("stamp");
+
+  if (found != records.end())
+  {
+    uint64_t now = (uint64_t)utility::get_time();
+    uint64_t sent = (uint64_t)found->second.to_integer();
+    uint64_t latency = now > sent ? now - sent : 0;
+
+    ++received;
+    total_latency += latency;
+
+    uint64_t cur_max = max_latency.load();
+    while (latency > cur_max &&
+           !max_latency.compare_exchange_weak(cur_max, latency))
+    {
+    }
+  }
+}
+
+/**
+ * Sends num_updates stamps from one knowledge base to another over
+ * loopback UDP and prints a row of statistics
+ **/
+void run_test(const std::string& mode, bool event_driven, double hertz,
+    int port)
+{
+  received = 0;
+  total_latency = 0;
+  max_latency = 0;
+
+  std::stringstream sender_host, receiver_host;
+  sender_host << "127.0.0.1:" << port;
+  receiver_host << "127.0.0.1:" << port + 1;
+
+  transport::QoSTransportSettings sender_settings;
+  sender_settings.type = transport::UDP;
+  sender_settings.no_receiving = true;
+  sender_settings.hosts.push_back(sender_host.str());
+  sender_settings.hosts.push_back(receiver_host.str());
+
+  transport::QoSTransportSettings receiver_settings;
+  receiver_settings.type = transport::UDP;
+  receiver_settings.no_sending = true;
+  receiver_settings.read_thread_hertz = hertz;
+  receiver_settings.event_driven_reads = event_driven;
+  receiver_settings.read_batch_size = batch_size;
+  receiver_settings.hosts.push_back(receiver_host.str());
+  receiver_settings.add_receive_filter(measure_latency);
+
+  knowledge::KnowledgeBase receiver("receiver", receiver_settings);
+  knowledge::KnowledgeBase sender("sender", sender_settings);
+
+  // give the read threads a chance to start
+  utility::sleep(0.5);
+
+  knowledge::VariableReference stamp = sender.get_ref("stamp");
+
+  utility::EpochEnforcer<utility::Clock> enforcer(
+      send_hertz > 0 ? 1 / send_hertz : 0.0);
+
+  int64_t start = utility::get_time();
+
+  for (uint32_t i = 0; i < num_updates; ++i)
+  {
+    sender.set(stamp, (Integer)utility::get_time());
+
+    if (send_hertz > 0)
+      enforcer.sleep_until_next();
+  }
+
+  int64_t send_end = utility::get_time();
+
+  // wait for stragglers
+  for (int i = 0; i < 20 && received < num_updates; ++i)
+  {
+    utility::sleep(0.1);
+  }
+
+  uint64_t count = received.load();
+  double seconds = (send_end - start) / 1000000000.0;
+
+  std::stringstream buffer;
+  std::locale loc("C");
+  buffer.imbue(loc);
+
+  buffer << " " << std::setw(20) << std::left << mode << std::right;
+  buffer << " " << std::setw(9) << count << "/" << num_updates;
+  buffer << " " << std::setw(13)
+         << (count > 0 ? total_latency.load() / count / 1000 : 0);
+  buffer << " " << std::setw(13) << max_latency.load() / 1000;
+  buffer << " " << std::setw(13)
+         << (seconds > 0 ? (uint64_t)(count / seconds) : 0);
+  buffer << "\n";
+
+  madara_logger_ptr_log(
+      logger::global_logger.get(), logger::LOG_ALWAYS, buffer.str().c_str());
+}
+
+int main(int argc, char** argv)
+{
+  handle_arguments(argc, argv);
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      "Comparing UDP read thread modes over loopback\n"
+      "  updates: %d, send hertz: %f, batch size: %d\n\n",
+      num_updates, send_hertz, batch_size);
+
+  madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+      " mode                          received  avg lat (us)  max lat (us)"
+      "    updates/s\n"
+      "======================================================================"
+      "==========\n");
+
+  std::stringstream polled;
+  polled << "polled @ " << polled_hertz << " hz";
+
+  run_test(polled.str(), false, polled_hertz, base_port);
+  run_test("polled @ 0 hz (spin)", false, 0.0, base_port + 2);
+  run_test("event-driven", true, 0.0, base_port + 4);
+
+  return 0;
+}
+
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-b" || arg1 == "--batch")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> batch_size;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-f" || arg1 == "--logfile")
+    {
+      if (i + 1 < argc)
+      {
+        logger::global_logger->add_file(argv[i + 1]);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-l" || arg1 == "--level")
+    {
+      if (i + 1 < argc)
+      {
+        int level;
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> level;
+        logger::global_logger->set_level(level);
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-n" || arg1 == "--updates")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> num_updates;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-p" || arg1 == "--port")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> base_port;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-s" || arg1 == "--send-hertz")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> send_hertz;
+      }
+
+      ++i;
+    }
+    else if (arg1 == "-z" || arg1 == "--read-hertz")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer(argv[i + 1]);
+        buffer >> polled_hertz;
+      }
+
+      ++i;
+    }
+    else
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProgram summary for %s:\n\n"
+          "  Compares receive latency and throughput of hertz-polled and\n"
+          "  event-driven UDP read threads over loopback.\n\n"
+          " [-b|--batch num]         datagrams per event-driven wakeup\n"
+          " [-f|--logfile file]      log to a file\n"
+          " [-l|--level level]       the logger level (0+, higher is higher "
+          "detail)\n"
+          " [-n|--updates num]       number of updates to send per mode\n"
+          " [-p|--port port]         first of six loopback ports to use\n"
+          " [-s|--send-hertz hertz]  send rate (0 or less bursts)\n"
+          " [-z|--read-hertz hertz]  hertz of the polled read thread\n"
+          "\n",
+          argv[0]);
+      exit(0);
+    }
+  }
+}
@@ -70,6 +70,9 @@ std::string save_checkpoint;
 // filename to save knowledge base as binary to
 std::string save_binary;
 
+// filename to save folded stacks of the logic profiles to
+std::string profile_file;
+
 // filename to load a stream from
 std::string stream_from;
 
@@ -402,6 +405,11 @@ void handle_arguments(int argc, const char** argv, size_t recursion_limit = 10)
           "imports. Must appear before all -n and -nf.\n"
           "  [-o|--host hostname]     the hostname of this process "
           "(def:localhost)\n"
+          "  [--profile file]         print the calls and time of each part "
+          "of the\n"
+          "                           logic at the end, and save them to "
+          "file as\n"
+          "                           folded stacks for flame graphs\n"
           "  [-ps|--print-stats]      print variable/originator stats at the "
           "end\n"
           "  [-pu|--print-updates]    print variables received, respects "
@@ -754,6 +762,15 @@ void handle_arguments(int argc, const char** argv, size_t recursion_limit = 10)
 
       ++i;
     }
+    else if (arg1 == "--profile")
+    {
+      if (i + 1 < argc)
+      {
+        profile_file = argv[i + 1];
+      }
+
+      ++i;
+    }
     else if (arg1 == "-p" || arg1 == "--drop-rate")
     {
       if (i + 1 < argc)
@@ -1432,6 +1449,17 @@ int main(int argc, char** argv)
     expressions.push_back(kb.compile(logic));
   }
 
+#ifndef _MADARA_NO_KARL_
+  // count the calls and time of each part of the logics
+  if (profile_file.size() > 0)
+  {
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+      expressions[i].enable_profiling();
+    }
+  }
+#endif  // _MADARA_NO_KARL_
+
   // check frequency to see if we should only execute once
   if (frequency < 0)
   {
@@ -1497,6 +1525,43 @@ int main(int argc, char** argv)
     }
   }
 
+#ifndef _MADARA_NO_KARL_
+  // print the profiles and save them for flame graph tools
+  if (profile_file.size() > 0)
+  {
+    std::ofstream folded(profile_file.c_str());
+
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+      std::shared_ptr<madara::expression::ExpressionProfile> profile =
+          expressions[i].get_profile();
+
+      if (!profile)
+        continue;
+
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nProfile of logic %d, evaluated %d times:\n", (int)i,
+          (int)profile->calls());
+
+      // logged by line, since the profile may not fit in a log message
+      std::stringstream lines(profile->annotate());
+      for (std::string line; std::getline(lines, line);)
+      {
+        madara_logger_ptr_log(logger::global_logger.get(),
+            logger::LOG_ALWAYS, "%s\n", line.c_str());
+      }
+
+      folded << profile->folded();
+    }
+
+    if (!folded)
+    {
+      madara_logger_ptr_log(logger::global_logger.get(), logger::LOG_ALWAYS,
+          "\nUnable to save profile to %s.\n", profile_file.c_str());
+    }
+  }
+#endif  // _MADARA_NO_KARL_
+
   // if the user requests debugging information, print final knowledge
   if (debug || print_knowledge)
   {
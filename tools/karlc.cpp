@@ -0,0 +1,124 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/expression/CppVisitor.h"
+#include "madara/utility/Utility.h"
+
+namespace knowledge = madara::knowledge;
+namespace expression = madara::expression;
+namespace utility = madara::utility;
+
+std::string logic;
+std::string output_file("logic.cpp");
+
+// handle command line arguments
+void handle_arguments(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1(argv[i]);
+
+    if (arg1 == "-i" || arg1 == "--input")
+    {
+      if (i + 1 < argc)
+      {
+        logic = utility::file_to_string(argv[i + 1]);
+      }
+      ++i;
+    }
+    else if (arg1 == "-k" || arg1 == "--karl")
+    {
+      if (i + 1 < argc)
+      {
+        logic = argv[i + 1];
+      }
+      ++i;
+    }
+    else if (arg1 == "-o" || arg1 == "--output")
+    {
+      if (i + 1 < argc)
+      {
+        output_file = argv[i + 1];
+      }
+      ++i;
+    }
+    else
+    {
+      std::cerr
+          << "\nProgram summary for " << argv[0]
+          << " [options]:\n\n"
+             "Generates C++ for KaRL logic, to be built into a shared library\n"
+             "and loaded with KnowledgeBase::load_compiled_logic, e.g.:\n\n"
+             "  g++ -std=c++11 -O2 -shared -fPIC -I$MADARA_ROOT/include\n"
+             "      logic.cpp -o liblogic.so -L$MADARA_ROOT/lib -lMADARA\n"
+             "\n\noptions:\n"
+             "  [-i|--input file]        file containing the logic.\n"
+             "  [-k|--karl logic]        the logic.\n"
+             "  [-o|--output file]       C++ file to write. Default output\n"
+             "                           is logic.cpp.\n"
+             "\n";
+      exit(0);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // handle all user arguments
+  handle_arguments(argc, argv);
+
+  if (logic == "")
+  {
+    std::cerr << "ERROR: No logic was provided. See " << argv[0]
+              << " --help.\n";
+    return -1;
+  }
+
+  knowledge::KnowledgeBase kb;
+  knowledge::CompiledExpression compiled;
+
+  try
+  {
+    compiled = kb.compile(logic);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "ERROR: Unable to compile the logic: " << e.what() << "\n";
+    return -1;
+  }
+
+  expression::CppVisitor visitor;
+
+  if (!visitor.generate(compiled.get_root()))
+  {
+    std::cerr << "ERROR: The logic contains nodes that cannot be "
+                 "generated as C++:\n";
+
+    for (const std::string& type : visitor.unsupported())
+    {
+      std::cerr << "  " << type << "\n";
+    }
+
+    return -2;
+  }
+
+  std::ofstream output(output_file.c_str());
+
+  if (!output.is_open())
+  {
+    std::cerr << "ERROR: Unable to open " << output_file << " for writing\n";
+    return -3;
+  }
+
+  output << visitor.source(logic);
+
+  return 0;
+}